@@ -124,9 +124,14 @@ bool SceneFile::Deserialise(std::vector<Entity*>& entities)
     }
     else
     {
-        PackFile* packFile = ResourceSystem::GetInstance().GetPackFile();
-
-        std::shared_ptr<SceneData> sceneData = packFile->FindDataDeserialised<SceneData>(scenePath);
+        // Read the scene's bundle in one go so that its entities' resources load from memory,
+        // dropping the previous scene's bundle in the process
+        ResourceSystem& resourceSystem = ResourceSystem::GetInstance();
+        resourceSystem.ReleaseBundles();
+        resourceSystem.PreloadBundle(scenePath);
+
+        std::shared_ptr<SceneData> sceneData =
+            resourceSystem.FindDataDeserialised<SceneData>(scenePath);
         if (!sceneData)
         {
             CC_LOG_WARNING(
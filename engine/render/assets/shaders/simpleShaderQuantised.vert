@@ -0,0 +1,72 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#version 460
+
+// Quantised vertices store positions as unorm16 values relative to the mesh bounds (which are
+// folded into the object transform), octahedral snorm16 normals, unorm8 colours and half UVs
+layout(location = 0) in vec4 position;
+layout(location = 1) in vec2 normal;
+layout(location = 2) in vec4 color;
+layout(location = 3) in vec2 uv;
+
+layout(location = 0) out vec3 fragColor;
+layout(location = 1) out vec3 fragPosWorld;
+layout(location = 2) out vec3 fragNormalWorld;
+
+struct ObjectData 
+{
+    mat4 transform;
+    mat4 normalMatrix;
+};
+
+struct CameraData
+{
+    mat4 projectionMatrix;
+    mat4 viewMatrix;
+};
+
+struct LightData
+{
+    vec4 lightColor;
+    vec4 ambientLightColor;
+    vec3 position;
+};
+
+layout (std140, binding = 0) readonly buffer ObjectBuffer {
+    ObjectData objects[];
+} objectBuffer;
+
+layout (binding = 1) uniform GlobalData {
+    CameraData cameraData;
+    LightData lightData;
+} globalData;
+
+vec3 OctahedralDecode(vec2 encoded)
+{
+    vec3 normal = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+    float fold = max(-normal.z, 0.0);
+    normal.x += normal.x >= 0.0 ? -fold : fold;
+    normal.y += normal.y >= 0.0 ? -fold : fold;
+    return normalize(normal);
+}
+
+void main() {
+
+    ObjectData object = objectBuffer.objects[gl_InstanceIndex];
+
+    vec4 positionWorld = object.transform * vec4(position.xyz, 1.0);
+
+    CameraData camera = globalData.cameraData;
+
+    gl_Position = camera.projectionMatrix * camera.viewMatrix * positionWorld;
+    fragNormalWorld = normalize(mat3(object.normalMatrix) * OctahedralDecode(normal));
+    fragPosWorld = positionWorld.xyz;
+    fragColor = color.rgb;
+}
\ No newline at end of file
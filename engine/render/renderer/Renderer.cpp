@@ -11,7 +11,6 @@
 
 #include "platform/vulkan/Font.h"
 #include "platform/vulkan/utils/Types.h"
-#include "platform/vulkan/utils/Viewport.h"
 #include "statics/Statics.h"
 
 namespace Siege
@@ -43,11 +42,14 @@ Renderer::Renderer(Window& window) : window {window}
     renderer2D.Initialise("globalData");
 
     commandBuffers = Vulkan::CommandBuffer(Vulkan::Swapchain::MAX_FRAMES_IN_FLIGHT);
+
+    commandRecorder.Start();
 }
 
 Renderer::~Renderer()
 {
     CC_LOG_INFO("Destroying renderer")
+    commandRecorder.Stop();
     DescriptorPool::DestroyPool();
     Renderer3D::DestroyRenderer3D();
     Statics::Free();
@@ -55,13 +57,20 @@ Renderer::~Renderer()
 
 void Renderer::DrawFrame()
 {
-    Renderer3D::Render(currentFrameIndex, commandBuffers, camera3D);
-    renderer2D.Render(commandBuffers, sizeof(camera2D), &camera2D, currentFrameIndex);
+    Renderer3D::Render(currentFrameIndex, commandRecorder, camera3D);
+
+    // The 2D pass is drawn over the 3D one, so its job is queued after every 3D job
+    commandRecorder.Record([this](Vulkan::CommandBuffer& commandBuffer) {
+        renderer2D.Render(commandBuffer, sizeof(camera2D), &camera2D, currentFrameIndex);
+    });
+
+    commandRecorder.Execute(commandBuffers);
 }
 
 void Renderer::RecreateSwapChain()
 {
-    ClearQueues();
+    // The old swapchain's objects are destroyed through the deletion queue once the frames using
+    // them complete, so there's no need to wait for the device to go idle here
     auto extent = window.GetExtents();
 
     while (!window.IsVisible() || extent.width == 0.0 || extent.height == 0.0)
@@ -105,8 +114,19 @@ bool Renderer::StartFrame()
 
     isFrameStarted = true;
 
+    // Acquiring the image waited on this frame's fence, so its uniform data, and anything released
+    // since the frame last used its slot, is no longer in use
+    Vulkan::Context::GetUniformRing().BeginFrame(currentFrameIndex);
+    Vulkan::Context::GetDeletionQueue().BeginFrame();
+
     commandBuffers.Begin(currentFrameIndex);
 
+    // The frame's fence was waited on above too, so its command pools can be reset
+    commandRecorder.BeginFrame(currentFrameIndex,
+                               swapchain.GetRenderPass()->GetRawRenderPass(),
+                               swapchain.GetFramebuffer(currentImageIndex),
+                               swapchain.GetExtent());
+
     BeginSwapChainRenderPass();
 
     return true;
@@ -170,6 +190,9 @@ void Renderer::EndFrame()
 
     commandBuffers.SetActiveBufferIndex(currentFrameIndex);
 
+    // Uploads made since the last frame are submitted ahead of the frame which draws with them
+    Vulkan::Context::GetUploadManager().Flush();
+
     auto result = swapchain.SubmitCommandBuffers(commandBuffers, currentImageIndex);
 
     if (result == Vulkan::Utils::ERROR_RESIZED || window.WasResized() || !window.IsVisible())
@@ -196,16 +219,9 @@ void Renderer::BeginSwapChainRenderPass()
 
     CC_ASSERT(isFrameStarted, "Can't start render pass while the frame hasn't started!")
 
-    auto swapExtent = swapchain.GetExtent();
-
-    swapchain.BeginRenderPass(commandBuffers, currentImageIndex, {0.96f, 0.96f, 0.96f, 1.f});
-
-    using namespace Vulkan::Utils;
-
-    SetViewport(commandBuffers.GetActiveCommandBuffer(),
-                static_cast<float>(swapExtent.width),
-                static_cast<float>(swapExtent.height));
-    SetScissor(commandBuffers.GetActiveCommandBuffer(), swapExtent.width, swapExtent.height);
+    // The render pass's contents are recorded by the command recorder, which sets the viewport
+    // and scissor in each of its command buffers
+    swapchain.BeginRenderPass(commandBuffers, currentImageIndex, {0.96f, 0.96f, 0.96f, 1.f}, true);
 }
 
 void Renderer::EndSwapChainRenderPass()
@@ -16,6 +16,7 @@
 #include "camera/Camera.h"
 #include "lights/PointLight.h"
 #include "render/renderer/platform/vulkan/CommandBuffer.h"
+#include "render/renderer/platform/vulkan/CommandRecorder.h"
 #include "render/renderer/platform/vulkan/Context.h"
 #include "render/renderer/platform/vulkan/DescriptorPool.h"
 #include "renderer/Renderer2D.h"
@@ -102,6 +103,7 @@ private:
     void DrawFrame();
 
     Vulkan::Context context;
+    Vulkan::CommandRecorder commandRecorder;
     Renderer2D renderer2D;
 
     Window& window;
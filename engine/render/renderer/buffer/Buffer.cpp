@@ -24,7 +24,7 @@ void CreateBuffer(unsigned long size,
                   unsigned int usage,
                   unsigned int properties,
                   VkBuffer& buffer,
-                  VkDeviceMemory& bufferMemory)
+                  Vulkan::MemoryAllocation& bufferMemory)
 {
     if (size == 0) return;
 
@@ -42,38 +42,24 @@ void CreateBuffer(unsigned long size,
     VkMemoryRequirements memRequirements;
     vkGetBufferMemoryRequirements(device, buffer, &memRequirements);
 
-    VkMemoryAllocateInfo allocInfo {};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex =
-        Vulkan::Device::Physical::FindMemoryType(Vulkan::Context::GetPhysicalDevice()->GetDevice(),
-                                                 memRequirements.memoryTypeBits,
-                                                 properties);
+    bufferMemory = Vulkan::Context::GetMemoryAllocator().Allocate(
+        memRequirements,
+        properties,
+        Vulkan::MemoryAllocator::RESOURCE_BUFFER);
 
-    CC_ASSERT(vkAllocateMemory(device, &allocInfo, nullptr, OUT & bufferMemory) == VK_SUCCESS,
-              "failed to allocate vertex buffer memory!");
-
-    vkBindBufferMemory(device, buffer, bufferMemory, 0);
+    vkBindBufferMemory(device, buffer, bufferMemory.memory, bufferMemory.offset);
 };
 
 void CopyData(Buffer& dstBuffer, unsigned long size, const void* bufferData, unsigned long offset)
 {
-    auto device = Vulkan::Context::GetVkLogicalDevice();
+    CC_ASSERT(dstBuffer.bufferMemory.mappedData, "Cannot copy data into unmapped buffer memory!")
 
-    void* data;
-    vkMapMemory(device, dstBuffer.bufferMemory, offset, size, 0, &data);
-    memcpy(data, bufferData, size);
-    vkUnmapMemory(device, dstBuffer.bufferMemory);
+    memcpy(static_cast<uint8_t*>(dstBuffer.bufferMemory.mappedData) + offset, bufferData, size);
 }
 
 void AppendData(Buffer& dstBuffer, unsigned long size, const void* bufferData)
 {
-    auto device = Vulkan::Context::GetVkLogicalDevice();
-
-    void* data;
-    vkMapMemory(device, dstBuffer.bufferMemory, dstBuffer.size, size, 0, &data);
-    memcpy(data, bufferData, size);
-    vkUnmapMemory(device, dstBuffer.bufferMemory);
+    CopyData(dstBuffer, size, bufferData, dstBuffer.size);
 
     dstBuffer.size = dstBuffer.size + size;
 }
@@ -85,14 +71,19 @@ void CopyBuffer(VkBuffer& srcBuffer, VkBuffer& dstBuffer, unsigned long size)
 
 void DestroyBuffer(Buffer& buffer)
 {
-    VkDevice device = Vulkan::Context::GetVkLogicalDevice();
-    if (device == nullptr) return;
+    if (Vulkan::Context::GetVkLogicalDevice() == nullptr) return;
 
-    if (buffer.buffer != VK_NULL_HANDLE) vkDestroyBuffer(device, buffer.buffer, nullptr);
-    if (buffer.bufferMemory != VK_NULL_HANDLE) vkFreeMemory(device, buffer.bufferMemory, nullptr);
+    Vulkan::Context::GetDeletionQueue().Push(
+        [vkBuffer = buffer.buffer, memory = buffer.bufferMemory](VkDevice device) mutable {
+            if (device != nullptr && vkBuffer != VK_NULL_HANDLE)
+            {
+                vkDestroyBuffer(device, vkBuffer, nullptr);
+            }
+            Vulkan::Context::GetMemoryAllocator().Free(memory);
+        });
 
     buffer.buffer = VK_NULL_HANDLE;
-    buffer.bufferMemory = VK_NULL_HANDLE;
+    buffer.bufferMemory = {};
 }
 
 size_t PadUniformBufferSize(size_t originalSize)
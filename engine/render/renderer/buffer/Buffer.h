@@ -10,6 +10,7 @@
 #ifndef SIEGE_ENGINE_BUFFER_H
 #define SIEGE_ENGINE_BUFFER_H
 
+#include "render/renderer/platform/vulkan/utils/MemoryAllocator.h"
 #include "render/renderer/platform/vulkan/utils/Types.h"
 
 namespace Siege::Buffer
@@ -17,13 +18,14 @@ namespace Siege::Buffer
 struct Buffer
 {
     VkBuffer buffer {nullptr};
-    VkDeviceMemory bufferMemory {nullptr};
+    Vulkan::MemoryAllocation bufferMemory;
     uint64_t size = 0;
 };
 
 /**
  * Creates a memory buffer for transferring data to our GPU. Allocates resulting data to the
- *'buffer' and 'bufferMemory' variables respectively.
+ *'buffer' and 'bufferMemory' variables respectively. Memory is sub-allocated from the context's
+ * MemoryAllocator, and is left mapped if it is host visible.
  *
  * @param size - specifies the size of the buffer.
  * @param usage - specifies what the buffer will be used for (i.e: vertex definitions).
@@ -35,7 +37,7 @@ void CreateBuffer(unsigned long size,
                   unsigned int usage,
                   unsigned int properties,
                   VkBuffer& buffer,
-                  VkDeviceMemory& bufferMemory);
+                  Vulkan::MemoryAllocation& bufferMemory);
 
 /**
  * Returns a bitmask value representing the memory type required to allocate GPU memory.
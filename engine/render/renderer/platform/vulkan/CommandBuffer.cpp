@@ -23,6 +23,13 @@ CommandBuffer::CommandBuffer(uint32_t count)
     commandBuffers = Utils::CommandBuffer::AllocateCommandBuffers(device, pool, count);
 }
 
+CommandBuffer::CommandBuffer(uint32_t count, VkCommandPool pool)
+{
+    auto device = Context::GetVkLogicalDevice();
+
+    commandBuffers = Utils::CommandBuffer::AllocateSecondaryCommandBuffers(device, pool, count);
+}
+
 void CommandBuffer::Begin(int32_t index)
 {
     auto commandBuffer = commandBuffers[index];
@@ -33,6 +40,25 @@ void CommandBuffer::Begin(int32_t index)
     currentActiveBufferIndex = index;
 }
 
+void CommandBuffer::BeginInRenderPass(int32_t index,
+                                      VkRenderPass renderPass,
+                                      VkFramebuffer framebuffer)
+{
+    auto commandBuffer = commandBuffers[index];
+
+    Utils::CommandBuffer::BeginSecondaryCommand(commandBuffer, renderPass, framebuffer);
+
+    activeCommandBuffer = commandBuffer;
+    currentActiveBufferIndex = index;
+}
+
+void CommandBuffer::ExecuteCommands(const VkCommandBuffer* secondaryBuffers, uint32_t count)
+{
+    if (count == 0) return;
+
+    vkCmdExecuteCommands(activeCommandBuffer, count, secondaryBuffers);
+}
+
 void CommandBuffer::End()
 {
     Utils::CommandBuffer::EndCommandBuffer(activeCommandBuffer);
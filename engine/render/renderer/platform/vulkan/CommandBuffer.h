@@ -41,6 +41,14 @@ public:
      * @param count the number of buffers to create
      */
     CommandBuffer(uint32_t count);
+
+    /**
+     * Constructor for secondary CommandBuffers, which record commands to be executed from within a
+     * primary CommandBuffer's render pass
+     * @param count the number of buffers to create
+     * @param pool the command pool to allocate the buffers from
+     */
+    CommandBuffer(uint32_t count, VkCommandPool pool);
     /**
      * Move constructor for the CommandBuffer
      * @param other the CommandBuffer to move
@@ -107,6 +115,21 @@ public:
      */
     void Begin(int32_t index = 0);
 
+    /**
+     * Starts recording a secondary command buffer which continues a render pass
+     * @param index the index of the command buffer to be recorded
+     * @param renderPass the render pass the commands will be executed in
+     * @param framebuffer the framebuffer the render pass is rendering to
+     */
+    void BeginInRenderPass(int32_t index, VkRenderPass renderPass, VkFramebuffer framebuffer);
+
+    /**
+     * Records the execution of secondary command buffers into the active command buffer
+     * @param secondaryBuffers the secondary command buffers to execute, in order
+     * @param count the number of secondary command buffers
+     */
+    void ExecuteCommands(const VkCommandBuffer* secondaryBuffers, uint32_t count);
+
     /**
      * Ends the recording of the active command buffer
      */
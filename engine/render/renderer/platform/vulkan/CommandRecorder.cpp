@@ -0,0 +1,219 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#include "CommandRecorder.h"
+
+#include <utils/Logging.h>
+#include <volk/volk.h>
+
+#include <algorithm>
+
+#include "Context.h"
+#include "Swapchain.h"
+#include "utils/CommandPool.h"
+#include "utils/Viewport.h"
+
+namespace Siege::Vulkan
+{
+CommandRecorder::~CommandRecorder()
+{
+    Stop();
+}
+
+void CommandRecorder::Start(uint32_t workerCount)
+{
+    if (threadCount > 0) return;
+
+    if (workerCount == 0)
+    {
+        uint32_t hardwareThreads = std::thread::hardware_concurrency();
+        workerCount = std::clamp(hardwareThreads > 1 ? hardwareThreads - 1 : 1u,
+                                 1u,
+                                 MAX_DEFAULT_WORKERS);
+    }
+
+    threadCount = workerCount + 1;
+
+    VkDevice device = Context::GetVkLogicalDevice();
+    uint32_t queueFamily = Context::GetPhysicalDevice()->GetGraphicsFamilyQueueIndex();
+
+    // Pools are reset as a whole at the start of each frame, so buffers never need resetting on
+    // their own
+    threadFrames.resize(threadCount * Swapchain::MAX_FRAMES_IN_FLIGHT);
+    for (ThreadFrame& threadFrame : threadFrames)
+    {
+        threadFrame.pool = CommandPool::Builder()
+                               .WithQueueFamily(queueFamily)
+                               .WithCallbacks(nullptr)
+                               .WithFlag(VK_COMMAND_POOL_CREATE_TRANSIENT_BIT)
+                               .Build(device);
+        threadFrame.commandBuffers = CommandBuffer(MAX_JOBS_PER_THREAD, threadFrame.pool);
+    }
+
+    stopWorkers = false;
+    for (uint32_t i = 1; i < threadCount; i++)
+    {
+        workers.emplace_back(&CommandRecorder::RunWorker, this, i);
+    }
+
+    CC_LOG_INFO("[COMMAND RECORDER] Recording across {} threads", threadCount)
+}
+
+void CommandRecorder::Stop()
+{
+    if (threadCount == 0) return;
+
+    {
+        std::lock_guard<std::mutex> lock(workerMutex);
+        stopWorkers = true;
+    }
+    dispatchCondition.notify_all();
+
+    for (auto& worker : workers) worker.join();
+    workers.clear();
+
+    // Destroying the pools frees the command buffers allocated from them
+    VkDevice device = Context::GetVkLogicalDevice();
+    if (device != nullptr)
+    {
+        for (ThreadFrame& threadFrame : threadFrames)
+        {
+            vkDestroyCommandPool(device, threadFrame.pool, nullptr);
+        }
+    }
+
+    threadFrames.clear();
+    jobs.clear();
+    threadCount = 0;
+}
+
+void CommandRecorder::BeginFrame(uint32_t frameIndex,
+                                 VkRenderPass targetRenderPass,
+                                 VkFramebuffer targetFramebuffer,
+                                 Utils::Extent2D targetExtent)
+{
+    CC_ASSERT(jobs.empty(), "Can't begin a frame while jobs from the last one are still queued!")
+
+    currentFrame = frameIndex;
+    renderPass = targetRenderPass;
+    framebuffer = targetFramebuffer;
+    extent = targetExtent;
+
+    // Resetting without releasing resources keeps the pools' memory for this frame's recording
+    VkDevice device = Context::GetVkLogicalDevice();
+    for (uint32_t thread = 0; thread < threadCount; thread++)
+    {
+        ThreadFrame& threadFrame = GetThreadFrame(thread);
+        vkResetCommandPool(device, threadFrame.pool, 0);
+        threadFrame.usedCount = 0;
+    }
+}
+
+void CommandRecorder::Record(RecordFunction&& function)
+{
+    uint32_t thread = static_cast<uint32_t>(jobs.size() % threadCount);
+    ThreadFrame& threadFrame = GetThreadFrame(thread);
+
+    CC_ASSERT(threadFrame.usedCount < MAX_JOBS_PER_THREAD,
+              "Too many recording jobs were queued in a single frame!")
+
+    jobs.push_back({std::move(function), thread, threadFrame.usedCount++});
+}
+
+void CommandRecorder::Execute(CommandBuffer& primaryBuffer)
+{
+    if (jobs.empty()) return;
+
+    // A single job gains nothing from waking the workers, so it's recorded in place
+    if (workers.empty() || jobs.size() == 1)
+    {
+        for (uint32_t thread = 0; thread < threadCount; thread++) RecordJobs(thread);
+    }
+    else
+    {
+        {
+            std::lock_guard<std::mutex> lock(workerMutex);
+            dispatchCount++;
+            busyWorkers = static_cast<uint32_t>(workers.size());
+        }
+        dispatchCondition.notify_all();
+
+        RecordJobs(0);
+
+        std::unique_lock<std::mutex> lock(workerMutex);
+        completeCondition.wait(lock, [this] { return busyWorkers == 0; });
+    }
+
+    std::vector<VkCommandBuffer> secondaryBuffers;
+    secondaryBuffers.reserve(jobs.size());
+    for (const Job& job : jobs)
+    {
+        secondaryBuffers.push_back(GetThreadFrame(job.thread).commandBuffers.Get(job.bufferIndex));
+    }
+
+    primaryBuffer.ExecuteCommands(secondaryBuffers.data(),
+                                  static_cast<uint32_t>(secondaryBuffers.size()));
+    jobs.clear();
+}
+
+CommandRecorder::ThreadFrame& CommandRecorder::GetThreadFrame(uint32_t thread)
+{
+    return threadFrames[currentFrame * threadCount + thread];
+}
+
+void CommandRecorder::RecordJobs(uint32_t thread)
+{
+    CommandBuffer& commandBuffers = GetThreadFrame(thread).commandBuffers;
+
+    for (Job& job : jobs)
+    {
+        if (job.thread != thread) continue;
+
+        commandBuffers.BeginInRenderPass(static_cast<int32_t>(job.bufferIndex),
+                                         renderPass,
+                                         framebuffer);
+
+        // Secondary command buffers don't inherit dynamic state from the primary buffer
+        Utils::SetViewport(commandBuffers.GetActiveCommandBuffer(),
+                           static_cast<float>(extent.width),
+                           static_cast<float>(extent.height));
+        Utils::SetScissor(commandBuffers.GetActiveCommandBuffer(), extent.width, extent.height);
+
+        job.function(commandBuffers);
+
+        commandBuffers.End();
+    }
+}
+
+void CommandRecorder::RunWorker(uint32_t thread)
+{
+    uint64_t lastDispatch = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(workerMutex);
+            dispatchCondition.wait(lock, [this, lastDispatch] {
+                return stopWorkers || dispatchCount != lastDispatch;
+            });
+            if (stopWorkers) return;
+
+            lastDispatch = dispatchCount;
+        }
+
+        RecordJobs(thread);
+
+        {
+            std::lock_guard<std::mutex> lock(workerMutex);
+            busyWorkers--;
+        }
+        completeCondition.notify_one();
+    }
+}
+} // namespace Siege::Vulkan
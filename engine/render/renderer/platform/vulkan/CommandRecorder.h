@@ -0,0 +1,183 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#ifndef SIEGE_ENGINE_VULKAN_COMMAND_RECORDER_H
+#define SIEGE_ENGINE_VULKAN_COMMAND_RECORDER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "CommandBuffer.h"
+#include "utils/Types.h"
+
+namespace Siege::Vulkan
+{
+/**
+ * Records the contents of a render pass into secondary command buffers across several threads.
+ * Each thread has a command pool per frame in flight, which is reset when the frame begins so
+ * its command buffers are reused rather than reallocated. Recording jobs are handed to threads in
+ * turn and their command buffers are executed in the order the jobs were queued, so the result is
+ * the same no matter which thread finishes first. The calling thread records its share of the
+ * jobs too, so with no workers started everything is recorded in place
+ *
+ * @param workers the worker threads, each recording the jobs of one thread index after the first
+ * @param threadFrames the command pool and command buffers of each thread, for each frame
+ * @param jobs the jobs queued for the current frame, in execution order
+ * @param threadCount the number of threads recording, including the calling thread
+ * @param currentFrame the index of the frame being recorded
+ * @param renderPass the render pass the command buffers are executed in
+ * @param framebuffer the framebuffer the render pass renders to
+ * @param extent the size of the area rendered to, which every command buffer sets its viewport
+ * and scissor to
+ */
+class CommandRecorder
+{
+public:
+
+    // The most worker threads started when no count is given
+    static constexpr uint32_t MAX_DEFAULT_WORKERS = 3;
+
+    // The most jobs a single thread can record in one frame
+    static constexpr uint32_t MAX_JOBS_PER_THREAD = 8;
+
+    /**
+     * A function which records commands into the command buffer it is given
+     */
+    using RecordFunction = std::function<void(CommandBuffer&)>;
+
+    /**
+     * An empty default constructor for the CommandRecorder
+     */
+    CommandRecorder() = default;
+
+    /**
+     * A destructor for the CommandRecorder, stops the workers if they are running
+     */
+    ~CommandRecorder();
+
+    /**
+     * Starts the worker threads and creates each thread's command pools
+     * @param workerCount the number of worker threads to start, if zero one less than the number
+     * of hardware threads is used, up to MAX_DEFAULT_WORKERS
+     */
+    void Start(uint32_t workerCount = 0);
+
+    /**
+     * Stops the worker threads and destroys the command pools
+     */
+    void Stop();
+
+    /**
+     * Resets the frame's command pools, making their command buffers available for recording.
+     * Must only be called once the frame's previous submission has completed
+     * @param frameIndex the index of the frame being started
+     * @param targetRenderPass the render pass the frame's commands are executed in
+     * @param targetFramebuffer the framebuffer the render pass renders to
+     * @param targetExtent the size of the area being rendered to
+     */
+    void BeginFrame(uint32_t frameIndex,
+                    VkRenderPass targetRenderPass,
+                    VkFramebuffer targetFramebuffer,
+                    Utils::Extent2D targetExtent);
+
+    /**
+     * Queues a recording job, to be recorded into a command buffer of its own when the frame is
+     * executed. Jobs run at the same time as each other, so must not share state which isn't
+     * safe to access from several threads
+     * @param function the function recording the job's commands
+     */
+    void Record(RecordFunction&& function);
+
+    /**
+     * Records every queued job across the threads, waits for them to finish, then records the
+     * execution of their command buffers, in the order they were queued, into a primary buffer
+     * @param primaryBuffer the command buffer recording the render pass
+     */
+    void Execute(CommandBuffer& primaryBuffer);
+
+    /**
+     * Returns the number of threads recording jobs, including the calling thread
+     * @return the number of recording threads
+     */
+    uint32_t GetThreadCount() const
+    {
+        return threadCount;
+    }
+
+private:
+
+    /**
+     * A queued recording job
+     * @param function the function recording the job's commands
+     * @param thread the index of the thread recording the job
+     * @param bufferIndex the index of the job's command buffer within the thread's buffers
+     */
+    struct Job
+    {
+        RecordFunction function;
+        uint32_t thread {0};
+        uint32_t bufferIndex {0};
+    };
+
+    /**
+     * The recording resources of a single thread for a single frame
+     * @param pool the command pool the command buffers are allocated from
+     * @param commandBuffers the secondary command buffers jobs are recorded into
+     * @param usedCount the number of command buffers handed to jobs this frame
+     */
+    struct ThreadFrame
+    {
+        VkCommandPool pool {nullptr};
+        CommandBuffer commandBuffers;
+        uint32_t usedCount {0};
+    };
+
+    /**
+     * Gets the recording resources of a thread for the current frame
+     * @param thread the index of the thread
+     * @return the thread's resources
+     */
+    ThreadFrame& GetThreadFrame(uint32_t thread);
+
+    /**
+     * Records every job handed to a thread, in the order they were queued
+     * @param thread the index of the thread
+     */
+    void RecordJobs(uint32_t thread);
+
+    /**
+     * The loop run by each worker thread, recording its jobs whenever a frame is executed
+     * @param thread the index of the thread
+     */
+    void RunWorker(uint32_t thread);
+
+    std::vector<std::thread> workers;
+    std::mutex workerMutex;
+    std::condition_variable dispatchCondition;
+    std::condition_variable completeCondition;
+    uint64_t dispatchCount {0};
+    uint32_t busyWorkers {0};
+    bool stopWorkers {false};
+
+    std::vector<ThreadFrame> threadFrames;
+    std::vector<Job> jobs;
+    uint32_t threadCount {0};
+    uint32_t currentFrame {0};
+
+    VkRenderPass renderPass {nullptr};
+    VkFramebuffer framebuffer {nullptr};
+    Utils::Extent2D extent {};
+};
+} // namespace Siege::Vulkan
+
+#endif // SIEGE_ENGINE_VULKAN_COMMAND_RECORDER_H
@@ -25,7 +25,17 @@ namespace Siege::Vulkan
 {
 Context::~Context()
 {
+    // Nothing can be in use once the device is idle, so everything still queued is destroyed now
+    if (logicalDevice.GetDevice() != nullptr) logicalDevice.WaitIdle();
+    uploadManager.Free();
+    uniformRing.Free();
     swapchain.~Swapchain();
+    pipelineLibrary.Destroy();
+    deletionQueue.Flush();
+    pipelineCache.Save();
+    pipelineCache.Destroy();
+    memoryAllocator.LogUsageReport();
+    memoryAllocator.Destroy();
     logicalDevice.~LogicalDevice();
     vkDestroySurfaceKHR(vulkanInstance.GetInstance(), surface, nullptr);
     vulkanInstance.~Instance();
@@ -48,8 +58,14 @@ void Context::Init(Window& window)
 
     logicalDevice = LogicalDevice(surface, physicalDevice);
 
+    memoryAllocator = MemoryAllocator(MemoryAllocator::DEFAULT_BLOCK_SIZE);
+    pipelineCache = PipelineCache(PipelineCache::DEFAULT_PATH);
+
     auto extents = window.GetExtents();
     swapchain = Swapchain({extents.width, extents.height});
+
+    uniformRing = UniformRing(UniformRing::DEFAULT_FRAME_CAPACITY);
+    uploadManager = UploadManager(UploadManager::DEFAULT_CAPACITY);
 }
 
 Context& Context::Get()
@@ -59,11 +75,10 @@ Context& Context::Get()
 
 void Context::RecreateSwapchain(const Utils::Extent2D& extent)
 {
-    auto oldSwapchain = Get().GetSwapchain().GetRaw();
-    Get().RecreateSwapchain(extent, oldSwapchain);
+    Get().RecreateSwapchain(extent, Get().swapchain);
 }
 
-void Context::RecreateSwapchain(const Utils::Extent2D& extent, VkSwapchainKHR oldSwapchain)
+void Context::RecreateSwapchain(const Utils::Extent2D& extent, Swapchain& oldSwapchain)
 {
     swapchain = Swapchain(extent, oldSwapchain);
 }
@@ -10,10 +10,16 @@
 #ifndef SIEGE_ENGINE_CONTEXT_H
 #define SIEGE_ENGINE_CONTEXT_H
 
+#include "DeletionQueue.h"
 #include "Instance.h"
 #include "LogicalDevice.h"
 #include "PhysicalDevice.h"
+#include "PipelineCache.h"
+#include "PipelineLibrary.h"
 #include "Swapchain.h"
+#include "UniformRing.h"
+#include "UploadManager.h"
+#include "utils/MemoryAllocator.h"
 #include "window/Window.h"
 
 namespace Siege::Vulkan
@@ -53,18 +59,54 @@ public:
         return Get().swapchain;
     }
 
+    static MemoryAllocator& GetMemoryAllocator()
+    {
+        return Get().memoryAllocator;
+    }
+
+    static PipelineCache& GetPipelineCache()
+    {
+        return Get().pipelineCache;
+    }
+
+    static PipelineLibrary& GetPipelineLibrary()
+    {
+        return Get().pipelineLibrary;
+    }
+
+    static DeletionQueue& GetDeletionQueue()
+    {
+        return Get().deletionQueue;
+    }
+
+    static UniformRing& GetUniformRing()
+    {
+        return Get().uniformRing;
+    }
+
+    static UploadManager& GetUploadManager()
+    {
+        return Get().uploadManager;
+    }
+
     static void RecreateSwapchain(const Utils::Extent2D& extent);
 
 private:
 
-    void RecreateSwapchain(const Utils::Extent2D& extent, VkSwapchainKHR oldSwapchain);
+    void RecreateSwapchain(const Utils::Extent2D& extent, Swapchain& oldSwapchain);
 
     static inline Instance vulkanInstance;
 
     PhysicalDevice physicalDevice;
     Surface surface {nullptr};
     LogicalDevice logicalDevice;
+    MemoryAllocator memoryAllocator;
+    PipelineCache pipelineCache;
+    PipelineLibrary pipelineLibrary;
+    DeletionQueue deletionQueue;
     Swapchain swapchain;
+    UniformRing uniformRing;
+    UploadManager uploadManager;
 };
 } // namespace Siege::Vulkan
 
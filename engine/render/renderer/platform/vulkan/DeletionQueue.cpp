@@ -0,0 +1,85 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#include "DeletionQueue.h"
+
+#include <utility>
+#include <vector>
+
+#include "Context.h"
+#include "Swapchain.h"
+
+namespace Siege::Vulkan
+{
+DeletionQueue::DeletionQueue(DeletionQueue&& other) noexcept
+{
+    Swap(other);
+}
+
+DeletionQueue::~DeletionQueue()
+{
+    Flush();
+}
+
+DeletionQueue& DeletionQueue::operator=(DeletionQueue&& other) noexcept
+{
+    Swap(other);
+    return *this;
+}
+
+void DeletionQueue::Push(Deleter&& deleter)
+{
+    std::lock_guard<std::mutex> lock(entryMutex);
+    entries.push_back({frameNumber, std::move(deleter)});
+}
+
+void DeletionQueue::BeginFrame()
+{
+    std::vector<Deleter> completed;
+    {
+        std::lock_guard<std::mutex> lock(entryMutex);
+        frameNumber++;
+
+        if (frameNumber < Swapchain::MAX_FRAMES_IN_FLIGHT) return;
+
+        // The frame which last used this frame's slot has had its fence waited on, so anything
+        // released while it was being recorded, or earlier, is no longer in use
+        uint64_t completedFrame = frameNumber - Swapchain::MAX_FRAMES_IN_FLIGHT;
+        while (!entries.empty() && entries.front().frame <= completedFrame)
+        {
+            completed.push_back(std::move(entries.front().deleter));
+            entries.pop_front();
+        }
+    }
+
+    // Deleters are run outside the lock so they're free to release other objects
+    VkDevice device = Context::GetVkLogicalDevice();
+    for (Deleter& deleter : completed) deleter(device);
+}
+
+void DeletionQueue::Flush()
+{
+    std::deque<Entry> pending;
+    {
+        std::lock_guard<std::mutex> lock(entryMutex);
+        std::swap(pending, entries);
+    }
+
+    // Deleters are still run without a device, as they also release host memory and allocator
+    // ranges owned by the objects they destroy
+    VkDevice device = Context::GetVkLogicalDevice();
+    for (Entry& entry : pending) entry.deleter(device);
+}
+
+void DeletionQueue::Swap(DeletionQueue& other)
+{
+    std::swap(entries, other.entries);
+    std::swap(frameNumber, other.frameNumber);
+}
+} // namespace Siege::Vulkan
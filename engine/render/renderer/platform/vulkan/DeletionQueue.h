@@ -0,0 +1,105 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#ifndef SIEGE_ENGINE_VULKAN_DELETION_QUEUE_H
+#define SIEGE_ENGINE_VULKAN_DELETION_QUEUE_H
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+#include "utils/Types.h"
+
+namespace Siege::Vulkan
+{
+/**
+ * Defers the destruction of Vulkan objects until the GPU can no longer be using them. Each object
+ * is tagged with the frame that was being recorded when it was released, and is only destroyed
+ * once that frame's fence has been waited on, which happens when its slot comes round again
+ * MAX_FRAMES_IN_FLIGHT frames later. This lets resources be released mid-frame, or between
+ * frames, without waiting for the device to go idle
+ *
+ * @param entries the pending destructions, in the order they were pushed
+ * @param frameNumber the number of frames begun since the queue was created
+ * @param entryMutex guards the entries against objects being released from several threads
+ */
+class DeletionQueue
+{
+public:
+
+    /**
+     * A function which destroys one or more Vulkan objects with the device it is given. The device
+     * may be null if it has already been destroyed, in which case only host-side resources are
+     * released
+     */
+    using Deleter = std::function<void(VkDevice)>;
+
+    /**
+     * An empty default constructor for the DeletionQueue
+     */
+    DeletionQueue() = default;
+
+    /**
+     * A move constructor for the DeletionQueue
+     * @param other the DeletionQueue to be moved
+     */
+    DeletionQueue(DeletionQueue&& other) noexcept;
+
+    /**
+     * A destructor for the DeletionQueue, destroys everything still pending
+     */
+    ~DeletionQueue();
+
+    /**
+     * A move assignment operator for the DeletionQueue
+     * @param other the DeletionQueue to be moved
+     * @return a reference to the current DeletionQueue
+     */
+    DeletionQueue& operator=(DeletionQueue&& other) noexcept;
+
+    /**
+     * Queues objects for destruction once the frame currently being recorded has completed
+     * @param deleter the function destroying the objects, which must capture them by value
+     */
+    void Push(Deleter&& deleter);
+
+    /**
+     * Advances the queue to a new frame and destroys everything released in frames that have
+     * since completed. Must only be called once the new frame's fence has been waited on
+     */
+    void BeginFrame();
+
+    /**
+     * Destroys everything pending regardless of the frame it was released in. Must only be called
+     * once the device is idle
+     */
+    void Flush();
+
+private:
+
+    struct Entry
+    {
+        uint64_t frame {0};
+        Deleter deleter;
+    };
+
+    /**
+     * Swaps the contents of two DeletionQueues
+     * @param other the DeletionQueue to swap with
+     */
+    void Swap(DeletionQueue& other);
+
+    std::deque<Entry> entries;
+    uint64_t frameNumber {0};
+    std::mutex entryMutex;
+};
+} // namespace Siege::Vulkan
+
+#endif // SIEGE_ENGINE_VULKAN_DELETION_QUEUE_H
@@ -66,6 +66,13 @@ void Fence::Wait(const size_t idx)
     vkWaitForFences(Context::GetVkLogicalDevice(), 1, &fences[idx], VK_TRUE, UINT64_MAX);
 }
 
+bool Fence::IsSignalled(const size_t idx)
+{
+    if (fences[idx] == VK_NULL_HANDLE) return true;
+
+    return vkGetFenceStatus(Context::GetVkLogicalDevice(), fences[idx]) == VK_SUCCESS;
+}
+
 void Fence::Swap(Fence& other)
 {
     auto tmpFences = fences;
@@ -110,6 +110,13 @@ public:
      */
     void Wait(const size_t idx = 0);
 
+    /**
+     * Checks whether a fence has been signalled, without waiting for it
+     * @param idx the index of the fence to check
+     * @return true if the fence has been signalled, false otherwise
+     */
+    bool IsSignalled(const size_t idx = 0);
+
     /**
      * Resets the state of the provided fence
      * @param idx the index of the fence to reset
@@ -13,18 +13,17 @@
 #include <utils/Hash.h>
 #include <utils/collections/StackArray.h>
 
-#include "Texture2D.h"
+#include <unordered_map>
 
-struct FT_FaceRec_;
-typedef struct FT_FaceRec_* FontFace;
+#include "Texture2D.h"
 
 namespace Siege::Vulkan
 {
 
 /**
- * The Font class is responsible for loading in fonts from disk. Fonts are loaded into a texture
- * atlas with every character represented as a glyph. The Font class controls how these glyphs are
- * loaded in and stored
+ * The Font class is responsible for loading in fonts from disk. Fonts are baked by the packer into
+ * a signed distance field atlas with every character represented as a glyph, which lets text
+ * render crisply at any size. The Font class controls how these glyphs are loaded in and stored
  */
 class Font
 {
@@ -43,7 +42,8 @@ public:
     /**
      * A glyph is a single character (currently only ASCII characters). Each character takes up a
      * specific region of space in the texture atlas. The glyph struct stores information such as
-     * the glyph's uv coordinates and dimensions
+     * the glyph's uv coordinates and dimensions. Dimensions, bearings and advances are measured in
+     * units of EM_SIZE per em
      */
     struct Glyph
     {
@@ -55,10 +55,14 @@ public:
         float heightNormalised {0};
         float bearingX {0};
         float bearingY {0};
-        signed long advance {0};
-        unsigned long bufferOffset {0};
+        float advance {0};
     };
 
+    // Constexpr declarations
+
+    // The number of units glyph metrics are measured in per em
+    static constexpr float EM_SIZE {64.f};
+
     // 'Structors
 
     /**
@@ -67,7 +71,7 @@ public:
     Font() = default;
 
     /**
-     * A base constructor. This constructor loads in a font from a specific location on disk
+     * A base constructor. This constructor loads in a font baked by the packer from a .font file
      * @param filePath the file path to load the font from
      */
     Font(const char* filePath);
@@ -137,6 +141,19 @@ public:
         return glyphs[c];
     }
 
+    /**
+     * Returns the adjustment to the advance between two characters
+     * @param left the character being advanced from
+     * @param right the character being advanced to
+     * @return the kerning between the two characters, or zero if the font has none for the pair
+     */
+    inline float GetKerning(const unsigned char left, const unsigned char right) const
+    {
+        if (kerning.empty()) return 0.f;
+        auto it = kerning.find((left << 8) | right);
+        return it != kerning.end() ? it->second : 0.f;
+    }
+
     /**
      * Returns the list of glyphs stored by the font
      * @return an SArray which holds all the font's glyphs
@@ -148,34 +165,17 @@ public:
 
 private:
 
-    // Constexpr declarations
-    static constexpr uint32_t MAX_ATLAS_WIDTH {512};
-    static constexpr uint32_t MAX_ATLAS_HEIGHT {8192};
-
     /**
      * Swaps the values of two Fonts
      * @param other the Font to swap values with
      */
     void Swap(Font& other);
 
-    /**
-     * Populates the font with all glyphs stored in the ttf file
-     * @param fontFace the font face used to render the characters
-     * @param padding padding between the characters in the font
-     * @param buffer a buffer of pixels to copy data from the font face into
-     * @return the width and height of the texture
-     */
-    Utils::Extent2DF PopulateGlyphs(FontFace fontFace, Utils::Offset2D padding, uint8_t* buffer);
-
-    /**
-     * Populates the texture atlas with the glyphs collected from PopulateGlyphs
-     * @param buffer the pixel buffer storing our glyph pixels
-     */
-    void PopulateTextureAtlas(uint8_t* buffer);
-
     Utils::Extent2DF extent {};
 
     SArray<Glyph, 256> glyphs;
+    // Kerning between character pairs, keyed by the left character above the right
+    std::unordered_map<uint16_t, float> kerning;
 
     Hash::StringId id {0};
     Texture2D texture;
@@ -11,13 +11,16 @@
 
 #include <utils/Logging.h>
 
+#include <algorithm>
+#include <vector>
+
 #include "render/renderer/platform/vulkan/Context.h"
 #include "render/renderer/platform/vulkan/utils/Image.h"
 #include "render/renderer/platform/vulkan/utils/TypeAdaptor.h"
 
 namespace Siege::Vulkan
 {
-Image::Image(const Config& config) : extent {config.imageExtent}
+Image::Image(const Config& config) : extent {config.imageExtent}, mipLevels {config.mipLevels}
 {
     auto device = Context::GetCurrentDevice()->GetDevice();
 
@@ -30,7 +33,8 @@ Image::Image(const Config& config) : extent {config.imageExtent}
 
 Image::Image(VkImage swapchainImage, const Config& config) :
     image {swapchainImage},
-    extent {config.imageExtent}
+    extent {config.imageExtent},
+    mipLevels {config.mipLevels}
 {
     CreateImageView(config);
 }
@@ -55,7 +59,7 @@ void Image::AllocateMemory()
 
 void Image::BindImageMemory(VkDevice device)
 {
-    CC_ASSERT(vkBindImageMemory(device, OUT image, memory, 0) == VK_SUCCESS,
+    CC_ASSERT(vkBindImageMemory(device, OUT image, memory.memory, memory.offset) == VK_SUCCESS,
               "Failed to bind image memory!")
 }
 
@@ -102,17 +106,19 @@ Image& Image::operator=(Image&& other)
 
 void Image::Free()
 {
-    auto device = Context::GetCurrentDevice()->GetDevice();
+    if (Context::GetVkLogicalDevice() == nullptr) return;
 
-    if (device == nullptr) return;
+    // Swapchain images are owned by the swapchain, so only their views are destroyed here
+    Context::GetDeletionQueue().Push(
+        [view = info.view, vkImage = image, imageMemory = memory, ownsImage = HasInfo()](
+            VkDevice device) mutable {
+            if (device != nullptr) vkDestroyImageView(device, view, nullptr);
 
-    vkDestroyImageView(device, info.view, nullptr);
+            if (!ownsImage) return;
 
-    if (HasInfo())
-    {
-        vkDestroyImage(device, image, nullptr);
-        vkFreeMemory(device, memory, nullptr);
-    }
+            if (device != nullptr) vkDestroyImage(device, vkImage, nullptr);
+            Context::GetMemoryAllocator().Free(imageMemory);
+        });
 
     Invalidate();
 }
@@ -121,12 +127,12 @@ void Image::Invalidate()
 {
     image = nullptr;
     info.view = nullptr;
-    memory = nullptr;
+    memory = {};
 }
 
 bool Image::HasInfo()
 {
-    return memory;
+    return memory.memory;
 }
 
 bool Image::IsValid()
@@ -135,40 +141,81 @@ bool Image::IsValid()
 }
 
 // TODO: we'll likely need to send some sort of config object into this to get better config options
-void Image::CopyBuffer(VkBuffer buffer, Utils::Extent3D bufferExtent, Utils::Offset3D offset)
+void Image::CopyBuffer(VkCommandBuffer commandBuffer,
+                       VkBuffer buffer,
+                       uint64_t bufferOffset,
+                       Utils::Extent3D bufferExtent,
+                       Utils::Offset3D offset)
 {
-    TransitionLayout(Utils::STAGE_TRANSFER_BIT,
+    TransitionLayout(commandBuffer,
+                     Utils::STAGE_TRANSFER_BIT,
                      Utils::LAYOUT_TRANSFER_DST_OPTIMAL,
                      Utils::ACCESS_TRANSFER_WRITE);
 
-    CommandBuffer::ExecuteSingleTimeCommand([&](VkCommandBuffer commandBuffer) {
-        VkBufferImageCopy copyRegion = {};
-        copyRegion.bufferOffset = 0;
+    VkBufferImageCopy copyRegion = {};
+    copyRegion.bufferOffset = bufferOffset;
+    copyRegion.bufferRowLength = 0;
+    copyRegion.bufferImageHeight = 0;
+
+    copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    copyRegion.imageSubresource.mipLevel = 0;
+    copyRegion.imageSubresource.baseArrayLayer = 0;
+    copyRegion.imageSubresource.layerCount = 1;
+    copyRegion.imageOffset = {offset.width, offset.height, offset.depth};
+    copyRegion.imageExtent = {bufferExtent.width, bufferExtent.height, 1};
+
+    vkCmdCopyBufferToImage(commandBuffer,
+                           buffer,
+                           image,
+                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           1,
+                           &copyRegion);
+
+    TransitionLayout(commandBuffer,
+                     Utils::STAGE_FRAGMENT_SHADER,
+                     Utils::LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                     Utils::ACCESS_SHADER_READ);
+}
+
+void Image::CopyBufferLevels(VkCommandBuffer commandBuffer,
+                             VkBuffer buffer,
+                             Utils::Extent3D baseExtent,
+                             const uint64_t* levelOffsets)
+{
+    TransitionLayout(commandBuffer,
+                     Utils::STAGE_TRANSFER_BIT,
+                     Utils::LAYOUT_TRANSFER_DST_OPTIMAL,
+                     Utils::ACCESS_TRANSFER_WRITE);
+
+    std::vector<VkBufferImageCopy> copyRegions(mipLevels);
+    for (uint32_t level = 0; level < mipLevels; level++)
+    {
+        VkBufferImageCopy& copyRegion = copyRegions[level];
+        copyRegion.bufferOffset = levelOffsets[level];
         copyRegion.bufferRowLength = 0;
         copyRegion.bufferImageHeight = 0;
 
         copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        copyRegion.imageSubresource.mipLevel = 0;
+        copyRegion.imageSubresource.mipLevel = level;
         copyRegion.imageSubresource.baseArrayLayer = 0;
         copyRegion.imageSubresource.layerCount = 1;
-        copyRegion.imageOffset = {offset.width, offset.height, offset.depth};
-        copyRegion.imageExtent = {bufferExtent.width, bufferExtent.height, 1};
-
-        vkCmdCopyBufferToImage(commandBuffer,
-                               buffer,
-                               image,
-                               VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                               1,
-                               &copyRegion);
-    });
+        copyRegion.imageOffset = {0, 0, 0};
+        copyRegion.imageExtent = {std::max(baseExtent.width >> level, 1u),
+                                  std::max(baseExtent.height >> level, 1u),
+                                  1};
+    }
+
+    vkCmdCopyBufferToImage(commandBuffer,
+                           buffer,
+                           image,
+                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           copyRegions.size(),
+                           copyRegions.data());
 
-    TransitionLayout(Utils::STAGE_FRAGMENT_SHADER,
+    TransitionLayout(commandBuffer,
+                     Utils::STAGE_FRAGMENT_SHADER,
                      Utils::LAYOUT_SHADER_READ_ONLY_OPTIMAL,
                      Utils::ACCESS_SHADER_READ);
-
-    info.layout = Utils::ImageLayout::LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-    info.access = Utils::MemoryAccess::ACCESS_SHADER_READ;
-    info.stage = Utils::PipelineStage::STAGE_FRAGMENT_SHADER;
 }
 
 void Image::TransitionLayout(Utils::PipelineStage newStage,
@@ -176,56 +223,67 @@ void Image::TransitionLayout(Utils::PipelineStage newStage,
                              Utils::MemoryAccess newAccess)
 {
     CommandBuffer::ExecuteSingleTimeCommand([&](VkCommandBuffer commandBuffer) {
-        auto range = Utils::Image::SubResourceRange()
-                         .WithAspect(VK_IMAGE_ASPECT_COLOR_BIT)
-                         .WithMipLevel(0)
-                         .WithLevelCount(1)
-                         .WithLayerCount(1)
-                         .WithArrayLayer(0)
-                         .Build();
-
-        auto barrier = Utils::Image::Barrier()
-                           .ToAccessMask(newAccess)
-                           .FromAccessMask(info.access)
-                           .FromLayout(Utils::ToVkImageLayout(info.layout))
-                           .ToLayout(Utils::ToVkImageLayout(newLayout))
-                           .WithImage(image)
-                           .WithSubResourceRange(range)
-                           .Build();
-
-        vkCmdPipelineBarrier(commandBuffer,
-                             Utils::ToVkPipelineStageFlagBits(info.stage),
-                             Utils::ToVkPipelineStageFlagBits(newStage),
-                             0,
-                             0,
-                             nullptr,
-                             0,
-                             nullptr,
-                             1,
-                             &barrier);
-
-        info.access = newAccess;
-        info.layout = newLayout;
-        info.stage = newStage;
+        TransitionLayout(commandBuffer, newStage, newLayout, newAccess);
     });
 }
 
+void Image::TransitionLayout(VkCommandBuffer commandBuffer,
+                             Utils::PipelineStage newStage,
+                             Utils::ImageLayout newLayout,
+                             Utils::MemoryAccess newAccess)
+{
+    auto range = Utils::Image::SubResourceRange()
+                     .WithAspect(VK_IMAGE_ASPECT_COLOR_BIT)
+                     .WithMipLevel(0)
+                     .WithLevelCount(mipLevels)
+                     .WithLayerCount(1)
+                     .WithArrayLayer(0)
+                     .Build();
+
+    auto barrier = Utils::Image::Barrier()
+                       .ToAccessMask(newAccess)
+                       .FromAccessMask(info.access)
+                       .FromLayout(Utils::ToVkImageLayout(info.layout))
+                       .ToLayout(Utils::ToVkImageLayout(newLayout))
+                       .WithImage(image)
+                       .WithSubResourceRange(range)
+                       .Build();
+
+    vkCmdPipelineBarrier(commandBuffer,
+                         Utils::ToVkPipelineStageFlagBits(info.stage),
+                         Utils::ToVkPipelineStageFlagBits(newStage),
+                         0,
+                         0,
+                         nullptr,
+                         0,
+                         nullptr,
+                         1,
+                         &barrier);
+
+    info.access = newAccess;
+    info.layout = newLayout;
+    info.stage = newStage;
+}
+
 void Image::Swap(Image& other)
 {
     auto tmpImage = image;
     auto tmpImageInfo = info;
     auto tmpMemory = memory;
     auto tmpExtent = extent;
+    auto tmpMipLevels = mipLevels;
 
     image = other.image;
     info = other.info;
     memory = other.memory;
     extent = other.extent;
+    mipLevels = other.mipLevels;
 
     other.image = tmpImage;
     other.info = tmpImageInfo;
     other.memory = tmpMemory;
     other.extent = tmpExtent;
+    other.mipLevels = tmpMipLevels;
 }
 
 bool Image::IsDepthFormat(Utils::ImageFormat format)
@@ -12,6 +12,7 @@
 
 #include <cstdint>
 
+#include "utils/MemoryAllocator.h"
 #include "utils/Types.h"
 
 namespace Siege::Vulkan
@@ -59,7 +60,7 @@ public:
     {
         return image;
     }
-    const VkDeviceMemory& GetMemory() const
+    const MemoryAllocation& GetMemory() const
     {
         return memory;
     }
@@ -67,6 +68,10 @@ public:
     {
         return info.view;
     }
+    uint32_t GetMipLevels() const
+    {
+        return mipLevels;
+    }
 
     void Free();
     void Invalidate();
@@ -74,10 +79,35 @@ public:
     bool IsValid();
     bool HasInfo();
 
-    void CopyBuffer(VkBuffer buffer,
+    /**
+     * Records a copy of a region of the image from a buffer, along with the layout transitions
+     * around it. Nothing is submitted, so the buffer must stay alive until the command buffer
+     * has executed
+     * @param commandBuffer the command buffer to record into
+     * @param buffer the buffer holding the pixels
+     * @param bufferOffset the offset of the pixels within the buffer
+     * @param bufferExtent the extent of the region to copy
+     * @param offset the offset of the region within the image
+     */
+    void CopyBuffer(VkCommandBuffer commandBuffer,
+                    VkBuffer buffer,
+                    uint64_t bufferOffset,
                     Utils::Extent3D bufferExtent,
                     Utils::Offset3D offset = {0, 0, 0});
 
+    /**
+     * Records a copy of every mip level of the image from a buffer in a single command, with one
+     * copy region per level
+     * @param commandBuffer the command buffer to record into
+     * @param buffer the buffer holding the levels
+     * @param baseExtent the extent of the base level, each level below it is half the size
+     * @param levelOffsets the offset of each level within the buffer, one per mip level
+     */
+    void CopyBufferLevels(VkCommandBuffer commandBuffer,
+                          VkBuffer buffer,
+                          Utils::Extent3D baseExtent,
+                          const uint64_t* levelOffsets);
+
     /**
      * Transitions an image from one layout to another
      * @param newStage the stage in the pipeline to transition to image to
@@ -88,6 +118,18 @@ public:
                           Utils::ImageLayout newLayout,
                           Utils::MemoryAccess newAccess);
 
+    /**
+     * Records a transition of the image from one layout to another into a command buffer
+     * @param commandBuffer the command buffer to record into
+     * @param newStage the stage in the pipeline to transition to image to
+     * @param newLayout the layout you want to transition into
+     * @param newAccess the new access rules we want to transition into
+     */
+    void TransitionLayout(VkCommandBuffer commandBuffer,
+                          Utils::PipelineStage newStage,
+                          Utils::ImageLayout newLayout,
+                          Utils::MemoryAccess newAccess);
+
 private:
 
     static bool IsDepthFormat(Utils::ImageFormat format);
@@ -101,8 +143,9 @@ private:
     void Swap(Image& other);
 
     VkImage image {nullptr};
-    VkDeviceMemory memory {nullptr};
+    MemoryAllocation memory;
     Utils::Extent3D extent {0, 0, 0};
+    uint32_t mipLevels {1};
     Info info;
 };
 } // namespace Siege::Vulkan
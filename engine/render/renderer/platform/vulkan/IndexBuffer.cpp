@@ -13,11 +13,14 @@
 
 #include "Context.h"
 #include "utils/Buffer.h"
+#include "utils/TypeAdaptor.h"
 
 namespace Siege::Vulkan
 {
 
-IndexBuffer::IndexBuffer(unsigned long bufferSize) : size {bufferSize}
+IndexBuffer::IndexBuffer(unsigned long bufferSize, Utils::IndexType type) :
+    size {bufferSize},
+    indexType {type}
 {
     CC_ASSERT(bufferSize > 0,
               "Cannot allocate vertex buffer of size 0. If you wanted to create an "
@@ -33,7 +36,10 @@ IndexBuffer::IndexBuffer(void* data, uint64_t dataSize) : IndexBuffer(dataSize)
     Copy(data, dataSize, 0);
 }
 
-IndexBuffer::IndexBuffer(const IndexBuffer& other) : IndexBuffer(other.rawBuffer, other.size) {}
+IndexBuffer::IndexBuffer(const IndexBuffer& other) : IndexBuffer(other.size, other.indexType)
+{
+    Copy(other.rawBuffer, other.size, 0);
+}
 
 IndexBuffer::IndexBuffer(IndexBuffer&& other)
 {
@@ -48,6 +54,7 @@ IndexBuffer::~IndexBuffer()
 IndexBuffer& IndexBuffer::operator=(const IndexBuffer& other)
 {
     size = other.size;
+    indexType = other.indexType;
 
     auto device = Context::GetVkLogicalDevice();
 
@@ -72,10 +79,9 @@ void IndexBuffer::Free()
 
     free(rawBuffer);
 
-    Utils::FreeBuffer(device, buffer, memory);
+    Utils::FreeBuffer(buffer, memory);
 
     buffer = nullptr;
-    memory = nullptr;
 
     size = 0;
     rawBuffer = nullptr;
@@ -83,16 +89,14 @@ void IndexBuffer::Free()
 
 void IndexBuffer::Copy(const void* data, unsigned long dSize, unsigned long offset)
 {
-    auto device = Context::GetVkLogicalDevice();
-
     void* dst = reinterpret_cast<char*>(rawBuffer) + offset;
     memcpy(dst, data, dSize);
-    Utils::CopyData(device, memory, dSize, dst, offset);
+    Utils::CopyData(memory, dSize, dst, offset);
 }
 
 void IndexBuffer::Bind(const CommandBuffer& commandBuffer, uint64_t offset)
 {
-    vkCmdBindIndexBuffer(commandBuffer.Get(), buffer, offset, VK_INDEX_TYPE_UINT32);
+    vkCmdBindIndexBuffer(commandBuffer.Get(), buffer, offset, Utils::ToVkIndexType(indexType));
 }
 
 void IndexBuffer::Swap(IndexBuffer& other)
@@ -101,26 +105,26 @@ void IndexBuffer::Swap(IndexBuffer& other)
     auto tmpSize = size;
     auto tmpBuffer = buffer;
     auto tmpMemory = memory;
+    auto tmpIndexType = indexType;
 
     rawBuffer = other.rawBuffer;
     size = other.size;
     buffer = other.buffer;
     memory = other.memory;
+    indexType = other.indexType;
 
     other.rawBuffer = tmpRawBuffer;
     other.size = tmpSize;
     other.buffer = tmpBuffer;
     other.memory = tmpMemory;
+    other.indexType = tmpIndexType;
 }
 
 void IndexBuffer::Allocate(VkDevice device)
 {
     rawBuffer = malloc(size);
 
-    auto physicalDevice = Context::GetPhysicalDevice()->GetDevice();
-
     Utils::CreateBuffer(device,
-                        physicalDevice,
                         size,
                         VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
@@ -13,6 +13,7 @@
 #include <cstdint>
 
 #include "CommandBuffer.h"
+#include "utils/MemoryAllocator.h"
 #include "utils/Types.h"
 
 namespace Siege::Vulkan
@@ -40,8 +41,9 @@ public:
     /**
      * A zero copy constructor. Initialises the IndexBuffer with a maximum size but no data
      * @param bufferSize the total size of the buffer in bytes
+     * @param type the integer type of the indices stored in the buffer
      */
-    IndexBuffer(unsigned long bufferSize);
+    IndexBuffer(unsigned long bufferSize, Utils::IndexType type = Utils::INDEX_UINT32);
 
     /**
      * An IndexBuffer copy constructor. Creates a new IndexBuffer with the contents of another
@@ -100,6 +102,17 @@ public:
      */
     void Bind(const CommandBuffer& commandBuffer, uint64_t offset = 0);
 
+    // Getters
+
+    /**
+     * Returns the size in bytes of a single index in the buffer
+     * @return the index size in bytes
+     */
+    inline uint32_t GetIndexSize() const
+    {
+        return indexType == Utils::INDEX_UINT16 ? sizeof(uint16_t) : sizeof(uint32_t);
+    }
+
 private:
 
     /**
@@ -116,8 +129,9 @@ private:
 
     void* rawBuffer {nullptr};
     VkBuffer buffer {nullptr};
-    VkDeviceMemory memory {nullptr};
+    MemoryAllocation memory;
     unsigned long size {0};
+    Utils::IndexType indexType {Utils::INDEX_UINT32};
 };
 
 } // namespace Siege::Vulkan
@@ -82,6 +82,10 @@ LogicalDevice::LogicalDevice(const Surface& surface, PhysicalDevice& physDevice)
 
     auto deviceExtensions = Vulkan::Config::deviceExtensions;
 
+    // Block compressed textures can be sampled wherever the device supports them
+    VkBool32 textureCompressionBC =
+        Vulkan::Device::Physical::GetDeviceFeatures(vkPhysicalDevice).textureCompressionBC;
+
     CREATE_LOGICAL_DEVICE(
         vkPhysicalDevice,
         device,
@@ -89,7 +93,10 @@ LogicalDevice::LogicalDevice(const Surface& surface, PhysicalDevice& physDevice)
         queueCreateInfos,
         static_cast<uint32_t>(deviceExtensions.Size()),
         deviceExtensions.Data(),
-        Vulkan::Device::Physical::DeviceFeaturesBuilder().WithSamplerAnistropy(VK_TRUE).Build(),
+        Vulkan::Device::Physical::DeviceFeaturesBuilder()
+            .WithSamplerAnistropy(VK_TRUE)
+            .WithTextureCompressionBC(textureCompressionBC)
+            .Build(),
         static_cast<uint32_t>(layers.Size()),
         layers.Data())
 
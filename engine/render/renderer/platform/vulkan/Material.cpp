@@ -9,9 +9,10 @@
 
 #include "Material.h"
 
-#include <utils/Branchless.h>
 #include <utils/Logging.h>
 
+#include <algorithm>
+#include <cstring>
 #include <utility>
 
 #include "Pipeline.h"
@@ -39,11 +40,13 @@ Material::Material(Shader vertShader, Shader fragShader, bool isWritingDepth) :
 
     bufferUpdates = MHArray<MHArray<UniformBufferUpdate>>(framesCount);
     imageUpdates = MHArray<MHArray<UniformImageUpdate>>(framesCount);
+    perFrameDynamicBindings = MHArray<MSArray<DynamicBinding, MAX_DYNAMIC_BINDINGS>>(framesCount);
 
     for (size_t i = 0; i < framesCount; i++)
     {
         bufferUpdates.Append(MHArray<UniformBufferUpdate>(10));
         imageUpdates.Append(MHArray<UniformImageUpdate>(MAX_TEXTURES));
+        perFrameDynamicBindings.Append({});
     }
 
     textureInfos = MHArray<ImageData>(MAX_TEXTURES);
@@ -53,12 +56,8 @@ Material::Material(Shader vertShader, Shader fragShader, bool isWritingDepth) :
     AddShader(vertexShader, OUT offset);
     AddShader(fragmentShader, OUT offset);
 
-    // Allocate buffer which can store all the data we need
-    Buffer::CreateBuffer(bufferSize,
-                         Vulkan::Utils::STORAGE_BUFFER | Vulkan::Utils::UNIFORM_BUFFER,
-                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                         OUT buffer.buffer,
-                         OUT buffer.bufferMemory);
+    // The data itself lives in the uniform ring, this only keeps a copy of it between frames
+    uniformData.resize(offset);
 
     // Set the number of frames
     perFrameDescriptorSets = MHArray<MSArray<VkDescriptorSet, MAX_UNIFORM_SETS>>(framesCount);
@@ -75,9 +74,19 @@ Material::Material(Shader vertShader, Shader fragShader, bool isWritingDepth) :
         for (auto propIt = properties.CreateIterator(); propIt; ++propIt)
         {
             auto& prop = *propIt;
-            bindings.Append(
-                CreateLayoutBinding(propIt.GetIndex(), prop.count, prop.type, prop.shaderStage));
+            bindings.Append(CreateLayoutBinding(propIt.GetIndex(),
+                                                prop.count,
+                                                GetDescriptorType(prop.type),
+                                                prop.shaderStage));
             prop.binding = propIt.GetIndex();
+
+            if (!IsUniform(prop.type) && !IsStorage(prop.type)) continue;
+
+            prop.dynamicIndex = perFrameDynamicBindings[0].Count();
+            for (auto bindingIt = perFrameDynamicBindings.CreateFIterator(); bindingIt; ++bindingIt)
+            {
+                bindingIt->Append({0, prop.size, 0, Context::GetUniformRing().GetBuffer()});
+            }
         }
 
         CC_ASSERT(CreateLayout(device, OUT slot.layout, bindings.Data(), properties.Count()),
@@ -113,8 +122,6 @@ Material::~Material()
     auto device = Vulkan::Context::GetVkLogicalDevice();
     if (device == nullptr) return;
 
-    Buffer::DestroyBuffer(buffer);
-
     for (auto it = propertiesSlots.CreateFIterator(); it; ++it)
     {
         vkDestroyDescriptorSetLayout(device, it->layout, nullptr);
@@ -125,8 +132,6 @@ void Material::Free()
 {
     auto device = Vulkan::Context::GetVkLogicalDevice();
 
-    Buffer::DestroyBuffer(buffer);
-
     for (auto it = propertiesSlots.CreateFIterator(); it; ++it)
     {
         vkDestroyDescriptorSetLayout(device, it->layout, nullptr);
@@ -146,16 +151,92 @@ Material& Material::operator=(Material&& other)
 
 void Material::SetUniformData(Hash::StringId id, uint64_t dataSize, const void* data)
 {
+    auto& uniformRing = Context::GetUniformRing();
+
     for (auto it = propertiesSlots.CreateIterator(); it; ++it)
     {
-        auto slot = *it;
+        auto& slot = *it;
 
         auto propertyIndex = FindPropertyIndex(id, slot);
 
-        if (propertyIndex == -1) return;
+        if (propertyIndex == -1) continue;
+
+        auto& prop = slot.properties[propertyIndex];
+
+        CC_ASSERT(IsUniform(prop.type) || IsStorage(prop.type),
+                  "Only uniform and storage properties can be given data")
+
+        uint8_t* propData = uniformData.data() + prop.offset;
+        memcpy(propData, data, std::min(dataSize, prop.size));
+
+        // Data which fits the size the shader reserved is uploaded from the kept copy so that the
+        // region is always the size of the property, even if only part of it was set
+        auto allocation = dataSize > prop.size ? uniformRing.Upload(data, dataSize) :
+                                                 uniformRing.Upload(propData, prop.size);
+        SetDynamicBinding(it.GetIndex(), prop, allocation);
+    }
+}
+
+void Material::SetUniformAllocation(Hash::StringId id, const UniformRing::Allocation& allocation)
+{
+    for (auto it = propertiesSlots.CreateIterator(); it; ++it)
+    {
+        auto& slot = *it;
+
+        auto propertyIndex = FindPropertyIndex(id, slot);
+
+        if (propertyIndex == -1) continue;
+
+        auto& prop = slot.properties[propertyIndex];
+
+        CC_ASSERT(IsUniform(prop.type) || IsStorage(prop.type),
+                  "Only uniform and storage properties can read from the uniform ring")
+
+        SetDynamicBinding(it.GetIndex(), prop, allocation);
+    }
+}
+
+void Material::SetDynamicBinding(uint32_t set,
+                                 const Property& prop,
+                                 const UniformRing::Allocation& allocation)
+{
+    auto frameIndex = Renderer::GetCurrentFrameIndex();
+    auto& uniformRing = Context::GetUniformRing();
+    auto& dynamicBinding = perFrameDynamicBindings[frameIndex][prop.dynamicIndex];
+
+    // The buffer and range are part of the descriptor rather than the dynamic offset, so a new
+    // size, or a ring which has grown into a new buffer, means rewriting this frame's descriptor.
+    // That isn't allowed once its set has been bound
+    if (allocation.size != dynamicBinding.range || allocation.buffer != dynamicBinding.buffer)
+    {
+        bool isBound = lastBoundFrame == uniformRing.GetFrameNumber();
 
-        Buffer::CopyData(buffer, dataSize, data, slot.properties[propertyIndex].offset);
+        CC_ASSERT(!isBound || allocation.size == dynamicBinding.range,
+                  "Can't resize a uniform once its Material has been bound in the frame")
+
+        // The ring grew after the Material was bound, so its draws keep the data they were bound
+        // with until the next frame
+        if (isBound)
+        {
+            CC_LOG_WARNING("[MATERIAL] Uniform ring grew after the Material was bound, ignoring "
+                           "new data until the next frame")
+            return;
+        }
+
+        QueuePropertyUpdate(bufferUpdates[frameIndex],
+                            perFrameDescriptorSets[frameIndex][set],
+                            GetDescriptorType(prop.type),
+                            prop.binding,
+                            1,
+                            {allocation.buffer, 0, allocation.size});
+        UpdateUniforms(bufferUpdates[frameIndex], imageUpdates[frameIndex]);
+
+        dynamicBinding.range = allocation.size;
+        dynamicBinding.buffer = allocation.buffer;
     }
+
+    dynamicBinding.offset = static_cast<uint32_t>(allocation.offset);
+    dynamicBinding.frame = uniformRing.GetFrameNumber();
 }
 
 uint32_t Material::SetTexture(Hash::StringId id, const Texture2D& texture)
@@ -202,7 +283,6 @@ void Material::AddShader(const Shader& shader, uint64_t& offset)
 {
     using Utils::ShaderType;
     using Utils::UniformType;
-    using namespace Buffer;
 
     auto uniforms = shader.GetUniforms();
 
@@ -231,10 +311,6 @@ void Material::AddShader(const Shader& shader, uint64_t& offset)
             shader.GetShaderType(),
         });
 
-        bufferSize +=
-            IF(IsStorage(uniform.type) THEN PadStorageBufferSize(uniform.totalSize) ELSE IF(
-                IsUniform(uniform.type) THEN PadUniformBufferSize(uniform.totalSize) ELSE 0));
-
         offset += uniform.totalSize;
 
         if (IsTexture2D(uniform.type))
@@ -256,8 +332,49 @@ void Material::AddShader(const Shader& shader, uint64_t& offset)
 void Material::Bind(const CommandBuffer& commandBuffer)
 {
     auto frameIndex = Renderer::GetCurrentFrameIndex();
+    auto& uniformRing = Context::GetUniformRing();
+    auto& dynamicBindings = perFrameDynamicBindings[frameIndex];
+
+    MSArray<uint32_t, MAX_DYNAMIC_BINDINGS> dynamicOffsets;
+
+    std::unique_lock<std::mutex> lock(bindMutex);
+
+    for (auto slotIt = propertiesSlots.CreateIterator(); slotIt; ++slotIt)
+    {
+        for (auto propIt = slotIt->properties.CreateIterator(); propIt; ++propIt)
+        {
+            auto& prop = *propIt;
+
+            if (!IsUniform(prop.type) && !IsStorage(prop.type)) continue;
+
+            // Regions from earlier frames may have been reused since, so data which wasn't set this
+            // frame is copied in again, padded to the range its descriptor was written with
+            auto& dynamicBinding = dynamicBindings[prop.dynamicIndex];
+            if (dynamicBinding.frame != uniformRing.GetFrameNumber())
+            {
+                auto allocation = uniformRing.Allocate(dynamicBinding.range);
+                memcpy(allocation.data,
+                       uniformData.data() + prop.offset,
+                       std::min(prop.size, dynamicBinding.range));
+
+                // The set hasn't been bound this frame yet, so its descriptor can still be pointed
+                // at a new buffer if the ring has grown
+                SetDynamicBinding(slotIt.GetIndex(), prop, allocation);
+            }
+
+            dynamicOffsets.Append(dynamicBinding.offset);
+        }
+    }
+
+    lastBoundFrame = uniformRing.GetFrameNumber();
+
+    lock.unlock();
+
     graphicsPipeline.Bind(commandBuffer);
-    graphicsPipeline.BindSets(commandBuffer, perFrameDescriptorSets[frameIndex]);
+    graphicsPipeline.BindSets(commandBuffer,
+                              perFrameDescriptorSets[frameIndex],
+                              dynamicOffsets.Data(),
+                              dynamicOffsets.Count());
 }
 
 void Material::BindPushConstant(const CommandBuffer& commandBuffer, const void* values)
@@ -338,10 +455,10 @@ void Material::WriteSet(uint32_t set, PropertiesSlot& slot)
             else
                 QueuePropertyUpdate(bufferUpdates[setIt.GetIndex()],
                                     sets[set],
-                                    prop.type,
+                                    GetDescriptorType(prop.type),
                                     propIt.GetIndex(),
                                     1,
-                                    {buffer.buffer, prop.offset, prop.size});
+                                    {Context::GetUniformRing().GetBuffer(), 0, prop.size});
         }
     }
 }
@@ -447,11 +564,12 @@ void Material::Swap(Material& other)
 {
     auto tmpVertexShader = std::move(vertexShader);
     auto tmpFragmentShader = std::move(fragmentShader);
-    auto tmpBufferSize = bufferSize;
-    auto tmpBuffer = buffer;
+    auto tmpUniformData = std::move(uniformData);
     auto tmpGraphicsPipeline = std::move(graphicsPipeline);
     auto tmpPropertiesSlots = propertiesSlots;
     auto tmpPerFrameDescriptors = std::move(perFrameDescriptorSets);
+    auto tmpPerFrameDynamicBindings = std::move(perFrameDynamicBindings);
+    auto tmpLastBoundFrame = lastBoundFrame;
     auto tmpPushConstant = pushConstant;
     auto tmpIsWritingDepth = isWritingDepth;
 
@@ -461,11 +579,12 @@ void Material::Swap(Material& other)
 
     vertexShader = std::move(other.vertexShader);
     fragmentShader = std::move(other.fragmentShader);
-    bufferSize = other.bufferSize;
-    buffer = other.buffer;
+    uniformData = std::move(other.uniformData);
     graphicsPipeline = std::move(other.graphicsPipeline);
     propertiesSlots = other.propertiesSlots;
     perFrameDescriptorSets = std::move(other.perFrameDescriptorSets);
+    perFrameDynamicBindings = std::move(other.perFrameDynamicBindings);
+    lastBoundFrame = other.lastBoundFrame;
     pushConstant = other.pushConstant;
     isWritingDepth = other.isWritingDepth;
     textureInfos = std::move(other.textureInfos);
@@ -474,11 +593,12 @@ void Material::Swap(Material& other)
 
     other.vertexShader = std::move(tmpVertexShader);
     other.fragmentShader = std::move(tmpFragmentShader);
-    other.bufferSize = tmpBufferSize;
-    other.buffer = tmpBuffer;
+    other.uniformData = std::move(tmpUniformData);
     other.graphicsPipeline = std::move(tmpGraphicsPipeline);
     other.propertiesSlots = tmpPropertiesSlots;
     other.perFrameDescriptorSets = std::move(tmpPerFrameDescriptors);
+    other.perFrameDynamicBindings = std::move(tmpPerFrameDynamicBindings);
+    other.lastBoundFrame = tmpLastBoundFrame;
     other.pushConstant = tmpPushConstant;
     other.isWritingDepth = tmpIsWritingDepth;
 
@@ -10,10 +10,14 @@
 #ifndef SIEGE_ENGINE_VULKAN_MATERIAL_H
 #define SIEGE_ENGINE_VULKAN_MATERIAL_H
 
+#include <mutex>
+#include <vector>
+
 #include "CommandBuffer.h"
 #include "Pipeline.h"
 #include "Shader.h"
 #include "Texture2D.h"
+#include "UniformRing.h"
 
 namespace Siege::Vulkan
 {
@@ -26,11 +30,14 @@ namespace Siege::Vulkan
  * @param graphicsPipeline the Vulkan pipeline stored in the material
  * @param vertexShader the vertex shader used by the material
  * @param fragmentShader the fragment shader used by the material
- * @param bufferSize the total size of the memory allocated for this material on the GPU
- * @param buffer the buffer holding all uniform data
+ * @param uniformData the last data set for each uniform, kept so that it can be copied into the
+ * uniform ring in frames where it isn't set again
  * @param propertiesSlots an array storing all uniforms the material knows about
  * @param perFrameDescriptorSets an array holding all descriptor sets the Material uses. Holds one
  * per frames in flight
+ * @param perFrameDynamicBindings the ring offset and range of each uniform and storage property,
+ * per frame in flight
+ * @param lastBoundFrame the uniform ring frame the Material was last bound in
  * @param bufferInfos an array holding buffer access information
  * @param writes an array holding uniform update structs. These are cached to avoid potentially
  * remaking every them every frame
@@ -45,6 +52,7 @@ public:
 
     static constexpr uint32_t MAX_UNIFORM_SETS = 2;
     static constexpr uint32_t MAX_TEXTURES = 16;
+    static constexpr uint32_t MAX_DYNAMIC_BINDINGS = MAX_UNIFORM_SETS * 10;
     /**
      * An empty default constructor for the Material class
      */
@@ -80,13 +88,25 @@ public:
     Material& operator=(Material&& other);
 
     /**
-     * Sets the uniform to the provided data. Uses a string ID to avoid string comparison
+     * Sets the uniform to the provided data. Uses a string ID to avoid string comparison. The data
+     * is copied into the current frame's region of the uniform ring, so it can be set again
+     * between draws without affecting the ones already recorded
      * @param id the ID of the uniform
      * @param dataSize the size of the memory being allocated to the uniform
      * @param data the data to be inputted into the uniform
      */
     void SetUniformData(Hash::StringId id, uint64_t dataSize, const void* data);
 
+    /**
+     * Points a uniform at data already written to the current frame's region of the uniform ring,
+     * letting several Materials share one upload. Storage data larger than the size reserved by
+     * the shader is supported, but changing a uniform's size rewrites its descriptor, so must be
+     * done before the Material is bound in the frame
+     * @param id the ID of the uniform
+     * @param allocation the region of the uniform ring holding the data
+     */
+    void SetUniformAllocation(Hash::StringId id, const UniformRing::Allocation& allocation);
+
     /**
      * TODO(Aryeh): Document this
      * @param id
@@ -96,7 +116,8 @@ public:
     uint32_t SetTexture(Hash::StringId id, const Texture2D& texture);
 
     /**
-     * Binds the Material for rendering (also binds the stored Pipeline)
+     * Binds the Material for rendering (also binds the stored Pipeline). Uniforms which weren't
+     * set this frame have their last data copied into the uniform ring first
      * @param commandBuffer the command buffer being used to record rendering information
      */
     void Bind(const CommandBuffer& commandBuffer);
@@ -127,7 +148,7 @@ private:
      *
      * @param id the unique identifier for the property
      * @param binding the binding within the descriptor set
-     * @param offset the memory offset of the property within the material buffer
+     * @param offset the memory offset of the property within the Material's uniform data
      * @param size the total size of the property
      * @param type the type of Property (Uniform, Storage...etc)
      * @param shaderStage the shader stages where the uniform is used
@@ -141,6 +162,23 @@ private:
         uint64_t size {0};
         Utils::UniformType type {Utils::UNKNOWN};
         Utils::ShaderType shaderStage {Utils::EMPTY};
+        uint32_t dynamicIndex {0};
+    };
+
+    /**
+     * The uniform ring region a uniform or storage property reads from in a frame
+     *
+     * @param offset the dynamic offset of the region within the uniform ring
+     * @param range the size of the region, as written into the property's descriptor
+     * @param frame the uniform ring frame the offset was set in
+     * @param buffer the uniform ring buffer the property's descriptor was written with
+     */
+    struct DynamicBinding
+    {
+        uint32_t offset {0};
+        uint64_t range {0};
+        uint64_t frame {0};
+        VkBuffer buffer {nullptr};
     };
 
     /**
@@ -217,6 +255,17 @@ private:
      */
     int32_t FindTextureIndex(Hash::StringId id);
 
+    /**
+     * Points a property at a region of the uniform ring for the current frame, rewriting its
+     * descriptor if the region's size or buffer differs from the one it was last given
+     * @param set the index of the descriptor set holding the property
+     * @param prop the uniform or storage property
+     * @param allocation the region of the uniform ring holding the property's data
+     */
+    void SetDynamicBinding(uint32_t set,
+                           const Property& prop,
+                           const UniformRing::Allocation& allocation);
+
     /**
      * Swaps the contents of two Materials
      * @param other the Material to swap values with
@@ -296,13 +345,25 @@ private:
         return type == Utils::STORAGE;
     }
 
+    /**
+     * Gets the descriptor type a property is bound with. Uniform and storage properties read
+     * from the uniform ring, so are bound as dynamic descriptors
+     * @param type the property's type
+     * @return the dynamic equivalent of uniform and storage types, otherwise the type itself
+     */
+    inline Utils::UniformType GetDescriptorType(Utils::UniformType type)
+    {
+        if (IsUniform(type)) return Utils::UNIFORM_DYNAMIC;
+        if (IsStorage(type)) return Utils::STORAGE_DYNAMIC;
+        return type;
+    }
+
     Pipeline graphicsPipeline;
 
     Shader vertexShader;
     Shader fragmentShader;
 
-    uint64_t bufferSize {0};
-    Buffer::Buffer buffer;
+    std::vector<uint8_t> uniformData;
 
     PushConstant pushConstant;
 
@@ -310,6 +371,12 @@ private:
 
     // Descriptor set data
     MHArray<MSArray<VkDescriptorSet, MAX_UNIFORM_SETS>> perFrameDescriptorSets;
+    MHArray<MSArray<DynamicBinding, MAX_DYNAMIC_BINDINGS>> perFrameDynamicBindings;
+    uint64_t lastBoundFrame {0};
+
+    // Held while Bind refreshes the dynamic bindings, as draws using the same material may be
+    // recorded from several threads at once
+    std::mutex bindMutex;
 
     MHArray<MHArray<UniformBufferUpdate>> bufferUpdates;
     MHArray<MHArray<UniformImageUpdate>> imageUpdates;
@@ -11,11 +11,75 @@
 
 #include <utils/Logging.h>
 
+#include <utility>
+
 #include "utils/Pipeline.h"
 #include "utils/TypeAdaptor.h"
 
 namespace Siege::Vulkan
 {
+static void WriteShaderState(PipelineState& state, const Shader& shader)
+{
+    state.Write(shader.GetFilePath());
+    state.Write(shader.GetShaderType());
+    state.Write(shader.GetVertexTopology());
+    state.Write(shader.GetPushConstant().size);
+
+    // Each list is preceded by its length, so that lists of different lengths can never match
+    state.Write(static_cast<uint64_t>(shader.GetUniforms().Count()));
+    for (auto it = shader.GetUniforms().CreateIterator(); it; ++it)
+    {
+        auto& uniform = *it;
+        state.Write(uniform.id);
+        state.Write(uniform.totalSize);
+        state.Write(uniform.set);
+        state.Write(uniform.slot);
+        state.Write(uniform.count);
+        state.Write(uniform.type);
+    }
+
+    state.Write(static_cast<uint64_t>(shader.GetVertexBindings().Count()));
+    for (auto bindingIt = shader.GetVertexBindings().CreateIterator(); bindingIt; ++bindingIt)
+    {
+        auto& binding = *bindingIt;
+        state.Write(binding.stride);
+        state.Write(binding.inputRate);
+
+        state.Write(static_cast<uint64_t>(binding.attributes.Count()));
+        for (auto attrIt = binding.attributes.CreateIterator(); attrIt; ++attrIt)
+        {
+            state.Write(attrIt->offset);
+            state.Write(attrIt->type);
+        }
+    }
+}
+
+// Descriptor set layouts are described by the shader uniforms they were created from rather than
+// by their handles, since every material creates its own layouts and pipeline layouts made from
+// identically defined set layouts are compatible with each other
+static PipelineState GetPipelineState(const Pipeline::Builder& builder)
+{
+    PipelineState state;
+
+    WriteShaderState(state, *builder.vertexShader);
+    WriteShaderState(state, *builder.fragmentShader);
+
+    state.Write(static_cast<uint64_t>(builder.dynamicStates.Count()));
+    for (auto it = builder.dynamicStates.CreateIterator(); it; ++it) state.Write(*it);
+
+    state.Write(static_cast<uint64_t>(builder.descriptorLayouts.Count()));
+    state.Write(builder.pushConstant.size);
+    state.Write(builder.pushConstant.type);
+    state.Write(builder.fillMode);
+    state.Write(builder.viewportCount);
+    state.Write(builder.scissorCount);
+    state.Write(builder.usingDepthTest);
+    state.Write(builder.usingDepthWrite);
+    state.Write(builder.renderPass->GetRawRenderPass());
+
+    return state;
+}
+
 Pipeline::Builder& Pipeline::Builder::WithRenderPass(RenderPass* targetRenderPass)
 {
     renderPass = targetRenderPass;
@@ -70,6 +134,15 @@ Pipeline::Builder& Pipeline::Builder::WithPushConstant(uint32_t size, Utils::Sha
 Pipeline Pipeline::Builder::Build()
 {
     Pipeline newPipeline;
+    newPipeline.state = GetPipelineState(*this);
+
+    PipelineLibrary& library = Context::GetPipelineLibrary();
+    if (library.AcquirePipeline(newPipeline.state,
+                                OUT newPipeline.layout,
+                                OUT newPipeline.pipeline))
+    {
+        return newPipeline;
+    }
 
     auto device = Context::GetVkLogicalDevice();
 
@@ -161,13 +234,15 @@ Pipeline Pipeline::Builder::Build()
     pipelineCreateInfo.basePipelineIndex = -1;
 
     CC_ASSERT(vkCreateGraphicsPipelines(Vulkan::Context::GetVkLogicalDevice(),
-                                        VK_NULL_HANDLE,
+                                        Vulkan::Context::GetPipelineCache().Get(),
                                         1,
                                         &pipelineCreateInfo,
                                         nullptr,
                                         OUT & newPipeline.pipeline) == VK_SUCCESS,
               "Failed to create graphics pipeline!")
 
+    library.AddPipeline(newPipeline.state, newPipeline.layout, newPipeline.pipeline);
+
     return newPipeline;
 }
 
@@ -182,10 +257,13 @@ void Pipeline::Destroy()
 
     // This check is only necessary because we're using globals.
     // TODO: Remove all globals so that we can avoid this kind of thing in future
-    if (device == nullptr) return;
+    if (device == nullptr || pipeline == nullptr) return;
 
-    vkDestroyPipelineLayout(device, layout, nullptr);
-    vkDestroyPipeline(device, pipeline, nullptr);
+    Context::GetPipelineLibrary().ReleasePipeline(state);
+
+    layout = nullptr;
+    pipeline = nullptr;
+    state = {};
 }
 
 void Pipeline::Bind(const CommandBuffer& commandBuffer)
@@ -193,7 +271,10 @@ void Pipeline::Bind(const CommandBuffer& commandBuffer)
     vkCmdBindPipeline(commandBuffer.Get(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
 }
 
-void Pipeline::BindSets(const CommandBuffer& commandBuffer, MSArray<VkDescriptorSet, 2> sets)
+void Pipeline::BindSets(const CommandBuffer& commandBuffer,
+                        MSArray<VkDescriptorSet, 2> sets,
+                        const uint32_t* dynamicOffsets,
+                        uint32_t dynamicOffsetCount)
 {
     if (sets.Count() == 0) return;
     vkCmdBindDescriptorSets(commandBuffer.Get(),
@@ -202,8 +283,8 @@ void Pipeline::BindSets(const CommandBuffer& commandBuffer, MSArray<VkDescriptor
                             0,
                             sets.Count(),
                             sets.Data(),
-                            0,
-                            nullptr);
+                            dynamicOffsetCount,
+                            dynamicOffsets);
 }
 
 void Pipeline::PushConstants(const CommandBuffer& commandBuffer,
@@ -229,5 +310,7 @@ void Pipeline::Swap(Pipeline& other)
 
     other.pipeline = tmpPipeline;
     other.layout = tmpPipelineLayout;
+
+    std::swap(state, other.state);
 }
 } // namespace Siege::Vulkan
@@ -13,6 +13,7 @@
 #include <utils/collections/StackArray.h>
 
 #include "CommandBuffer.h"
+#include "PipelineLibrary.h"
 #include "RenderPass.h"
 #include "Shader.h"
 #include "utils/Types.h"
@@ -26,6 +27,8 @@ namespace Siege::Vulkan
  *
  *  @param layout the pipeline layout
  *  @param pipeline the raw vulkan pipeline object
+ *  @param state the state the pipeline was built from, used to share it through the context's
+ *  PipelineLibrary
  */
 class Pipeline
 {
@@ -129,7 +132,8 @@ public:
         Builder& WithPushConstant(uint32_t size, Utils::ShaderType type);
 
         /**
-         * Builds a new graphics Pipeline and returns the newly created instance
+         * Builds a new graphics Pipeline and returns the newly created instance. If a pipeline
+         * was already built from the same shaders and state, it is shared rather than rebuilt
          * @return a new Pipeline instance
          */
         Pipeline Build();
@@ -170,7 +174,8 @@ public:
     ~Pipeline();
 
     /**
-     * Manual destruction function
+     * Manual destruction function. Releases the Pipeline's reference to its shared pipeline,
+     * which is destroyed once nothing else refers to it
      */
     void Destroy();
 
@@ -190,7 +195,19 @@ public:
      * @param commandBuffer the commandBuffer being recorded. Must be active for rendering
      */
     void Bind(const CommandBuffer& commandBuffer);
-    void BindSets(const CommandBuffer& commandBuffer, MSArray<VkDescriptorSet, 2> sets);
+
+    /**
+     * Binds descriptor sets to the Pipeline's layout
+     * @param commandBuffer the commandBuffer being recorded. Must be active for rendering
+     * @param sets the descriptor sets to bind, starting from set zero
+     * @param dynamicOffsets the offsets of the sets' dynamic descriptors, in set then binding order
+     * @param dynamicOffsetCount the number of dynamic offsets
+     */
+    void BindSets(const CommandBuffer& commandBuffer,
+                  MSArray<VkDescriptorSet, 2> sets,
+                  const uint32_t* dynamicOffsets = nullptr,
+                  uint32_t dynamicOffsetCount = 0);
+
     void PushConstants(const CommandBuffer& commandBuffer,
                        Utils::ShaderType,
                        uint32_t size,
@@ -205,6 +222,7 @@ private:
     void Swap(Pipeline& other);
     VkPipelineLayout layout {nullptr};
     VkPipeline pipeline {nullptr};
+    PipelineState state;
 };
 } // namespace Siege::Vulkan
 
@@ -0,0 +1,201 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#include "PipelineCache.h"
+
+#include <utils/Hash.h>
+#include <utils/Logging.h>
+#include <volk/volk.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <utility>
+#include <vector>
+
+#include "Context.h"
+#include "utils/Device.h"
+
+namespace Siege::Vulkan
+{
+static constexpr const char PIPELINE_CACHE_MAGIC[4] {'S', 'P', 'C', 'H'};
+static constexpr uint32_t PIPELINE_CACHE_VERSION = 1;
+
+/**
+ * The header written ahead of the cache data. Drivers only accept data produced by the same
+ * device and driver, so the identity of both is recorded and checked before the data is used
+ */
+struct PipelineCacheHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t vendorId;
+    uint32_t deviceId;
+    uint32_t driverVersion;
+    uint8_t pipelineCacheUuid[VK_UUID_SIZE];
+    uint64_t dataSize;
+    uint64_t dataHash;
+};
+
+static PipelineCacheHeader MakeHeader()
+{
+    auto physicalDevice = Context::GetPhysicalDevice()->GetDevice();
+    auto properties = Device::Physical::GetDeviceProperties(physicalDevice);
+
+    PipelineCacheHeader header {};
+    memcpy(header.magic, PIPELINE_CACHE_MAGIC, sizeof(header.magic));
+    header.version = PIPELINE_CACHE_VERSION;
+    header.vendorId = properties.vendorID;
+    header.deviceId = properties.deviceID;
+    header.driverVersion = properties.driverVersion;
+    memcpy(header.pipelineCacheUuid, properties.pipelineCacheUUID, VK_UUID_SIZE);
+    return header;
+}
+
+static bool ReadCacheData(const String& filePath, std::vector<uint8_t>& data)
+{
+    std::ifstream inputFileStream(filePath.Str(), std::ios::in | std::ios::binary);
+    if (!inputFileStream) return false;
+
+    PipelineCacheHeader header {};
+    inputFileStream.read(reinterpret_cast<char*>(&header), sizeof(PipelineCacheHeader));
+
+    PipelineCacheHeader expected = MakeHeader();
+    if (!inputFileStream || memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 ||
+        header.version != expected.version || header.vendorId != expected.vendorId ||
+        header.deviceId != expected.deviceId || header.driverVersion != expected.driverVersion ||
+        memcmp(header.pipelineCacheUuid, expected.pipelineCacheUuid, VK_UUID_SIZE) != 0)
+    {
+        CC_LOG_INFO("[PIPELINE CACHE] Ignoring \"{}\", it was saved by another device or driver",
+                    filePath)
+        return false;
+    }
+
+    // The size comes straight from the file, so check it against what's actually there before
+    // allocating for it
+    std::error_code error;
+    uint64_t fileSize = std::filesystem::file_size(filePath.Str(), error);
+    if (error || fileSize < sizeof(PipelineCacheHeader) ||
+        header.dataSize != fileSize - sizeof(PipelineCacheHeader))
+    {
+        CC_LOG_WARNING("[PIPELINE CACHE] Ignoring \"{}\", its size does not match its header",
+                       filePath)
+        return false;
+    }
+
+    data.resize(header.dataSize);
+    inputFileStream.read(reinterpret_cast<char*>(data.data()),
+                         static_cast<std::streamsize>(header.dataSize));
+
+    if (!inputFileStream || Hash::Fnv1a64(data.data(), data.size()) != header.dataHash)
+    {
+        CC_LOG_WARNING("[PIPELINE CACHE] Ignoring \"{}\", its data is corrupt", filePath)
+        data.clear();
+        return false;
+    }
+
+    return true;
+}
+
+PipelineCache::PipelineCache(const String& filePath) : filePath {filePath}
+{
+    std::vector<uint8_t> data;
+    bool isWarm = ReadCacheData(filePath, data);
+
+    VkPipelineCacheCreateInfo createInfo {};
+    createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    createInfo.initialDataSize = data.size();
+    createInfo.pInitialData = data.data();
+
+    CC_ASSERT(vkCreatePipelineCache(Context::GetVkLogicalDevice(),
+                                    &createInfo,
+                                    nullptr,
+                                    OUT & cache) == VK_SUCCESS,
+              "Failed to create pipeline cache!")
+
+    if (isWarm)
+    {
+        CC_LOG_INFO("[PIPELINE CACHE] Loaded {} bytes from \"{}\"", data.size(), filePath)
+    }
+}
+
+PipelineCache::PipelineCache(PipelineCache&& other) noexcept
+{
+    Swap(other);
+}
+
+PipelineCache::~PipelineCache()
+{
+    Destroy();
+}
+
+PipelineCache& PipelineCache::operator=(PipelineCache&& other) noexcept
+{
+    Swap(other);
+    return *this;
+}
+
+bool PipelineCache::Save() const
+{
+    if (cache == nullptr) return false;
+
+    VkDevice device = Context::GetVkLogicalDevice();
+
+    size_t dataSize = 0;
+    vkGetPipelineCacheData(device, cache, OUT & dataSize, nullptr);
+
+    std::vector<uint8_t> data(dataSize);
+    if (vkGetPipelineCacheData(device, cache, OUT & dataSize, data.data()) != VK_SUCCESS)
+    {
+        CC_LOG_WARNING("[PIPELINE CACHE] Failed to read back the pipeline cache")
+        return false;
+    }
+
+    PipelineCacheHeader header = MakeHeader();
+    header.dataSize = dataSize;
+    header.dataHash = Hash::Fnv1a64(data.data(), dataSize);
+
+    // Write to a temporary file first so that an interrupted save never leaves a partial cache
+    // under its final name
+    std::filesystem::path cachePath(filePath.Str());
+    std::filesystem::path tempPath = cachePath;
+    tempPath += ".tmp";
+    {
+        std::ofstream outputFileStream(tempPath, std::ios::out | std::ios::binary);
+        outputFileStream.write(reinterpret_cast<const char*>(&header), sizeof(PipelineCacheHeader));
+        outputFileStream.write(reinterpret_cast<const char*>(data.data()),
+                               static_cast<std::streamsize>(dataSize));
+        if (!outputFileStream)
+        {
+            CC_LOG_WARNING("[PIPELINE CACHE] Failed to write \"{}\"", tempPath.string().c_str())
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, cachePath, error);
+    return !error;
+}
+
+void PipelineCache::Destroy()
+{
+    if (cache == nullptr) return;
+
+    VkDevice device = Context::GetVkLogicalDevice();
+    if (device != nullptr) vkDestroyPipelineCache(device, cache, nullptr);
+
+    cache = nullptr;
+}
+
+void PipelineCache::Swap(PipelineCache& other)
+{
+    std::swap(cache, other.cache);
+    std::swap(filePath, other.filePath);
+}
+} // namespace Siege::Vulkan
@@ -0,0 +1,95 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#ifndef SIEGE_ENGINE_VULKAN_PIPELINE_CACHE_H
+#define SIEGE_ENGINE_VULKAN_PIPELINE_CACHE_H
+
+#include <utils/String.h>
+
+#include "utils/Types.h"
+
+namespace Siege::Vulkan
+{
+/**
+ * A wrapper around a VkPipelineCache which persists between runs. The cache is seeded from disk
+ * when created and written back when saved, so pipelines compiled in earlier runs don't need to
+ * be compiled again. Saved data is only loaded back on the same device and driver, since
+ * anything else would be rejected or, on some drivers, misread
+ *
+ * @param cache the raw Vulkan pipeline cache
+ * @param filePath the path the cache is loaded from and saved to
+ */
+class PipelineCache
+{
+public:
+
+    // The file the cache is kept in, relative to the working directory
+    static constexpr const char* DEFAULT_PATH = "pipeline.cache";
+
+    /**
+     * An empty default constructor for the PipelineCache
+     */
+    PipelineCache() = default;
+
+    /**
+     * Creates the pipeline cache, seeded with the data saved at a path if it was saved by the
+     * current device and driver
+     * @param filePath the path to load the cache from and save it to
+     */
+    explicit PipelineCache(const String& filePath);
+
+    /**
+     * A move constructor for the PipelineCache
+     * @param other the PipelineCache to be moved
+     */
+    PipelineCache(PipelineCache&& other) noexcept;
+
+    /**
+     * A destructor for the PipelineCache
+     */
+    ~PipelineCache();
+
+    /**
+     * A move assignment operator for the PipelineCache
+     * @param other the PipelineCache to be moved
+     * @return a reference to the current PipelineCache
+     */
+    PipelineCache& operator=(PipelineCache&& other) noexcept;
+
+    /**
+     * Writes the cache's contents to disk, along with the identity of the device and driver
+     * which produced them
+     * @return true if the cache was saved, false otherwise
+     */
+    bool Save() const;
+
+    /**
+     * Destroys the pipeline cache without saving it
+     */
+    void Destroy();
+
+    VkPipelineCache Get() const
+    {
+        return cache;
+    }
+
+private:
+
+    /**
+     * Swaps the contents of two PipelineCaches
+     * @param other the PipelineCache to swap with
+     */
+    void Swap(PipelineCache& other);
+
+    VkPipelineCache cache {nullptr};
+    String filePath;
+};
+} // namespace Siege::Vulkan
+
+#endif // SIEGE_ENGINE_VULKAN_PIPELINE_CACHE_H
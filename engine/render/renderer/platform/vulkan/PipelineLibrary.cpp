@@ -0,0 +1,137 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#include "PipelineLibrary.h"
+
+#include <utils/Logging.h>
+#include <volk/volk.h>
+
+#include <utility>
+
+#include "Context.h"
+#include "Shader.h"
+#include "utils/ShaderModule.h"
+
+namespace Siege::Vulkan
+{
+PipelineLibrary::PipelineLibrary(PipelineLibrary&& other) noexcept
+{
+    Swap(other);
+}
+
+PipelineLibrary::~PipelineLibrary()
+{
+    Destroy();
+}
+
+PipelineLibrary& PipelineLibrary::operator=(PipelineLibrary&& other) noexcept
+{
+    Swap(other);
+    return *this;
+}
+
+VkShaderModule PipelineLibrary::AcquireShaderModule(const String& filePath)
+{
+    ShaderModuleEntry& entry = shaderModules[filePath];
+
+    if (entry.module == nullptr)
+    {
+        entry.module = Utils::Shader::CreateShaderModule(Shader::ReadFileAsBinary(filePath));
+    }
+
+    entry.refCount++;
+    return entry.module;
+}
+
+void PipelineLibrary::ReleaseShaderModule(const String& filePath)
+{
+    auto it = shaderModules.find(filePath);
+    if (it == shaderModules.end()) return;
+
+    ShaderModuleEntry& entry = it->second;
+    if (--entry.refCount > 0) return;
+
+    Utils::Shader::DestroyShaderModule(entry.module);
+    shaderModules.erase(it);
+}
+
+bool PipelineLibrary::AcquirePipeline(const PipelineState& state,
+                                      VkPipelineLayout& layout,
+                                      VkPipeline& pipeline)
+{
+    auto it = pipelines.find(state);
+    if (it == pipelines.end()) return false;
+
+    PipelineEntry& entry = it->second;
+    entry.refCount++;
+
+    layout = entry.layout;
+    pipeline = entry.pipeline;
+    return true;
+}
+
+void PipelineLibrary::AddPipeline(const PipelineState& state,
+                                  VkPipelineLayout layout,
+                                  VkPipeline pipeline)
+{
+    CC_ASSERT(pipelines.find(state) == pipelines.end(),
+              "A pipeline with this state already exists!")
+
+    pipelines[state] = {layout, pipeline, 1};
+}
+
+void PipelineLibrary::ReleasePipeline(const PipelineState& state)
+{
+    auto it = pipelines.find(state);
+    if (it == pipelines.end()) return;
+
+    PipelineEntry& entry = it->second;
+    if (--entry.refCount > 0) return;
+
+    // Frames in flight may still be drawing with the pipeline, so its destruction waits for them
+    Context::GetDeletionQueue().Push(
+        [layout = entry.layout, pipeline = entry.pipeline](VkDevice device) {
+            if (device == nullptr) return;
+
+            vkDestroyPipeline(device, pipeline, nullptr);
+            vkDestroyPipelineLayout(device, layout, nullptr);
+        });
+    pipelines.erase(it);
+}
+
+void PipelineLibrary::Destroy()
+{
+    if (shaderModules.empty() && pipelines.empty()) return;
+
+    VkDevice device = Context::GetVkLogicalDevice();
+
+    if (!pipelines.empty())
+    {
+        CC_LOG_WARNING("[PIPELINE LIBRARY] Destroying {} pipelines which are still referenced",
+                       static_cast<uint32_t>(pipelines.size()))
+    }
+
+    for (auto& [state, entry] : pipelines)
+    {
+        vkDestroyPipeline(device, entry.pipeline, nullptr);
+        vkDestroyPipelineLayout(device, entry.layout, nullptr);
+    }
+
+    for (auto& [filePath, entry] : shaderModules) Utils::Shader::DestroyShaderModule(entry.module);
+
+    pipelines.clear();
+    shaderModules.clear();
+}
+
+void PipelineLibrary::Swap(PipelineLibrary& other)
+{
+    std::swap(shaderModules, other.shaderModules);
+    std::swap(pipelines, other.pipelines);
+}
+} // namespace Siege::Vulkan
@@ -0,0 +1,182 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#ifndef SIEGE_ENGINE_VULKAN_PIPELINE_LIBRARY_H
+#define SIEGE_ENGINE_VULKAN_PIPELINE_LIBRARY_H
+
+#include <utils/Hash.h>
+#include <utils/String.h>
+
+#include <cstdint>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "utils/Types.h"
+
+namespace Siege::Vulkan
+{
+/**
+ * The state a pipeline was built from, written out field by field. Pipelines are looked up by
+ * comparing whole states, so two states whose hashes collide never share a pipeline
+ *
+ * @param data the state's fields, in the order they were written
+ */
+struct PipelineState
+{
+    /**
+     * Hashes a PipelineState's data, for storing it in unordered containers
+     */
+    struct Hasher
+    {
+        size_t operator()(const PipelineState& state) const
+        {
+            return Hash::Fnv1a64(state.data.data(), state.data.size());
+        }
+    };
+
+    /**
+     * Appends a field to the state
+     * @param value the field, which must not contain any padding
+     */
+    template<typename T>
+    void Write(const T& value)
+    {
+        static_assert(std::is_scalar_v<T>, "Only scalar fields can be written to a PipelineState");
+
+        auto bytes = reinterpret_cast<const uint8_t*>(&value);
+        data.insert(data.end(), bytes, bytes + sizeof(T));
+    }
+
+    /**
+     * Appends a string field to the state, prefixed by its size so that adjacent strings can't
+     * run into each other
+     * @param value the string
+     */
+    void Write(const String& value)
+    {
+        Write(static_cast<uint64_t>(value.Size()));
+        data.insert(data.end(), value.Str(), value.Str() + value.Size());
+    }
+
+    bool operator==(const PipelineState& other) const
+    {
+        return data == other.data;
+    }
+
+    std::vector<uint8_t> data;
+};
+
+/**
+ * Shares shader modules and graphics pipelines between everything which uses them. Shader modules
+ * are keyed by the path of their SPIR-V, and pipelines by the state they were built from, so
+ * materials built from the same shaders and state use a single module and pipeline. Each entry is
+ * reference counted and destroyed once nothing refers to it
+ *
+ * @param shaderModules the shader modules currently in use, keyed by file path
+ * @param pipelines the pipelines currently in use, keyed by their state
+ */
+class PipelineLibrary
+{
+public:
+
+    /**
+     * An empty default constructor for the PipelineLibrary
+     */
+    PipelineLibrary() = default;
+
+    /**
+     * A move constructor for the PipelineLibrary
+     * @param other the PipelineLibrary to be moved
+     */
+    PipelineLibrary(PipelineLibrary&& other) noexcept;
+
+    /**
+     * A destructor for the PipelineLibrary
+     */
+    ~PipelineLibrary();
+
+    /**
+     * A move assignment operator for the PipelineLibrary
+     * @param other the PipelineLibrary to be moved
+     * @return a reference to the current PipelineLibrary
+     */
+    PipelineLibrary& operator=(PipelineLibrary&& other) noexcept;
+
+    /**
+     * Gets the shader module for a SPIR-V file, creating it from the packed data if no other
+     * shader is using it
+     * @param filePath the path of the SPIR-V file
+     * @return the shader module, which must be released with ReleaseShaderModule
+     */
+    VkShaderModule AcquireShaderModule(const String& filePath);
+
+    /**
+     * Releases a reference to a shader module, destroying it if it was the last one
+     * @param filePath the path the module was acquired with
+     */
+    void ReleaseShaderModule(const String& filePath);
+
+    /**
+     * Gets an existing pipeline built from the same state, if there is one
+     * @param state the pipeline's state
+     * @param layout the pipeline layout, set if the pipeline was found
+     * @param pipeline the pipeline, set if it was found
+     * @return true if the pipeline was found and a reference to it taken, false otherwise
+     */
+    bool AcquirePipeline(const PipelineState& state,
+                         VkPipelineLayout& layout,
+                         VkPipeline& pipeline);
+
+    /**
+     * Stores a newly built pipeline, holding a single reference to it
+     * @param state the pipeline's state
+     * @param layout the pipeline layout
+     * @param pipeline the pipeline
+     */
+    void AddPipeline(const PipelineState& state, VkPipelineLayout layout, VkPipeline pipeline);
+
+    /**
+     * Releases a reference to a pipeline, destroying it and its layout if it was the last one
+     * @param state the state the pipeline was stored with
+     */
+    void ReleasePipeline(const PipelineState& state);
+
+    /**
+     * Destroys every module and pipeline regardless of how many references remain
+     */
+    void Destroy();
+
+private:
+
+    struct ShaderModuleEntry
+    {
+        VkShaderModule module {nullptr};
+        uint32_t refCount {0};
+    };
+
+    struct PipelineEntry
+    {
+        VkPipelineLayout layout {nullptr};
+        VkPipeline pipeline {nullptr};
+        uint32_t refCount {0};
+    };
+
+    /**
+     * Swaps the contents of two PipelineLibraries
+     * @param other the PipelineLibrary to swap with
+     */
+    void Swap(PipelineLibrary& other);
+
+    std::unordered_map<String, ShaderModuleEntry> shaderModules;
+    std::unordered_map<PipelineState, PipelineEntry, PipelineState::Hasher> pipelines;
+};
+} // namespace Siege::Vulkan
+
+#endif // SIEGE_ENGINE_VULKAN_PIPELINE_LIBRARY_H
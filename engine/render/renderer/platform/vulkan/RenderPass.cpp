@@ -130,11 +130,13 @@ RenderPass::RenderPass(RenderPass&& other)
 
 RenderPass::~RenderPass()
 {
-    auto device = Context::GetVkLogicalDevice();
+    if (Context::GetVkLogicalDevice() == nullptr || renderPass == nullptr) return;
 
-    if (device == nullptr) return;
+    Context::GetDeletionQueue().Push([rawRenderPass = renderPass](VkDevice device) {
+        if (device != nullptr) Utils::Free(device, rawRenderPass);
+    });
 
-    Utils::Free(Context::GetVkLogicalDevice(), renderPass);
+    renderPass = nullptr;
 }
 
 RenderPass& RenderPass::operator=(RenderPass&& other)
@@ -147,17 +149,22 @@ void RenderPass::Begin(CommandBuffer& commandBuffer,
                        unsigned int width,
                        unsigned int height,
                        FColour clearColour,
-                       VkFramebuffer framebuffer)
+                       VkFramebuffer framebuffer,
+                       bool executesSecondaryBuffers)
 {
     VkClearValue clearValues[2] = {{{{clearColour.r, clearColour.g, clearColour.b, clearColour.a}}},
                                    {{{1.f, 0.f}}}};
 
+    VkSubpassContents contents = VK_SUBPASS_CONTENTS_INLINE;
+    if (executesSecondaryBuffers) contents = VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS;
+
     Utils::BeginRenderPass(commandBuffer.Get(),
                            renderPass,
                            clearValues,
                            2,
                            framebuffer,
-                           {{}, {width, height}});
+                           {{}, {width, height}},
+                           contents);
 }
 
 void RenderPass::End(CommandBuffer& commandBuffer)
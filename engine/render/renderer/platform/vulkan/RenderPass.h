@@ -96,7 +96,8 @@ public:
                unsigned int width,
                unsigned int height,
                FColour clearColour,
-               VkFramebuffer framebuffer);
+               VkFramebuffer framebuffer,
+               bool executesSecondaryBuffers = false);
     void End(CommandBuffer& commandBuffer);
 
     inline constexpr RenderPassRaw GetRawRenderPass() const
@@ -39,10 +39,18 @@ Semaphore::~Semaphore()
 
     CC_LOG_INFO("[SEMAPHORE] Destroying Semaphore")
 
-    auto device = Context::GetVkLogicalDevice();
-    for (size_t i = 0; i < size; i++) vkDestroySemaphore(device, semaphores[i], nullptr);
+    // A presentation may still be waiting on the semaphores, so they outlive the frames in flight
+    Context::GetDeletionQueue().Push([rawSemaphores = semaphores, count = size](VkDevice device) {
+        if (device != nullptr)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                vkDestroySemaphore(device, rawSemaphores[i], nullptr);
+            }
+        }
+        delete[] rawSemaphores;
+    });
 
-    delete[] semaphores;
     semaphores = VK_NULL_HANDLE;
     size = 0;
 }
@@ -16,8 +16,8 @@
 
 #include <fstream>
 
+#include "Context.h"
 #include "render/renderer/renderer/Renderer3D.h"
-#include "utils/ShaderModule.h"
 
 namespace Siege::Vulkan
 {
@@ -48,6 +48,41 @@ Shader::VertexBinding& Shader::VertexBinding::AddFloatVec2Attribute()
     return *this;
 }
 
+Shader::VertexBinding& Shader::VertexBinding::AddUnorm16Vec4Attribute()
+{
+    attributes.Append({stride, Utils::VertexAttributeType::VERTEX_UNORM16_VEC4, inputRate});
+    stride += sizeof(uint16_t) * 4;
+    return *this;
+}
+
+Shader::VertexBinding& Shader::VertexBinding::AddSnorm16Vec2Attribute()
+{
+    attributes.Append({stride, Utils::VertexAttributeType::VERTEX_SNORM16_VEC2, inputRate});
+    stride += sizeof(int16_t) * 2;
+    return *this;
+}
+
+Shader::VertexBinding& Shader::VertexBinding::AddHalfVec2Attribute()
+{
+    attributes.Append({stride, Utils::VertexAttributeType::VERTEX_HALF_VEC2, inputRate});
+    stride += sizeof(uint16_t) * 2;
+    return *this;
+}
+
+Shader::VertexBinding& Shader::VertexBinding::AddUnorm8Vec4Attribute()
+{
+    attributes.Append({stride, Utils::VertexAttributeType::VERTEX_UNORM8_VEC4, inputRate});
+    stride += sizeof(uint8_t) * 4;
+    return *this;
+}
+
+Shader::VertexBinding& Shader::VertexBinding::AddUint8Vec4Attribute()
+{
+    attributes.Append({stride, Utils::VertexAttributeType::VERTEX_UINT8_VEC4, inputRate});
+    stride += sizeof(uint8_t) * 4;
+    return *this;
+}
+
 Shader::VertexBinding& Shader::VertexBinding::AddMat4Attribute()
 {
     return AddFloatVec4Attribute()
@@ -168,13 +203,15 @@ Shader::~Shader()
 
 void Shader::Destroy()
 {
-    Utils::Shader::DestroyShaderModule(shaderModule);
+    if (shaderModule == nullptr || Context::GetVkLogicalDevice() == nullptr) return;
+
+    Context::GetPipelineLibrary().ReleaseShaderModule(filePath);
+    shaderModule = nullptr;
 }
 
 MHArray<char> Shader::ReadFileAsBinary(const String& filePath)
 {
-    PackFile* packFile = ResourceSystem::GetInstance().GetPackFile();
-    std::shared_ptr<PackFileData> fileData = packFile->FindData(filePath);
+    std::shared_ptr<PackFileData> fileData = ResourceSystem::GetInstance().FindData(filePath);
     MHArray<char> buffer(fileData->data, fileData->dataSize);
     return buffer;
 }
@@ -183,9 +220,7 @@ void Shader::CreateShaderModule()
 {
     if (filePath == "") return;
 
-    auto buffer = ReadFileAsBinary(filePath);
-
-    shaderModule = Utils::Shader::CreateShaderModule(buffer);
+    shaderModule = Context::GetPipelineLibrary().AcquireShaderModule(filePath);
 }
 
 void Shader::Swap(Shader& other)
@@ -97,6 +97,36 @@ public:
          */
         VertexBinding& AddFloatVec2Attribute();
 
+        /**
+         * Specifies a 4D vector vertex attribute stored as 16-bit unsigned normalised integers
+         * @return a reference to the VertexBinding type
+         */
+        VertexBinding& AddUnorm16Vec4Attribute();
+
+        /**
+         * Specifies a 2D vector vertex attribute stored as 16-bit signed normalised integers
+         * @return a reference to the VertexBinding type
+         */
+        VertexBinding& AddSnorm16Vec2Attribute();
+
+        /**
+         * Specifies a 2D vector vertex attribute stored as half precision floats
+         * @return a reference to the VertexBinding type
+         */
+        VertexBinding& AddHalfVec2Attribute();
+
+        /**
+         * Specifies a 4D vector vertex attribute stored as 8-bit unsigned normalised integers
+         * @return a reference to the VertexBinding type
+         */
+        VertexBinding& AddUnorm8Vec4Attribute();
+
+        /**
+         * Specifies a 4D vector vertex attribute stored as 8-bit unsigned integers
+         * @return a reference to the VertexBinding type
+         */
+        VertexBinding& AddUint8Vec4Attribute();
+
         /**
          * Specifies a 4 dimensional matrix vertex attribute
          * @return a reference to the VertexBinding type
@@ -336,6 +366,8 @@ public:
      */
     inline Shader& operator=(const Shader& other) noexcept
     {
+        Destroy();
+
         filePath = other.filePath;
 
         CreateShaderModule();
@@ -364,6 +396,15 @@ public:
         return expectedUniforms;
     }
 
+    /**
+     * Returns the path of the SPIR-V file the Shader was created from
+     * @return the Shader's file path
+     */
+    inline const String& GetFilePath() const
+    {
+        return filePath;
+    }
+
     /**
      * Returns the Vulkan ShaderModule for the Shader
      * @return A VkShaderModule type
@@ -429,8 +470,8 @@ private:
     void Swap(Shader& other);
 
     /**
-     * Creates the Vulkan Shader Module
-     * TODO: Move this to a Vulkan renderer which can store this information
+     * Acquires the Vulkan Shader Module from the context's pipeline library, which shares a
+     * single module between every Shader created from the same file
      */
     void CreateShaderModule();
 
@@ -13,6 +13,7 @@
 #include <resources/ResourceSystem.h>
 #include <resources/StaticMeshData.h>
 #include <utils/Logging.h>
+#include <utils/math/Transform.h>
 
 #include "Swapchain.h"
 
@@ -32,6 +33,7 @@ StaticMesh::StaticMesh(unsigned int vertexBufferSize,
     CC_ASSERT(vertexCount < MAX_VERTICES, "The provided model has too many vertices!")
     CC_ASSERT(indexCount < MAX_INDICES, "The provided model has too many indices!")
 
+    vertexStride = vertexBufferSize / vertexCount;
     vertexBuffer = VertexBuffer(vertexBufferSize);
     indexBuffer = IndexBuffer(indexBufferSize);
 
@@ -42,31 +44,57 @@ StaticMesh::StaticMesh(unsigned int vertexBufferSize,
 StaticMesh::StaticMesh(const char* filePath, Material* material)
 {
     // TODO(Aryeh): How to extract material data from object files?
-    PackFile* packFile = ResourceSystem::GetInstance().GetPackFile();
-    std::shared_ptr<StaticMeshData> staticMeshData =
-        packFile->FindDataDeserialised<StaticMeshData>(filePath);
+    std::shared_ptr<const StaticMeshDataView> staticMeshData =
+        ResourceSystem::GetInstance().FindDataView<StaticMeshDataView>(filePath);
+
+    // Quantised meshes are uploaded as-is and decoded by the vertex shader, with their bounds
+    // applied through the dequantisation transform at draw time
+    const MeshFormat& format = staticMeshData->format;
+    bool isQuantised = format.vertexFormat == VERTEX_FORMAT_QUANTISED;
+    const void* vertexData = isQuantised ? static_cast<const void*>(
+                                               staticMeshData->quantisedVertices.Data()) :
+                                           staticMeshData->vertices.Data();
+
+    // Meshes with few enough vertices may also have been packed with 16-bit indices
+    bool hasShortIndices = format.indexFormat == INDEX_FORMAT_UINT16;
+    const void* indexData = hasShortIndices ? static_cast<const void*>(
+                                                  staticMeshData->shortIndices.Data()) :
+                                              staticMeshData->indices.Data();
+
+    vertexCount = isQuantised ? staticMeshData->quantisedVertices.Size() :
+                                staticMeshData->vertices.Size();
+    indexCount = hasShortIndices ? staticMeshData->shortIndices.Size() :
+                                   staticMeshData->indices.Size();
+
+    // Any LODs are stored after the full detail indices, which the submesh covers alone
+    const Span<const MeshLod>& meshLods = staticMeshData->lods;
+    unsigned int baseIndexCount = meshLods.Empty() ? indexCount : meshLods[0].indexOffset;
+    if (!meshLods.Empty()) lods = MHArray<MeshLod>(meshLods.Data(), meshLods.Size());
+    CalculateBoundingBox(*staticMeshData, boundingBox.min, boundingBox.max);
+    boundsCentre = (boundingBox.min + boundingBox.max) * 0.5f;
+    boundsRadius = Vec3::Length(boundingBox.max - boundingBox.min) * 0.5f;
+    vertexStride = isQuantised ? sizeof(QuantisedVertex) : sizeof(BaseVertex);
 
-    CC_ASSERT(!staticMeshData->vertices.empty(), "Cannot load in a file with no vertices!")
-    CC_ASSERT(!staticMeshData->indices.empty(), "Cannot load in a file with no indices!")
+    CC_ASSERT(vertexCount > 0, "Cannot load in a file with no vertices!")
+    CC_ASSERT(indexCount > 0, "Cannot load in a file with no indices!")
 
-    CC_ASSERT(staticMeshData->vertices.size() < MAX_VERTICES,
-              "The provided model has too many vertices!")
-    CC_ASSERT(staticMeshData->indices.size() < MAX_INDICES,
-              "The provided model has too many indices!")
+    CC_ASSERT(vertexCount < MAX_VERTICES, "The provided model has too many vertices!")
+    CC_ASSERT(indexCount < MAX_INDICES, "The provided model has too many indices!")
 
-    vertexCount = staticMeshData->vertices.size();
-    indexCount = staticMeshData->indices.size();
+    if (isQuantised) dequantisation = Transform3D(format.boundsMin, {}, format.boundsExtent);
 
-    vertexBuffer = VertexBuffer(sizeof(BaseVertex) * vertexCount);
-    vertexBuffer.Copy(staticMeshData->vertices.data(), sizeof(BaseVertex) * vertexCount);
+    vertexBuffer = VertexBuffer(vertexStride * vertexCount);
+    vertexBuffer.Copy(vertexData, vertexStride * vertexCount);
 
-    indexBuffer = IndexBuffer(sizeof(unsigned int) * indexCount);
-    indexBuffer.Copy(staticMeshData->indices.data(), sizeof(unsigned int) * indexCount);
+    unsigned int indexSize = hasShortIndices ? sizeof(uint16_t) : sizeof(uint32_t);
+    indexBuffer = IndexBuffer(indexSize * indexCount,
+                              hasShortIndices ? Utils::INDEX_UINT16 : Utils::INDEX_UINT32);
+    indexBuffer.Copy(indexData, indexSize * indexCount);
 
     subMeshes = MHArray<SubMesh>(1);
     materials = MHArray<Material*>(1);
 
-    subMeshes.Append({0, 0, 0, vertexCount, indexCount});
+    subMeshes.Append({0, 0, 0, vertexCount, baseIndexCount});
     materials.Append(material);
 }
 
@@ -77,6 +105,12 @@ void StaticMesh::Swap(StaticMesh& other)
 
     auto tmpVertexCount = vertexCount;
     auto tmpIndexCount = indexCount;
+    auto tmpVertexStride = vertexStride;
+    auto tmpDequantisation = dequantisation;
+    auto tmpLods = lods;
+    auto tmpBoundsCentre = boundsCentre;
+    auto tmpBoundsRadius = boundsRadius;
+    auto tmpBoundingBox = boundingBox;
 
     auto tmpSubmeshes = subMeshes;
     auto tmpMaterials = materials;
@@ -86,6 +120,12 @@ void StaticMesh::Swap(StaticMesh& other)
 
     vertexCount = other.vertexCount;
     indexCount = other.indexCount;
+    vertexStride = other.vertexStride;
+    dequantisation = other.dequantisation;
+    lods = other.lods;
+    boundsCentre = other.boundsCentre;
+    boundsRadius = other.boundsRadius;
+    boundingBox = other.boundingBox;
 
     subMeshes = other.subMeshes;
     materials = other.materials;
@@ -95,6 +135,12 @@ void StaticMesh::Swap(StaticMesh& other)
 
     other.vertexCount = tmpVertexCount;
     other.indexCount = tmpIndexCount;
+    other.vertexStride = tmpVertexStride;
+    other.dequantisation = tmpDequantisation;
+    other.lods = tmpLods;
+    other.boundsCentre = tmpBoundsCentre;
+    other.boundsRadius = tmpBoundsRadius;
+    other.boundingBox = tmpBoundingBox;
 
     other.subMeshes = tmpSubmeshes;
     other.materials = tmpMaterials;
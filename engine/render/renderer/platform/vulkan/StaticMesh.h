@@ -10,7 +10,10 @@
 #ifndef SIEGE_ENGINE_VULKAN_MESH_H
 #define SIEGE_ENGINE_VULKAN_MESH_H
 
+#include <resources/StaticMeshData.h>
 #include <utils/collections/HeapArray.h>
+#include <utils/math/Maths.h>
+#include <utils/math/mat/Mat4.h>
 
 #include <cstdint>
 
@@ -74,7 +77,13 @@ public:
         indexBuffer {other.indexBuffer},
         vertexBuffer {other.vertexBuffer},
         vertexCount {other.vertexCount},
-        indexCount {other.indexCount}
+        indexCount {other.indexCount},
+        vertexStride {other.vertexStride},
+        dequantisation {other.dequantisation},
+        lods {other.lods},
+        boundsCentre {other.boundsCentre},
+        boundsRadius {other.boundsRadius},
+        boundingBox {other.boundingBox}
     {}
 
     /**
@@ -97,6 +106,13 @@ public:
 
         vertexCount = other.vertexCount;
         indexCount = other.indexCount;
+        vertexStride = other.vertexStride;
+        dequantisation = other.dequantisation;
+
+        lods = other.lods;
+        boundsCentre = other.boundsCentre;
+        boundsRadius = other.boundsRadius;
+        boundingBox = other.boundingBox;
 
         subMeshes = other.subMeshes;
         materials = other.materials;
@@ -128,6 +144,72 @@ public:
         return subMeshes;
     }
 
+    /**
+     * Returns the size in bytes of each vertex stored in the vertex buffer, which differs between
+     * full precision and quantised meshes
+     * @return the vertex stride in bytes
+     */
+    inline unsigned int GetVertexStride() const
+    {
+        return vertexStride;
+    }
+
+    /**
+     * Returns the size in bytes of each index stored in the index buffer
+     * @return the index size in bytes
+     */
+    inline unsigned int GetIndexSize() const
+    {
+        return indexBuffer.GetIndexSize();
+    }
+
+    /**
+     * Returns the transform mapping the mesh's stored positions into model space. Quantised meshes
+     * store positions relative to their bounds, so this should be applied before the object's own
+     * transform (it is the identity for full precision meshes)
+     * @return the dequantisation transform
+     */
+    inline const Mat4& GetDequantisation() const
+    {
+        return dequantisation;
+    }
+
+    /**
+     * Returns the reduced LODs of the mesh, which replace its only submesh when drawn
+     * @return the reduced LODs in order of increasing error, empty if the mesh has none
+     */
+    inline Span<const MeshLod> GetLods() const
+    {
+        return {lods.Data(), lods.Count()};
+    }
+
+    /**
+     * Returns the centre of the mesh's bounding sphere in model space
+     * @return the bounding sphere centre
+     */
+    inline const Vec3& GetBoundsCentre() const
+    {
+        return boundsCentre;
+    }
+
+    /**
+     * Returns the radius of the mesh's bounding sphere in model space
+     * @return the bounding sphere radius
+     */
+    inline float GetBoundsRadius() const
+    {
+        return boundsRadius;
+    }
+
+    /**
+     * Returns the axis aligned bounding box of the mesh in model space
+     * @return the bounding box
+     */
+    inline const BoundedBox& GetBoundingBox() const
+    {
+        return boundingBox;
+    }
+
 private:
 
     /**
@@ -144,6 +226,14 @@ private:
 
     unsigned int vertexCount {0};
     unsigned int indexCount {0};
+    unsigned int vertexStride {0};
+
+    Mat4 dequantisation {Mat4::Identity()};
+
+    MHArray<MeshLod> lods;
+    Vec3 boundsCentre;
+    float boundsRadius {0.f};
+    BoundedBox boundingBox;
 };
 
 } // namespace Siege::Vulkan
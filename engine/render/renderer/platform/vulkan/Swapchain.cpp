@@ -27,6 +27,15 @@ Swapchain::Swapchain(const Utils::Extent2D& imageExtent, VkSwapchainKHR oldSwapc
     CreateSyncObjects();
 }
 
+Swapchain::Swapchain(const Utils::Extent2D& imageExtent, Swapchain& oldSwapchain) :
+    Swapchain(imageExtent, oldSwapchain.swapchain)
+{
+    // Frames submitted to the old swapchain are still signalling its fences, so they're carried
+    // over along with the frame index to keep waiting on the right frame
+    std::swap(inFlightFences, oldSwapchain.inFlightFences);
+    currentFrame = oldSwapchain.currentFrame;
+}
+
 Swapchain::Swapchain(Swapchain&& other)
 {
     Swap(other);
@@ -90,25 +99,31 @@ void Swapchain::CreateSwapChain(VkSwapchainKHR oldSwapchain)
 
 Swapchain::~Swapchain()
 {
-    auto device = Context::GetVkLogicalDevice();
+    if (Context::GetVkLogicalDevice() == nullptr) return;
 
-    if (device == nullptr) return;
+    if (swapchain == nullptr && swapChainFrameBuffers == nullptr) return;
 
     uint32_t imageCount = FrameImages::GetImageCount();
 
     CC_LOG_INFO("Clearing Swapchain")
-    vkDestroySwapchainKHR(device, swapchain, nullptr);
 
-    if (swapChainFrameBuffers)
-    {
-        for (size_t i = 0; i < imageCount; i++)
-        {
-            vkDestroyFramebuffer(device, swapChainFrameBuffers[i], nullptr);
-            swapChainFrameBuffers[i] = VK_NULL_HANDLE;
-        }
-    }
+    // The swapchain's images may still be rendered to or presented by frames in flight, so it's
+    // only destroyed once they've completed
+    Context::GetDeletionQueue().Push(
+        [rawSwapchain = swapchain, frameBuffers = swapChainFrameBuffers, imageCount](
+            VkDevice device) {
+            if (device != nullptr && frameBuffers)
+            {
+                for (size_t i = 0; i < imageCount; i++)
+                {
+                    vkDestroyFramebuffer(device, frameBuffers[i], nullptr);
+                }
+            }
+
+            delete[] frameBuffers;
 
-    delete[] swapChainFrameBuffers;
+            if (device != nullptr) vkDestroySwapchainKHR(device, rawSwapchain, nullptr);
+        });
 
     swapChainFrameBuffers = VK_NULL_HANDLE;
     swapchain = VK_NULL_HANDLE;
@@ -134,13 +149,15 @@ Utils::Result Swapchain::AcquireNextImage(uint32_t* imageIndex)
 
 void Swapchain::BeginRenderPass(Vulkan::CommandBuffer& commandBuffer,
                                 uint32_t imageIndex,
-                                FColour clearColour)
+                                FColour clearColour,
+                                bool executesSecondaryBuffers)
 {
     renderPass.Begin(commandBuffer,
                      swapchainExtent.width,
                      swapchainExtent.height,
                      clearColour,
-                     swapChainFrameBuffers[imageIndex]);
+                     swapChainFrameBuffers[imageIndex],
+                     executesSecondaryBuffers);
 }
 
 void Swapchain::EndRenderPass(Vulkan::CommandBuffer& commandBuffer)
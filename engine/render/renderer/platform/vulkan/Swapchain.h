@@ -50,6 +50,15 @@ public:
      */
     Swapchain(const Utils::Extent2D& imageExtent, VkSwapchainKHR oldSwapchain = nullptr);
 
+    /**
+     * Constructor for a Swapchain replacing another, without waiting for the device to go idle.
+     * The old swapchain's in-flight fences and frame index are carried over so the frames still
+     * rendering to it are waited on before their slots are reused
+     * @param imageExtent the width/height of the swapchain images
+     * @param oldSwapchain the swapchain being replaced
+     */
+    Swapchain(const Utils::Extent2D& imageExtent, Swapchain& oldSwapchain);
+
     /**
      * Swapchain move constructor
      * @param other the Swapchain to move
@@ -155,9 +164,28 @@ public:
         return swapchainExtent;
     }
 
+    /**
+     * Returns the framebuffer which renders to a swapchain image
+     * @param imageIndex the index of the swapchain image
+     * @return the image's framebuffer
+     */
+    VkFramebuffer GetFramebuffer(uint32_t imageIndex)
+    {
+        return swapChainFrameBuffers[imageIndex];
+    }
+
+    /**
+     * Begins the swapchain's render pass
+     * @param commandBuffer the command buffer to record the render pass to
+     * @param imageIndex the index of the swapchain image being rendered to
+     * @param clearColour the colour the image is cleared to
+     * @param executesSecondaryBuffers whether the render pass's contents are recorded to secondary
+     * command buffers, rather than to the command buffer itself
+     */
     void BeginRenderPass(Vulkan::CommandBuffer& commandBuffer,
                          uint32_t imageIndex,
-                         FColour clearColour);
+                         FColour clearColour,
+                         bool executesSecondaryBuffers = false);
 
     void EndRenderPass(Vulkan::CommandBuffer& commandBuffer);
 
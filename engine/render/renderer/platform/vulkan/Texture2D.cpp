@@ -12,16 +12,45 @@
 #include <resources/PackFile.h>
 #include <resources/ResourceSystem.h>
 #include <resources/Texture2DData.h>
-#include <utils/Defer.h>
+#include <utils/Logging.h>
+
+#include <vector>
 
 #include "Constants.h"
 #include "Context.h"
-#include "render/renderer/buffer/Buffer.h"
 #include "utils/Descriptor.h"
+#include "utils/Device.h"
 #include "utils/TypeAdaptor.h"
 
 namespace Siege::Vulkan
 {
+static Utils::ImageFormat GetImageFormat(int32_t textureFormat)
+{
+    switch (textureFormat)
+    {
+        case TEXTURE2D_FORMAT_BC1:
+            return Utils::BC1SRGB;
+        case TEXTURE2D_FORMAT_BC3:
+            return Utils::BC3SRGB;
+        case TEXTURE2D_FORMAT_BC4:
+            return Utils::BC4UN;
+        case TEXTURE2D_FORMAT_BC5:
+            return Utils::BC5UN;
+        case TEXTURE2D_FORMAT_BC7:
+            return Utils::BC7SRGB;
+        default:
+            return Utils::RGBASRGB;
+    }
+}
+
+static bool CanSampleFormat(Utils::ImageFormat imageFormat)
+{
+    VkFormatProperties properties =
+        Device::Physical::GetProperties(Context::GetPhysicalDevice()->GetDevice(),
+                                        Utils::ToVkFormat(imageFormat));
+    return properties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT;
+}
+
 Texture2D::Texture2D(const char* name, Utils::TextureFilter filter, Usage texUsage)
 {
     LoadTexture(Constants::DEFAULT_TEXTURE_2D, Constants::DEFAULT_TEXTURE_SIZE, 16, 16, texUsage);
@@ -45,6 +74,7 @@ Texture2D::Texture2D(const char* name, const char* filePath, Utils::TextureFilte
 
     VkSamplerCreateInfo samplerInfo =
         Utils::Descriptor::SamplerCreateInfo(Utils::ToVkFilter(filter));
+    samplerInfo.maxLod = static_cast<float>(image.GetMipLevels());
 
     info = {image.GetInfo()};
 
@@ -93,23 +123,37 @@ Texture2D& Texture2D::operator=(Texture2D&& other)
 
 void Texture2D::LoadFromFile(const char* filePath)
 {
-    PackFile* packFile = ResourceSystem::GetInstance().GetPackFile();
-    std::shared_ptr<Texture2DData> texture2dData =
-        packFile->FindDataDeserialised<Texture2DData>(filePath);
-
-    Buffer::Buffer stagingBuffer;
-    defer([&stagingBuffer] { Buffer::DestroyBuffer(stagingBuffer); });
-
-    Buffer::CreateBuffer(texture2dData->GetImageSize(),
-                         VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                         // specifies that data is accessible on the CPU.
-                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-                             // Ensures that CPU and GPU memory are consistent across both devices.
-                             VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                         OUT stagingBuffer.buffer,
-                         OUT stagingBuffer.bufferMemory);
-
-    Buffer::CopyData(stagingBuffer, texture2dData->GetImageSize(), texture2dData->pixels.data());
+    std::shared_ptr<const Texture2DDataView> texture2dData =
+        ResourceSystem::GetInstance().FindDataView<Texture2DDataView>(filePath);
+
+    // Block compressed formats are optional, so a device without them gets the default texture
+    // rather than an image it can't create
+    Utils::ImageFormat imageFormat = GetImageFormat(texture2dData->format);
+    if (imageFormat != Utils::RGBASRGB && !CanSampleFormat(imageFormat))
+    {
+        CC_LOG_ERROR("[TEXTURE2D] \"{}\" is block compressed in a format this device cannot "
+                     "sample, repack it without its .bc suffix. Using the default texture instead",
+                     filePath)
+        LoadTexture(Constants::DEFAULT_TEXTURE_2D,
+                    Constants::DEFAULT_TEXTURE_SIZE,
+                    16,
+                    16,
+                    TEX_USAGE_TEX2D);
+        return;
+    }
+
+    // Every level of the mip chain is staged together and copied with one command, block
+    // compressed levels are copied as is
+    uint32_t mipLevels = texture2dData->GetMipLevelCount();
+    std::vector<uint64_t> levelOffsets(mipLevels);
+    for (uint32_t level = 0; level < mipLevels; level++)
+    {
+        levelOffsets[level] = texture2dData->GetMipLevelOffset(level);
+    }
+    uint64_t chainSize = levelOffsets.back() + texture2dData->GetMipLevelSize(mipLevels - 1);
+
+    auto staging = Context::GetUploadManager().Stage(texture2dData->pixels.Data(), chainSize);
+    for (uint64_t& levelOffset : levelOffsets) levelOffset += staging.offset;
 
     extent = {static_cast<uint32_t>(texture2dData->texWidth),
               static_cast<uint32_t>(texture2dData->texHeight)};
@@ -117,9 +161,9 @@ void Texture2D::LoadFromFile(const char* filePath)
     Utils::Extent3D imageExtent {static_cast<uint32_t>(texture2dData->texWidth),
                                  static_cast<uint32_t>(texture2dData->texHeight),
                                  1};
-    image = Image({Utils::RGBASRGB, imageExtent, Vulkan::Utils::USAGE_TEXTURE, 1, 1});
+    image = Image({imageFormat, imageExtent, Vulkan::Utils::USAGE_TEXTURE, mipLevels, 1});
 
-    image.CopyBuffer(stagingBuffer.buffer, imageExtent);
+    image.CopyBufferLevels(staging.commandBuffer, staging.buffer, imageExtent, levelOffsets.data());
 }
 
 void Texture2D::LoadTexture(const uint8_t* pixels,
@@ -128,17 +172,7 @@ void Texture2D::LoadTexture(const uint8_t* pixels,
                             uint32_t height,
                             Usage texUsage)
 {
-    Buffer::Buffer stagingBuffer;
-    Buffer::CreateBuffer(size,
-                         VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                         // specifies that data is accessible on the CPU.
-                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-                             // Ensures that CPU and GPU memory are consistent across both devices.
-                             VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                         OUT stagingBuffer.buffer,
-                         OUT stagingBuffer.bufferMemory);
-
-    Buffer::CopyData(stagingBuffer, size, pixels);
+    auto staging = Context::GetUploadManager().Stage(pixels, size);
 
     extent = {width, height};
 
@@ -146,9 +180,7 @@ void Texture2D::LoadTexture(const uint8_t* pixels,
 
     image = Image({(Utils::ImageFormat) texUsage, imageExtent, Vulkan::Utils::USAGE_TEXTURE, 1, 1});
 
-    image.CopyBuffer(stagingBuffer.buffer, imageExtent);
-
-    Buffer::DestroyBuffer(stagingBuffer);
+    image.CopyBuffer(staging.commandBuffer, staging.buffer, staging.offset, imageExtent);
 }
 
 void Texture2D::CopyToRegion(uint8_t* pixels,
@@ -156,29 +188,18 @@ void Texture2D::CopyToRegion(uint8_t* pixels,
                              Utils::Extent3D copyExtent,
                              Utils::Offset3D copyOffset)
 {
-    Buffer::Buffer stagingBuffer;
-    defer([&stagingBuffer]() { Buffer::DestroyBuffer(stagingBuffer); });
-    Buffer::CreateBuffer(size,
-                         VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                         // specifies that data is accessible on the CPU.
-                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-                             // Ensures that CPU and GPU memory are consistent across both devices.
-                             VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                         OUT stagingBuffer.buffer,
-                         OUT stagingBuffer.bufferMemory);
-
-    Buffer::CopyData(stagingBuffer, size, pixels);
-
-    image.CopyBuffer(stagingBuffer.buffer, copyExtent, copyOffset);
+    auto staging = Context::GetUploadManager().Stage(pixels, size);
+
+    image.CopyBuffer(staging.commandBuffer, staging.buffer, staging.offset, copyExtent, copyOffset);
 }
 
 void Texture2D::Free()
 {
-    auto device = Context::GetVkLogicalDevice();
-
-    if (device == nullptr) return;
+    if (Context::GetVkLogicalDevice() == nullptr) return;
 
-    vkDestroySampler(device, info.sampler, nullptr);
+    Context::GetDeletionQueue().Push([sampler = info.sampler](VkDevice device) {
+        if (device != nullptr) vkDestroySampler(device, sampler, nullptr);
+    });
 
     image.Free();
 
@@ -0,0 +1,153 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#include "UniformRing.h"
+
+#include <utils/Logging.h>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "Context.h"
+#include "Swapchain.h"
+
+namespace Siege::Vulkan
+{
+UniformRing::UniformRing(uint64_t frameCapacity)
+{
+    auto physicalDevice = Context::GetPhysicalDevice();
+    alignment = std::max<uint64_t>({physicalDevice->GetMinUniformDeviceAlignment(),
+                                    physicalDevice->GetMinStorageDeviceAlignment(),
+                                    1});
+
+    CreateRegions(frameCapacity);
+}
+
+UniformRing::UniformRing(UniformRing&& other) noexcept
+{
+    Swap(other);
+}
+
+UniformRing::~UniformRing()
+{
+    Free();
+}
+
+UniformRing& UniformRing::operator=(UniformRing&& other) noexcept
+{
+    Swap(other);
+    return *this;
+}
+
+void UniformRing::BeginFrame(uint32_t frameIndex)
+{
+    currentFrame = frameIndex;
+    frameNumber++;
+    frameAllocators[currentFrame].Reset();
+}
+
+UniformRing::Allocation UniformRing::Allocate(uint64_t size)
+{
+    std::lock_guard<std::mutex> lock(allocationMutex);
+
+    uint64_t offset = frameAllocators[currentFrame].Allocate(size, alignment);
+
+    // The frame's existing allocations can't be moved, so the rest of the frame is allocated from
+    // a larger buffer instead
+    if (offset == LinearAllocator::INVALID_OFFSET)
+    {
+        Grow(size);
+        offset = frameAllocators[currentFrame].Allocate(size, alignment);
+    }
+
+    offset += frameCapacity * currentFrame;
+    return {buffer.buffer, offset, size, mappedData + offset};
+}
+
+UniformRing::Allocation UniformRing::Upload(const void* data, uint64_t size)
+{
+    Allocation allocation = Allocate(size);
+    memcpy(allocation.data, data, size);
+    return allocation;
+}
+
+void UniformRing::Free()
+{
+    if (buffer.buffer == nullptr) return;
+
+    Buffer::DestroyBuffer(buffer);
+
+    buffer.size = 0;
+    mappedData = nullptr;
+}
+
+uint64_t UniformRing::GetHighWaterMark() const
+{
+    uint64_t highWaterMark = 0;
+    for (auto it = frameAllocators.CreateFIterator(); it; ++it)
+    {
+        highWaterMark = std::max(highWaterMark, it->HighWaterMark());
+    }
+    return highWaterMark;
+}
+
+void UniformRing::CreateRegions(uint64_t capacity)
+{
+    // Rounding each region up to the alignment keeps every region's offsets aligned too
+    frameCapacity = (capacity + alignment - 1) / alignment * alignment;
+
+    const auto framesCount = Swapchain::MAX_FRAMES_IN_FLIGHT;
+
+    buffer.size = frameCapacity * framesCount;
+    Buffer::CreateBuffer(buffer.size,
+                         Utils::STORAGE_BUFFER | Utils::UNIFORM_BUFFER,
+                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                         OUT buffer.buffer,
+                         OUT buffer.bufferMemory);
+
+    // Host visible memory stays mapped for as long as it is allocated
+    mappedData = static_cast<uint8_t*>(buffer.bufferMemory.mappedData);
+
+    frameAllocators = MHArray<LinearAllocator>(framesCount);
+    for (size_t i = 0; i < framesCount; i++)
+    {
+        frameAllocators[i] = LinearAllocator(frameCapacity);
+    }
+}
+
+void UniformRing::Grow(uint64_t size)
+{
+    uint64_t required = frameAllocators[currentFrame].BytesUsed() + size + alignment;
+
+    uint64_t capacity = frameCapacity * 2;
+    while (capacity < required) capacity *= 2;
+
+    CC_LOG_WARNING("[UNIFORM RING] Out of space for this frame, growing each frame's region from "
+                   "{} to {} bytes",
+                   static_cast<unsigned long long>(frameCapacity),
+                   static_cast<unsigned long long>(capacity))
+
+    // Frames in flight are still reading from the old buffer, so destroying it goes through the
+    // deletion queue rather than waiting for the device
+    Buffer::DestroyBuffer(buffer);
+    CreateRegions(capacity);
+}
+
+void UniformRing::Swap(UniformRing& other)
+{
+    std::swap(buffer, other.buffer);
+    std::swap(mappedData, other.mappedData);
+    std::swap(frameAllocators, other.frameAllocators);
+    std::swap(frameCapacity, other.frameCapacity);
+    std::swap(alignment, other.alignment);
+    std::swap(currentFrame, other.currentFrame);
+    std::swap(frameNumber, other.frameNumber);
+}
+} // namespace Siege::Vulkan
@@ -0,0 +1,181 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#ifndef SIEGE_ENGINE_VULKAN_UNIFORM_RING_H
+#define SIEGE_ENGINE_VULKAN_UNIFORM_RING_H
+
+#include <utils/allocators/LinearAllocator.h>
+#include <utils/collections/HeapArray.h>
+
+#include <cstdint>
+#include <mutex>
+
+#include "render/renderer/buffer/Buffer.h"
+
+namespace Siege::Vulkan
+{
+/**
+ * A host visible buffer which holds the uniform and storage data written in each frame. The
+ * buffer is split into one region per frame in flight and stays mapped for its whole lifetime.
+ * Data is bump allocated from the current frame's region and read by shaders through dynamic
+ * offsets, so writing it never touches memory the GPU may still be reading from an earlier frame.
+ * Running out of space moves the ring into a larger buffer, so allocations may come from a
+ * different buffer to those made earlier in the frame
+ *
+ * @param buffer the buffer holding every frame's region
+ * @param mappedData the host address the buffer is mapped to
+ * @param frameAllocators the allocators handing out each frame's region
+ * @param frameCapacity the size of each frame's region in bytes
+ * @param alignment the alignment of every allocation, which satisfies both uniform and storage
+ * offset requirements
+ * @param currentFrame the index of the frame allocations are made from
+ * @param frameNumber a count of the frames begun, used to tell whether data was written this frame
+ */
+class UniformRing
+{
+public:
+
+    // The space each frame starts with for uniform and storage data unless a capacity is given
+    static constexpr uint64_t DEFAULT_FRAME_CAPACITY = 16 * 1024 * 1024;
+
+    /**
+     * A region of the ring allocated in the current frame
+     * @param buffer the ring's buffer
+     * @param offset the offset of the region within the buffer
+     * @param size the size of the region in bytes
+     * @param data the host address of the region
+     */
+    struct Allocation
+    {
+        VkBuffer buffer {nullptr};
+        uint64_t offset {0};
+        uint64_t size {0};
+        void* data {nullptr};
+    };
+
+    /**
+     * An empty default constructor for the UniformRing
+     */
+    UniformRing() = default;
+
+    /**
+     * Creates the ring's buffer
+     * @param frameCapacity the number of bytes each frame can allocate
+     */
+    explicit UniformRing(uint64_t frameCapacity);
+
+    /**
+     * A move constructor for the UniformRing
+     * @param other the UniformRing to be moved
+     */
+    UniformRing(UniformRing&& other) noexcept;
+
+    /**
+     * A destructor for the UniformRing
+     */
+    ~UniformRing();
+
+    /**
+     * A move assignment operator for the UniformRing
+     * @param other the UniformRing to be moved
+     * @return a reference to the current UniformRing
+     */
+    UniformRing& operator=(UniformRing&& other) noexcept;
+
+    /**
+     * Starts allocating from a frame's region, releasing everything allocated in it the last time
+     * the frame was drawn. Must only be called once the frame's previous submission has completed
+     * @param frameIndex the index of the frame being started
+     */
+    void BeginFrame(uint32_t frameIndex);
+
+    /**
+     * Allocates a region of the current frame, growing the ring if the frame is out of space. Safe
+     * to call from several threads at once
+     * @param size the size of the region in bytes
+     * @return the allocated region
+     */
+    Allocation Allocate(uint64_t size);
+
+    /**
+     * Allocates a region of the current frame and copies data into it
+     * @param data the data to copy
+     * @param size the size of the data in bytes
+     * @return the allocated region
+     */
+    Allocation Upload(const void* data, uint64_t size);
+
+    /**
+     * Destroys the ring's buffer
+     */
+    void Free();
+
+    VkBuffer GetBuffer() const
+    {
+        return buffer.buffer;
+    }
+
+    uint64_t GetFrameCapacity() const
+    {
+        return frameCapacity;
+    }
+
+    /**
+     * Returns the number of frames begun. Starts from one, so zero never matches a frame
+     * @return the current frame number
+     */
+    uint64_t GetFrameNumber() const
+    {
+        return frameNumber;
+    }
+
+    /**
+     * Returns the most bytes any frame has allocated, for sizing the ring
+     * @return the largest number of bytes used in a single frame
+     */
+    uint64_t GetHighWaterMark() const;
+
+private:
+
+    /**
+     * Swaps the contents of two UniformRings
+     * @param other the UniformRing to swap with
+     */
+    void Swap(UniformRing& other);
+
+    /**
+     * Creates the buffer and an empty region in it for every frame in flight
+     * @param capacity the number of bytes each frame can allocate, before alignment
+     */
+    void CreateRegions(uint64_t capacity);
+
+    /**
+     * Replaces the ring's buffer with one whose regions can hold everything the current frame has
+     * allocated so far along with a new allocation. The old buffer is destroyed once every frame
+     * reading from it has completed
+     * @param size the size of the allocation which didn't fit
+     */
+    void Grow(uint64_t size);
+
+    Buffer::Buffer buffer;
+    uint8_t* mappedData {nullptr};
+
+    MHArray<LinearAllocator> frameAllocators;
+    uint64_t frameCapacity {0};
+    uint64_t alignment {0};
+
+    uint32_t currentFrame {0};
+    uint64_t frameNumber {1};
+
+    // Held while allocating, as materials are bound from several recording threads at once
+    std::mutex allocationMutex;
+};
+} // namespace Siege::Vulkan
+
+#endif // SIEGE_ENGINE_VULKAN_UNIFORM_RING_H
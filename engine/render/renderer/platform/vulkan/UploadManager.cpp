@@ -0,0 +1,232 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#include "UploadManager.h"
+
+#include <utils/Logging.h>
+
+#include <cstring>
+#include <utility>
+
+#include "Context.h"
+#include "utils/SubmitCommands.h"
+
+namespace Siege::Vulkan
+{
+static constexpr uint64_t INVALID_OFFSET = UINT64_MAX;
+
+static uint64_t AlignUp(uint64_t offset)
+{
+    constexpr uint64_t mask = UploadManager::STAGING_ALIGNMENT - 1;
+    return (offset + mask) & ~mask;
+}
+
+UploadManager::UploadManager(uint64_t capacity) : capacity {capacity}
+{
+    buffer.size = capacity;
+    Buffer::CreateBuffer(capacity,
+                         VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                         OUT buffer.buffer,
+                         OUT buffer.bufferMemory);
+
+    mappedData = static_cast<uint8_t*>(buffer.bufferMemory.mappedData);
+
+    commandBuffers = CommandBuffer(MAX_PENDING_BATCHES);
+    fences = Fence(MAX_PENDING_BATCHES);
+    batches.resize(MAX_PENDING_BATCHES);
+}
+
+UploadManager::UploadManager(UploadManager&& other) noexcept
+{
+    Swap(other);
+}
+
+UploadManager::~UploadManager()
+{
+    Free();
+}
+
+UploadManager& UploadManager::operator=(UploadManager&& other) noexcept
+{
+    Swap(other);
+    return *this;
+}
+
+UploadManager::Staging UploadManager::Stage(const void* data, uint64_t size)
+{
+    uint64_t offset = Reserve(size);
+
+    if (offset == INVALID_OFFSET)
+    {
+        uint32_t batch = BeginBatch();
+
+        Buffer::Buffer dedicatedBuffer;
+        dedicatedBuffer.size = size;
+        Buffer::CreateBuffer(size,
+                             VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                             VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                                 VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                             OUT dedicatedBuffer.buffer,
+                             OUT dedicatedBuffer.bufferMemory);
+        Buffer::CopyData(dedicatedBuffer, size, data);
+
+        batches[batch].dedicatedBuffers.push_back(dedicatedBuffer);
+        return {commandBuffers.Get(batch), dedicatedBuffer.buffer, 0};
+    }
+
+    memcpy(mappedData + offset, data, size);
+
+    uint32_t batch = BeginBatch();
+    return {commandBuffers.Get(batch), buffer.buffer, offset};
+}
+
+void UploadManager::Flush()
+{
+    while (pendingCount > 0 && RetireOldestBatch(false)) {}
+
+    if (!isRecording) return;
+
+    uint32_t batch = (oldestBatch + pendingCount) % MAX_PENDING_BATCHES;
+
+    commandBuffers.End();
+
+    fences.Reset(batch);
+    Utils::SubmitGraphicsCommand()
+        .ToQueue(Context::GetCurrentDevice()->GetGraphicsQueue())
+        .WithCommandBuffers({commandBuffers.Get(batch)})
+        .Submit(fences.Get(batch));
+
+    batches[batch].end = isStagingInRing ? head : INVALID_OFFSET;
+    pendingCount++;
+    isRecording = false;
+    isStagingInRing = false;
+}
+
+void UploadManager::WaitIdle()
+{
+    Flush();
+    while (pendingCount > 0) RetireOldestBatch(true);
+}
+
+void UploadManager::Free()
+{
+    if (buffer.buffer == nullptr) return;
+
+    WaitIdle();
+
+    Buffer::DestroyBuffer(buffer);
+    fences = Fence();
+    commandBuffers = CommandBuffer();
+    batches.clear();
+
+    buffer.size = 0;
+    mappedData = nullptr;
+    capacity = 0;
+}
+
+uint64_t UploadManager::Reserve(uint64_t size)
+{
+    if (size > capacity) return INVALID_OFFSET;
+
+    uint64_t offset = FindSpace(size);
+    while (offset == INVALID_OFFSET)
+    {
+        // The ring is full, so the space of the oldest upload has to be reclaimed. Anything still
+        // being recorded must be submitted first, or it would never finish
+        Flush();
+        RetireOldestBatch(true);
+        offset = FindSpace(size);
+    }
+
+    head = offset + size;
+    isRingEmpty = false;
+    isStagingInRing = true;
+    return offset;
+}
+
+uint64_t UploadManager::FindSpace(uint64_t size) const
+{
+    // With nothing in the ring, the whole of it is free. Batches may still be pending or recording
+    // with only dedicated buffers, so they don't say whether the ring is in use
+    if (isRingEmpty) return size <= capacity ? 0 : INVALID_OFFSET;
+
+    uint64_t offset = AlignUp(head);
+
+    // While the data in use doesn't wrap, there is space both after it and before it
+    if (tail < head)
+    {
+        if (offset + size <= capacity) return offset;
+        return size <= tail ? 0 : INVALID_OFFSET;
+    }
+
+    return offset + size <= tail ? offset : INVALID_OFFSET;
+}
+
+uint32_t UploadManager::BeginBatch()
+{
+    uint32_t batch = (oldestBatch + pendingCount) % MAX_PENDING_BATCHES;
+    if (isRecording) return batch;
+
+    if (pendingCount == MAX_PENDING_BATCHES)
+    {
+        RetireOldestBatch(true);
+        batch = (oldestBatch + pendingCount) % MAX_PENDING_BATCHES;
+    }
+
+    commandBuffers.Begin(static_cast<int32_t>(batch));
+    isRecording = true;
+    return batch;
+}
+
+bool UploadManager::RetireOldestBatch(bool wait)
+{
+    if (pendingCount == 0) return false;
+
+    if (wait) fences.Wait(oldestBatch);
+    else if (!fences.IsSignalled(oldestBatch)) return false;
+
+    Batch& batch = batches[oldestBatch];
+    for (auto& dedicatedBuffer : batch.dedicatedBuffers) Buffer::DestroyBuffer(dedicatedBuffer);
+    batch.dedicatedBuffers.clear();
+
+    oldestBatch = (oldestBatch + 1) % MAX_PENDING_BATCHES;
+    pendingCount--;
+
+    if (batch.end == INVALID_OFFSET) return true;
+    tail = batch.end;
+
+    // Data is only ever staged into free space, so the tail reaching the head means everything
+    // staged has been read, rather than the ring having filled up
+    if (tail == head)
+    {
+        head = tail = 0;
+        isRingEmpty = true;
+    }
+
+    return true;
+}
+
+void UploadManager::Swap(UploadManager& other)
+{
+    std::swap(buffer, other.buffer);
+    std::swap(mappedData, other.mappedData);
+    std::swap(capacity, other.capacity);
+    std::swap(head, other.head);
+    std::swap(tail, other.tail);
+    std::swap(isRingEmpty, other.isRingEmpty);
+    std::swap(commandBuffers, other.commandBuffers);
+    std::swap(fences, other.fences);
+    std::swap(batches, other.batches);
+    std::swap(oldestBatch, other.oldestBatch);
+    std::swap(pendingCount, other.pendingCount);
+    std::swap(isRecording, other.isRecording);
+    std::swap(isStagingInRing, other.isStagingInRing);
+}
+} // namespace Siege::Vulkan
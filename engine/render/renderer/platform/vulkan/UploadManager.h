@@ -0,0 +1,192 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#ifndef SIEGE_ENGINE_VULKAN_UPLOAD_MANAGER_H
+#define SIEGE_ENGINE_VULKAN_UPLOAD_MANAGER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "CommandBuffer.h"
+#include "Fence.h"
+#include "render/renderer/buffer/Buffer.h"
+
+namespace Siege::Vulkan
+{
+/**
+ * Stages data for the GPU through a persistent, host visible ring buffer. Copies out of the ring
+ * are recorded into a shared batch which is submitted once per frame, or sooner if the ring fills
+ * up, rather than waiting on the queue for every upload. Each batch has a fence, and the space a
+ * batch staged is only reused once its fence has been signalled
+ *
+ * @param buffer the ring's staging buffer
+ * @param mappedData the host address the staging buffer is mapped to
+ * @param capacity the size of the staging buffer in bytes
+ * @param head the offset the next upload is staged from
+ * @param tail the offset of the oldest data which may still be read by the GPU
+ * @param isRingEmpty whether nothing staged in the ring may still be read by the GPU, which tells
+ * an empty ring apart from a full one when the head meets the tail
+ * @param commandBuffers the command buffer of each batch
+ * @param fences the fence signalled when each batch has executed
+ * @param batches the state of each batch
+ * @param oldestBatch the index of the batch submitted longest ago
+ * @param pendingCount the number of batches submitted but not yet retired
+ * @param isRecording whether the open batch has commands recorded into it
+ * @param isStagingInRing whether the open batch has staged any data in the ring
+ */
+class UploadManager
+{
+public:
+
+    // The space in the staging ring unless a capacity is given
+    static constexpr uint64_t DEFAULT_CAPACITY = 32 * 1024 * 1024;
+
+    // The number of batches which can be submitted and unfinished at once
+    static constexpr uint32_t MAX_PENDING_BATCHES = 4;
+
+    // Satisfies the offset requirements of buffer to image copies for every supported format,
+    // including block compressed ones
+    static constexpr uint64_t STAGING_ALIGNMENT = 16;
+
+    /**
+     * Data copied into staging memory, ready to have copy commands recorded from it
+     * @param commandBuffer the command buffer of the open batch, which copies must be recorded to
+     * @param buffer the buffer holding the data
+     * @param offset the offset of the data within the buffer
+     */
+    struct Staging
+    {
+        VkCommandBuffer commandBuffer {nullptr};
+        VkBuffer buffer {nullptr};
+        uint64_t offset {0};
+    };
+
+    /**
+     * An empty default constructor for the UploadManager
+     */
+    UploadManager() = default;
+
+    /**
+     * Creates the staging ring and the command buffers and fences of each batch
+     * @param capacity the size of the staging ring in bytes
+     */
+    explicit UploadManager(uint64_t capacity);
+
+    /**
+     * A move constructor for the UploadManager
+     * @param other the UploadManager to be moved
+     */
+    UploadManager(UploadManager&& other) noexcept;
+
+    /**
+     * A destructor for the UploadManager
+     */
+    ~UploadManager();
+
+    /**
+     * A move assignment operator for the UploadManager
+     * @param other the UploadManager to be moved
+     * @return a reference to the current UploadManager
+     */
+    UploadManager& operator=(UploadManager&& other) noexcept;
+
+    /**
+     * Copies data into staging memory and opens a batch to record copies from it. If the ring is
+     * full, the open batch is submitted and the oldest batches are waited on to make room. Data
+     * larger than the whole ring is given a staging buffer of its own, released with its batch
+     * @param data the data to stage
+     * @param size the size of the data in bytes
+     * @return the staged data, along with the command buffer to record its copies to
+     */
+    Staging Stage(const void* data, uint64_t size);
+
+    /**
+     * Submits the open batch, if any commands have been recorded to it, and retires every batch
+     * which has finished executing. Does not wait on the GPU
+     */
+    void Flush();
+
+    /**
+     * Submits the open batch and waits for every batch to finish executing
+     */
+    void WaitIdle();
+
+    /**
+     * Waits for every batch to finish, then destroys the staging ring, fences and command buffers
+     */
+    void Free();
+
+private:
+
+    /**
+     * The resources of a single batch
+     * @param end the offset of the end of the data the batch staged in the ring, or UINT64_MAX if
+     * it only staged data in dedicated buffers
+     * @param dedicatedBuffers staging buffers created for data too large for the ring, released
+     * when the batch retires
+     */
+    struct Batch
+    {
+        uint64_t end {0};
+        std::vector<Buffer::Buffer> dedicatedBuffers;
+    };
+
+    /**
+     * Reserves space in the ring, submitting and waiting on batches until the space is free
+     * @param size the number of bytes to reserve
+     * @return the offset of the reserved space, or UINT64_MAX if the ring is too small
+     */
+    uint64_t Reserve(uint64_t size);
+
+    /**
+     * Finds free space in the ring without changing it
+     * @param size the number of bytes needed
+     * @return the offset of the free space, or UINT64_MAX if there isn't enough
+     */
+    uint64_t FindSpace(uint64_t size) const;
+
+    /**
+     * Starts recording the open batch if it isn't already, waiting on the oldest batch if every
+     * batch is still pending
+     * @return the index of the open batch
+     */
+    uint32_t BeginBatch();
+
+    /**
+     * Retires the oldest pending batch, releasing the ring space and buffers it used
+     * @param wait whether to wait for the batch to finish, rather than leaving it pending if it
+     * hasn't
+     * @return true if the batch was retired, false otherwise
+     */
+    bool RetireOldestBatch(bool wait);
+
+    /**
+     * Swaps the contents of two UploadManagers
+     * @param other the UploadManager to swap with
+     */
+    void Swap(UploadManager& other);
+
+    Buffer::Buffer buffer;
+    uint8_t* mappedData {nullptr};
+    uint64_t capacity {0};
+    uint64_t head {0};
+    uint64_t tail {0};
+    bool isRingEmpty {true};
+
+    CommandBuffer commandBuffers;
+    Fence fences;
+    std::vector<Batch> batches;
+    uint32_t oldestBatch {0};
+    uint32_t pendingCount {0};
+    bool isRecording {false};
+    bool isStagingInRing {false};
+};
+} // namespace Siege::Vulkan
+
+#endif // SIEGE_ENGINE_VULKAN_UPLOAD_MANAGER_H
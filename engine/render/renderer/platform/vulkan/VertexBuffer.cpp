@@ -38,11 +38,9 @@ VertexBuffer::VertexBuffer(void* data, unsigned long bufferSize) : VertexBuffer(
 
 void VertexBuffer::Copy(const void* data, unsigned long dSize, unsigned long offset)
 {
-    auto device = Context::GetVkLogicalDevice();
-
     void* dst = reinterpret_cast<char*>(rawBuffer) + offset;
     memcpy(dst, data, dSize);
-    Utils::CopyData(device, memory, dSize, dst, offset);
+    Utils::CopyData(memory, dSize, dst, offset);
 }
 
 VertexBuffer::VertexBuffer(VertexBuffer&& other)
@@ -71,11 +69,10 @@ void VertexBuffer::Free()
     if (device == nullptr) return;
 
     free(rawBuffer);
-    Utils::FreeBuffer(device, buffer, memory);
+    Utils::FreeBuffer(buffer, memory);
     size = 0;
     rawBuffer = nullptr;
     buffer = nullptr;
-    memory = nullptr;
 }
 
 VertexBuffer& VertexBuffer::operator=(const VertexBuffer& other)
@@ -119,10 +116,7 @@ void VertexBuffer::Allocate(VkDevice device)
 {
     rawBuffer = malloc(size);
 
-    auto physicalDevice = Context::GetPhysicalDevice()->GetDevice();
-
     Utils::CreateBuffer(device,
-                        physicalDevice,
                         size,
                         VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
@@ -13,6 +13,7 @@
 #include <cstdint>
 
 #include "CommandBuffer.h"
+#include "utils/MemoryAllocator.h"
 #include "utils/Types.h"
 
 namespace Siege::Vulkan
@@ -127,7 +128,7 @@ private:
 
     void* rawBuffer {nullptr};
     VkBuffer buffer {nullptr};
-    VkDeviceMemory memory {nullptr};
+    MemoryAllocation memory;
     unsigned long size {0};
 };
 
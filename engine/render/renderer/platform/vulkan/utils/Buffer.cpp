@@ -31,12 +31,11 @@ void CopyBuffer(VkCommandBuffer commandBuffer,
 }
 
 void CreateBuffer(VkDevice logicalDevice,
-                  VkPhysicalDevice physicalDevice,
                   VkDeviceSize size,
                   VkBufferUsageFlags usage,
                   VkMemoryPropertyFlags properties,
                   VkBuffer& buffer,
-                  VkDeviceMemory& bufferMemory)
+                  MemoryAllocation& bufferMemory)
 {
     VkBufferCreateInfo bufferInfo {};
     bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
@@ -50,36 +49,32 @@ void CreateBuffer(VkDevice logicalDevice,
     VkMemoryRequirements memRequirements;
     vkGetBufferMemoryRequirements(logicalDevice, buffer, &memRequirements);
 
-    VkMemoryAllocateInfo allocInfo {};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = Device::Physical::FindMemoryType(physicalDevice,
-                                                                 memRequirements.memoryTypeBits,
-                                                                 properties);
+    bufferMemory = Context::GetMemoryAllocator().Allocate(memRequirements,
+                                                          properties,
+                                                          MemoryAllocator::RESOURCE_BUFFER);
 
-    CC_ASSERT(
-        vkAllocateMemory(logicalDevice, &allocInfo, nullptr, OUT & bufferMemory) == VK_SUCCESS,
-        "failed to allocate vertex buffer memory!");
-
-    vkBindBufferMemory(logicalDevice, buffer, bufferMemory, 0);
+    vkBindBufferMemory(logicalDevice, buffer, bufferMemory.memory, bufferMemory.offset);
 };
 
-void CopyData(VkDevice device,
-              VkDeviceMemory& memory,
+void CopyData(const MemoryAllocation& memory,
               VkDeviceSize size,
               const void* bufferData,
               VkDeviceSize offset)
 {
-    void* data;
-    vkMapMemory(device, memory, offset, size, 0, &data);
-    memcpy(data, bufferData, size);
-    vkUnmapMemory(device, memory);
+    CC_ASSERT(memory.mappedData, "Cannot copy data into unmapped memory!")
+
+    memcpy(static_cast<uint8_t*>(memory.mappedData) + offset, bufferData, size);
 }
 
-void FreeBuffer(VkDevice device, VkBuffer buffer, VkDeviceMemory memory)
+void FreeBuffer(VkBuffer buffer, MemoryAllocation& memory)
 {
-    vkDestroyBuffer(device, buffer, nullptr);
-    vkFreeMemory(device, memory, nullptr);
+    // The buffer may still be read by frames in flight, so its destruction waits for them
+    Context::GetDeletionQueue().Push([buffer, memory](VkDevice device) mutable {
+        if (device != nullptr) vkDestroyBuffer(device, buffer, nullptr);
+        Context::GetMemoryAllocator().Free(memory);
+    });
+
+    memory = {};
 }
 
 } // namespace Siege::Vulkan::Utils
\ No newline at end of file
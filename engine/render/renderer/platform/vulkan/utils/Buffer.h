@@ -12,6 +12,8 @@
 
 #include <volk/volk.h>
 
+#include "MemoryAllocator.h"
+
 namespace Siege::Vulkan::Utils
 {
 
@@ -24,20 +26,18 @@ void CopyBuffer(VkCommandBuffer commandBuffer,
                 uint32_t regionCount = 1);
 
 void CreateBuffer(VkDevice logicalDevice,
-                  VkPhysicalDevice physicalDevice,
                   VkDeviceSize size,
                   VkBufferUsageFlags usage,
                   VkMemoryPropertyFlags properties,
                   VkBuffer& buffer,
-                  VkDeviceMemory& bufferMemory);
+                  MemoryAllocation& bufferMemory);
 
-void CopyData(VkDevice device,
-              VkDeviceMemory& memory,
+void CopyData(const MemoryAllocation& memory,
               VkDeviceSize size,
               const void* bufferData,
               VkDeviceSize offset);
 
-void FreeBuffer(VkDevice device, VkBuffer buffer, VkDeviceMemory memory);
+void FreeBuffer(VkBuffer buffer, MemoryAllocation& memory);
 
 } // namespace Siege::Vulkan::Utils
 
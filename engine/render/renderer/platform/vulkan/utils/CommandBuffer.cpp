@@ -47,6 +47,24 @@ MHArray<VkCommandBuffer> CommandBuffer::AllocateCommandBuffers(VkDevice device,
     return buffers;
 }
 
+MHArray<VkCommandBuffer> CommandBuffer::AllocateSecondaryCommandBuffers(VkDevice device,
+                                                                        VkCommandPool pool,
+                                                                        uint32_t count)
+{
+    MHArray<VkCommandBuffer> buffers(count);
+
+    VkCommandBufferAllocateInfo allocInfo {};
+    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+    allocInfo.commandPool = pool;
+    allocInfo.commandBufferCount = count;
+
+    CC_ASSERT(vkAllocateCommandBuffers(device, &allocInfo, OUT buffers.Data()) == VK_SUCCESS,
+              "Failed to allocate secondary command buffer!")
+
+    return buffers;
+}
+
 void CommandBuffer::BeginSingleTimeCommand(VkCommandBuffer buffer)
 {
     VkCommandBufferBeginInfo beginInfo {};
@@ -57,6 +75,26 @@ void CommandBuffer::BeginSingleTimeCommand(VkCommandBuffer buffer)
               "Failed to begin recording command buffer!")
 }
 
+void CommandBuffer::BeginSecondaryCommand(VkCommandBuffer buffer,
+                                          VkRenderPass renderPass,
+                                          VkFramebuffer framebuffer)
+{
+    VkCommandBufferInheritanceInfo inheritanceInfo {};
+    inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritanceInfo.renderPass = renderPass;
+    inheritanceInfo.subpass = 0;
+    inheritanceInfo.framebuffer = framebuffer;
+
+    VkCommandBufferBeginInfo beginInfo {};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT |
+                      VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+    CC_ASSERT(vkBeginCommandBuffer(OUT buffer, &beginInfo) == VK_SUCCESS,
+              "Failed to begin recording secondary command buffer!")
+}
+
 void CommandBuffer::EndCommandBuffer(VkCommandBuffer commandBuffer)
 {
     CC_ASSERT(commandBuffer != VK_NULL_HANDLE, "commandBuffer must be a valid value!")
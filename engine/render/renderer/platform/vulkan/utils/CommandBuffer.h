@@ -21,7 +21,13 @@ public:
 
     static VkCommandBuffer AllocateCommandBuffer(VkDevice device, VkCommandPool pool);
     static MHArray<VkCommandBuffer> AllocateCommandBuffers(VkDevice, VkCommandPool, uint32_t);
+    static MHArray<VkCommandBuffer> AllocateSecondaryCommandBuffers(VkDevice,
+                                                                    VkCommandPool,
+                                                                    uint32_t);
     static void BeginSingleTimeCommand(VkCommandBuffer buffer);
+    static void BeginSecondaryCommand(VkCommandBuffer buffer,
+                                      VkRenderPass renderPass,
+                                      VkFramebuffer framebuffer);
     static void EndCommandBuffer(VkCommandBuffer commandBuffer);
 };
 } // namespace Siege::Vulkan::Utils
@@ -174,14 +174,22 @@ public:
                 return *this;
             }
 
+            DeviceFeaturesBuilder& WithTextureCompressionBC(const VkBool32& compression)
+            {
+                textureCompressionBC = compression;
+                return *this;
+            }
+
             VkPhysicalDeviceFeatures Build()
             {
                 VkPhysicalDeviceFeatures features {};
                 features.samplerAnisotropy = samplerAnistropy;
+                features.textureCompressionBC = textureCompressionBC;
                 return features;
             }
 
             VkBool32 samplerAnistropy = VK_FALSE;
+            VkBool32 textureCompressionBC = VK_FALSE;
         };
 
         static VkFormatProperties GetProperties(VkPhysicalDevice device, VkFormat format);
@@ -155,24 +155,16 @@ VkImageViewCreateInfo Image::CreateImageViewCreateInfo(VkImage image,
             subResourceRange};
 }
 
-void Image::AllocateImageMemory(VkImage& image, VkDeviceMemory& memory)
+void Image::AllocateImageMemory(VkImage& image, MemoryAllocation& memory)
 {
     auto device = Context::GetVkLogicalDevice();
-    auto physicalDevice = Context::GetPhysicalDevice()->GetDevice();
 
     VkMemoryRequirements memRequirements;
     vkGetImageMemoryRequirements(device, image, OUT & memRequirements);
 
-    VkMemoryAllocateInfo allocInfo {
-        VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
-        nullptr,
-        memRequirements.size,
-        Device::Physical::FindMemoryType(physicalDevice,
-                                         memRequirements.memoryTypeBits,
-                                         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)};
-
-    CC_ASSERT(vkAllocateMemory(device, &allocInfo, nullptr, OUT & memory) == VK_SUCCESS,
-              "Failed to allocate image memory!")
+    memory = Context::GetMemoryAllocator().Allocate(memRequirements,
+                                                    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                                    MemoryAllocator::RESOURCE_IMAGE);
 }
 
 VkImage Image::CreateImage(VkImageType type,
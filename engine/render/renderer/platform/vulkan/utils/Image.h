@@ -12,6 +12,8 @@
 
 #include <volk/volk.h>
 
+#include "MemoryAllocator.h"
+
 namespace Siege::Vulkan::Utils
 {
 class Image
@@ -82,7 +84,7 @@ public:
         VkImageCreateFlags flags = 0,
         const void* pNext = nullptr);
 
-    static void AllocateImageMemory(VkImage& image, VkDeviceMemory& memory);
+    static void AllocateImageMemory(VkImage& image, MemoryAllocation& memory);
 
     static VkImage CreateImage(VkImageType type,
                                VkFormat format,
@@ -0,0 +1,258 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#include "MemoryAllocator.h"
+
+#include <utils/Logging.h>
+#include <volk/volk.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "../Context.h"
+#include "Device.h"
+
+namespace Siege::Vulkan
+{
+MemoryAllocator::MemoryAllocator(uint64_t blockSize) : blockSize {blockSize}
+{
+    VkPhysicalDeviceMemoryProperties memoryProperties;
+    vkGetPhysicalDeviceMemoryProperties(Context::GetPhysicalDevice()->GetDevice(),
+                                        OUT & memoryProperties);
+
+    memoryTypeFlags.resize(memoryProperties.memoryTypeCount);
+    for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++)
+    {
+        memoryTypeFlags[i] = memoryProperties.memoryTypes[i].propertyFlags;
+    }
+
+    pools.resize(memoryProperties.memoryTypeCount * RESOURCE_TYPE_COUNT);
+}
+
+MemoryAllocator::MemoryAllocator(MemoryAllocator&& other) noexcept
+{
+    Swap(other);
+}
+
+MemoryAllocator::~MemoryAllocator()
+{
+    Destroy();
+}
+
+MemoryAllocator& MemoryAllocator::operator=(MemoryAllocator&& other) noexcept
+{
+    Swap(other);
+    return *this;
+}
+
+MemoryAllocation MemoryAllocator::Allocate(const VkMemoryRequirements& requirements,
+                                           uint32_t properties,
+                                           ResourceType resourceType)
+{
+    uint32_t memoryType =
+        Device::Physical::FindMemoryType(Context::GetPhysicalDevice()->GetDevice(),
+                                         requirements.memoryTypeBits,
+                                         properties);
+    uint32_t poolIndex = memoryType * RESOURCE_TYPE_COUNT + resourceType;
+    Pool& pool = pools[poolIndex];
+
+    uint32_t blockIndex = OffsetAllocator::INVALID_NODE;
+    OffsetAllocator::Allocation range;
+
+    // Large resources would fragment a shared block badly, so they get a block of their own
+    if (requirements.size <= blockSize / 2)
+    {
+        for (uint32_t i = 0; i < pool.blocks.size(); i++)
+        {
+            Block& block = pool.blocks[i];
+            if (block.memory == nullptr) continue;
+
+            range = block.allocator.Allocate(requirements.size, requirements.alignment);
+            if (range.offset == OffsetAllocator::INVALID_OFFSET) continue;
+
+            blockIndex = i;
+            break;
+        }
+    }
+
+    if (blockIndex == OffsetAllocator::INVALID_NODE)
+    {
+        blockIndex = CreateBlock(poolIndex, std::max(requirements.size, blockSize));
+        range =
+            pool.blocks[blockIndex].allocator.Allocate(requirements.size, requirements.alignment);
+    }
+
+    CC_ASSERT(range.offset != OffsetAllocator::INVALID_OFFSET,
+              "Unable to fit an allocation into a new memory block!")
+
+    Block& block = pool.blocks[blockIndex];
+
+    MemoryAllocation allocation;
+    allocation.memory = block.memory;
+    allocation.offset = range.offset;
+    allocation.size = requirements.size;
+    allocation.mappedData = block.mappedData ? block.mappedData + range.offset : nullptr;
+    allocation.pool = poolIndex;
+    allocation.block = blockIndex;
+    allocation.range = range;
+    return allocation;
+}
+
+void MemoryAllocator::Free(MemoryAllocation& allocation)
+{
+    if (allocation.memory == nullptr || allocation.pool >= pools.size()) return;
+
+    Pool& pool = pools[allocation.pool];
+    Block& block = pool.blocks[allocation.block];
+
+    CC_ASSERT(block.memory == allocation.memory, "Freeing memory from a released block!")
+
+    block.allocator.Free(allocation.range);
+    allocation = {};
+
+    if (!block.allocator.IsEmpty()) return;
+
+    // Keeping a single empty block stops a resource being created and destroyed every frame from
+    // allocating device memory every frame
+    bool hasOtherEmptyBlock =
+        std::any_of(pool.blocks.begin(), pool.blocks.end(), [&block](const Block& other) {
+            return &other != &block && other.memory != nullptr && other.allocator.IsEmpty();
+        });
+
+    if (hasOtherEmptyBlock || block.allocator.Capacity() > blockSize) ReleaseBlock(block);
+}
+
+MemoryAllocator::Stats MemoryAllocator::GetStats(uint32_t memoryType) const
+{
+    Stats stats;
+    stats.memoryType = memoryType;
+
+    for (uint32_t resourceType = 0; resourceType < RESOURCE_TYPE_COUNT; resourceType++)
+    {
+        const Pool& pool = pools[memoryType * RESOURCE_TYPE_COUNT + resourceType];
+        for (const Block& block : pool.blocks)
+        {
+            if (block.memory == nullptr) continue;
+
+            OffsetAllocator::Stats blockStats = block.allocator.GetStats();
+
+            stats.blockCount++;
+            stats.bytesReserved += blockStats.capacity;
+            stats.bytesAllocated += blockStats.bytesAllocated;
+            stats.largestFreeRegion =
+                std::max(stats.largestFreeRegion, blockStats.largestFreeRegion);
+            stats.allocationCount += blockStats.allocationCount;
+            stats.freeRegionCount += blockStats.freeRegionCount;
+        }
+    }
+
+    return stats;
+}
+
+void MemoryAllocator::LogUsageReport() const
+{
+    for (uint32_t memoryType = 0; memoryType < memoryTypeFlags.size(); memoryType++)
+    {
+        Stats stats = GetStats(memoryType);
+        if (stats.blockCount == 0) continue;
+
+        CC_LOG_INFO("[MEMORY] Type {} (flags {}): {} blocks, {}/{} KB allocated in {} allocations, "
+                    "{} free regions, {}% fragmented",
+                    memoryType,
+                    memoryTypeFlags[memoryType],
+                    stats.blockCount,
+                    stats.bytesAllocated / 1024,
+                    stats.bytesReserved / 1024,
+                    stats.allocationCount,
+                    stats.freeRegionCount,
+                    static_cast<uint32_t>(stats.Fragmentation() * 100.f))
+    }
+}
+
+void MemoryAllocator::Destroy()
+{
+    for (Pool& pool : pools)
+    {
+        for (Block& block : pool.blocks)
+        {
+            if (block.memory == nullptr) continue;
+
+            if (!block.allocator.IsEmpty())
+            {
+                CC_LOG_WARNING("[MEMORY] Releasing a block with {} allocations still live",
+                               block.allocator.AllocationCount())
+            }
+
+            ReleaseBlock(block);
+        }
+    }
+
+    pools.clear();
+    memoryTypeFlags.clear();
+}
+
+uint32_t MemoryAllocator::CreateBlock(uint32_t pool, uint64_t size)
+{
+    VkDevice device = Context::GetVkLogicalDevice();
+    uint32_t memoryType = pool / RESOURCE_TYPE_COUNT;
+
+    Block block;
+    block.allocator = OffsetAllocator(size);
+
+    VkMemoryAllocateInfo allocInfo {};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = size;
+    allocInfo.memoryTypeIndex = memoryType;
+
+    CC_ASSERT(vkAllocateMemory(device, &allocInfo, nullptr, OUT & block.memory) == VK_SUCCESS,
+              "Failed to allocate a memory block!")
+
+    if (memoryTypeFlags[memoryType] & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+    {
+        void* data {nullptr};
+        CC_ASSERT(vkMapMemory(device, block.memory, 0, size, 0, OUT & data) == VK_SUCCESS,
+                  "Failed to map a memory block!")
+        block.mappedData = static_cast<uint8_t*>(data);
+    }
+
+    // Reuse the slot of a released block where possible, as allocations only refer to blocks by
+    // their index
+    std::vector<Block>& blocks = pools[pool].blocks;
+    for (uint32_t i = 0; i < blocks.size(); i++)
+    {
+        if (blocks[i].memory != nullptr) continue;
+
+        blocks[i] = std::move(block);
+        return i;
+    }
+
+    blocks.push_back(std::move(block));
+    return static_cast<uint32_t>(blocks.size() - 1);
+}
+
+void MemoryAllocator::ReleaseBlock(Block& block)
+{
+    // Device memory is released along with the device, so there may be nothing left to free
+    VkDevice device = Context::GetVkLogicalDevice();
+    if (device != nullptr)
+    {
+        if (block.mappedData) vkUnmapMemory(device, block.memory);
+        vkFreeMemory(device, block.memory, nullptr);
+    }
+
+    block = Block {};
+}
+
+void MemoryAllocator::Swap(MemoryAllocator& other)
+{
+    std::swap(pools, other.pools);
+    std::swap(memoryTypeFlags, other.memoryTypeFlags);
+    std::swap(blockSize, other.blockSize);
+}
+} // namespace Siege::Vulkan
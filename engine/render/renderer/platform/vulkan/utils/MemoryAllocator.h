@@ -0,0 +1,216 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#ifndef SIEGE_ENGINE_VULKAN_MEMORY_ALLOCATOR_H
+#define SIEGE_ENGINE_VULKAN_MEMORY_ALLOCATOR_H
+
+#include <utils/allocators/OffsetAllocator.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "Types.h"
+
+namespace Siege::Vulkan
+{
+/**
+ * A range of device memory handed out by the MemoryAllocator
+ * @param memory the block of device memory the range belongs to
+ * @param offset the offset of the range within the block, which resources must be bound at
+ * @param size the size of the range in bytes
+ * @param mappedData the host address of the range if its memory is host visible, otherwise null
+ * @param pool the pool the range was allocated from
+ * @param block the block within the pool the range was allocated from
+ * @param range the allocation tracking the range within its block
+ */
+struct MemoryAllocation
+{
+    VkDeviceMemory memory {nullptr};
+    uint64_t offset {0};
+    uint64_t size {0};
+    void* mappedData {nullptr};
+    uint32_t pool {0};
+    uint32_t block {0};
+    OffsetAllocator::Allocation range;
+};
+
+/**
+ * Sub-allocates resource memory from large blocks of device memory, so that each resource doesn't
+ * need a vkAllocateMemory call of its own. Blocks are pooled by memory type, with buffers and
+ * images kept in separate pools so that linear and optimal resources never share a page. Host
+ * visible blocks stay mapped for their whole lifetime, since memory can only be mapped once
+ *
+ * @param pools the pools of blocks, indexed by memory type and resource type
+ * @param memoryTypeFlags the property flags of each of the device's memory types
+ * @param blockSize the size of each block allocated for a pool
+ */
+class MemoryAllocator
+{
+public:
+
+    // The size of each block of device memory. Allocations larger than half a block are given a
+    // block of their own
+    static constexpr uint64_t DEFAULT_BLOCK_SIZE = 64 * 1024 * 1024;
+
+    enum ResourceType
+    {
+        RESOURCE_BUFFER = 0,
+        RESOURCE_IMAGE = 1,
+        RESOURCE_TYPE_COUNT = 2
+    };
+
+    /**
+     * Usage statistics for a single memory type, summed across its blocks
+     * @param memoryType the memory type the statistics describe
+     * @param blockCount the number of blocks allocated from the device
+     * @param bytesReserved the number of bytes allocated from the device
+     * @param bytesAllocated the number of bytes handed out to resources
+     * @param largestFreeRegion the size of the largest contiguous free region in any block
+     * @param allocationCount the number of live allocations
+     * @param freeRegionCount the number of contiguous free regions across all blocks
+     */
+    struct Stats
+    {
+        uint32_t memoryType {0};
+        uint32_t blockCount {0};
+        uint64_t bytesReserved {0};
+        uint64_t bytesAllocated {0};
+        uint64_t largestFreeRegion {0};
+        uint32_t allocationCount {0};
+        uint32_t freeRegionCount {0};
+
+        /**
+         * Returns how fragmented the free space is, as the fraction of it outside the largest free
+         * region. A high value with a lot of free space means new blocks are being allocated that
+         * a compacted heap would not need
+         * @return the fragmentation, from zero to one
+         */
+        float Fragmentation() const
+        {
+            uint64_t bytesFree = bytesReserved - bytesAllocated;
+            if (bytesFree == 0) return 0.f;
+            return 1.f - static_cast<float>(largestFreeRegion) / static_cast<float>(bytesFree);
+        }
+    };
+
+    /**
+     * An empty default constructor for the MemoryAllocator
+     */
+    MemoryAllocator() = default;
+
+    /**
+     * Creates an allocator for the current device. No device memory is allocated until the first
+     * allocation is made
+     * @param blockSize the size of each block of device memory
+     */
+    explicit MemoryAllocator(uint64_t blockSize);
+
+    /**
+     * A move constructor for the MemoryAllocator
+     * @param other the MemoryAllocator to be moved
+     */
+    MemoryAllocator(MemoryAllocator&& other) noexcept;
+
+    /**
+     * A destructor for the MemoryAllocator
+     */
+    ~MemoryAllocator();
+
+    /**
+     * A move assignment operator for the MemoryAllocator
+     * @param other the MemoryAllocator to be moved
+     * @return a reference to the current MemoryAllocator
+     */
+    MemoryAllocator& operator=(MemoryAllocator&& other) noexcept;
+
+    /**
+     * Allocates memory for a resource, allocating a new block from the device if none of the
+     * existing blocks can fit it
+     * @param requirements the memory requirements of the resource
+     * @param properties the memory properties the resource needs
+     * @param resourceType whether the memory will back a buffer or an image
+     * @return the allocated memory
+     */
+    MemoryAllocation Allocate(const VkMemoryRequirements& requirements,
+                              uint32_t properties,
+                              ResourceType resourceType);
+
+    /**
+     * Returns an allocation's memory to its block. Empty blocks are released to the device,
+     * except for one per pool which is kept to avoid reallocating it
+     * @param allocation the allocation to free, reset once freed. Empty allocations are ignored
+     */
+    void Free(MemoryAllocation& allocation);
+
+    /**
+     * Walks the blocks of a memory type to summarise their use. Runs in linear time, so is meant
+     * for reporting
+     * @param memoryType the memory type to summarise
+     * @return the memory type's statistics
+     */
+    Stats GetStats(uint32_t memoryType) const;
+
+    /**
+     * Logs the statistics of every memory type in use
+     */
+    void LogUsageReport() const;
+
+    /**
+     * Releases every block to the device, logging any allocations which were never freed
+     */
+    void Destroy();
+
+private:
+
+    /**
+     * A single allocation of device memory, split between resources by an OffsetAllocator
+     */
+    struct Block
+    {
+        VkDeviceMemory memory {nullptr};
+        uint8_t* mappedData {nullptr};
+        OffsetAllocator allocator;
+    };
+
+    /**
+     * The blocks of a single memory type and resource type. Released blocks leave an empty slot
+     * so that the indices held by allocations stay valid
+     */
+    struct Pool
+    {
+        std::vector<Block> blocks;
+    };
+
+    /**
+     * Allocates a new block from the device
+     * @param pool the index of the pool to add the block to
+     * @param size the size of the block in bytes
+     * @return the index of the block within the pool
+     */
+    uint32_t CreateBlock(uint32_t pool, uint64_t size);
+
+    /**
+     * Releases a block's memory to the device
+     * @param block the block to release
+     */
+    void ReleaseBlock(Block& block);
+
+    /**
+     * Swaps the contents of two MemoryAllocators
+     * @param other the MemoryAllocator to swap with
+     */
+    void Swap(MemoryAllocator& other);
+
+    std::vector<Pool> pools;
+    std::vector<uint32_t> memoryTypeFlags;
+    uint64_t blockSize {0};
+};
+} // namespace Siege::Vulkan
+
+#endif // SIEGE_ENGINE_VULKAN_MEMORY_ALLOCATOR_H
@@ -45,7 +45,8 @@ void BeginRenderPass(VkCommandBuffer commandBuffer,
                      VkClearValue* clearValues,
                      uint32_t clearValueCount,
                      VkFramebuffer framebuffer,
-                     VkRect2D renderArea)
+                     VkRect2D renderArea,
+                     VkSubpassContents contents)
 {
     VkRenderPassBeginInfo renderPassInfo {};
     renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
@@ -57,7 +58,7 @@ void BeginRenderPass(VkCommandBuffer commandBuffer,
     renderPassInfo.clearValueCount = clearValueCount;
     renderPassInfo.pClearValues = clearValues;
 
-    vkCmdBeginRenderPass(OUT commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+    vkCmdBeginRenderPass(OUT commandBuffer, &renderPassInfo, contents);
 }
 
 void EndRenderPass(VkCommandBuffer commandBuffer)
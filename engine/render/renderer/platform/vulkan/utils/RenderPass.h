@@ -77,7 +77,8 @@ void BeginRenderPass(VkCommandBuffer commandBuffer,
                      VkClearValue* clearValues,
                      uint32_t clearValueCount,
                      VkFramebuffer framebuffer,
-                     VkRect2D renderArea);
+                     VkRect2D renderArea,
+                     VkSubpassContents contents = VK_SUBPASS_CONTENTS_INLINE);
 void EndRenderPass(VkCommandBuffer commandBuffer);
 
 void Free(VkDevice device, VkRenderPass renderPass);
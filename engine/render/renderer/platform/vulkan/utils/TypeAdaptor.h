@@ -93,7 +93,26 @@ DECL_VULKAN_SWITCH_FUN(
                                                             SWITCH_MEM(ImageFormat,
                                                                        DEPTH24STENCIL8,
                                                                        VK_FORMAT_R32G32_SFLOAT)
-                                                                SWITCH_DEFAULT(VK_FORMAT_UNDEFINED))
+                                                                SWITCH_MEM(ImageFormat,
+                                                                           BC1SRGB,
+                                                                           VK_FORMAT_BC1_RGB_SRGB_BLOCK)
+                                                                    SWITCH_MEM(ImageFormat,
+                                                                               BC3SRGB,
+                                                                               VK_FORMAT_BC3_SRGB_BLOCK)
+                                                                        SWITCH_MEM(
+                                                                            ImageFormat,
+                                                                            BC4UN,
+                                                                            VK_FORMAT_BC4_UNORM_BLOCK)
+                                                                            SWITCH_MEM(
+                                                                                ImageFormat,
+                                                                                BC5UN,
+                                                                                VK_FORMAT_BC5_UNORM_BLOCK)
+                                                                                SWITCH_MEM(
+                                                                                    ImageFormat,
+                                                                                    BC7SRGB,
+                                                                                    VK_FORMAT_BC7_SRGB_BLOCK)
+                                                                                    SWITCH_DEFAULT(
+                                                                                        VK_FORMAT_UNDEFINED))
 
 DECL_VULKAN_SWITCH_FUN(
     ImageFormat,
@@ -121,14 +140,35 @@ DECL_VULKAN_SWITCH_FUN(
                                                     SWITCH_MEM(VkFormat,
                                                                VK_FORMAT_D24_UNORM_S8_UINT,
                                                                DEPTH24STENCIL8)
-                                                        SWITCH_DEFAULT(NONE))
+                                                        SWITCH_MEM(VkFormat,
+                                                                   VK_FORMAT_BC1_RGB_SRGB_BLOCK,
+                                                                   BC1SRGB)
+                                                            SWITCH_MEM(VkFormat,
+                                                                       VK_FORMAT_BC3_SRGB_BLOCK,
+                                                                       BC3SRGB)
+                                                                SWITCH_MEM(VkFormat,
+                                                                           VK_FORMAT_BC4_UNORM_BLOCK,
+                                                                           BC4UN)
+                                                                    SWITCH_MEM(VkFormat,
+                                                                               VK_FORMAT_BC5_UNORM_BLOCK,
+                                                                               BC5UN)
+                                                                        SWITCH_MEM(
+                                                                            VkFormat,
+                                                                            VK_FORMAT_BC7_SRGB_BLOCK,
+                                                                            BC7SRGB)
+                                                                            SWITCH_DEFAULT(NONE))
 
-DECL_VULKAN_SWITCH_FUN(VkDescriptorType,
-                       UniformType,
-                       SWITCH_MEM(UniformType, TEXTURE2D, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER)
-                           SWITCH_MEM(UniformType, STORAGE, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER)
-                               SWITCH_MEM(UniformType, UNIFORM, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER)
-                                   SWITCH_DEFAULT(VK_DESCRIPTOR_TYPE_MAX_ENUM))
+DECL_VULKAN_SWITCH_FUN(
+    VkDescriptorType,
+    UniformType,
+    SWITCH_MEM(UniformType, TEXTURE2D, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER)
+        SWITCH_MEM(UniformType, STORAGE, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER)
+            SWITCH_MEM(UniformType, UNIFORM, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER)
+                SWITCH_MEM(UniformType, STORAGE_DYNAMIC, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC)
+                    SWITCH_MEM(UniformType,
+                               UNIFORM_DYNAMIC,
+                               VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC)
+                        SWITCH_DEFAULT(VK_DESCRIPTOR_TYPE_MAX_ENUM))
 
 DECL_VULKAN_SWITCH_FUN(
     UniformType,
@@ -136,7 +176,13 @@ DECL_VULKAN_SWITCH_FUN(
     SWITCH_MEM(VkDescriptorType, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, TEXTURE2D)
         SWITCH_MEM(VkDescriptorType, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, STORAGE)
             SWITCH_MEM(VkDescriptorType, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, UNIFORM)
-                SWITCH_DEFAULT(UNKNOWN))
+                SWITCH_MEM(VkDescriptorType,
+                           VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC,
+                           STORAGE_DYNAMIC)
+                    SWITCH_MEM(VkDescriptorType,
+                               VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+                               UNIFORM_DYNAMIC)
+                        SWITCH_DEFAULT(UNKNOWN))
 
 DECL_VULKAN_SWITCH_FUN(VkShaderStageFlagBits,
                        ShaderType,
@@ -157,7 +203,18 @@ DECL_VULKAN_SWITCH_FUN(
         SWITCH_MEM(VertexAttributeType, VERTEX_UINT_32, VK_FORMAT_R32_UINT)
             SWITCH_MEM(VertexAttributeType, VERTEX_FLOAT_VEC3, VK_FORMAT_R32G32B32_SFLOAT)
                 SWITCH_MEM(VertexAttributeType, VERTEX_FLOAT_VEC4, VK_FORMAT_R32G32B32A32_SFLOAT)
-                    SWITCH_DEFAULT(VK_FORMAT_UNDEFINED))
+                    SWITCH_MEM(VertexAttributeType, VERTEX_UNORM8_VEC4, VK_FORMAT_R8G8B8A8_UNORM)
+                        SWITCH_MEM(VertexAttributeType, VERTEX_UINT8_VEC4, VK_FORMAT_R8G8B8A8_UINT)
+                            SWITCH_MEM(VertexAttributeType,
+                                       VERTEX_SNORM16_VEC2,
+                                       VK_FORMAT_R16G16_SNORM)
+                                SWITCH_MEM(VertexAttributeType,
+                                           VERTEX_HALF_VEC2,
+                                           VK_FORMAT_R16G16_SFLOAT)
+                                    SWITCH_MEM(VertexAttributeType,
+                                               VERTEX_UNORM16_VEC4,
+                                               VK_FORMAT_R16G16B16A16_UNORM)
+                                        SWITCH_DEFAULT(VK_FORMAT_UNDEFINED))
 
 DECL_VULKAN_SWITCH_FUN(VertexAttributeType,
                        VkFormat,
@@ -166,7 +223,23 @@ DECL_VULKAN_SWITCH_FUN(VertexAttributeType,
                                SWITCH_MEM(VkFormat, VK_FORMAT_R32G32B32_SFLOAT, VERTEX_FLOAT_VEC3)
                                    SWITCH_MEM(VkFormat,
                                               VK_FORMAT_R32G32B32A32_SFLOAT,
-                                              VERTEX_FLOAT_VEC4) SWITCH_DEFAULT(VERTEX_UNDEFINED))
+                                              VERTEX_FLOAT_VEC4)
+                                       SWITCH_MEM(VkFormat,
+                                                  VK_FORMAT_R8G8B8A8_UNORM,
+                                                  VERTEX_UNORM8_VEC4)
+                                           SWITCH_MEM(VkFormat,
+                                                      VK_FORMAT_R8G8B8A8_UINT,
+                                                      VERTEX_UINT8_VEC4)
+                                               SWITCH_MEM(VkFormat,
+                                                          VK_FORMAT_R16G16_SNORM,
+                                                          VERTEX_SNORM16_VEC2)
+                                                   SWITCH_MEM(VkFormat,
+                                                              VK_FORMAT_R16G16_SFLOAT,
+                                                              VERTEX_HALF_VEC2)
+                                                       SWITCH_MEM(VkFormat,
+                                                                  VK_FORMAT_R16G16B16A16_UNORM,
+                                                                  VERTEX_UNORM16_VEC4)
+                                                           SWITCH_DEFAULT(VERTEX_UNDEFINED))
 
 DECL_VULKAN_SWITCH_FUN(
     PipelineTopology,
@@ -355,6 +428,11 @@ DECL_VULKAN_SWITCH_FUN(VertexInputRate,
                                   VK_VERTEX_INPUT_RATE_INSTANCE,
                                   INPUT_RATE_INSTANCE) SWITCH_DEFAULT(INPUT_RATE_VERTEX))
 
+DECL_VULKAN_SWITCH_FUN(VkIndexType,
+                       IndexType,
+                       SWITCH_MEM(IndexType, INDEX_UINT16, VK_INDEX_TYPE_UINT16)
+                           SWITCH_DEFAULT(VK_INDEX_TYPE_UINT32))
+
 DECL_VULKAN_SWITCH_FUN(VkFilter,
                        TextureFilter,
                        SWITCH_MEM(TextureFilter, TEXTURE_FILTER_NEAREST, VK_FILTER_NEAREST)
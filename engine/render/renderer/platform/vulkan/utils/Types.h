@@ -35,6 +35,7 @@ struct VkFence_T;
 struct VkShaderModule_T;
 struct VkPipelineLayout_T;
 struct VkPipeline_T;
+struct VkPipelineCache_T;
 struct VkSampler_T;
 struct VkDescriptorPool_T;
 struct VkRenderPass_T;
@@ -42,6 +43,7 @@ struct VkFramebuffer_T;
 struct VkDescriptorSet_T;
 struct VkDescriptorSetLayout_T;
 struct VkWriteDescriptorSet;
+struct VkMemoryRequirements;
 
 typedef VkInstance_T* VkInstance;
 typedef VkSurfaceKHR_T* Surface;
@@ -62,8 +64,10 @@ typedef VkFence_T* VkFence;
 typedef VkShaderModule_T* VkShaderModule;
 typedef VkPipelineLayout_T* VkPipelineLayout;
 typedef VkPipeline_T* VkPipeline;
+typedef VkPipelineCache_T* VkPipelineCache;
 typedef VkSampler_T* VkSampler;
 typedef VkFramebuffer_T* VkFramebuffer;
+typedef VkRenderPass_T* VkRenderPass;
 typedef VkDescriptorSet_T* VkDescriptorSet;
 typedef VkDescriptorSetLayout_T* VkDescriptorSetLayout;
 
@@ -100,6 +104,11 @@ enum ImageFormat
     RG32F = 103,
     RGBA32F = 109,
     B10R11G11UF = 122,
+    BC1SRGB = 132,
+    BC3SRGB = 138,
+    BC4UN = 139,
+    BC5UN = 141,
+    BC7SRGB = 146,
     DEPTH32FSTENCIL8UINT = 130,
     DEPTH32F = 126,
     DEPTH24STENCIL8,
@@ -151,6 +160,11 @@ enum ShaderType
 enum VertexAttributeType
 {
     VERTEX_UNDEFINED = 0,
+    VERTEX_UNORM8_VEC4 = 37,
+    VERTEX_UINT8_VEC4 = 41,
+    VERTEX_SNORM16_VEC2 = 78,
+    VERTEX_HALF_VEC2 = 83,
+    VERTEX_UNORM16_VEC4 = 91,
     VERTEX_UINT_32 = 98,
     VERTEX_FLOAT_VEC2 = 103,
     VERTEX_FLOAT_VEC3 = 106,
@@ -219,6 +233,12 @@ enum VertexInputRate
     INPUT_RATE_INSTANCE = 1
 };
 
+enum IndexType
+{
+    INDEX_UINT16 = 0,
+    INDEX_UINT32 = 1
+};
+
 enum MemoryProperty
 {
     MEMORY_DEVICE_LOCAL = 0x00000001,
@@ -12,6 +12,7 @@
 #include <utils/math/vec/Vec2.h>
 
 #include <cstdint>
+#include <limits>
 
 #include "render/renderer/platform/vulkan/Swapchain.h"
 #include "render/renderer/platform/vulkan/utils/Draw.h"
@@ -58,7 +59,8 @@ void BillboardRenderer::Initialise(const String& globalDataAttributeName)
             Vulkan::VertexBuffer(sizeof(BillboardVertex) * VERTEX_BUFFER_SIZE);
     }
 
-    vertices = MHArray<MHArray<BillboardVertex>>(MAX_TEXTURES);
+    vertices = MHArray<BillboardVertex>(VERTEX_BUFFER_SIZE);
+    textureIndices = MHArray<uint32_t>(VERTEX_BUFFER_SIZE);
 
     indexBuffer = Vulkan::IndexBuffer(sizeof(uint32_t) * 6);
     indexBuffer.Copy(fontIndices, sizeof(uint32_t) * 6);
@@ -86,47 +88,91 @@ void BillboardRenderer::DrawBillboard(const Vec3& position,
 
     auto texIndex = billboardMaterial.SetTexture(textureId, *targetTexture);
 
-    if (texIndex >= vertices.Count())
-        vertices.Append(MHArray<BillboardVertex>(MAX_QUADS_PER_TEXTURE));
-
-    auto& textureQuads = vertices[texIndex];
-
-    textureQuads.Append({position, scale, ToFColour(colour), {0.f, 0.f, 1.f, 1.f}});
+    vertices.Append({position, scale, ToFColour(colour), {0.f, 0.f, 1.f, 1.f}});
+    textureIndices.Append(texIndex);
 }
 
-void BillboardRenderer::Render(Vulkan::CommandBuffer& buffer,
+void BillboardRenderer::Submit(DrawList& drawList,
                                const uint64_t& globalDataSize,
                                const void* globalData,
+                               const Camera& camera,
+                               const Frustum& frustum,
                                uint32_t currentFrame)
 {
-    billboardMaterial.SetUniformData(globalDataId, globalDataSize, globalData);
-
-    auto& vBuffer = perFrameVertexBuffers[currentFrame];
+    if (vertices.Count() == 0) return;
 
+    // Billboards always face the camera, so are bounded by the circle around their corners
+    bounds.resize(vertices.Count());
     for (uint32_t i = 0; i < vertices.Count(); i++)
     {
-        billboardMaterial.BindPushConstant(buffer, &i);
+        const BillboardVertex& vertex = vertices[i];
+        float radius = Vec3::Length({vertex.scale.x, vertex.scale.y, 0.f}) * 0.5f;
+        bounds[i] = {vertex.position, radius};
+    }
+
+    visibility.resize(vertices.Count());
+    size_t visibleCount = CullSpheres(frustum, bounds.data(), bounds.size(), visibility.data());
+    drawList.AddCullingResults(visibleCount, vertices.Count() - visibleCount);
+    if (visibleCount == 0) return;
 
-        billboardMaterial.Bind(buffer);
+    billboardMaterial.SetUniformData(globalDataId, globalDataSize, globalData);
 
-        uint64_t quadOffset = (i * MAX_QUADS_PER_TEXTURE);
+    perFrameVertexBuffers[currentFrame].Copy(vertices.Data(),
+                                             sizeof(BillboardVertex) * vertices.Count());
 
-        vBuffer.Copy(vertices[i].Data(),
-                     sizeof(BillboardVertex) * vertices[i].Count(),
-                     sizeof(BillboardVertex) * quadOffset);
+    // Billboards have no mesh, so their texture takes its place in the sort key
+    auto materialId = drawList.GetMaterialId(&billboardMaterial);
+    for (uint32_t i = 0; i < vertices.Count(); i++)
+    {
+        if (!visibility[i]) continue;
+
+        float depth = Vec3::Length((camera.view * Vec4(vertices[i].position, 1.f)).XYZ());
+        uint64_t key = DrawList::MakeTranslucentKey(DrawList::PASS_WORLD,
+                                                    materialId,
+                                                    textureIndices[i],
+                                                    depth);
+        drawList.Add(key, DrawList::SOURCE_BILLBOARD, i);
+    }
+}
 
-        uint64_t bindOffset = sizeof(BillboardVertex) * quadOffset;
+void BillboardRenderer::Record(Vulkan::CommandBuffer& buffer,
+                               Span<const DrawList::Item> items,
+                               uint32_t currentFrame)
+{
+    billboardMaterial.Bind(buffer);
 
-        vBuffer.Bind(buffer, &bindOffset);
-        indexBuffer.Bind(buffer);
+    uint64_t bindOffset = 0;
+    perFrameVertexBuffers[currentFrame].Bind(buffer, &bindOffset);
+    indexBuffer.Bind(buffer);
 
-        Vulkan::Utils::DrawIndexed(buffer.Get(), 6, vertices[i].Count(), 0, 0, 0);
+    uint32_t boundTexture = std::numeric_limits<uint32_t>::max();
+    for (size_t i = 0; i < items.Size();)
+    {
+        uint32_t first = items[i].index;
+        uint32_t texture = textureIndices[first];
+
+        uint32_t count = 1;
+        while (i + count < items.Size() && items[i + count].index == first + count &&
+               textureIndices[first + count] == texture)
+        {
+            count++;
+        }
+
+        if (texture != boundTexture)
+        {
+            billboardMaterial.BindPushConstant(buffer, &texture);
+            boundTexture = texture;
+        }
+
+        Vulkan::Utils::DrawIndexed(buffer.Get(), 6, count, 0, 0, first);
+        i += count;
     }
 }
 
 void BillboardRenderer::Flush()
 {
-    for (size_t i = 0; i < vertices.Count(); i++) vertices[i].Clear();
+    vertices.Clear();
+    textureIndices.Clear();
 }
 
 void BillboardRenderer::Update()
@@ -12,10 +12,15 @@
 
 #include <utils/Colour.h>
 #include <utils/String.h>
+#include <utils/math/Frustum.h>
 #include <utils/math/vec/Vec2.h>
 #include <utils/math/vec/Vec3.h>
 #include <utils/math/vec/Vec4.h>
 
+#include <vector>
+
+#include "DrawList.h"
+#include "render/renderer/camera/Camera.h"
 #include "render/renderer/platform/vulkan/IndexBuffer.h"
 #include "render/renderer/platform/vulkan/Material.h"
 #include "render/renderer/platform/vulkan/VertexBuffer.h"
@@ -37,9 +42,31 @@ public:
                        const IColour& colour,
                        Vulkan::Texture2D* texture = nullptr);
 
-    void Render(Vulkan::CommandBuffer& commandBuffer,
+    /**
+     * Uploads the frame's billboards and adds a translucent draw to the list for each of them
+     * @param drawList the frame's draw list
+     * @param globalDataSize the size of the global data in bytes
+     * @param globalData the global data used by the billboard material
+     * @param camera the camera the frame is drawn from
+     * @param frustum the camera's frustum, in world space
+     * @param currentFrame the index of the frame being drawn
+     */
+    void Submit(DrawList& drawList,
                 const uint64_t& globalDataSize,
                 const void* globalData,
+                const Camera& camera,
+                const Frustum& frustum,
+                uint32_t currentFrame);
+
+    /**
+     * Records a run of this renderer's draws from the sorted draw list. Consecutive billboards
+     * sharing a texture are drawn as a single instanced draw
+     * @param commandBuffer the command buffer to record into
+     * @param items the draws to record, in order
+     * @param currentFrame the index of the frame being drawn
+     */
+    void Record(Vulkan::CommandBuffer& commandBuffer,
+                Span<const DrawList::Item> items,
                 uint32_t currentFrame);
 
     void Flush();
@@ -67,7 +94,14 @@ private:
     Hash::StringId globalDataId;
     Hash::StringId textureId;
 
-    MHArray<MHArray<BillboardVertex>> vertices;
+    // The frame's billboards in submission order, along with the texture index each one samples
+    MHArray<BillboardVertex> vertices;
+    MHArray<uint32_t> textureIndices;
+
+    // The bounding sphere of each of the frame's billboards, and whether it passed culling
+    std::vector<Vec4> bounds;
+    std::vector<uint8_t> visibility;
+
     MHArray<Vulkan::VertexBuffer> perFrameVertexBuffers;
     Vulkan::IndexBuffer indexBuffer;
     Vulkan::Texture2D defaultTexture;
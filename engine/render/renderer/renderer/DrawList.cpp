@@ -0,0 +1,119 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#include "DrawList.h"
+
+#include <utils/RadixSort.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace Siege
+{
+static constexpr uint64_t DEPTH_MASK = 0xFFFFFF;
+static constexpr uint32_t PASS_SHIFT = 62;
+static constexpr uint32_t TRANSLUCENT_SHIFT = 61;
+
+// The bits of a non-negative float increase with its value, so dropping the sign bit and the
+// lowest mantissa bits quantises depth to 24 bits without needing the camera's depth range
+static uint64_t QuantiseDepth(float depth)
+{
+    depth = std::max(depth, 0.f);
+    uint32_t bits;
+    memcpy(&bits, &depth, sizeof(bits));
+    return (bits >> 7) & DEPTH_MASK;
+}
+
+uint64_t DrawList::MakeOpaqueKey(Pass pass, uint16_t material, uint16_t mesh, float depth)
+{
+    return static_cast<uint64_t>(pass) << PASS_SHIFT | static_cast<uint64_t>(material) << 45 |
+           static_cast<uint64_t>(mesh) << 29 | QuantiseDepth(depth) << 5;
+}
+
+uint64_t DrawList::MakeTranslucentKey(Pass pass, uint16_t material, uint16_t mesh, float depth)
+{
+    uint64_t invertedDepth = ~QuantiseDepth(depth) & DEPTH_MASK;
+    return static_cast<uint64_t>(pass) << PASS_SHIFT | 1ull << TRANSLUCENT_SHIFT |
+           invertedDepth << 37 | static_cast<uint64_t>(material) << 21 |
+           static_cast<uint64_t>(mesh) << 5;
+}
+
+bool DrawList::IsTranslucent(uint64_t key)
+{
+    return (key >> TRANSLUCENT_SHIFT) & 1;
+}
+
+uint16_t DrawList::GetId(std::unordered_map<const void*, uint16_t>& ids, const void* object)
+{
+    auto it = ids.find(object);
+    if (it != ids.end()) return it->second;
+
+    auto id = static_cast<uint16_t>(ids.size());
+    ids.emplace(object, id);
+    return id;
+}
+
+uint16_t DrawList::GetMaterialId(const void* material)
+{
+    return GetId(materialIds, material);
+}
+
+uint16_t DrawList::GetMeshId(const void* mesh)
+{
+    return GetId(meshIds, mesh);
+}
+
+void DrawList::Add(uint64_t key, Source source, uint32_t index)
+{
+    items.push_back({key, static_cast<uint32_t>(source), index});
+}
+
+void DrawList::AddCullingResults(size_t visible, size_t culled)
+{
+    cullingStats.visible += static_cast<uint32_t>(visible);
+    cullingStats.culled += static_cast<uint32_t>(culled);
+}
+
+const DrawList::CullingStats& DrawList::GetCullingStats() const
+{
+    return cullingStats;
+}
+
+void DrawList::Sort()
+{
+    RadixSort(items, scratch, [](const Item& item) { return item.key; });
+}
+
+void DrawList::Clear()
+{
+    items.clear();
+    materialIds.clear();
+    meshIds.clear();
+    cullingStats = {};
+}
+
+size_t DrawList::GetFirstTranslucentItem() const
+{
+    auto it = std::find_if(items.begin(), items.end(), [](const Item& item) {
+        return IsTranslucent(item.key);
+    });
+    return it - items.begin();
+}
+
+Span<const DrawList::Item> DrawList::GetOpaqueItems() const
+{
+    return {items.data(), GetFirstTranslucentItem()};
+}
+
+Span<const DrawList::Item> DrawList::GetTranslucentItems() const
+{
+    size_t first = GetFirstTranslucentItem();
+    return {items.data() + first, items.size() - first};
+}
+} // namespace Siege
@@ -0,0 +1,169 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#ifndef SIEGE_ENGINE_DRAW_LIST_H
+#define SIEGE_ENGINE_DRAW_LIST_H
+
+#include <utils/collections/Span.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Siege
+{
+/**
+ * A list of the draws submitted by the 3D sub-renderers in a frame. Each draw carries a 64-bit key
+ * packing its pass, translucency, material, mesh and quantised depth, so that sorting the list by
+ * key orders draws to minimise state changes, with translucent draws after opaque ones and
+ * ordered back to front. From the most significant bit, keys are laid out as:
+ *
+ *  - Opaque: pass (2), translucent (1), material (16), mesh (16), depth (24), unused (5)
+ *  - Translucent: pass (2), translucent (1), inverted depth (24), material (16), mesh (16),
+ *    unused (5)
+ */
+class DrawList
+{
+public:
+
+    // The passes draws can be recorded in. Reserved for passes such as shadows and overlays, which
+    // the 3D renderer doesn't have yet
+    enum Pass
+    {
+        PASS_WORLD = 0
+    };
+
+    // The sub-renderers which submit draws, used to hand each draw back to its renderer to record
+    enum Source
+    {
+        SOURCE_MODEL = 0,
+        SOURCE_BILLBOARD = 1,
+        SOURCE_QUAD = 2
+    };
+
+    /**
+     * A single submitted draw
+     * @param key the packed sort key of the draw
+     * @param source the sub-renderer which submitted the draw
+     * @param index the draw's index within its sub-renderer
+     */
+    struct Item
+    {
+        uint64_t key {0};
+        uint32_t source {0};
+        uint32_t index {0};
+    };
+
+    /**
+     * The number of submitted objects which passed and failed frustum culling in a frame
+     */
+    struct CullingStats
+    {
+        uint32_t visible {0};
+        uint32_t culled {0};
+    };
+
+    /**
+     * Packs the sort key of an opaque draw, which groups draws by material then mesh, and orders
+     * draws sharing both front to back
+     * @param pass the pass the draw is recorded in
+     * @param material the frame-local ID of the draw's material
+     * @param mesh the frame-local ID of the draw's mesh
+     * @param depth the distance from the camera to the draw
+     * @return the packed sort key
+     */
+    static uint64_t MakeOpaqueKey(Pass pass, uint16_t material, uint16_t mesh, float depth);
+
+    /**
+     * Packs the sort key of a translucent draw, which orders draws back to front, grouping only
+     * draws at the same quantised depth by material and mesh
+     * @param pass the pass the draw is recorded in
+     * @param material the frame-local ID of the draw's material
+     * @param mesh the frame-local ID of the draw's mesh
+     * @param depth the distance from the camera to the draw
+     * @return the packed sort key
+     */
+    static uint64_t MakeTranslucentKey(Pass pass, uint16_t material, uint16_t mesh, float depth);
+
+    /**
+     * Checks whether a key belongs to a translucent draw
+     * @param key the packed sort key
+     * @return true if the draw is translucent, false if it is opaque
+     */
+    static bool IsTranslucent(uint64_t key);
+
+    /**
+     * Gets a small ID for a material or mesh, unique within the frame. IDs are handed out in the
+     * order objects are first seen and wrap after 65536 objects, which only costs state changes
+     * @param object the material or mesh to identify
+     * @return the object's ID
+     */
+    uint16_t GetMaterialId(const void* material);
+    uint16_t GetMeshId(const void* mesh);
+
+    /**
+     * Adds a draw to the list
+     * @param key the packed sort key of the draw
+     * @param source the sub-renderer submitting the draw
+     * @param index the draw's index within its sub-renderer
+     */
+    void Add(uint64_t key, Source source, uint32_t index);
+
+    /**
+     * Adds the results of a sub-renderer's culling pass to the frame's counters
+     * @param visible the number of objects which may be visible
+     * @param culled the number of objects found to be outside the frustum
+     */
+    void AddCullingResults(size_t visible, size_t culled);
+
+    /**
+     * Returns the culling counters of every sub-renderer which submitted to the list this frame
+     * @return the culling counters
+     */
+    const CullingStats& GetCullingStats() const;
+
+    /**
+     * Sorts the draws by key. Draws with equal keys keep their submission order
+     */
+    void Sort();
+
+    /**
+     * Clears the list, the IDs handed out and the culling counters for the frame
+     */
+    void Clear();
+
+    /**
+     * Returns the opaque draws, which come first once the list is sorted
+     * @return a span over the opaque draws
+     */
+    Span<const Item> GetOpaqueItems() const;
+
+    /**
+     * Returns the translucent draws, which come last once the list is sorted
+     * @return a span over the translucent draws
+     */
+    Span<const Item> GetTranslucentItems() const;
+
+private:
+
+    static uint16_t GetId(std::unordered_map<const void*, uint16_t>& ids, const void* object);
+
+    size_t GetFirstTranslucentItem() const;
+
+    std::vector<Item> items;
+    std::vector<Item> scratch;
+
+    std::unordered_map<const void*, uint16_t> materialIds;
+    std::unordered_map<const void*, uint16_t> meshIds;
+
+    CullingStats cullingStats;
+};
+} // namespace Siege
+
+#endif // SIEGE_ENGINE_DRAW_LIST_H
@@ -10,8 +10,15 @@
 #include "ModelRenderer.h"
 
 #include <resources/StaticMeshData.h>
+#include <utils/RadixSort.h>
 #include <utils/math/Transform.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "render/renderer/platform/vulkan/Context.h"
 #include "render/renderer/platform/vulkan/utils/Draw.h"
 
 namespace Siege
@@ -30,47 +37,200 @@ void ModelRenderer::DrawMesh(Vulkan::StaticMesh* mesh,
                              const Vec3& scale,
                              const Vec3& rotation)
 {
-    staticMeshes.Append(mesh);
-    transforms.Append({Transform3D(position, rotation, scale), Normal(rotation, scale)});
+    Mat4 transform = Transform3D(position, rotation, scale);
+    float maxScale = std::max({std::abs(scale.x), std::abs(scale.y), std::abs(scale.z)});
+
+    staticMeshes.push_back(mesh);
+    // Quantised meshes need their bounds applied to positions but not to normals
+    transforms.push_back({transform * mesh->GetDequantisation(), Normal(rotation, scale)});
+    bounds.push_back({(transform * Vec4(mesh->GetBoundsCentre(), 1.f)).XYZ(),
+                      mesh->GetBoundsRadius() * maxScale});
+
+    // Each world axis of the transformed box spans the sum of its rotated model axes' extents
+    const BoundedBox& box = mesh->GetBoundingBox();
+    Vec3 centre = (transform * Vec4((box.min + box.max) * 0.5f, 1.f)).XYZ();
+    Vec3 extent = (box.max - box.min) * 0.5f;
+    Vec3 worldExtent;
+    for (unsigned int axis = 0; axis < 3; axis++)
+    {
+        worldExtent[axis] = std::abs(transform[0][axis]) * extent.x +
+                            std::abs(transform[1][axis]) * extent.y +
+                            std::abs(transform[2][axis]) * extent.z;
+    }
+    boxes.push_back({centre - worldExtent, centre + worldExtent});
 }
 
-void ModelRenderer::Render(Vulkan::CommandBuffer& buffer,
-                           const uint64_t& globalDataSize,
-                           const void* globalData)
+uint32_t ModelRenderer::SelectLod(const Vulkan::StaticMesh* mesh,
+                                  const Vec4& bounds,
+                                  const Camera& camera,
+                                  size_t occurrence)
 {
-    Vulkan::Material* mat = nullptr;
+    Span<const MeshLod> lods = mesh->GetLods();
+    if (lods.Empty()) return 0;
+
+    // The projected radius of the bounding sphere as a fraction of half the screen height
+    float distance = Vec3::Length((camera.view * Vec4(bounds.XYZ(), 1.f)).XYZ());
+    float screenSize = std::numeric_limits<float>::max();
+    if (distance > bounds.w) screenSize = bounds.w * std::abs(camera.projection[1][1]) / distance;
+
+    // Looked up without inserting, as a mesh that wasn't drawn last frame has nothing to carry over
+    uint32_t previousLod = 0;
+    auto it = previousLods.find(mesh);
+    if (it != previousLods.end() && occurrence < it->second.size())
+    {
+        previousLod = it->second[occurrence];
+    }
+    return SelectMeshLod(lods, screenSize, previousLod, LOD_ERROR_THRESHOLD, LOD_HYSTERESIS);
+}
 
-    for (size_t i = 0; i < staticMeshes.Count(); i++)
+void ModelRenderer::BuildBatches(const Camera& camera, const Frustum& frustum, DrawList& drawList)
+{
+    // Spheres are cheap to test in bulk, so only the draws they keep are tested against boxes
+    visibility.resize(staticMeshes.size());
+    CullSpheres(frustum, bounds.data(), bounds.size(), visibility.data());
+
+    // LODs are selected in submission order so that hysteresis can match draws to last frame's.
+    // Culled draws aren't counted, so a draw leaving the frustum can shift the LODs of later draws
+    // of the same mesh for a frame
+    lods.resize(staticMeshes.size());
+    depths.resize(staticMeshes.size());
+    drawKeys.resize(staticMeshes.size());
+    drawOrder.clear();
+    for (uint32_t i = 0; i < staticMeshes.size(); i++)
     {
-        auto& mesh = staticMeshes[i];
-        auto& subMeshes = mesh->GetSubMeshes();
+        if (!visibility[i] || !frustum.Intersects(boxes[i])) continue;
+
+        std::vector<uint32_t>& meshLods = currentLods[staticMeshes[i]];
+        lods[i] = SelectLod(staticMeshes[i], bounds[i], camera, meshLods.size());
+        meshLods.push_back(lods[i]);
+
+        depths[i] = Vec3::Length((camera.view * Vec4(bounds[i].XYZ(), 1.f)).XYZ());
+        drawKeys[i] = static_cast<uint64_t>(drawList.GetMeshId(staticMeshes[i])) << 32 | lods[i];
+        drawOrder.push_back(i);
+    }
+
+    drawList.AddCullingResults(drawOrder.size(), staticMeshes.size() - drawOrder.size());
 
-        for (size_t j = 0; j < subMeshes.Count(); j++)
+    // Sorting by mesh and LOD makes the instances of each batch adjacent in the transform buffer
+    RadixSort(drawOrder, drawOrderScratch, [this](uint32_t draw) { return drawKeys[draw]; });
+
+    batches.clear();
+    instanceTransforms.clear();
+    for (uint32_t draw : drawOrder)
+    {
+        if (batches.empty() || batches.back().mesh != staticMeshes[draw] ||
+            batches.back().lod != lods[draw])
         {
-            auto subMesh = subMeshes[j];
-            auto subMeshMaterial = mesh->GetMaterial(subMesh.materialIndex);
-            if (mat != subMeshMaterial)
+            batches.push_back({staticMeshes[draw],
+                               lods[draw],
+                               static_cast<uint32_t>(instanceTransforms.size()),
+                               0,
+                               depths[draw]});
+        }
+
+        batches.back().instanceCount++;
+        batches.back().depth = std::min(batches.back().depth, depths[draw]);
+        instanceTransforms.push_back(transforms[draw]);
+    }
+}
+
+void ModelRenderer::Submit(DrawList& drawList,
+                           const uint64_t& globalDataSize,
+                           const void* globalData,
+                           const Camera& camera,
+                           const Frustum& frustum)
+{
+    subMeshDraws.clear();
+    if (staticMeshes.empty()) return;
+
+    BuildBatches(camera, frustum, drawList);
+    if (batches.empty()) return;
+
+    // The transforms are uploaded once and shared by every material. Their space is rounded up to
+    // a power of two so that the materials' descriptors only need resizing when the instance
+    // count crosses one
+    size_t capacity = MIN_TRANSFORM_CAPACITY;
+    while (capacity < instanceTransforms.size()) capacity *= 2;
+
+    auto transformAllocation =
+        Vulkan::Context::GetUniformRing().Allocate(sizeof(ModelTransform) * capacity);
+    memcpy(transformAllocation.data,
+           instanceTransforms.data(),
+           sizeof(ModelTransform) * instanceTransforms.size());
+
+    // A descriptor set can't be resized once it has been bound in a frame, so every material
+    // needs to be pointed at this frame's transforms before any of them are bound
+    materials.clear();
+    for (uint32_t i = 0; i < batches.size(); i++)
+    {
+        const Batch& batch = batches[i];
+        auto& subMeshes = batch.mesh->GetSubMeshes();
+        for (uint32_t j = 0; j < subMeshes.Count(); j++)
+        {
+            auto subMeshMaterial = batch.mesh->GetMaterial(subMeshes[j].materialIndex);
+            if (std::find(materials.begin(), materials.end(), subMeshMaterial) == materials.end())
             {
-                mat = subMeshMaterial;
-                mat->SetUniformData(transformId,
-                                    sizeof(ModelTransform) * transforms.Count(),
-                                    transforms.Data());
-                mat->SetUniformData(globalDataId, globalDataSize, globalData);
-                mat->Bind(buffer);
+                materials.push_back(subMeshMaterial);
+                subMeshMaterial->SetUniformAllocation(transformId, transformAllocation);
+                subMeshMaterial->SetUniformData(globalDataId, globalDataSize, globalData);
             }
 
-            mesh->BindIndexed(buffer,
-                              sizeof(BaseVertex) * subMesh.baseVertex,
-                              sizeof(unsigned int) * subMesh.baseIndex);
-            Vulkan::Utils::DrawIndexed(buffer.Get(), subMesh.indexCount, 1, 0, 0, i);
+            uint64_t key = DrawList::MakeOpaqueKey(DrawList::PASS_WORLD,
+                                                   drawList.GetMaterialId(subMeshMaterial),
+                                                   drawList.GetMeshId(batch.mesh),
+                                                   batch.depth);
+            drawList.Add(key, DrawList::SOURCE_MODEL, subMeshDraws.size());
+            subMeshDraws.push_back({i, j});
         }
     }
 }
 
+void ModelRenderer::Record(Vulkan::CommandBuffer& buffer, Span<const DrawList::Item> items)
+{
+    Vulkan::Material* mat = nullptr;
+
+    for (const DrawList::Item& item : items)
+    {
+        const SubMeshDraw& draw = subMeshDraws[item.index];
+        const Batch& batch = batches[draw.batch];
+        auto& mesh = batch.mesh;
+
+        auto subMesh = mesh->GetSubMeshes()[draw.subMesh];
+        if (batch.lod > 0)
+        {
+            const MeshLod& meshLod = mesh->GetLods()[batch.lod - 1];
+            subMesh.baseIndex = meshLod.indexOffset;
+            subMesh.indexCount = meshLod.indexCount;
+        }
+        auto subMeshMaterial = mesh->GetMaterial(subMesh.materialIndex);
+        if (mat != subMeshMaterial)
+        {
+            mat = subMeshMaterial;
+            mat->Bind(buffer);
+        }
+
+        mesh->BindIndexed(buffer,
+                          mesh->GetVertexStride() * subMesh.baseVertex,
+                          mesh->GetIndexSize() * subMesh.baseIndex);
+        Vulkan::Utils::DrawIndexed(buffer.Get(),
+                                   subMesh.indexCount,
+                                   batch.instanceCount,
+                                   0,
+                                   0,
+                                   batch.firstInstance);
+    }
+}
+
 void ModelRenderer::Flush()
 {
-    transforms.Clear();
-    staticMeshes.Clear();
+    transforms.clear();
+    staticMeshes.clear();
+    bounds.clear();
+    boxes.clear();
+
+    // Meshes that weren't drawn this frame have no LODs to carry over
+    std::swap(previousLods, currentLods);
+    currentLods.clear();
 }
 
 void ModelRenderer::RecreateMaterials() {}
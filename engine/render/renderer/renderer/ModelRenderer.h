@@ -10,8 +10,14 @@
 #ifndef SIEGE_ENGINE_MODEL_RENDERER_H
 #define SIEGE_ENGINE_MODEL_RENDERER_H
 
+#include <utils/math/Frustum.h>
 #include <utils/math/mat/Mat4.h>
 
+#include <unordered_map>
+#include <vector>
+
+#include "DrawList.h"
+#include "render/renderer/camera/Camera.h"
 #include "render/renderer/platform/vulkan/Material.h"
 #include "render/renderer/platform/vulkan/StaticMesh.h"
 
@@ -37,9 +43,27 @@ public:
                   const Vec3& scale,
                   const Vec3& rotation);
 
-    void Render(Vulkan::CommandBuffer& buffer,
+    /**
+     * Culls draws outside the frustum, selects the LOD of the rest and groups them into instanced
+     * batches, uploads their transforms, then adds a draw to the list for each batch's submeshes
+     * @param drawList the frame's draw list
+     * @param globalDataSize the size of the global data in bytes
+     * @param globalData the global data shared by all materials
+     * @param camera the camera the frame is drawn from
+     * @param frustum the camera's frustum, in world space
+     */
+    void Submit(DrawList& drawList,
                 const uint64_t& globalDataSize,
-                const void* globalData);
+                const void* globalData,
+                const Camera& camera,
+                const Frustum& frustum);
+
+    /**
+     * Records a run of this renderer's draws from the sorted draw list
+     * @param buffer the command buffer to record into
+     * @param items the draws to record, in order
+     */
+    void Record(Vulkan::CommandBuffer& buffer, Span<const DrawList::Item> items);
 
     void Flush();
 
@@ -47,20 +71,79 @@ public:
 
 private:
 
+    /**
+     * A run of draws sharing a mesh and LOD, which is drawn as a single instanced draw per submesh
+     * @param mesh the mesh being drawn
+     * @param lod the LOD of the mesh to draw, where zero is the full detail mesh
+     * @param firstInstance the index of the first instance's transform in the frame's buffer
+     * @param instanceCount the number of instances to draw
+     * @param depth the distance from the camera to the nearest instance
+     */
     struct Batch
     {
-        Vulkan::StaticMesh* mesh;
-        unsigned int instances;
+        Vulkan::StaticMesh* mesh {nullptr};
+        uint32_t lod {0};
+        uint32_t firstInstance {0};
+        uint32_t instanceCount {0};
+        float depth {0.f};
+    };
+
+    /**
+     * A single submesh of a batch, which is what each of the renderer's draw list items refers to
+     * @param batch the index of the batch
+     * @param subMesh the index of the submesh within the batch's mesh
+     */
+    struct SubMeshDraw
+    {
+        uint32_t batch {0};
+        uint32_t subMesh {0};
     };
 
-    // TODO(Aryeh): Make this configurable via macros
-    static constexpr size_t MAX_OBJECT_TRANSFORMS = 1000;
+    // The fewest transforms space is allocated for in the uniform ring each frame
+    static constexpr size_t MIN_TRANSFORM_CAPACITY = 256;
+
+    // The largest LOD error to allow on screen, as a fraction of half the screen height (roughly a
+    // pixel at 1080p), and the fraction of it to clear before switching to a coarser LOD
+    static constexpr float LOD_ERROR_THRESHOLD = 0.002f;
+    static constexpr float LOD_HYSTERESIS = 0.25f;
+
+    uint32_t SelectLod(const Vulkan::StaticMesh* mesh,
+                       const Vec4& bounds,
+                       const Camera& camera,
+                       size_t occurrence);
+
+    void BuildBatches(const Camera& camera, const Frustum& frustum, DrawList& drawList);
 
     Hash::StringId globalDataId;
     Hash::StringId transformId;
 
-    MSArray<ModelTransform, MAX_OBJECT_TRANSFORMS> transforms;
-    MSArray<Vulkan::StaticMesh*, MAX_OBJECT_TRANSFORMS> staticMeshes;
+    std::vector<ModelTransform> transforms;
+    std::vector<Vulkan::StaticMesh*> staticMeshes;
+
+    // World space bounding spheres of each draw, with the radius stored in w, and the world space
+    // boxes the draws which pass the sphere test are checked against
+    std::vector<Vec4> bounds;
+    std::vector<BoundedBox> boxes;
+    std::vector<uint8_t> visibility;
+
+    // The LOD and camera distance of each draw, and the draws sorted by mesh and LOD so that a
+    // batch's instances are adjacent
+    std::vector<uint32_t> lods;
+    std::vector<float> depths;
+    std::vector<uint64_t> drawKeys;
+    std::vector<uint32_t> drawOrder;
+    std::vector<uint32_t> drawOrderScratch;
+
+    std::vector<Batch> batches;
+    std::vector<SubMeshDraw> subMeshDraws;
+    std::vector<ModelTransform> instanceTransforms;
+    std::vector<Vulkan::Material*> materials;
+
+    // The LODs drawn for each mesh in draw order, for the previous and current frames. Draws have
+    // no persistent identity, so the nth draw of a mesh is assumed to be the same object as the
+    // nth draw of it last frame when applying hysteresis
+    std::unordered_map<const Vulkan::StaticMesh*, std::vector<uint32_t>> previousLods;
+    std::unordered_map<const Vulkan::StaticMesh*, std::vector<uint32_t>> currentLods;
 };
 } // namespace Siege
 
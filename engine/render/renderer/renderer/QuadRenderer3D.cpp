@@ -11,7 +11,9 @@
 
 #include <utils/math/Transform.h>
 
+#include <algorithm>
 #include <cstdint>
+#include <limits>
 
 #include "render/renderer/platform/vulkan/Swapchain.h"
 #include "render/renderer/platform/vulkan/utils/Draw.h"
@@ -56,6 +58,9 @@ void QuadRenderer3D::Initialise(const String& globalDataAttributeName)
     }
 
     indexBuffer = Vulkan::IndexBuffer(quadIndices, sizeof(unsigned int) * 6);
+
+    quads = MHArray<QuadVertex>(VERTEX_BUFFER_SIZE);
+    textureIndices = MHArray<uint32_t>(VERTEX_BUFFER_SIZE);
 }
 
 void QuadRenderer3D::DrawQuad(const Siege::Vec3& position,
@@ -68,12 +73,9 @@ void QuadRenderer3D::DrawQuad(const Siege::Vec3& position,
 
     auto texIndex = defaultMaterial.SetTexture(textureId, *targetTexture);
 
-    if (texIndex >= quads.Count()) quads.Append(MHArray<QuadVertex>(MAX_QUADS_PER_TEXTURE));
-
-    auto& textureQuads = quads[texIndex];
-
-    textureQuads.Append(
+    quads.Append(
         {Transform3D(position, rotation, scale), ToFColour(colour), {0.f, 0.f, 1.f, 1.f}});
+    textureIndices.Append(texIndex);
 }
 
 void QuadRenderer3D::RecreateMaterials()
@@ -81,29 +83,81 @@ void QuadRenderer3D::RecreateMaterials()
     defaultMaterial.Recreate();
 }
 
-void QuadRenderer3D::Render(Vulkan::CommandBuffer& buffer,
+void QuadRenderer3D::Submit(DrawList& drawList,
                             const uint64_t& globalDataSize,
                             const void* globalData,
+                            const Camera& camera,
+                            const Frustum& frustum,
                             uint32_t frameIndex)
 {
-    defaultMaterial.SetUniformData(globalDataId, globalDataSize, globalData);
-
-    auto& vBuffer = perFrameVBuffers[frameIndex];
+    if (quads.Count() == 0) return;
 
+    // A quad's corners sit at its transformed x and y axes added to or taken from its centre
+    bounds.resize(quads.Count());
     for (uint32_t i = 0; i < quads.Count(); i++)
     {
-        defaultMaterial.BindPushConstant(buffer, &i);
+        const Mat4& transform = quads[i].transform;
+        Vec3 xAxis = transform[0].XYZ();
+        Vec3 yAxis = transform[1].XYZ();
+        float radius = std::max(Vec3::Length(xAxis + yAxis), Vec3::Length(xAxis - yAxis));
+        bounds[i] = {transform[3].XYZ(), radius};
+    }
+
+    visibility.resize(quads.Count());
+    size_t visibleCount = CullSpheres(frustum, bounds.data(), bounds.size(), visibility.data());
+    drawList.AddCullingResults(visibleCount, quads.Count() - visibleCount);
+    if (visibleCount == 0) return;
+
+    defaultMaterial.SetUniformData(globalDataId, globalDataSize, globalData);
 
-        defaultMaterial.Bind(buffer);
+    perFrameVBuffers[frameIndex].Copy(quads.Data(), sizeof(QuadVertex) * quads.Count());
 
-        uint64_t bindOffset = sizeof(QuadVertex) * (i * MAX_QUADS_PER_TEXTURE);
+    // Quads have no mesh, so their texture takes its place in the sort key
+    auto materialId = drawList.GetMaterialId(&defaultMaterial);
+    for (uint32_t i = 0; i < quads.Count(); i++)
+    {
+        if (!visibility[i]) continue;
+
+        float depth = Vec3::Length((camera.view * Vec4(bounds[i].XYZ(), 1.f)).XYZ());
+        uint64_t key = DrawList::MakeTranslucentKey(DrawList::PASS_WORLD,
+                                                    materialId,
+                                                    textureIndices[i],
+                                                    depth);
+        drawList.Add(key, DrawList::SOURCE_QUAD, i);
+    }
+}
 
-        vBuffer.Copy(quads[i].Data(), sizeof(QuadVertex) * quads[i].Count(), bindOffset);
+void QuadRenderer3D::Record(Vulkan::CommandBuffer& buffer,
+                            Span<const DrawList::Item> items,
+                            uint32_t frameIndex)
+{
+    defaultMaterial.Bind(buffer);
 
-        vBuffer.Bind(buffer, &bindOffset);
-        indexBuffer.Bind(buffer);
+    uint64_t bindOffset = 0;
+    perFrameVBuffers[frameIndex].Bind(buffer, &bindOffset);
+    indexBuffer.Bind(buffer);
 
-        Vulkan::Utils::DrawIndexed(buffer.Get(), 6, quads[i].Count(), 0, 0, 0);
+    uint32_t boundTexture = std::numeric_limits<uint32_t>::max();
+    for (size_t i = 0; i < items.Size();)
+    {
+        uint32_t first = items[i].index;
+        uint32_t texture = textureIndices[first];
+
+        uint32_t count = 1;
+        while (i + count < items.Size() && items[i + count].index == first + count &&
+               textureIndices[first + count] == texture)
+        {
+            count++;
+        }
+
+        if (texture != boundTexture)
+        {
+            defaultMaterial.BindPushConstant(buffer, &texture);
+            boundTexture = texture;
+        }
+
+        Vulkan::Utils::DrawIndexed(buffer.Get(), 6, count, 0, 0, first);
+        i += count;
     }
 }
 
@@ -117,7 +171,8 @@ void QuadRenderer3D::Free()
 
 void QuadRenderer3D::Flush()
 {
-    for (size_t i = 0; i < quads.Count(); i++) quads[i].Clear();
+    quads.Clear();
+    textureIndices.Clear();
 }
 
 void QuadRenderer3D::Update()
@@ -12,8 +12,13 @@
 
 #include <utils/Colour.h>
 #include <utils/collections/StackArray.h>
+#include <utils/math/Frustum.h>
 #include <utils/math/mat/Mat4.h>
 
+#include <vector>
+
+#include "DrawList.h"
+#include "render/renderer/camera/Camera.h"
 #include "render/renderer/platform/vulkan/IndexBuffer.h"
 #include "render/renderer/platform/vulkan/Material.h"
 #include "render/renderer/platform/vulkan/Texture2D.h"
@@ -36,10 +41,33 @@ public:
 
     void RecreateMaterials();
 
-    void Render(Vulkan::CommandBuffer& commandBuffer,
+    /**
+     * Uploads the frame's quads and adds a translucent draw to the list for each of them
+     * @param drawList the frame's draw list
+     * @param globalDataSize the size of the global data in bytes
+     * @param globalData the global data used by the quad material
+     * @param camera the camera the frame is drawn from
+     * @param frustum the camera's frustum, in world space
+     * @param frameIndex the index of the frame being drawn
+     */
+    void Submit(DrawList& drawList,
                 const uint64_t& globalDataSize,
                 const void* globalData,
+                const Camera& camera,
+                const Frustum& frustum,
+                uint32_t frameIndex);
+
+    /**
+     * Records a run of this renderer's draws from the sorted draw list. Consecutive quads sharing a
+     * texture are drawn as a single instanced draw
+     * @param commandBuffer the command buffer to record into
+     * @param items the draws to record, in order
+     * @param frameIndex the index of the frame being drawn
+     */
+    void Record(Vulkan::CommandBuffer& commandBuffer,
+                Span<const DrawList::Item> items,
                 uint32_t frameIndex);
+
     void Update();
     void Flush();
 
@@ -59,7 +87,13 @@ private:
     Hash::StringId globalDataId;
     Hash::StringId textureId;
 
-    MSArray<MHArray<QuadVertex>, MAX_TEXTURES> quads;
+    // The frame's quads in submission order, along with the texture index each one samples
+    MHArray<QuadVertex> quads;
+    MHArray<uint32_t> textureIndices;
+
+    // The bounding sphere of each of the frame's quads, and whether it passed culling
+    std::vector<Vec4> bounds;
+    std::vector<uint8_t> visibility;
 
     MHArray<Vulkan::VertexBuffer> perFrameVBuffers;
     Vulkan::IndexBuffer indexBuffer;
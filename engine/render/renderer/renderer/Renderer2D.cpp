@@ -175,7 +175,7 @@ void Renderer2D::DrawText2D(const char* const text,
     auto& fontTexts = layerQuads[texIndex];
 
     size_t textSize = strlen(text);
-    float textScale = 64.f;
+    float textScale = Vulkan::Font::EM_SIZE;
 
     float x = 0;
     float y = 0;
@@ -196,7 +196,8 @@ void Renderer2D::DrawText2D(const char* const text,
              {glyph.uvxMin, glyph.uvyMin, glyph.widthNormalised, glyph.heightNormalised},
              coordinates / textScale});
 
-        x += glyph.advance >> 6;
+        x += glyph.advance;
+        if (i + 1 < textSize) x += font.GetKerning(text[i], text[i + 1]);
     }
 }
 
@@ -332,13 +333,15 @@ void Renderer2D::RecreateMaterials()
     gridMaterial.Recreate();
 }
 
-float Renderer2D::GetTotalTextWidth(const char* text,
-                                    size_t textLength,
-                                    SArray<Vulkan::Font::Glyph, 256>& glyphs)
+float Renderer2D::GetTotalTextWidth(const char* text, size_t textLength, Vulkan::Font& font)
 {
     float texWidth = 0;
 
-    for (size_t i = 0; i < textLength; i++) texWidth += glyphs[text[i]].advance >> 6;
+    for (size_t i = 0; i < textLength; i++)
+    {
+        texWidth += font.GetGlyph(text[i]).advance;
+        if (i + 1 < textLength) texWidth += font.GetKerning(text[i], text[i + 1]);
+    }
 
     return texWidth;
 }
@@ -106,9 +106,7 @@ private:
     // NOTE(Aryeh): This function isn't being used right now. It was useful for centering text on a
     // coordinate and can be re-used when we add text formatting. As such, I don't want to remove it
     // just yet.
-    float GetTotalTextWidth(const char* text,
-                            size_t textLength,
-                            SArray<Vulkan::Font::Glyph, 256>& glyphs);
+    float GetTotalTextWidth(const char* text, size_t textLength, Vulkan::Font& font);
 
     Hash::StringId globalDataId;
     Hash::StringId textureId;
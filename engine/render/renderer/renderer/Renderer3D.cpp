@@ -11,6 +11,8 @@
 
 #include <utils/math/vec/Vec2.h>
 
+#include <algorithm>
+
 #include "render/renderer/platform/vulkan/utils/Draw.h"
 
 namespace Siege
@@ -25,6 +27,8 @@ LightRenderer Renderer3D::lightRenderer;
 TextRenderer Renderer3D::textRenderer;
 QuadRenderer3D Renderer3D::quadRenderer3D;
 
+DrawList Renderer3D::drawList;
+
 Renderer3D::GlobalData Renderer3D::global3DData;
 
 void Renderer3D::Initialise()
@@ -85,19 +89,101 @@ void Renderer3D::DrawQuad(const Vec3 position,
 }
 
 void Renderer3D::Render(uint32_t currentFrame,
-                        Vulkan::CommandBuffer& commandBuffer,
+                        Vulkan::CommandRecorder& recorder,
                         const Camera& cameraData)
 {
     global3DData.cameraData = cameraData;
     uint64_t globalDataSize = sizeof(global3DData);
 
-    modelRenderer.Render(commandBuffer, globalDataSize, &global3DData);
+    Frustum frustum = Frustum::FromViewProjection(Camera::ViewProjection(cameraData));
+
+    drawList.Clear();
+    modelRenderer.Submit(drawList, globalDataSize, &global3DData, cameraData, frustum);
+    billboardRenderer.Submit(drawList,
+                             globalDataSize,
+                             &global3DData,
+                             cameraData,
+                             frustum,
+                             currentFrame);
+    quadRenderer3D.Submit(drawList,
+                          globalDataSize,
+                          &global3DData,
+                          cameraData,
+                          frustum,
+                          currentFrame);
+    drawList.Sort();
+
+    // Jobs are executed in the order they're queued, so the passes keep their order even though
+    // they're recorded at the same time
+    QueueDraws(currentFrame, recorder, drawList.GetOpaqueItems());
+
+    recorder.Record([globalDataSize, currentFrame](Vulkan::CommandBuffer& commandBuffer) {
+        lightRenderer.Render(commandBuffer, globalDataSize, &global3DData, currentFrame);
+        debugRenderer.Render(commandBuffer, globalDataSize, &global3DData, currentFrame);
+    });
+
+    QueueDraws(currentFrame, recorder, drawList.GetTranslucentItems());
+
+    recorder.Record([globalDataSize, currentFrame](Vulkan::CommandBuffer& commandBuffer) {
+        textRenderer.Render(commandBuffer, globalDataSize, &global3DData, currentFrame);
+    });
+}
+
+void Renderer3D::QueueDraws(uint32_t currentFrame,
+                            Vulkan::CommandRecorder& recorder,
+                            Span<const DrawList::Item> items)
+{
+    if (items.Size() == 0) return;
+
+    size_t jobCount = std::clamp<size_t>(items.Size() / MIN_DRAWS_PER_JOB,
+                                         1,
+                                         recorder.GetThreadCount());
+    size_t drawsPerJob = (items.Size() + jobCount - 1) / jobCount;
+
+    for (size_t first = 0; first < items.Size(); first += drawsPerJob)
+    {
+        Span<const DrawList::Item> range {items.Data() + first,
+                                          std::min(drawsPerJob, items.Size() - first)};
+
+        recorder.Record([currentFrame, range](Vulkan::CommandBuffer& commandBuffer) {
+            RecordDraws(currentFrame, commandBuffer, range);
+        });
+    }
+}
+
+void Renderer3D::RecordDraws(uint32_t currentFrame,
+                             Vulkan::CommandBuffer& commandBuffer,
+                             Span<const DrawList::Item> items)
+{
+    for (size_t first = 0; first < items.Size();)
+    {
+        size_t count = 1;
+        while (first + count < items.Size() && items[first + count].source == items[first].source)
+        {
+            count++;
+        }
+
+        Span<const DrawList::Item> run {items.Data() + first, count};
+        switch (items[first].source)
+        {
+            case DrawList::SOURCE_MODEL:
+                modelRenderer.Record(commandBuffer, run);
+                break;
+            case DrawList::SOURCE_BILLBOARD:
+                billboardRenderer.Record(commandBuffer, run, currentFrame);
+                break;
+            case DrawList::SOURCE_QUAD:
+                quadRenderer3D.Record(commandBuffer, run, currentFrame);
+                break;
+        }
+
+        first += count;
+    }
+}
 
-    lightRenderer.Render(commandBuffer, globalDataSize, &global3DData, currentFrame);
-    debugRenderer.Render(commandBuffer, globalDataSize, &global3DData, currentFrame);
-    billboardRenderer.Render(commandBuffer, globalDataSize, &global3DData, currentFrame);
-    quadRenderer3D.Render(commandBuffer, globalDataSize, &global3DData, currentFrame);
-    textRenderer.Render(commandBuffer, globalDataSize, &global3DData, currentFrame);
+const DrawList::CullingStats& Renderer3D::GetCullingStats()
+{
+    return drawList.GetCullingStats();
 }
 
 void Renderer3D::DrawLine(const Vec3& origin, const Vec3& destination, const IColour& colour)
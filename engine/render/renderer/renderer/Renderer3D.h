@@ -12,8 +12,10 @@
 
 #include "../camera/Camera.h"
 #include "../lights/PointLight.h"
+#include "../platform/vulkan/CommandRecorder.h"
 #include "BillboardRenderer.h"
 #include "DebugRenderer3D.h"
+#include "DrawList.h"
 #include "LightRenderer.h"
 #include "ModelRenderer.h"
 #include "QuadRenderer3D.h"
@@ -70,10 +72,23 @@ public:
 
     static void SetGridEnabled(bool enabled);
 
+    /**
+     * Returns the number of objects which passed and failed frustum culling in the last frame
+     * @return the culling counters of the last frame
+     */
+    static const DrawList::CullingStats& GetCullingStats();
+
     static void RecreateMaterials();
 
+    /**
+     * Builds the frame's draw list and queues jobs recording it with a command recorder. Long
+     * runs of draws are split across several jobs, so they can be recorded in parallel
+     * @param currentFrame the index of the frame being drawn
+     * @param recorder the command recorder to queue the jobs with
+     * @param cameraData the camera the frame is drawn from
+     */
     static void Render(uint32_t currentFrame,
-                       Vulkan::CommandBuffer& commandBuffer,
+                       Vulkan::CommandRecorder& recorder,
                        const Camera& cameraData);
     static void Flush();
 
@@ -83,6 +98,32 @@ public:
 
 private:
 
+    // The fewest draws split into a job of their own, below which the cost of another secondary
+    // command buffer outweighs recording the draws in parallel
+    static constexpr size_t MIN_DRAWS_PER_JOB = 256;
+
+    /**
+     * Queues jobs recording a range of the sorted draw list, split evenly across the recorder's
+     * threads if there are enough draws
+     * @param currentFrame the index of the frame being drawn
+     * @param recorder the command recorder to queue the jobs with
+     * @param items the draws to record, in order
+     */
+    static void QueueDraws(uint32_t currentFrame,
+                           Vulkan::CommandRecorder& recorder,
+                           Span<const DrawList::Item> items);
+
+    /**
+     * Records a range of the sorted draw list, handing each run of consecutive draws from the same
+     * sub-renderer back to that renderer
+     * @param currentFrame the index of the frame being drawn
+     * @param commandBuffer the command buffer to record into
+     * @param items the draws to record, in order
+     */
+    static void RecordDraws(uint32_t currentFrame,
+                            Vulkan::CommandBuffer& commandBuffer,
+                            Span<const DrawList::Item> items);
+
     static Hash::StringId globalDataId;
 
     // FIXME(Aryeh): These statics are evil and need to be removed.
@@ -94,6 +135,8 @@ private:
     static TextRenderer textRenderer;
     static QuadRenderer3D quadRenderer3D;
 
+    static DrawList drawList;
+
     static GlobalData global3DData;
 };
 } // namespace Siege
@@ -86,9 +86,9 @@ void TextRenderer::DrawFont(const char* text,
     auto& fontTexts = characters[texIndex];
 
     size_t textSize = strlen(text);
-    float textScale = 64.f;
+    float textScale = Vulkan::Font::EM_SIZE;
 
-    float totalWidth = (GetTotalTextWidth(text, textSize, font->GetGlyphs()));
+    float totalWidth = (GetTotalTextWidth(text, textSize, *font));
 
     float x = 0 - (totalWidth / 2.f);
     float y = 0;
@@ -109,7 +109,8 @@ void TextRenderer::DrawFont(const char* text,
              ToFColour(colour),
              coordinates / textScale});
 
-        x += glyph.advance >> 6;
+        x += glyph.advance;
+        if (i + 1 < textSize) x += font->GetKerning(text[i], text[i + 1]);
     }
 }
 
@@ -160,13 +161,15 @@ void TextRenderer::Flush()
     for (size_t i = 0; i < characters.Count(); i++) characters[i].Clear();
 }
 
-float TextRenderer::GetTotalTextWidth(const char* text,
-                                      size_t textLength,
-                                      SArray<Vulkan::Font::Glyph, 256>& glyphs)
+float TextRenderer::GetTotalTextWidth(const char* text, size_t textLength, Vulkan::Font& font)
 {
     float texWidth = 0;
 
-    for (size_t i = 0; i < textLength; i++) texWidth += glyphs[text[i]].advance >> 6;
+    for (size_t i = 0; i < textLength; i++)
+    {
+        texWidth += font.GetGlyph(text[i]).advance;
+        if (i + 1 < textLength) texWidth += font.GetKerning(text[i], text[i + 1]);
+    }
 
     return texWidth;
 }
@@ -62,9 +62,7 @@ private:
         Vec4 position {};
     };
 
-    float GetTotalTextWidth(const char* text,
-                            size_t textLength,
-                            SArray<Vulkan::Font::Glyph, 256>& glyphs);
+    float GetTotalTextWidth(const char* text, size_t textLength, Vulkan::Font& font);
 
     Hash::StringId globalDataId;
     Hash::StringId textureId;
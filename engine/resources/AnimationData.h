@@ -11,6 +11,8 @@
 #define SIEGE_ENGINE_ANIMATIONDATA_H
 
 #include <utils/BinarySerialisation.h>
+#include <utils/Macros.h>
+#include <utils/math/Quantisation.h>
 #include <utils/math/mat/Mat4.h>
 #include <utils/math/vec/Vec3.h>
 
@@ -42,13 +44,90 @@ struct AnimationChannel
     std::vector<AnimKeyScale> scaleKeys;
 };
 
+/**
+ * A key of a compressed track. Frames index the uniform resampling of the clip, and values hold
+ * either a vector as 16-bit fractions of its track's range or a rotation in smallest three form
+ */
+struct AnimCompressedKey
+{
+    uint16_t frame = 0;
+    uint16_t value[3] = {0, 0, 0};
+};
+
+/**
+ * A resampled track with the keys that interpolation between their neighbours can reproduce
+ * removed. Vector values decode to rangeMin + value * rangeExtent, rotations ignore the range
+ */
+struct AnimCompressedTrack
+{
+    Vec3 rangeMin;
+    Vec3 rangeExtent {1.f, 1.f, 1.f};
+    std::vector<AnimCompressedKey> keys;
+};
+
+struct AnimCompressedChannel
+{
+    AnimCompressedTrack positions;
+    AnimCompressedTrack rotations;
+    AnimCompressedTrack scales;
+};
+
+/**
+ * Animation data, stored either as the source keys in channels or as compressed tracks in
+ * compressedChannels. Compressed tracks are resampled with a fixed duration in ticks per frame
+ */
 struct AnimationData
 {
     double length;
     double speed;
     std::map<String, AnimationChannel> channels;
+    double frameDuration = 0.0;
+    std::map<String, AnimCompressedChannel> compressedChannels;
 };
 
+inline Vec3 DecodeAnimKeyVector(const AnimCompressedTrack& track, const AnimCompressedKey& key)
+{
+    using namespace Quantisation;
+
+    return {track.rangeMin.x + DecodeUnorm16(key.value[0]) * track.rangeExtent.x,
+            track.rangeMin.y + DecodeUnorm16(key.value[1]) * track.rangeExtent.y,
+            track.rangeMin.z + DecodeUnorm16(key.value[2]) * track.rangeExtent.z};
+}
+
+inline Vec4 DecodeAnimKeyRotation(const AnimCompressedKey& key)
+{
+    return Quantisation::SmallestThreeDecode(key.value);
+}
+
+/**
+ * Expands a compressed channel back into keys. Only the keys kept by compression are produced,
+ * which interpolate to the same curves as the compressed tracks
+ * @param channel the compressed channel to expand
+ * @param frameDuration the duration in ticks of each of the channel's frames
+ * @param decompressed the channel to fill with the expanded keys
+ */
+inline void DecompressAnimationChannel(const AnimCompressedChannel& channel,
+                                       double frameDuration,
+                                       OUT AnimationChannel& decompressed)
+{
+    decompressed = {};
+    for (const AnimCompressedKey& key : channel.positions.keys)
+    {
+        decompressed.positionKeys.push_back(
+            {key.frame * frameDuration, DecodeAnimKeyVector(channel.positions, key)});
+    }
+    for (const AnimCompressedKey& key : channel.rotations.keys)
+    {
+        decompressed.rotationKeys.push_back(
+            {key.frame * frameDuration, DecodeAnimKeyRotation(key)});
+    }
+    for (const AnimCompressedKey& key : channel.scales.keys)
+    {
+        decompressed.scaleKeys.push_back(
+            {key.frame * frameDuration, DecodeAnimKeyVector(channel.scales, key)});
+    }
+}
+
 namespace BinarySerialisation
 {
 
@@ -77,11 +156,35 @@ inline void serialise(Buffer& buffer, AnimationChannel& value, SerialisationMode
     serialise(buffer, value.scaleKeys, mode);
 }
 
+inline void serialise(Buffer& buffer, AnimCompressedKey& value, SerialisationMode mode)
+{
+    serialise(buffer, value.frame, mode);
+    serialise(buffer, value.value[0], mode);
+    serialise(buffer, value.value[1], mode);
+    serialise(buffer, value.value[2], mode);
+}
+
+inline void serialise(Buffer& buffer, AnimCompressedTrack& value, SerialisationMode mode)
+{
+    serialise(buffer, value.rangeMin, mode);
+    serialise(buffer, value.rangeExtent, mode);
+    serialise(buffer, value.keys, mode);
+}
+
+inline void serialise(Buffer& buffer, AnimCompressedChannel& value, SerialisationMode mode)
+{
+    serialise(buffer, value.positions, mode);
+    serialise(buffer, value.rotations, mode);
+    serialise(buffer, value.scales, mode);
+}
+
 inline void serialise(Buffer& buffer, AnimationData& value, SerialisationMode mode)
 {
     serialise(buffer, value.length, mode);
     serialise(buffer, value.speed, mode);
     serialise(buffer, value.channels, mode);
+    serialise(buffer, value.frameDuration, mode);
+    serialise(buffer, value.compressedChannels, mode);
 }
 
 } // namespace BinarySerialisation
@@ -0,0 +1,179 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#ifndef SIEGE_ENGINE_FONTDATA_H
+#define SIEGE_ENGINE_FONTDATA_H
+
+#include <utils/BinarySerialisation.h>
+
+#include "InPlaceData.h"
+
+namespace Siege
+{
+
+/**
+ * The layout of a font's signed distance field atlas. Texels store the distance to the nearest
+ * glyph edge, with the edge itself at half intensity and the field falling off to zero and one
+ * over the distance range
+ */
+struct FontAtlas
+{
+    int32_t width = 0;
+    int32_t height = 0;
+    // The size of the em square the glyphs were rasterised at, in texels
+    float glyphSize = 0.f;
+    // The distance in texels over which the field falls off on each side of an edge
+    float distanceRange = 0.f;
+};
+
+/**
+ * A single glyph of a font. The atlas region is in texels, while the metrics are relative to the
+ * em size so that text can be laid out at any size. Both include the padding the distance field
+ * needs around the glyph's outline
+ */
+struct FontGlyph
+{
+    uint32_t codepoint = 0;
+    float atlasX = 0.f;
+    float atlasY = 0.f;
+    float atlasWidth = 0.f;
+    float atlasHeight = 0.f;
+    float width = 0.f;
+    float height = 0.f;
+    float bearingX = 0.f;
+    float bearingY = 0.f;
+    float advance = 0.f;
+};
+
+/**
+ * An adjustment to the advance between two glyphs, relative to the em size
+ */
+struct FontKerningPair
+{
+    uint32_t left = 0;
+    uint32_t right = 0;
+    float offset = 0.f;
+};
+
+/**
+ * A font baked into a single channel signed distance field atlas, along with the metrics and
+ * kerning needed to lay out text with it
+ */
+struct FontData
+{
+    FontAtlas atlas;
+    std::vector<FontGlyph> glyphs;
+    std::vector<FontKerningPair> kerning;
+    std::vector<uint8_t> pixels;
+};
+
+struct FontDataView
+{
+    using DataType = FontData;
+
+    FontAtlas atlas;
+    Span<const FontGlyph> glyphs;
+    Span<const FontKerningPair> kerning;
+    Span<const uint8_t> pixels;
+};
+
+namespace BinarySerialisation
+{
+
+inline void serialise(Buffer& buffer, FontAtlas& value, SerialisationMode mode)
+{
+    serialise(buffer, value.width, mode);
+    serialise(buffer, value.height, mode);
+    serialise(buffer, value.glyphSize, mode);
+    serialise(buffer, value.distanceRange, mode);
+}
+
+inline void serialise(Buffer& buffer, FontGlyph& value, SerialisationMode mode)
+{
+    serialise(buffer, value.codepoint, mode);
+    serialise(buffer, value.atlasX, mode);
+    serialise(buffer, value.atlasY, mode);
+    serialise(buffer, value.atlasWidth, mode);
+    serialise(buffer, value.atlasHeight, mode);
+    serialise(buffer, value.width, mode);
+    serialise(buffer, value.height, mode);
+    serialise(buffer, value.bearingX, mode);
+    serialise(buffer, value.bearingY, mode);
+    serialise(buffer, value.advance, mode);
+}
+
+inline void serialise(Buffer& buffer, FontKerningPair& value, SerialisationMode mode)
+{
+    serialise(buffer, value.left, mode);
+    serialise(buffer, value.right, mode);
+    serialise(buffer, value.offset, mode);
+}
+
+inline void serialise(Buffer& buffer, FontData& value, SerialisationMode mode)
+{
+    serialise(buffer, value.atlas, mode);
+    serialise(buffer, value.glyphs, mode);
+    serialise(buffer, value.kerning, mode);
+    serialise(buffer, value.pixels, mode);
+}
+
+} // namespace BinarySerialisation
+
+namespace InPlace
+{
+
+inline PackFileData* Write(const FontData& value)
+{
+    Writer writer;
+    writer.AddSection(&value.atlas, sizeof(FontAtlas));
+    writer.AddSection(value.glyphs);
+    writer.AddSection(value.kerning);
+    writer.AddSection(value.pixels);
+    return writer.Create();
+}
+
+inline bool Read(const Record& record, FontDataView& view)
+{
+    Span<const FontAtlas> atlas;
+    if (record.GetSectionCount() != 4 || !record.GetSection(0, atlas) || atlas.Size() != 1 ||
+        !record.GetSection(1, view.glyphs) || !record.GetSection(2, view.kerning) ||
+        !record.GetSection(3, view.pixels))
+    {
+        return false;
+    }
+
+    view.atlas = atlas[0];
+    return true;
+}
+
+inline bool Read(const Record& record, FontData& value)
+{
+    FontDataView view;
+    if (!Read(record, view)) return false;
+
+    value.atlas = view.atlas;
+    value.glyphs.assign(view.glyphs.begin(), view.glyphs.end());
+    value.kerning.assign(view.kerning.begin(), view.kerning.end());
+    value.pixels.assign(view.pixels.begin(), view.pixels.end());
+    return true;
+}
+
+inline void View(const FontData& value, FontDataView& view)
+{
+    view.atlas = value.atlas;
+    view.glyphs = {value.glyphs.data(), value.glyphs.size()};
+    view.kerning = {value.kerning.data(), value.kerning.size()};
+    view.pixels = {value.pixels.data(), value.pixels.size()};
+}
+
+} // namespace InPlace
+
+} // namespace Siege
+
+#endif // SIEGE_ENGINE_FONTDATA_H
@@ -0,0 +1,104 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#include "InPlaceData.h"
+
+namespace Siege::InPlace
+{
+
+static uint32_t AlignOffset(uint32_t offset)
+{
+    return (offset + IN_PLACE_SECTION_ALIGNMENT - 1) & ~(IN_PLACE_SECTION_ALIGNMENT - 1);
+}
+
+Record::Record(const PackFileData& data)
+{
+    if (!IsRecord(data)) return;
+
+    const uint8_t* recordBase = reinterpret_cast<const uint8_t*>(&data);
+    const RecordHeader* recordHeader = reinterpret_cast<const RecordHeader*>(data.GetData());
+    uint64_t headerEnd = sizeof(PackFileData) + sizeof(RecordHeader) +
+                         static_cast<uint64_t>(recordHeader->sectionCount) * sizeof(Section);
+    uint64_t recordEnd = data.GetDataSize();
+    if (headerEnd > recordEnd) return;
+
+    const Section* recordSections = reinterpret_cast<const Section*>(recordHeader + 1);
+    for (uint32_t i = 0; i < recordHeader->sectionCount; i++)
+    {
+        const Section& section = recordSections[i];
+        if (section.offset < headerEnd ||
+            static_cast<uint64_t>(section.offset) + section.size > recordEnd)
+        {
+            return;
+        }
+    }
+
+    base = recordBase;
+    header = recordHeader;
+    sections = recordSections;
+}
+
+bool Record::IsRecord(const PackFileData& data)
+{
+    if (data.dataSize < sizeof(RecordHeader)) return false;
+    return memcmp(data.GetData(), PACKER_MAGIC_NUMBER_IN_PLACE, sizeof(uint32_t)) == 0;
+}
+
+bool Record::IsValid() const
+{
+    return header != nullptr;
+}
+
+uint32_t Record::GetSectionCount() const
+{
+    return header ? header->sectionCount : 0;
+}
+
+void Writer::AddSection(const void* data, uint32_t size)
+{
+    sections.push_back({0, size});
+    sectionData.push_back(data);
+}
+
+PackFileData* Writer::Create() const
+{
+    uint32_t sectionCount = sections.size();
+    uint32_t offset = AlignOffset(sizeof(PackFileData) + sizeof(RecordHeader) +
+                                  sectionCount * sizeof(Section));
+
+    std::vector<Section> placedSections = sections;
+    for (Section& section : placedSections)
+    {
+        section.offset = offset;
+        offset = AlignOffset(offset + section.size);
+    }
+
+    void* mem = malloc(offset);
+    memset(mem, 0, offset);
+    PackFileData* fileData = new (mem) PackFileData();
+    fileData->dataSize = offset - sizeof(PackFileData);
+
+    uint8_t* recordBase = static_cast<uint8_t*>(mem);
+    RecordHeader header {0, sectionCount};
+    memcpy(&header.magic, PACKER_MAGIC_NUMBER_IN_PLACE, sizeof(uint32_t));
+    memcpy(recordBase + sizeof(PackFileData), &header, sizeof(RecordHeader));
+    memcpy(recordBase + sizeof(PackFileData) + sizeof(RecordHeader),
+           placedSections.data(),
+           sectionCount * sizeof(Section));
+
+    for (uint32_t i = 0; i < sectionCount; i++)
+    {
+        if (placedSections[i].size == 0) continue;
+        memcpy(recordBase + placedSections[i].offset, sectionData[i], placedSections[i].size);
+    }
+
+    return fileData;
+}
+
+} // namespace Siege::InPlace
@@ -0,0 +1,122 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#ifndef SIEGE_ENGINE_INPLACEDATA_H
+#define SIEGE_ENGINE_INPLACEDATA_H
+
+#include <utils/Macros.h>
+#include <utils/collections/Span.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "PackFileData.h"
+
+#define PACKER_MAGIC_NUMBER_IN_PLACE "inp!"
+#define IN_PLACE_SECTION_ALIGNMENT 16
+
+namespace Siege::InPlace
+{
+
+// In-place records store each array of a resource as an aligned section of raw bytes so that it
+// can be read straight out of the decompressed pack memory. Section offsets are relative to the
+// start of the PackFileData block (which is allocated with malloc alignment), not its data field
+
+#pragma pack(push, 1)
+struct RecordHeader
+{
+    uint32_t magic;
+    uint32_t sectionCount;
+};
+
+struct Section
+{
+    uint32_t offset;
+    uint32_t size;
+};
+#pragma pack(pop)
+
+class Record
+{
+public:
+
+    // 'Structors
+
+    explicit Record(const PackFileData& data);
+
+    // Public methods
+
+    static bool IsRecord(const PackFileData& data);
+
+    bool IsValid() const;
+
+    uint32_t GetSectionCount() const;
+
+    template<typename T>
+    bool GetSection(uint32_t index, OUT Span<const T>& span) const
+    {
+        if (!IsValid() || index >= header->sectionCount) return false;
+
+        const Section& section = sections[index];
+        const uint8_t* start = base + section.offset;
+        if (section.size % sizeof(T) != 0) return false;
+        if (reinterpret_cast<uintptr_t>(start) % alignof(T) != 0) return false;
+
+        span = {reinterpret_cast<const T*>(start), section.size / sizeof(T)};
+        return true;
+    }
+
+private:
+
+    // Private fields
+
+    const uint8_t* base = nullptr;
+
+    const RecordHeader* header = nullptr;
+
+    const Section* sections = nullptr;
+};
+
+class Writer
+{
+public:
+
+    // Public methods
+
+    template<typename T>
+    void AddSection(const std::vector<T>& values)
+    {
+        AddSection(values.data(), values.size() * sizeof(T));
+    }
+
+    void AddSection(const void* data, uint32_t size);
+
+    PackFileData* Create() const;
+
+private:
+
+    // Private fields
+
+    std::vector<Section> sections;
+
+    std::vector<const void*> sectionData;
+};
+
+/**
+ * Fallback for types without an in-place layout, these are always deserialised instead
+ */
+template<typename T>
+bool Read(const Record&, T&)
+{
+    return false;
+}
+
+} // namespace Siege::InPlace
+
+#endif // SIEGE_ENGINE_INPLACEDATA_H
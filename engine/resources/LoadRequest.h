@@ -0,0 +1,214 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#ifndef SIEGE_ENGINE_LOADREQUEST_H
+#define SIEGE_ENGINE_LOADREQUEST_H
+
+#include <utils/String.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <type_traits>
+
+#include "PackFile.h"
+
+namespace Siege
+{
+
+enum class LoadPriority : uint8_t
+{
+    LOW = 0,
+    NORMAL = 1,
+    HIGH = 2
+};
+
+enum class LoadStatus : uint8_t
+{
+    PENDING,
+    COMPLETE,
+    FAILED,
+    CANCELLED
+};
+
+/**
+ * The untyped portion of an asynchronous load. The Load step runs on a worker thread, the
+ * Complete step runs on the main thread when the ResourceSystem completions are pumped
+ */
+class LoadRequest
+{
+public:
+
+    // 'Structors
+
+    LoadRequest(const String& path, LoadPriority priority) : path(path), priority(priority) {}
+
+    virtual ~LoadRequest() = default;
+
+    // Public methods
+
+    virtual void Load(PackFile& packFile) = 0;
+
+    virtual void Complete() = 0;
+
+    LoadStatus GetStatus() const
+    {
+        return status.load(std::memory_order_acquire);
+    }
+
+    bool IsCancelled() const
+    {
+        return cancelRequested.load(std::memory_order_acquire);
+    }
+
+    void Cancel()
+    {
+        cancelRequested.store(true, std::memory_order_release);
+    }
+
+    // Public fields
+
+    String path;
+
+    LoadPriority priority;
+
+    uint64_t sequence {0};
+
+protected:
+
+    // Protected fields
+
+    std::atomic<LoadStatus> status {LoadStatus::PENDING};
+
+    std::atomic<bool> cancelRequested {false};
+};
+
+template<typename T>
+class TypedLoadRequest : public LoadRequest
+{
+public:
+
+    using Callback = std::function<void(const std::shared_ptr<T>&)>;
+
+    // 'Structors
+
+    TypedLoadRequest(const String& path, LoadPriority priority, Callback callback) :
+        LoadRequest(path, priority),
+        callback(std::move(callback))
+    {}
+
+    // Public methods
+
+    void Load(PackFile& packFile) override
+    {
+        if (IsCancelled()) return;
+
+        if constexpr (std::is_same_v<T, PackFileData>) loadedData = packFile.FindData(path);
+        else loadedData = packFile.FindDataDeserialised<T>(path);
+    }
+
+    void Complete() override
+    {
+        if (IsCancelled())
+        {
+            loadedData.reset();
+            status.store(LoadStatus::CANCELLED, std::memory_order_release);
+            return;
+        }
+
+        if (!loadedData)
+        {
+            status.store(LoadStatus::FAILED, std::memory_order_release);
+            return;
+        }
+
+        data = std::move(loadedData);
+        status.store(LoadStatus::COMPLETE, std::memory_order_release);
+        if (callback) callback(data);
+    }
+
+    void Fail()
+    {
+        status.store(LoadStatus::FAILED, std::memory_order_release);
+    }
+
+    const std::shared_ptr<T>& GetData() const
+    {
+        return data;
+    }
+
+private:
+
+    // Private fields
+
+    Callback callback;
+
+    std::shared_ptr<T> loadedData;
+
+    std::shared_ptr<T> data;
+};
+
+/**
+ * A handle to an asynchronous load. Results only become visible once the main thread has
+ * pumped the load's completion, so GPU finalisation in callbacks stays single-threaded
+ */
+template<typename T>
+class LoadHandle
+{
+public:
+
+    // 'Structors
+
+    LoadHandle() = default;
+
+    explicit LoadHandle(std::shared_ptr<TypedLoadRequest<T>> request) : request(std::move(request))
+    {}
+
+    // Public methods
+
+    bool IsValid() const
+    {
+        return request != nullptr;
+    }
+
+    LoadStatus GetStatus() const
+    {
+        return request ? request->GetStatus() : LoadStatus::FAILED;
+    }
+
+    bool IsDone() const
+    {
+        return GetStatus() != LoadStatus::PENDING;
+    }
+
+    bool IsReady() const
+    {
+        return GetStatus() == LoadStatus::COMPLETE;
+    }
+
+    void Cancel()
+    {
+        if (request) request->Cancel();
+    }
+
+    std::shared_ptr<T> Get() const
+    {
+        return IsReady() ? request->GetData() : nullptr;
+    }
+
+private:
+
+    // Private fields
+
+    std::shared_ptr<TypedLoadRequest<T>> request;
+};
+
+} // namespace Siege
+
+#endif // SIEGE_ENGINE_LOADREQUEST_H
@@ -0,0 +1,56 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#ifndef SIEGE_ENGINE_PACKBUNDLEDATA_H
+#define SIEGE_ENGINE_PACKBUNDLEDATA_H
+
+#include <utils/BinarySerialisation.h>
+
+// The reserved entry name under which the packer stores its bundle table
+#define PACKER_BUNDLE_TABLE_NAME "$bundles"
+
+namespace Siege
+{
+
+/**
+ * A contiguous range of pack body data holding every entry a scene is expected to load, so that
+ * it can be read in a single sequential read
+ */
+struct PackBundle
+{
+    uint64_t dataOffset = 0;
+    uint64_t dataSize = 0;
+    std::vector<String> entries;
+};
+
+struct PackBundleData
+{
+    std::map<String, PackBundle> bundles;
+};
+
+namespace BinarySerialisation
+{
+
+inline void serialise(Buffer& buffer, PackBundle& value, SerialisationMode mode)
+{
+    serialise(buffer, value.dataOffset, mode);
+    serialise(buffer, value.dataSize, mode);
+    serialise(buffer, value.entries, mode);
+}
+
+inline void serialise(Buffer& buffer, PackBundleData& value, SerialisationMode mode)
+{
+    serialise(buffer, value.bundles, mode);
+}
+
+} // namespace BinarySerialisation
+
+} // namespace Siege
+
+#endif // SIEGE_ENGINE_PACKBUNDLEDATA_H
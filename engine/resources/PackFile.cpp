@@ -12,68 +12,317 @@
 #include <utils/FileSystem.h>
 #include <utils/Logging.h>
 
+#include <algorithm>
+#include <cstddef>
 #include <fstream>
 #include <iostream>
-#include <map>
+#include <new>
+#include <unordered_map>
 
 namespace Siege
 {
 
-PackFile::PackFile(const String& filepath)
+// zlib's lengths are 32-bit on some platforms, so entries are streamed through it in chunks
+static constexpr uint64_t ZLIB_CHUNK_SIZE = 1u << 30;
+
+static bool Inflate(const char* compressedData,
+                    uint64_t compressedSize,
+                    char* data,
+                    uint64_t dataSize)
 {
-    LoadFromPath(filepath);
+    z_stream stream {};
+    if (inflateInit(&stream) != Z_OK) return false;
+
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(compressedData));
+    stream.next_out = reinterpret_cast<Bytef*>(data);
+
+    int result = Z_OK;
+    while (result == Z_OK)
+    {
+        if (stream.avail_in == 0)
+        {
+            stream.avail_in = static_cast<uInt>(std::min(compressedSize, ZLIB_CHUNK_SIZE));
+            compressedSize -= stream.avail_in;
+        }
+        if (stream.avail_out == 0)
+        {
+            stream.avail_out = static_cast<uInt>(std::min(dataSize, ZLIB_CHUNK_SIZE));
+            dataSize -= stream.avail_out;
+        }
+        result = inflate(&stream, Z_NO_FLUSH);
+    }
+    inflateEnd(&stream);
+
+    // The entry must fill exactly the size its ToC entry gives
+    return result == Z_STREAM_END && dataSize == 0 && stream.avail_out == 0;
 }
 
-bool PackFile::LoadFromPath(const String& filepath)
+// Version 1 entries are stored behind a 32-bit size, and in-place records placed their sections
+// relative to that smaller header, so both are rebuilt around the current header
+static PackFileData* ConvertV1Data(const char* dataV1, uint64_t size)
 {
+    if (size < sizeof(PackFileDataV1)) return PackFileData::Create(dataV1, 0);
+
+    auto fileDataV1 = reinterpret_cast<const PackFileDataV1*>(dataV1);
+    uint64_t dataSize = std::min<uint64_t>(fileDataV1->dataSize, size - sizeof(PackFileDataV1));
+
+    InPlace::RecordHeader recordHeader {};
+    if (dataSize >= sizeof(InPlace::RecordHeader))
+    {
+        memcpy(&recordHeader, fileDataV1->data, sizeof(InPlace::RecordHeader));
+    }
+
+    if (memcmp(&recordHeader.magic, PACKER_MAGIC_NUMBER_IN_PLACE, sizeof(uint32_t)) != 0)
+    {
+        return PackFileData::Create(fileDataV1->data, dataSize);
+    }
+
+    uint64_t sectionsSize =
+        static_cast<uint64_t>(recordHeader.sectionCount) * sizeof(InPlace::Section);
+    uint64_t headerEnd = sizeof(PackFileDataV1) + sizeof(InPlace::RecordHeader) + sectionsSize;
+    if (headerEnd > size) return PackFileData::Create(fileDataV1->data, dataSize);
+
+    InPlace::Writer writer;
+    const char* sectionsV1 = fileDataV1->data + sizeof(InPlace::RecordHeader);
+    for (uint32_t i = 0; i < recordHeader.sectionCount; i++)
+    {
+        InPlace::Section section {};
+        memcpy(&section, sectionsV1 + i * sizeof(InPlace::Section), sizeof(InPlace::Section));
+        if (static_cast<uint64_t>(section.offset) + section.size > size)
+        {
+            return PackFileData::Create(fileDataV1->data, dataSize);
+        }
+        writer.AddSection(dataV1 + section.offset, section.size);
+    }
+    return writer.Create();
+}
+
+PackFile::PackFile(const String& filepath, LoadMode mode)
+{
+    LoadFromPath(filepath, mode);
+}
+
+PackFile::~PackFile()
+{
+    Free();
+}
+
+bool PackFile::LoadFromPath(const String& filepath, LoadMode mode)
+{
+    Free();
+
     std::ifstream inputFileStream;
     inputFileStream.open(filepath, std::ios::in | std::ios::binary);
-    inputFileStream.read(reinterpret_cast<char*>(&header), sizeof(Header));
+    if (!inputFileStream)
+    {
+        CC_LOG_ERROR("Failed to open pack file at path \"{}\"", filepath)
+        return false;
+    }
+
+    if (!ReadHeader(inputFileStream, filepath, header)) return false;
+
+    char* tocStart = nullptr;
+    char* tocEnd = nullptr;
+    if (mode == RESIDENT)
+    {
+        // Keep the body at least as aligned as its entries so their data can be used in place
+        bodyAlignment = std::max<size_t>(header.entryAlignment, alignof(std::max_align_t));
+        body = static_cast<char*>(operator new(header.bodySize, std::align_val_t(bodyAlignment)));
+        inputFileStream.seekg(static_cast<std::streamoff>(header.bodyOffset));
+        inputFileStream.read(body, static_cast<std::streamsize>(header.bodySize));
+        inputFileStream.close();
 
-    body = reinterpret_cast<char*>(malloc(header.bodySize));
-    inputFileStream.read(body, (uint32_t) header.bodySize);
-    inputFileStream.close();
+        tocStart = body + header.tocOffset;
+        tocEnd = body + header.bodySize;
+    }
+    else
+    {
+        tocData.resize(header.bodySize - header.tocOffset);
+        inputFileStream.seekg(static_cast<std::streamoff>(header.bodyOffset + header.tocOffset));
+        inputFileStream.read(tocData.data(), static_cast<std::streamsize>(tocData.size()));
+        fileStream = std::move(inputFileStream);
+
+        tocStart = tocData.data();
+        tocEnd = tocData.data() + tocData.size();
+    }
 
-    char* tocStart = body + header.tocOffset;
     CC_ASSERT(memcmp(tocStart, &PACKER_MAGIC_NUMBER_TOC, 4) == 0, "Failed to find magic number!")
 
     char* tocCurr = tocStart + PACKER_MAGIC_NUMBER_SIZE;
-    char* tocEnd = body + header.bodySize;
+    bool result = header.version == PACKER_FILE_VERSION_V1 ? ReadTocV1(tocCurr, tocEnd) :
+                                                             ReadToc(tocCurr, tocEnd);
+
+    if (entries.count(PACKER_BUNDLE_TABLE_NAME))
+    {
+        std::shared_ptr<PackBundleData> bundles =
+            FindDataDeserialised<PackBundleData>(PACKER_BUNDLE_TABLE_NAME);
+        if (bundles) bundleData = *bundles;
+    }
+    return result;
+}
+
+bool PackFile::ReadHeader(const String& filepath, Header& header)
+{
+    std::ifstream inputFileStream;
+    inputFileStream.open(filepath, std::ios::in | std::ios::binary);
+    if (!inputFileStream)
+    {
+        CC_LOG_ERROR("Failed to open pack file at path \"{}\"", filepath)
+        return false;
+    }
+
+    return ReadHeader(inputFileStream, filepath, header);
+}
+
+bool PackFile::ReadHeader(std::ifstream& inputFileStream, const String& filepath, Header& header)
+{
+    // The version 1 header is a prefix of the current one, so read it first to find the version
+    inputFileStream.read(reinterpret_cast<char*>(&header), sizeof(HeaderV1));
+    if (!inputFileStream || memcmp(header.magic.string, PACKER_MAGIC_NUMBER_FILE, 4) != 0)
+    {
+        CC_LOG_ERROR("File at path \"{}\" is not a pack file", filepath)
+        return false;
+    }
+
+    if (header.version == PACKER_FILE_VERSION_V1)
+    {
+        header.bodyOffset = sizeof(HeaderV1);
+        header.entryAlignment = 1;
+        header.flags = 0;
+    }
+    else if (header.version == PACKER_FILE_VERSION)
+    {
+        inputFileStream.seekg(0);
+        inputFileStream.read(reinterpret_cast<char*>(&header), sizeof(Header));
+    }
+    else
+    {
+        CC_LOG_ERROR("Pack file at path \"{}\" has unsupported version {}",
+                     filepath,
+                     header.version)
+        return false;
+    }
+    return true;
+}
+
+bool PackFile::ReadTocV1(const char* tocStart, const char* tocEnd)
+{
+    const char* tocCurr = tocStart;
     while (tocCurr < tocEnd)
     {
-        TocEntry* toc = reinterpret_cast<TocEntry*>(tocCurr);
-        if (!toc)
-        {
-            break;
-        }
+        const TocEntryV1* tocV1 = reinterpret_cast<const TocEntryV1*>(tocCurr);
+        tocCurr += tocV1->GetDataSize();
+
+        TocEntry* toc = TocEntry::Create(tocV1->name, tocV1->dataOffset, tocV1->dataSize);
+        toc->dataSizeCompressed = tocV1->dataSizeCompressed;
+        convertedEntries.push_back(toc);
+        entries.emplace(toc->name, toc);
+    }
+    return true;
+}
+
+bool PackFile::ReadToc(const char* tocStart, const char* tocEnd)
+{
+    const char* tocCurr = tocStart;
+    while (tocCurr < tocEnd)
+    {
+        TocEntry* toc = reinterpret_cast<TocEntry*>(const_cast<char*>(tocCurr));
         tocCurr += toc->GetDataSize();
         entries.emplace(toc->name, toc);
     }
     return true;
 }
 
+void PackFile::Free()
+{
+    entries.clear();
+    for (TocEntry* toc : convertedEntries) free(toc);
+    convertedEntries.clear();
+
+    if (body) operator delete(body, std::align_val_t(bodyAlignment));
+    body = nullptr;
+    header = {};
+
+    tocData.clear();
+    bundleData = {};
+    preloadedBundles.clear();
+    if (fileStream.is_open()) fileStream.close();
+}
+
+std::shared_ptr<const char> PackFile::ReadBodyRange(uint64_t dataOffset, uint64_t dataSize)
+{
+    std::lock_guard<std::mutex> lock(fileStreamMutex);
+
+    // Serve the range from a preloaded bundle where possible, sharing ownership of its memory
+    for (const auto& bundle : preloadedBundles)
+    {
+        const PreloadedRange& range = bundle.second;
+        if (dataOffset >= range.dataOffset &&
+            dataOffset + dataSize <= range.dataOffset + range.data->size())
+        {
+            return {range.data, range.data->data() + (dataOffset - range.dataOffset)};
+        }
+    }
+
+    auto data = std::make_shared<std::vector<char>>(dataSize);
+    if (!ReadFileRange(dataOffset, data->data(), dataSize)) return nullptr;
+    return {data, data->data()};
+}
+
+bool PackFile::ReadFileRange(uint64_t dataOffset, char* data, uint64_t dataSize)
+{
+    fileStream.seekg(static_cast<std::streamoff>(header.bodyOffset + dataOffset));
+    fileStream.read(data, static_cast<std::streamsize>(dataSize));
+    if (!fileStream)
+    {
+        fileStream.clear();
+        return false;
+    }
+    return true;
+}
+
 std::shared_ptr<PackFileData> PackFile::FindData(const String& filepath)
 {
-    const TocEntry* toc = entries[filepath];
-    if (!toc)
+    // Lookups must not modify the entry map, as they may come from loader worker threads
+    auto it = entries.find(filepath);
+    if (it == entries.end() || !it->second || it->second->IsRemoved())
+    {
+        return nullptr;
+    }
+
+    const TocEntry* toc = it->second;
+
+    std::shared_ptr<const char> compressedData;
+    if (body) compressedData = {std::shared_ptr<char>(), body + toc->dataOffset};
+    else compressedData = ReadBodyRange(toc->dataOffset, toc->dataSizeCompressed);
+
+    if (!compressedData)
     {
+        CC_LOG_ERROR("Failed to read data for filepath \"{}\"", filepath)
         return nullptr;
     }
 
-    uLongf bodyDataSizeUncompressed = toc->dataSize;
-    uLongf bodyDataSizeCompressed = toc->dataSizeCompressed;
+    if (header.version == PACKER_FILE_VERSION_V1)
+    {
+        std::vector<char> dataV1(toc->dataSize);
+        bool result =
+            Inflate(compressedData.get(), toc->dataSizeCompressed, dataV1.data(), dataV1.size());
+        CC_ASSERT(result, "Decompression failed for filepath: " + filepath);
+
+        return {ConvertV1Data(dataV1.data(), dataV1.size()), free};
+    }
 
-    PackFileData* packFileData = new (malloc(bodyDataSizeUncompressed)) PackFileData();
-    int result = uncompress(reinterpret_cast<Bytef*>(packFileData),
-                            &bodyDataSizeUncompressed,
-                            reinterpret_cast<Bytef*>(body + toc->dataOffset),
-                            bodyDataSizeCompressed);
-    CC_ASSERT(result == Z_OK, "Decompression failed for filepath: " + filepath);
+    PackFileData* packFileData = new (malloc(toc->dataSize)) PackFileData();
+    bool result = Inflate(compressedData.get(),
+                          toc->dataSizeCompressed,
+                          reinterpret_cast<char*>(packFileData),
+                          toc->dataSize);
+    CC_ASSERT(result, "Decompression failed for filepath: " + filepath);
 
     return {packFileData, free};
 }
 
-const std::map<String, PackFile::TocEntry*>& PackFile::GetEntries()
+const std::unordered_map<String, PackFile::TocEntry*>& PackFile::GetEntries()
 {
     return entries;
 }
@@ -83,9 +332,54 @@ const PackFile::Header& PackFile::GetHeader()
     return header;
 }
 
+bool PackFile::IsValid() const
+{
+    return body != nullptr || fileStream.is_open();
+}
+
+bool PackFile::IsDelta() const
+{
+    return header.flags & PACKER_FLAG_DELTA;
+}
+
+const PackBundle* PackFile::FindBundle(const String& name) const
+{
+    auto it = bundleData.bundles.find(name);
+    return it != bundleData.bundles.end() ? &it->second : nullptr;
+}
+
+bool PackFile::PreloadBundle(const String& name)
+{
+    const PackBundle* bundle = FindBundle(name);
+    if (!bundle) return false;
+    if (body) return true;
+
+    std::lock_guard<std::mutex> lock(fileStreamMutex);
+    if (preloadedBundles.count(name)) return true;
+
+    // Read straight into the memory the bundle keeps, so it is only ever held once
+    auto rangeData = std::make_shared<std::vector<char>>(bundle->dataSize);
+    if (!ReadFileRange(bundle->dataOffset, rangeData->data(), bundle->dataSize)) return false;
+
+    preloadedBundles[name] = {bundle->dataOffset, std::move(rangeData)};
+    return true;
+}
+
+void PackFile::ReleaseBundle(const String& name)
+{
+    std::lock_guard<std::mutex> lock(fileStreamMutex);
+    preloadedBundles.erase(name);
+}
+
+void PackFile::ReleaseBundles()
+{
+    std::lock_guard<std::mutex> lock(fileStreamMutex);
+    preloadedBundles.clear();
+}
+
 PackFile::TocEntry* PackFile::TocEntry::Create(const String& name,
-                                               uint32_t dataOffset,
-                                               uint32_t dataSize)
+                                               uint64_t dataOffset,
+                                               uint64_t dataSize)
 {
     uint32_t nameDataSize = name.Size() + 1;
     void* mem = malloc(sizeof(TocEntry) + nameDataSize);
@@ -93,6 +387,7 @@ PackFile::TocEntry* PackFile::TocEntry::Create(const String& name,
     TocEntry* tocEntry = new (mem) TocEntry();
     tocEntry->dataOffset = dataOffset;
     tocEntry->dataSize = dataSize;
+    tocEntry->dataSizeCompressed = 0;
     strcpy(&tocEntry->name[0], name.Str());
 
     return tocEntry;
@@ -115,7 +410,10 @@ std::ostream& operator<<(std::ostream& os, const Siege::PackFile::Header& header
     os << "magic: " << header.magic << ", ";
     os << "version: " << header.version << ", ";
     os << "bodySize: " << header.bodySize << ", ";
-    os << "tocOffset: " << header.tocOffset << "}";
+    os << "tocOffset: " << header.tocOffset << ", ";
+    os << "bodyOffset: " << header.bodyOffset << ", ";
+    os << "entryAlignment: " << header.entryAlignment << ", ";
+    os << "flags: " << header.flags << "}";
     return os;
 }
 
@@ -124,6 +422,7 @@ std::ostream& operator<<(std::ostream& os, const Siege::PackFile::TocEntry& tocE
     os << "PackFile::TocEntry: {";
     os << "dataOffset: " << tocEntry.dataOffset << ", ";
     os << "dataSize: " << tocEntry.dataSize << ", ";
+    os << "dataSizeCompressed: " << tocEntry.dataSizeCompressed << ", ";
     os << "name: " << tocEntry.name << "}";
     return os;
 }
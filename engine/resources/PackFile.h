@@ -16,9 +16,14 @@
 #include <zlib.h>
 
 #include <filesystem>
-#include <map>
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
 
 #include "AnimationData.h"
+#include "FontData.h"
+#include "InPlaceData.h"
+#include "PackBundleData.h"
 #include "PackFileData.h"
 #include "SceneData.h"
 #include "SkeletalMeshData.h"
@@ -28,7 +33,14 @@
 #define PACKER_MAGIC_NUMBER_FILE "pck"
 #define PACKER_MAGIC_NUMBER_TOC "toc!"
 #define PACKER_MAGIC_NUMBER_SIZE sizeof(uint32_t)
-#define PACKER_FILE_VERSION 1
+#define PACKER_FILE_VERSION 2
+#define PACKER_FILE_VERSION_V1 1
+#define PACKER_DEFAULT_ENTRY_ALIGNMENT 16
+#define PACKER_FLAG_DELTA (1u << 0)
+
+// Entry names starting with this character are generated by the packer rather than read from its
+// inputs, such as the bundle table
+#define PACKER_GENERATED_ENTRY_PREFIX '$'
 
 namespace Siege
 {
@@ -44,37 +56,93 @@ public:
         uint32_t number;
     };
 
+    // Version 1 files are read through this struct and converted on load
+    struct HeaderV1
+    {
+        MagicNumber magic;
+        uint32_t version;
+        uint64_t bodySize;
+        uint64_t tocOffset;
+    };
+
     struct Header
     {
         MagicNumber magic;
         uint32_t version;
         uint64_t bodySize;
         uint64_t tocOffset;
+        uint64_t bodyOffset;
+        uint32_t entryAlignment;
+        uint32_t flags;
     };
 
-    struct TocEntry
+    struct TocEntryV1
     {
         uint32_t dataOffset;
         uint32_t dataSize;
         uint32_t dataSizeCompressed;
         char name[];
 
+        uint32_t GetDataSize() const
+        {
+            return sizeof(TocEntryV1) + strlen(name) + 1;
+        }
+    };
+
+    struct TocEntry
+    {
+        uint64_t dataOffset;
+        uint64_t dataSize;
+        uint64_t dataSizeCompressed;
+        char name[];
+
         uint32_t GetDataSize() const
         {
             return sizeof(TocEntry) + strlen(name) + 1;
         }
 
-        static TocEntry* Create(const String& name, uint32_t dataOffset, uint32_t dataSize);
+        // Delta packs mark entries removed from their base pack with an empty entry
+        bool IsRemoved() const
+        {
+            return dataSize == 0;
+        }
+
+        static TocEntry* Create(const String& name, uint64_t dataOffset, uint64_t dataSize);
     };
 #pragma pack(pop)
 
+    enum LoadMode : uint8_t
+    {
+        // The whole body is read into memory when the pack is loaded
+        RESIDENT,
+        // Only the ToC is read up front, entry data is read from the file on demand
+        STREAMED
+    };
+
     // 'Structors
 
-    explicit PackFile(const String& filepath);
+    explicit PackFile(const String& filepath, LoadMode mode = RESIDENT);
+
+    PackFile(const PackFile& other) = delete;
+
+    ~PackFile();
+
+    // Operator overloads
+
+    PackFile& operator=(const PackFile& other) = delete;
 
     // Public methods
 
-    bool LoadFromPath(const String& filepath);
+    bool LoadFromPath(const String& filepath, LoadMode mode = RESIDENT);
+
+    /**
+     * Reads only the header of a pack file, without loading its ToC or body. Version 1 headers
+     * are converted to the current layout
+     * @param filepath - the path of the pack file
+     * @param header - the header read from the file
+     * @return true if the file is a pack file of a supported version, false otherwise
+     */
+    static bool ReadHeader(const String& filepath, Header& header);
 
     std::shared_ptr<PackFileData> FindData(const String& filepath);
 
@@ -88,20 +156,124 @@ public:
             return nullptr;
         }
 
-        BinarySerialisation::Buffer dataBuffer;
-        dataBuffer.Fill(reinterpret_cast<uint8_t*>(packFileData->data), packFileData->dataSize);
+        return Deserialise<T>(*packFileData, filepath);
+    }
+
+    /**
+     * Finds packed data and returns a read-only view of it. Data packed with the in-place layout
+     * is viewed directly in the decompressed pack memory, anything else is deserialised first
+     * and the view refers to that copy. Either way the returned pointer keeps the memory alive
+     * @param filepath - the path of the packed data to view
+     * @return a view type such as StaticMeshDataView, or nullptr if the data could not be found
+     */
+    template<typename TView>
+    std::shared_ptr<const TView> FindDataView(const String& filepath)
+    {
+        using TData = typename TView::DataType;
+
+        struct ViewStorage
+        {
+            TView view;
+            std::shared_ptr<PackFileData> packFileData;
+            std::shared_ptr<TData> data;
+        };
+
+        std::shared_ptr<PackFileData> packFileData = FindData(filepath);
+        if (!packFileData)
+        {
+            CC_LOG_WARNING("Failed to find data for filepath \"{}\"", filepath);
+            return nullptr;
+        }
 
+        auto storage = std::make_shared<ViewStorage>();
+        if (InPlace::Record::IsRecord(*packFileData))
+        {
+            if (!InPlace::Read(InPlace::Record(*packFileData), storage->view))
+            {
+                CC_LOG_WARNING("Failed to read in-place data for filepath \"{}\"", filepath);
+                return nullptr;
+            }
+            storage->packFileData = std::move(packFileData);
+        }
+        else
+        {
+            storage->data = Deserialise<TData>(*packFileData, filepath);
+            if (!storage->data) return nullptr;
+            InPlace::View(*storage->data, storage->view);
+        }
+
+        return std::shared_ptr<const TView>(storage, &storage->view);
+    }
+
+    const std::unordered_map<String, TocEntry*>& GetEntries();
+
+    const Header& GetHeader();
+
+    bool IsValid() const;
+
+    bool IsDelta() const;
+
+    const PackBundle* FindBundle(const String& name) const;
+
+    /**
+     * Reads a bundle's data range in one sequential read and keeps it in memory, so that later
+     * lookups of its entries do not touch the file. Does nothing for resident packs
+     * @param name - the name of the bundle, which is the path of the scene it was built for
+     * @return true if the bundle exists in this pack, false otherwise
+     */
+    bool PreloadBundle(const String& name);
+
+    void ReleaseBundle(const String& name);
+
+    void ReleaseBundles();
+
+private:
+
+    // Private structs
+
+    struct PreloadedRange
+    {
+        uint64_t dataOffset = 0;
+        std::shared_ptr<std::vector<char>> data;
+    };
+
+    // Private methods
+
+    template<typename T>
+    std::shared_ptr<T> Deserialise(const PackFileData& packFileData, const String& filepath)
+    {
         T* typedData = new T();
+        if (InPlace::Record::IsRecord(packFileData))
+        {
+            if (!InPlace::Read(InPlace::Record(packFileData), *typedData))
+            {
+                CC_LOG_WARNING("Failed to read in-place data for filepath \"{}\"", filepath);
+                delete typedData;
+                return nullptr;
+            }
+            return std::shared_ptr<T>(typedData);
+        }
+
+        BinarySerialisation::Buffer dataBuffer;
+        dataBuffer.Fill(reinterpret_cast<const uint8_t*>(packFileData.data),
+                        packFileData.dataSize);
         BinarySerialisation::serialise(dataBuffer, *typedData, BinarySerialisation::DESERIALISE);
 
         return std::shared_ptr<T>(typedData);
     }
 
-    const std::map<String, TocEntry*>& GetEntries();
+    static bool ReadHeader(std::ifstream& inputFileStream, const String& filepath, Header& header);
 
-    const Header& GetHeader();
+    std::shared_ptr<const char> ReadBodyRange(uint64_t dataOffset, uint64_t dataSize);
 
-private:
+    // Reads a range of the body from the file, the stream mutex must already be held
+    bool ReadFileRange(uint64_t dataOffset, char* data, uint64_t dataSize);
+
+    bool ReadTocV1(const char* tocStart, const char* tocEnd);
+
+    bool ReadToc(const char* tocStart, const char* tocEnd);
+
+    void Free();
 
     // Private fields
 
@@ -109,7 +281,21 @@ private:
 
     char* body = nullptr;
 
-    std::map<String, TocEntry*> entries;
+    size_t bodyAlignment = 0;
+
+    std::vector<char> tocData;
+
+    std::unordered_map<String, TocEntry*> entries;
+
+    std::vector<TocEntry*> convertedEntries;
+
+    PackBundleData bundleData;
+
+    std::ifstream fileStream;
+
+    std::mutex fileStreamMutex;
+
+    std::map<String, PreloadedRange> preloadedBundles;
 };
 
 } // namespace Siege
@@ -19,22 +19,29 @@ namespace Siege
 {
 
 #pragma pack(push, 1)
-struct PackFileData
+// Version 1 packs store each entry behind a 32-bit size, entries are converted on load
+struct PackFileDataV1
 {
     uint32_t dataSize = 0;
     char data[];
+};
+
+struct PackFileData
+{
+    uint64_t dataSize = 0;
+    char data[];
 
     const char* GetData() const
     {
         return &data[0];
     }
 
-    uint32_t GetDataSize() const
+    uint64_t GetDataSize() const
     {
         return sizeof(PackFileData) + dataSize;
     }
 
-    static PackFileData* Create(char* data, uint32_t dataSize)
+    static PackFileData* Create(const char* data, uint64_t dataSize)
     {
         void* mem = malloc(sizeof(PackFileData) + dataSize);
         PackFileData* fileData = new (mem) PackFileData();
@@ -9,14 +9,25 @@
 
 #include "ResourceSystem.h"
 
+#include <utils/FileSystem.h>
+
+#include <algorithm>
+
 #include "PackFile.h"
 
 namespace Siege
 {
 
-bool ResourceSystem::MountPackFile(const String& searchPath)
+static constexpr uint32_t MAX_DEFAULT_LOAD_WORKERS = 4;
+
+ResourceSystem::~ResourceSystem()
 {
-    if (packFile) return false;
+    StopLoadWorkers();
+}
+
+bool ResourceSystem::MountPackFile(const String& searchPath, PackFile::LoadMode mode)
+{
+    if (!packFiles.empty()) return false;
 
     const char* basePath = "./";
     if (!searchPath.IsEmpty())
@@ -24,29 +35,243 @@ bool ResourceSystem::MountPackFile(const String& searchPath)
         basePath = searchPath.Str();
     }
 
-    std::filesystem::path packFilePath;
+    // Patch packs may sit alongside the base pack, so take the first pack that is not a delta
+    std::vector<std::filesystem::path> packFilePaths;
     for (const auto& entry : std::filesystem::directory_iterator(basePath))
     {
-        if (entry.path().extension() == ".pck")
+        if (entry.path().extension() == ".pck") packFilePaths.push_back(entry.path());
+    }
+    std::sort(packFilePaths.begin(), packFilePaths.end());
+
+    // Only headers are read while searching, so patch packs are never loaded just to be skipped
+    for (const std::filesystem::path& packFilePath : packFilePaths)
+    {
+        String filepath = packFilePath.string().c_str();
+
+        PackFile::Header header {};
+        if (!PackFile::ReadHeader(filepath, header) || header.flags & PACKER_FLAG_DELTA) continue;
+
+        PackFile* packFile = new PackFile(filepath, mode);
+        if (packFile->IsValid())
         {
-            packFile = new PackFile(entry.path().c_str());
+            AddPackFile(packFile);
             return true;
         }
+        delete packFile;
     }
     return false;
 }
 
+bool ResourceSystem::MountPatchPackFile(const String& filepath, PackFile::LoadMode mode)
+{
+    if (packFiles.empty())
+    {
+        CC_LOG_WARNING("Cannot mount patch pack \"{}\" without a base pack mounted", filepath)
+        return false;
+    }
+
+    PackFile* packFile = new PackFile(filepath, mode);
+    if (!packFile->IsValid())
+    {
+        delete packFile;
+        return false;
+    }
+
+    AddPackFile(packFile);
+    return true;
+}
+
 void ResourceSystem::UnmountPackFile()
 {
-    delete packFile;
-    packFile = nullptr;
+    // Workers read from the pack files, so they must be finished before they are freed
+    StopLoadWorkers();
+
+    std::unique_lock<std::shared_mutex> lock(packFilesMutex);
+    for (PackFile* packFile : packFiles) delete packFile;
+    packFiles.clear();
+    packFileIndex.clear();
 }
 
 PackFile* ResourceSystem::GetPackFile()
 {
+    return packFiles.empty() ? nullptr : packFiles.front();
+}
+
+const std::vector<PackFile*>& ResourceSystem::GetPackFiles()
+{
+    return packFiles;
+}
+
+PackFile* ResourceSystem::FindPackFile(const String& filepath)
+{
+    PackFile* packFile = nullptr;
+    {
+        std::shared_lock<std::shared_mutex> lock(packFilesMutex);
+        auto it = packFileIndex.find(filepath);
+        if (it != packFileIndex.end()) packFile = it->second;
+    }
+
+    if (packFile && accessTraceEnabled.load(std::memory_order_relaxed))
+    {
+        std::lock_guard<std::mutex> lock(accessTraceMutex);
+        if (tracedEntries.insert(filepath).second) accessTrace.push_back(filepath);
+    }
     return packFile;
 }
 
+std::shared_ptr<PackFileData> ResourceSystem::FindData(const String& filepath)
+{
+    PackFile* packFile = FindPackFile(filepath);
+    return packFile ? packFile->FindData(filepath) : nullptr;
+}
+
+bool ResourceSystem::PreloadBundle(const String& name)
+{
+    std::shared_lock<std::shared_mutex> lock(packFilesMutex);
+    bool found = false;
+    for (auto it = packFiles.rbegin(); it != packFiles.rend(); ++it)
+    {
+        found |= (*it)->PreloadBundle(name);
+    }
+    return found;
+}
+
+void ResourceSystem::ReleaseBundles()
+{
+    std::shared_lock<std::shared_mutex> lock(packFilesMutex);
+    for (PackFile* packFile : packFiles) packFile->ReleaseBundles();
+}
+
+void ResourceSystem::StartAccessTrace()
+{
+    std::lock_guard<std::mutex> lock(accessTraceMutex);
+    accessTrace.clear();
+    tracedEntries.clear();
+    accessTraceEnabled.store(true, std::memory_order_relaxed);
+}
+
+bool ResourceSystem::StopAccessTrace(const String& outputPath)
+{
+    std::lock_guard<std::mutex> lock(accessTraceMutex);
+    accessTraceEnabled.store(false, std::memory_order_relaxed);
+
+    String content;
+    for (const String& entry : accessTrace) content += entry + "\n";
+    accessTrace.clear();
+    tracedEntries.clear();
+    return FileSystem::Save(outputPath, content);
+}
+
+void ResourceSystem::AddPackFile(PackFile* packFile)
+{
+    std::unique_lock<std::shared_mutex> lock(packFilesMutex);
+    packFiles.push_back(packFile);
+    for (const auto& entry : packFile->GetEntries())
+    {
+        if (entry.second->IsRemoved()) packFileIndex.erase(entry.first);
+        else packFileIndex[entry.first] = packFile;
+    }
+}
+
+uint32_t ResourceSystem::PumpCompletions(uint32_t maxCompletions)
+{
+    std::deque<std::shared_ptr<LoadRequest>> completions;
+    {
+        std::lock_guard<std::mutex> lock(completedLoadsMutex);
+        uint32_t count = std::min(maxCompletions, static_cast<uint32_t>(completedLoads.size()));
+        completions.insert(completions.end(),
+                           completedLoads.begin(),
+                           completedLoads.begin() + count);
+        completedLoads.erase(completedLoads.begin(), completedLoads.begin() + count);
+    }
+
+    // Callbacks are run outside the lock so that they can queue further loads
+    for (auto& request : completions) request->Complete();
+    pendingLoadCount -= completions.size();
+    return completions.size();
+}
+
+bool ResourceSystem::HasPendingLoads() const
+{
+    return pendingLoadCount > 0;
+}
+
+void ResourceSystem::StartLoadWorkers(uint32_t workerCount)
+{
+    if (!loadWorkers.empty()) return;
+
+    if (workerCount == 0)
+    {
+        uint32_t hardwareThreads = std::thread::hardware_concurrency();
+        workerCount = std::clamp(hardwareThreads > 1 ? hardwareThreads - 1 : 1u,
+                                 1u,
+                                 MAX_DEFAULT_LOAD_WORKERS);
+    }
+
+    stopLoadWorkers = false;
+    for (uint32_t i = 0; i < workerCount; i++)
+    {
+        loadWorkers.emplace_back(&ResourceSystem::RunLoadWorker, this);
+    }
+}
+
+void ResourceSystem::StopLoadWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(loadQueueMutex);
+        stopLoadWorkers = true;
+    }
+    loadQueueCondition.notify_all();
+
+    for (auto& worker : loadWorkers) worker.join();
+    loadWorkers.clear();
+
+    // Anything left in the queue never started, so hand it back cancelled
+    std::lock_guard<std::mutex> queueLock(loadQueueMutex);
+    std::lock_guard<std::mutex> completedLock(completedLoadsMutex);
+    while (!queuedLoads.empty())
+    {
+        queuedLoads.top()->Cancel();
+        completedLoads.push_back(queuedLoads.top());
+        queuedLoads.pop();
+    }
+}
+
+void ResourceSystem::QueueLoad(const std::shared_ptr<LoadRequest>& request)
+{
+    StartLoadWorkers();
+
+    {
+        std::lock_guard<std::mutex> lock(loadQueueMutex);
+        request->sequence = nextLoadSequence++;
+        queuedLoads.push(request);
+    }
+    pendingLoadCount++;
+    loadQueueCondition.notify_one();
+}
+
+void ResourceSystem::RunLoadWorker()
+{
+    while (true)
+    {
+        std::shared_ptr<LoadRequest> request;
+        {
+            std::unique_lock<std::mutex> lock(loadQueueMutex);
+            loadQueueCondition.wait(lock,
+                                    [this] { return stopLoadWorkers || !queuedLoads.empty(); });
+            if (stopLoadWorkers) return;
+
+            request = queuedLoads.top();
+            queuedLoads.pop();
+        }
+
+        if (PackFile* packFile = FindPackFile(request->path)) request->Load(*packFile);
+
+        std::lock_guard<std::mutex> lock(completedLoadsMutex);
+        completedLoads.push_back(request);
+    }
+}
+
 ResourceSystem& ResourceSystem::GetInstance()
 {
     static ResourceSystem resourceSystem;
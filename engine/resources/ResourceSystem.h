@@ -10,8 +10,22 @@
 #ifndef SIEGE_ENGINE_RESOURCESYSTEM_H
 #define SIEGE_ENGINE_RESOURCESYSTEM_H
 
+#include <utils/Logging.h>
 #include <utils/String.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <queue>
+#include <shared_mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "LoadRequest.h"
+
 namespace Siege
 {
 
@@ -19,21 +33,202 @@ class ResourceSystem
 {
 public:
 
+    // 'Structors
+
+    ~ResourceSystem();
+
     // Public methods
 
     static ResourceSystem& GetInstance();
 
-    bool MountPackFile(const String& searchPath = {});
+    bool MountPackFile(const String& searchPath = {},
+                       PackFile::LoadMode mode = PackFile::RESIDENT);
+
+    /**
+     * Mounts a pack on top of the currently mounted packs. Its entries shadow any entries of the
+     * same name in packs mounted before it, and entries it marks as removed are hidden
+     * @param filepath - the path of the pack file to mount
+     * @param mode - whether the pack body is read up front or streamed from the file on demand
+     * @return true if the pack was mounted, false if no base pack is mounted or it failed to load
+     */
+    bool MountPatchPackFile(const String& filepath, PackFile::LoadMode mode = PackFile::RESIDENT);
 
+    /**
+     * Unmounts all mounted packs, cancelling any loads still waiting to be started
+     */
     void UnmountPackFile();
 
-    class PackFile* GetPackFile();
+    /**
+     * Gets the base pack, the first one mounted. Lookups through it will not see patched entries,
+     * so prefer the Find methods on the ResourceSystem
+     * @return the base pack file, or nullptr if none is mounted
+     */
+    PackFile* GetPackFile();
+
+    const std::vector<PackFile*>& GetPackFiles();
+
+    /**
+     * Finds the pack that provides an entry, taking patch packs into account
+     * @param filepath - the path of the packed data
+     * @return the topmost pack file containing the entry, or nullptr if no pack contains it
+     */
+    PackFile* FindPackFile(const String& filepath);
+
+    std::shared_ptr<PackFileData> FindData(const String& filepath);
+
+    /**
+     * Preloads the named bundle from every mounted pack that has one, topmost first, so that the
+     * entries of a scene are read from streamed packs in one sequential read per pack
+     * @param name - the name of the bundle, which is the path of the scene it was built for
+     * @return true if any mounted pack had the bundle, false otherwise
+     */
+    bool PreloadBundle(const String& name);
+
+    void ReleaseBundles();
+
+    /**
+     * Starts recording the entries looked up through the ResourceSystem in first-access order.
+     * The recorded trace can be passed to the packer to order entries within scene bundles
+     */
+    void StartAccessTrace();
+
+    /**
+     * Stops recording entry lookups and writes the trace out as one entry name per line
+     * @param outputPath - the path to write the trace to
+     * @return true if the trace was written, false otherwise
+     */
+    bool StopAccessTrace(const String& outputPath);
+
+    template<typename T>
+    std::shared_ptr<T> FindDataDeserialised(const String& filepath)
+    {
+        PackFile* packFile = FindPackFile(filepath);
+        if (!packFile)
+        {
+            CC_LOG_WARNING("Failed to find data for filepath \"{}\"", filepath);
+            return nullptr;
+        }
+        return packFile->FindDataDeserialised<T>(filepath);
+    }
+
+    template<typename TView>
+    std::shared_ptr<const TView> FindDataView(const String& filepath)
+    {
+        PackFile* packFile = FindPackFile(filepath);
+        if (!packFile)
+        {
+            CC_LOG_WARNING("Failed to find data for filepath \"{}\"", filepath);
+            return nullptr;
+        }
+        return packFile->FindDataView<TView>(filepath);
+    }
+
+    /**
+     * Queues a load of the packed data at the given path onto the loader worker pool. Workers
+     * are started on first use if StartLoadWorkers has not been called
+     * @param path - the path of the packed data to load
+     * @param priority - the priority of the load relative to other queued loads
+     * @param callback - an optional function called on the main thread once the load succeeds
+     * @return a handle to the load, which is fulfilled during PumpCompletions
+     */
+    template<typename T>
+    LoadHandle<T> LoadAsync(const String& path,
+                            LoadPriority priority = LoadPriority::NORMAL,
+                            typename TypedLoadRequest<T>::Callback callback = {})
+    {
+        auto request = std::make_shared<TypedLoadRequest<T>>(path, priority, std::move(callback));
+        if (packFiles.empty())
+        {
+            CC_LOG_WARNING("Cannot load \"{}\" asynchronously without a mounted pack file", path);
+            request->Fail();
+            return LoadHandle<T>(request);
+        }
+
+        QueueLoad(request);
+        return LoadHandle<T>(request);
+    }
+
+    /**
+     * Finalises loads that the workers have finished with, should be called once per frame on
+     * the main thread. Completion callbacks are run from within this call
+     * @param maxCompletions - the maximum number of loads to finalise in this call
+     * @return the number of loads finalised
+     */
+    uint32_t PumpCompletions(uint32_t maxCompletions = UINT32_MAX);
+
+    bool HasPendingLoads() const;
+
+    /**
+     * Starts the loader worker pool
+     * @param workerCount - the number of workers to start, or 0 to pick from the hardware
+     */
+    void StartLoadWorkers(uint32_t workerCount = 0);
+
+    /**
+     * Stops the loader worker pool. Loads still waiting in the queue are cancelled
+     */
+    void StopLoadWorkers();
 
 private:
 
+    // Private structs
+
+    struct LoadRequestCompare
+    {
+        bool operator()(const std::shared_ptr<LoadRequest>& lhs,
+                        const std::shared_ptr<LoadRequest>& rhs) const
+        {
+            if (lhs->priority != rhs->priority) return lhs->priority < rhs->priority;
+            return lhs->sequence > rhs->sequence;
+        }
+    };
+
+    // Private methods
+
+    void AddPackFile(PackFile* packFile);
+
+    void QueueLoad(const std::shared_ptr<LoadRequest>& request);
+
+    void RunLoadWorker();
+
     // Private fields
 
-    PackFile* packFile = nullptr;
+    std::vector<PackFile*> packFiles;
+
+    // Maps every visible entry to the topmost pack providing it, so lookups stay O(1) however
+    // many patches are mounted
+    std::unordered_map<String, PackFile*> packFileIndex;
+
+    std::shared_mutex packFilesMutex;
+
+    std::atomic<bool> accessTraceEnabled {false};
+
+    std::mutex accessTraceMutex;
+
+    std::vector<String> accessTrace;
+
+    std::unordered_set<String> tracedEntries;
+
+    std::vector<std::thread> loadWorkers;
+
+    std::mutex loadQueueMutex;
+
+    std::condition_variable loadQueueCondition;
+
+    std::priority_queue<std::shared_ptr<LoadRequest>,
+                        std::vector<std::shared_ptr<LoadRequest>>,
+                        LoadRequestCompare>
+        queuedLoads;
+
+    bool stopLoadWorkers = false;
+
+    std::mutex completedLoadsMutex;
+
+    std::deque<std::shared_ptr<LoadRequest>> completedLoads;
+
+    uint64_t nextLoadSequence = 0;
+
+    uint32_t pendingLoadCount = 0;
 };
 
 } // namespace Siege
@@ -49,6 +49,67 @@ inline bool operator!=(const SkinnedVertex& left, const SkinnedVertex& right)
     return !(left == right);
 }
 
+/**
+ * A 28 byte SkinnedVertex, adding 8-bit bone indices and 8-bit normalised weights to the
+ * quantised base vertex. Meshes with more than 256 bones cannot be quantised
+ */
+struct QuantisedSkinnedVertex
+{
+    QuantisedVertex base;
+    uint8_t bones[4];
+    uint8_t weights[4];
+};
+
+inline QuantisedSkinnedVertex QuantiseVertex(const SkinnedVertex& vertex, const MeshFormat& format)
+{
+    using namespace Quantisation;
+
+    QuantisedSkinnedVertex quantised {
+        QuantiseVertex(BaseVertex {vertex.position, vertex.color, vertex.normal, vertex.uv},
+                       format)};
+
+    float weights[4] = {vertex.weights.x, vertex.weights.y, vertex.weights.z, vertex.weights.w};
+    float bones[4] = {vertex.bones.x, vertex.bones.y, vertex.bones.z, vertex.bones.w};
+    uint32_t weightSum = 0;
+    uint32_t heaviest = 0;
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        quantised.bones[i] = static_cast<uint8_t>(std::clamp(bones[i], 0.f, 255.f));
+        quantised.weights[i] = EncodeUnorm8(weights[i]);
+        weightSum += quantised.weights[i];
+        if (weights[i] > weights[heaviest]) heaviest = i;
+    }
+
+    // Rounding can leave normalised weights summing to slightly more or less than one, so the
+    // error is given to the heaviest influence where it matters least
+    if (weightSum > 0)
+    {
+        int32_t corrected = quantised.weights[heaviest] + 255 - static_cast<int32_t>(weightSum);
+        quantised.weights[heaviest] = static_cast<uint8_t>(std::clamp(corrected, 0, 255));
+    }
+    return quantised;
+}
+
+inline SkinnedVertex DequantiseVertex(const QuantisedSkinnedVertex& vertex,
+                                      const MeshFormat& format)
+{
+    using namespace Quantisation;
+
+    BaseVertex base = DequantiseVertex(vertex.base, format);
+    return {base.position,
+            base.color,
+            base.normal,
+            base.uv,
+            {static_cast<float>(vertex.bones[0]),
+             static_cast<float>(vertex.bones[1]),
+             static_cast<float>(vertex.bones[2]),
+             static_cast<float>(vertex.bones[3])},
+            {DecodeUnorm8(vertex.weights[0]),
+             DecodeUnorm8(vertex.weights[1]),
+             DecodeUnorm8(vertex.weights[2]),
+             DecodeUnorm8(vertex.weights[3])}};
+}
+
 struct SkeletalMeshData
 {
     std::vector<uint32_t> indices;
@@ -56,6 +117,17 @@ struct SkeletalMeshData
     std::map<String, Bone> bones;
 };
 
+struct SkeletalMeshDataView
+{
+    using DataType = SkeletalMeshData;
+
+    Span<const uint32_t> indices;
+    Span<const SkinnedVertex> vertices;
+    Span<const QuantisedSkinnedVertex> quantisedVertices;
+    MeshFormat format;
+    std::map<String, Bone> bones;
+};
+
 namespace BinarySerialisation
 {
 
@@ -84,6 +156,108 @@ inline void serialise(Buffer& buffer, SkeletalMeshData& value, SerialisationMode
 
 } // namespace BinarySerialisation
 
+namespace InPlace
+{
+
+// Bones are few and keyed by name, so they are kept serialised in their own section and copied
+// out when a view is created
+
+inline PackFileData* Write(const SkeletalMeshData& value)
+{
+    BinarySerialisation::Buffer bonesBuffer;
+    auto bones = value.bones;
+    BinarySerialisation::serialise(bonesBuffer, bones, BinarySerialisation::SERIALISE);
+
+    Writer writer;
+    writer.AddSection(value.indices);
+    writer.AddSection(value.vertices);
+    writer.AddSection(bonesBuffer.data.data(), bonesBuffer.data.size());
+    return writer.Create();
+}
+
+/**
+ * Writes a skeletal mesh with quantised vertices, which adds a leading format section to the
+ * record. Bone indices must fit in 8 bits
+ */
+inline PackFileData* WriteQuantised(const SkeletalMeshData& value)
+{
+    BinarySerialisation::Buffer bonesBuffer;
+    auto bones = value.bones;
+    BinarySerialisation::serialise(bonesBuffer, bones, BinarySerialisation::SERIALISE);
+
+    MeshFormat format = CalculateQuantisedFormat(value.vertices);
+    std::vector<QuantisedSkinnedVertex> vertices;
+    vertices.reserve(value.vertices.size());
+    for (const SkinnedVertex& vertex : value.vertices)
+    {
+        vertices.push_back(QuantiseVertex(vertex, format));
+    }
+
+    Writer writer;
+    writer.AddSection(&format, sizeof(MeshFormat));
+    writer.AddSection(value.indices);
+    writer.AddSection(vertices);
+    writer.AddSection(bonesBuffer.data.data(), bonesBuffer.data.size());
+    return writer.Create();
+}
+
+inline bool Read(const Record& record, SkeletalMeshDataView& view)
+{
+    Span<const uint8_t> bonesData;
+    if (record.GetSectionCount() == 3)
+    {
+        if (!record.GetSection(0, view.indices) || !record.GetSection(1, view.vertices) ||
+            !record.GetSection(2, bonesData))
+        {
+            return false;
+        }
+    }
+    else if (record.GetSectionCount() != 4 || !ReadFormat(record, view.format) ||
+             view.format.vertexFormat != VERTEX_FORMAT_QUANTISED ||
+             view.format.indexFormat != INDEX_FORMAT_UINT32 ||
+             !record.GetSection(1, view.indices) || !record.GetSection(2, view.quantisedVertices) ||
+             !record.GetSection(3, bonesData))
+    {
+        return false;
+    }
+
+    BinarySerialisation::Buffer bonesBuffer;
+    bonesBuffer.Fill(bonesData.Data(), bonesData.Size());
+    BinarySerialisation::serialise(bonesBuffer, view.bones, BinarySerialisation::DESERIALISE);
+    return true;
+}
+
+inline bool Read(const Record& record, SkeletalMeshData& value)
+{
+    SkeletalMeshDataView view;
+    if (!Read(record, view)) return false;
+
+    value.indices.assign(view.indices.begin(), view.indices.end());
+    value.bones = std::move(view.bones);
+    if (view.format.vertexFormat == VERTEX_FORMAT_FULL)
+    {
+        value.vertices.assign(view.vertices.begin(), view.vertices.end());
+        return true;
+    }
+
+    value.vertices.clear();
+    value.vertices.reserve(view.quantisedVertices.Size());
+    for (const QuantisedSkinnedVertex& vertex : view.quantisedVertices)
+    {
+        value.vertices.push_back(DequantiseVertex(vertex, view.format));
+    }
+    return true;
+}
+
+inline void View(const SkeletalMeshData& value, SkeletalMeshDataView& view)
+{
+    view.indices = {value.indices.data(), value.indices.size()};
+    view.vertices = {value.vertices.data(), value.vertices.size()};
+    view.bones = value.bones;
+}
+
+} // namespace InPlace
+
 } // namespace Siege
 
 namespace std
@@ -12,10 +12,13 @@
 
 #include <utils/BinarySerialisation.h>
 #include <utils/Colour.h>
+#include <utils/math/Quantisation.h>
 #include <utils/math/vec/Hashing.h>
 #include <utils/math/vec/Vec2.h>
 #include <utils/math/vec/Vec3.h>
 
+#include "InPlaceData.h"
+
 namespace Siege
 {
 
@@ -38,12 +41,226 @@ inline bool operator!=(const BaseVertex& left, const BaseVertex& right)
     return !(left == right);
 }
 
+enum VertexFormat : uint32_t
+{
+    VERTEX_FORMAT_FULL = 0,
+    VERTEX_FORMAT_QUANTISED = 1
+};
+
+enum IndexFormat : uint32_t
+{
+    INDEX_FORMAT_UINT32 = 0,
+    INDEX_FORMAT_UINT16 = 1
+};
+
+/**
+ * A 20 byte BaseVertex, matching the vertex input of the quantised mesh shaders. Positions are
+ * 16-bit normalised within the mesh bounds, normals are octahedral encoded, colours are 8-bit
+ * normalised and UVs are half precision
+ */
+struct QuantisedVertex
+{
+    uint16_t position[4];
+    int16_t normal[2];
+    uint8_t color[4];
+    uint16_t uv[2];
+};
+
+/**
+ * Describes how the vertices and indices of a mesh are stored. Quantised positions decode to
+ * boundsMin + position * boundsExtent
+ */
+struct MeshFormat
+{
+    uint32_t vertexFormat = VERTEX_FORMAT_FULL;
+    uint32_t indexFormat = INDEX_FORMAT_UINT32;
+    Vec3 boundsMin;
+    Vec3 boundsExtent {1.f, 1.f, 1.f};
+};
+
+template<typename TVertex>
+MeshFormat CalculateQuantisedFormat(const std::vector<TVertex>& vertices)
+{
+    MeshFormat format {VERTEX_FORMAT_QUANTISED};
+    if (vertices.empty()) return format;
+
+    Vec3 boundsMax = vertices[0].position;
+    format.boundsMin = vertices[0].position;
+    for (const TVertex& vertex : vertices)
+    {
+        format.boundsMin = {std::min(format.boundsMin.x, vertex.position.x),
+                            std::min(format.boundsMin.y, vertex.position.y),
+                            std::min(format.boundsMin.z, vertex.position.z)};
+        boundsMax = {std::max(boundsMax.x, vertex.position.x),
+                     std::max(boundsMax.y, vertex.position.y),
+                     std::max(boundsMax.z, vertex.position.z)};
+    }
+
+    // Flat meshes have no extent along an axis, which would otherwise divide by zero
+    format.boundsExtent = boundsMax - format.boundsMin;
+    if (format.boundsExtent.x <= 0.f) format.boundsExtent.x = 1.f;
+    if (format.boundsExtent.y <= 0.f) format.boundsExtent.y = 1.f;
+    if (format.boundsExtent.z <= 0.f) format.boundsExtent.z = 1.f;
+    return format;
+}
+
+/**
+ * Returns the smallest index format able to address every vertex of a mesh
+ * @param vertexCount the number of vertices in the mesh
+ * @return 16-bit indices for meshes of up to 65536 vertices, otherwise 32-bit indices
+ */
+inline IndexFormat SelectIndexFormat(size_t vertexCount)
+{
+    return vertexCount <= UINT16_MAX + 1 ? INDEX_FORMAT_UINT16 : INDEX_FORMAT_UINT32;
+}
+
+inline QuantisedVertex QuantiseVertex(const BaseVertex& vertex, const MeshFormat& format)
+{
+    using namespace Quantisation;
+
+    Vec3 position = (vertex.position - format.boundsMin) / format.boundsExtent;
+    Vec2 normal = OctahedralEncode(vertex.normal);
+    return {{EncodeUnorm16(position.x), EncodeUnorm16(position.y), EncodeUnorm16(position.z), 0},
+            {EncodeSnorm16(normal.x), EncodeSnorm16(normal.y)},
+            {EncodeUnorm8(vertex.color.r),
+             EncodeUnorm8(vertex.color.g),
+             EncodeUnorm8(vertex.color.b),
+             EncodeUnorm8(vertex.color.a)},
+            {FloatToHalf(vertex.uv.x), FloatToHalf(vertex.uv.y)}};
+}
+
+inline BaseVertex DequantiseVertex(const QuantisedVertex& vertex, const MeshFormat& format)
+{
+    using namespace Quantisation;
+
+    Vec3 position {DecodeUnorm16(vertex.position[0]),
+                   DecodeUnorm16(vertex.position[1]),
+                   DecodeUnorm16(vertex.position[2])};
+    return {format.boundsMin + position * format.boundsExtent,
+            {DecodeUnorm8(vertex.color[0]),
+             DecodeUnorm8(vertex.color[1]),
+             DecodeUnorm8(vertex.color[2]),
+             DecodeUnorm8(vertex.color[3])},
+            OctahedralDecode({DecodeSnorm16(vertex.normal[0]), DecodeSnorm16(vertex.normal[1])}),
+            {HalfToFloat(vertex.uv[0]), HalfToFloat(vertex.uv[1])}};
+}
+
+/**
+ * A reduced level of detail for a mesh. LODs share the mesh's vertices, with their indices stored
+ * after the full detail indices
+ * @param indexOffset the offset of the LOD's first index
+ * @param indexCount the number of indices in the LOD
+ * @param error the simplification error of the LOD, relative to the mesh's bounding radius
+ */
+struct MeshLod
+{
+    uint32_t indexOffset;
+    uint32_t indexCount;
+    float error;
+};
+
+/**
+ * Selects the coarsest LOD whose projected error stays within a threshold. Coarsening further than
+ * the current LOD additionally requires the error to clear the threshold by a hysteresis band, so
+ * that meshes near a transition don't flicker between LODs
+ * @param lods the reduced LODs of the mesh, in order of increasing error
+ * @param screenSize the projected bounding radius of the mesh, as a fraction of half the screen
+ * @param currentLod the LOD drawn previously, where 0 is full detail
+ * @param threshold the largest projected error to allow, as a fraction of half the screen
+ * @param hysteresis the fraction of the threshold the error must clear before coarsening
+ * @return the LOD to draw, where 0 is full detail and any other value selects lods[lod - 1]
+ */
+inline uint32_t SelectMeshLod(Span<const MeshLod> lods,
+                              float screenSize,
+                              uint32_t currentLod,
+                              float threshold,
+                              float hysteresis)
+{
+    uint32_t lod = 0;
+    while (lod < lods.Size() && lods[lod].error * screenSize <= threshold) lod++;
+
+    float coarsenThreshold = threshold * (1.f - hysteresis);
+    while (lod > currentLod && lods[lod - 1].error * screenSize > coarsenThreshold) lod--;
+    return lod;
+}
+
+/**
+ * Static mesh data. Meshes with LODs store the indices of each reduced LOD after those of the full
+ * detail mesh, and can only be packed as in-place records
+ */
 struct StaticMeshData
 {
     std::vector<uint32_t> indices;
     std::vector<BaseVertex> vertices;
+    std::vector<MeshLod> lods;
+};
+
+/**
+ * A view over packed static mesh data. Depending on the format of the packed mesh, either the
+ * full or the quantised vertices are populated, along with either the 32-bit or 16-bit indices
+ */
+struct StaticMeshDataView
+{
+    using DataType = StaticMeshData;
+
+    Span<const uint32_t> indices;
+    Span<const uint16_t> shortIndices;
+    Span<const BaseVertex> vertices;
+    Span<const QuantisedVertex> quantisedVertices;
+    Span<const MeshLod> lods;
+    MeshFormat format;
 };
 
+/**
+ * Calculates the axis aligned bounding box of a mesh's vertices
+ * @param view the mesh to calculate the bounding box of
+ * @param boundsMin the lowest coordinates of any vertex
+ * @param boundsMax the highest coordinates of any vertex
+ */
+inline void CalculateBoundingBox(const StaticMeshDataView& view,
+                                 OUT Vec3& boundsMin,
+                                 OUT Vec3& boundsMax)
+{
+    bool isQuantised = view.format.vertexFormat == VERTEX_FORMAT_QUANTISED;
+    size_t vertexCount = isQuantised ? view.quantisedVertices.Size() : view.vertices.Size();
+    if (vertexCount == 0)
+    {
+        boundsMin = boundsMax = {};
+        return;
+    }
+
+    for (size_t i = 0; i < vertexCount; i++)
+    {
+        Vec3 position = isQuantised ?
+                            DequantiseVertex(view.quantisedVertices[i], view.format).position :
+                            view.vertices[i].position;
+        if (i == 0) boundsMin = boundsMax = position;
+        boundsMin = {std::min(boundsMin.x, position.x),
+                     std::min(boundsMin.y, position.y),
+                     std::min(boundsMin.z, position.z)};
+        boundsMax = {std::max(boundsMax.x, position.x),
+                     std::max(boundsMax.y, position.y),
+                     std::max(boundsMax.z, position.z)};
+    }
+}
+
+/**
+ * Calculates the sphere around the bounding box of a mesh's vertices, which its LOD errors are
+ * measured relative to
+ * @param view the mesh to calculate the bounding sphere of
+ * @param centre the centre of the sphere
+ * @param radius the radius of the sphere
+ */
+inline void CalculateBoundingSphere(const StaticMeshDataView& view,
+                                    OUT Vec3& centre,
+                                    OUT float& radius)
+{
+    Vec3 boundsMin, boundsMax;
+    CalculateBoundingBox(view, boundsMin, boundsMax);
+    centre = (boundsMin + boundsMax) * 0.5f;
+    radius = Vec3::Length(boundsMax - boundsMin) * 0.5f;
+}
+
 namespace BinarySerialisation
 {
 
@@ -65,6 +282,121 @@ inline void serialise(Buffer& buffer, StaticMeshData& value, SerialisationMode m
 
 } // namespace BinarySerialisation
 
+namespace InPlace
+{
+
+inline PackFileData* Write(const StaticMeshData& value)
+{
+    Writer writer;
+    writer.AddSection(value.indices);
+    writer.AddSection(value.vertices);
+    return writer.Create();
+}
+
+/**
+ * Writes a static mesh in a compact format, which adds a leading format section to the record, and
+ * a trailing LOD section for meshes with LODs. 16-bit indices may only be used for meshes
+ * selected by SelectIndexFormat
+ */
+inline PackFileData* Write(const StaticMeshData& value,
+                           VertexFormat vertexFormat,
+                           IndexFormat indexFormat)
+{
+    MeshFormat format;
+    if (vertexFormat == VERTEX_FORMAT_QUANTISED) format = CalculateQuantisedFormat(value.vertices);
+    format.indexFormat = indexFormat;
+
+    Writer writer;
+    writer.AddSection(&format, sizeof(MeshFormat));
+
+    std::vector<uint16_t> shortIndices;
+    if (indexFormat == INDEX_FORMAT_UINT16)
+    {
+        shortIndices.assign(value.indices.begin(), value.indices.end());
+        writer.AddSection(shortIndices);
+    }
+    else writer.AddSection(value.indices);
+
+    std::vector<QuantisedVertex> quantisedVertices;
+    if (vertexFormat == VERTEX_FORMAT_QUANTISED)
+    {
+        quantisedVertices.reserve(value.vertices.size());
+        for (const BaseVertex& vertex : value.vertices)
+        {
+            quantisedVertices.push_back(QuantiseVertex(vertex, format));
+        }
+        writer.AddSection(quantisedVertices);
+    }
+    else writer.AddSection(value.vertices);
+
+    if (!value.lods.empty()) writer.AddSection(value.lods);
+    return writer.Create();
+}
+
+inline bool ReadFormat(const Record& record, OUT MeshFormat& format)
+{
+    Span<const MeshFormat> formats;
+    if (!record.GetSection(0, formats) || formats.Size() != 1) return false;
+    format = formats[0];
+    return true;
+}
+
+inline bool Read(const Record& record, StaticMeshDataView& view)
+{
+    if (record.GetSectionCount() == 2)
+    {
+        return record.GetSection(0, view.indices) && record.GetSection(1, view.vertices);
+    }
+
+    uint32_t sectionCount = record.GetSectionCount();
+    if ((sectionCount != 3 && sectionCount != 4) || !ReadFormat(record, view.format)) return false;
+    if (sectionCount == 4 && !record.GetSection(3, view.lods)) return false;
+
+    bool hasIndices = view.format.indexFormat == INDEX_FORMAT_UINT16 ?
+                          record.GetSection(1, view.shortIndices) :
+                          record.GetSection(1, view.indices);
+    bool hasVertices = view.format.vertexFormat == VERTEX_FORMAT_QUANTISED ?
+                           record.GetSection(2, view.quantisedVertices) :
+                           record.GetSection(2, view.vertices);
+    return hasIndices && hasVertices;
+}
+
+inline bool Read(const Record& record, StaticMeshData& value)
+{
+    StaticMeshDataView view;
+    if (!Read(record, view)) return false;
+
+    value.lods.assign(view.lods.begin(), view.lods.end());
+    if (view.format.indexFormat == INDEX_FORMAT_UINT16)
+    {
+        value.indices.assign(view.shortIndices.begin(), view.shortIndices.end());
+    }
+    else value.indices.assign(view.indices.begin(), view.indices.end());
+
+    if (view.format.vertexFormat == VERTEX_FORMAT_FULL)
+    {
+        value.vertices.assign(view.vertices.begin(), view.vertices.end());
+        return true;
+    }
+
+    value.vertices.clear();
+    value.vertices.reserve(view.quantisedVertices.Size());
+    for (const QuantisedVertex& vertex : view.quantisedVertices)
+    {
+        value.vertices.push_back(DequantiseVertex(vertex, view.format));
+    }
+    return true;
+}
+
+inline void View(const StaticMeshData& value, StaticMeshDataView& view)
+{
+    view.indices = {value.indices.data(), value.indices.size()};
+    view.vertices = {value.vertices.data(), value.vertices.size()};
+    view.lods = {value.lods.data(), value.lods.size()};
+}
+
+} // namespace InPlace
+
 } // namespace Siege
 
 namespace std
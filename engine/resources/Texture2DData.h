@@ -12,22 +12,179 @@
 
 #include <utils/BinarySerialisation.h>
 
+#include <algorithm>
+
+#include "InPlaceData.h"
+
 // TODO - Remove this hard-coded value and support various texture channel sizes
 #define TEXTURE2D_TEXTURE_CHANNELS 4
 
 namespace Siege
 {
 
+enum Texture2DFormat : int32_t
+{
+    TEXTURE2D_FORMAT_RGBA8 = 0,
+    TEXTURE2D_FORMAT_BC1 = 1,
+    TEXTURE2D_FORMAT_BC3 = 2,
+    TEXTURE2D_FORMAT_BC4 = 3,
+    TEXTURE2D_FORMAT_BC5 = 4,
+    TEXTURE2D_FORMAT_BC7 = 5
+};
+
+/**
+ * Returns the size in bytes of a 4x4 block of a block compressed format, or zero for formats that
+ * store individual texels
+ */
+inline uint32_t GetTexture2DBlockSize(int32_t format)
+{
+    switch (format)
+    {
+        case TEXTURE2D_FORMAT_BC1:
+        case TEXTURE2D_FORMAT_BC4:
+            return 8;
+        case TEXTURE2D_FORMAT_BC3:
+        case TEXTURE2D_FORMAT_BC5:
+        case TEXTURE2D_FORMAT_BC7:
+            return 16;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * Returns whether a format holds colour that should be sampled as sRGB, rather than linear data
+ * such as normals or masks
+ */
+inline bool IsTexture2DFormatSrgb(int32_t format)
+{
+    return format != TEXTURE2D_FORMAT_BC4 && format != TEXTURE2D_FORMAT_BC5;
+}
+
+/**
+ * Returns the size in bytes of a level of a texture's mip chain, where each level halves the
+ * dimensions of the one above it down to a single texel. Block compressed levels are padded out
+ * to whole blocks
+ */
+inline uint64_t GetTexture2DLevelSize(int32_t width,
+                                      int32_t height,
+                                      int32_t channels,
+                                      int32_t format,
+                                      uint32_t level)
+{
+    uint64_t levelWidth = std::max(width >> level, 1);
+    uint64_t levelHeight = std::max(height >> level, 1);
+
+    uint32_t blockSize = GetTexture2DBlockSize(format);
+    if (blockSize == 0) return levelWidth * levelHeight * channels;
+    return ((levelWidth + 3) / 4) * ((levelHeight + 3) / 4) * blockSize;
+}
+
+/**
+ * Returns the number of levels in a full mip chain for a texture of the given dimensions
+ */
+inline uint32_t GetTexture2DFullLevelCount(int32_t width, int32_t height)
+{
+    uint32_t levelCount = 1;
+    while ((std::max(width, height) >> levelCount) > 0) levelCount++;
+    return levelCount;
+}
+
+/**
+ * Returns the number of mip levels stored back to back in a texture's pixels. Pixel data that
+ * does not exactly fit a mip chain is treated as a single level
+ */
+inline uint32_t GetTexture2DLevelCount(int32_t width,
+                                       int32_t height,
+                                       int32_t channels,
+                                       int32_t format,
+                                       uint64_t pixelsSize)
+{
+    uint32_t maxLevelCount = GetTexture2DFullLevelCount(width, height);
+    uint64_t chainSize = 0;
+    for (uint32_t level = 0; level < maxLevelCount; level++)
+    {
+        chainSize += GetTexture2DLevelSize(width, height, channels, format, level);
+        if (chainSize == pixelsSize) return level + 1;
+        if (chainSize > pixelsSize) break;
+    }
+    return 1;
+}
+
+/**
+ * Returns the byte offset of a mip level within a texture's pixels
+ */
+inline uint64_t GetTexture2DLevelOffset(int32_t width,
+                                        int32_t height,
+                                        int32_t channels,
+                                        int32_t format,
+                                        uint32_t level)
+{
+    uint64_t offset = 0;
+    for (uint32_t i = 0; i < level; i++)
+    {
+        offset += GetTexture2DLevelSize(width, height, channels, format, i);
+    }
+    return offset;
+}
+
 struct Texture2DData
 {
     int32_t texWidth = 0;
     int32_t texHeight = 0;
     int32_t texChannels = TEXTURE2D_TEXTURE_CHANNELS;
+    int32_t format = TEXTURE2D_FORMAT_RGBA8;
     std::vector<uint8_t> pixels;
 
     uint64_t GetImageSize() const
     {
-        return texWidth * texHeight * texChannels;
+        return GetMipLevelSize(0);
+    }
+
+    uint32_t GetMipLevelCount() const
+    {
+        return GetTexture2DLevelCount(texWidth, texHeight, texChannels, format, pixels.size());
+    }
+
+    uint64_t GetMipLevelOffset(uint32_t level) const
+    {
+        return GetTexture2DLevelOffset(texWidth, texHeight, texChannels, format, level);
+    }
+
+    uint64_t GetMipLevelSize(uint32_t level) const
+    {
+        return GetTexture2DLevelSize(texWidth, texHeight, texChannels, format, level);
+    }
+};
+
+struct Texture2DDataView
+{
+    using DataType = Texture2DData;
+
+    int32_t texWidth = 0;
+    int32_t texHeight = 0;
+    int32_t texChannels = TEXTURE2D_TEXTURE_CHANNELS;
+    int32_t format = TEXTURE2D_FORMAT_RGBA8;
+    Span<const uint8_t> pixels;
+
+    uint64_t GetImageSize() const
+    {
+        return GetMipLevelSize(0);
+    }
+
+    uint32_t GetMipLevelCount() const
+    {
+        return GetTexture2DLevelCount(texWidth, texHeight, texChannels, format, pixels.Size());
+    }
+
+    uint64_t GetMipLevelOffset(uint32_t level) const
+    {
+        return GetTexture2DLevelOffset(texWidth, texHeight, texChannels, format, level);
+    }
+
+    uint64_t GetMipLevelSize(uint32_t level) const
+    {
+        return GetTexture2DLevelSize(texWidth, texHeight, texChannels, format, level);
     }
 };
 
@@ -39,11 +196,66 @@ inline void serialise(Buffer& buffer, Texture2DData& value, SerialisationMode mo
     serialise(buffer, value.texWidth, mode);
     serialise(buffer, value.texHeight, mode);
     serialise(buffer, value.texChannels, mode);
+    serialise(buffer, value.format, mode);
     serialise(buffer, value.pixels, mode);
 }
 
 } // namespace BinarySerialisation
 
+namespace InPlace
+{
+
+inline PackFileData* Write(const Texture2DData& value)
+{
+    int32_t dimensions[4] = {value.texWidth, value.texHeight, value.texChannels, value.format};
+
+    Writer writer;
+    writer.AddSection(dimensions, sizeof(dimensions));
+    writer.AddSection(value.pixels);
+    return writer.Create();
+}
+
+inline bool Read(const Record& record, Texture2DDataView& view)
+{
+    // Records written before block compression have no format and are always uncompressed
+    Span<const int32_t> dimensions;
+    if (record.GetSectionCount() != 2 || !record.GetSection(0, dimensions) ||
+        (dimensions.Size() != 3 && dimensions.Size() != 4) || !record.GetSection(1, view.pixels))
+    {
+        return false;
+    }
+
+    view.texWidth = dimensions[0];
+    view.texHeight = dimensions[1];
+    view.texChannels = dimensions[2];
+    view.format = dimensions.Size() == 4 ? dimensions[3] : TEXTURE2D_FORMAT_RGBA8;
+    return true;
+}
+
+inline bool Read(const Record& record, Texture2DData& value)
+{
+    Texture2DDataView view;
+    if (!Read(record, view)) return false;
+
+    value.texWidth = view.texWidth;
+    value.texHeight = view.texHeight;
+    value.texChannels = view.texChannels;
+    value.format = view.format;
+    value.pixels.assign(view.pixels.begin(), view.pixels.end());
+    return true;
+}
+
+inline void View(const Texture2DData& value, Texture2DDataView& view)
+{
+    view.texWidth = value.texWidth;
+    view.texHeight = value.texHeight;
+    view.texChannels = value.texChannels;
+    view.format = value.format;
+    view.pixels = {value.pixels.data(), value.pixels.size()};
+}
+
+} // namespace InPlace
+
 } // namespace Siege
 
 #endif // SIEGE_ENGINE_TEXTURE2DDATA_H
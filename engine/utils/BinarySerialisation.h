@@ -90,7 +90,9 @@ void serialiseNative(Buffer& buffer, const T& value, SerialisationMode mode)
 SERIALISE_NATIVE(bool)
 SERIALISE_NATIVE(char)
 SERIALISE_NATIVE(unsigned char)
+SERIALISE_NATIVE(uint16_t)
 SERIALISE_NATIVE(uint32_t)
+SERIALISE_NATIVE(uint64_t)
 SERIALISE_NATIVE(int32_t)
 SERIALISE_NATIVE(float)
 SERIALISE_NATIVE(double)
@@ -32,4 +32,10 @@ StringId WSID(const char* str)
     return crc32((uint8_t*) str, strlen_c(str));
 }
 
+uint64_t Fnv1a64(const uint8_t* data, size_t length, uint64_t hash)
+{
+    for (size_t i = 0; i < length; i++) hash = (hash ^ data[i]) * 0x100000001b3;
+    return hash;
+}
+
 } // namespace Siege::Hash
@@ -61,6 +61,11 @@ uint32_t crc32(const uint8_t* data, size_t length);
 size_t strlen_c(const char* str);
 
 StringId WSID(const char* str);
+
+// 64-bit FNV-1a, stable across platforms and runs so it can be used for persistent keys
+static constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325;
+
+uint64_t Fnv1a64(const uint8_t* data, size_t length, uint64_t hash = FNV_OFFSET_BASIS);
 } // namespace Siege::Hash
 
 #endif // SIEGE_ENGINE_HASH_H
@@ -0,0 +1,83 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#ifndef SIEGE_ENGINE_RADIXSORT_H
+#define SIEGE_ENGINE_RADIXSORT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Siege
+{
+/**
+ * Sorts items in ascending order of a 64-bit key using a least significant digit radix sort. The
+ * sort is stable and runs in linear time, making one pass to count every digit and one pass per
+ * byte of the key after that. Bytes which are the same across every key are skipped, so keys that
+ * only use their upper bits sort in fewer passes
+ * @tparam T the type of the items being sorted
+ * @tparam KeyFunc a callable returning the uint64_t key of an item
+ * @param items the items to sort
+ * @param scratch a buffer the sort may use, resized to the number of items
+ * @param getKey the function used to get each item's key
+ */
+template<typename T, typename KeyFunc>
+void RadixSort(std::vector<T>& items, std::vector<T>& scratch, KeyFunc getKey)
+{
+    static constexpr size_t DIGIT_COUNT = sizeof(uint64_t);
+    static constexpr size_t BUCKET_COUNT = 256;
+
+    size_t count = items.size();
+    if (count < 2) return;
+
+    size_t histograms[DIGIT_COUNT][BUCKET_COUNT] {};
+    for (const T& item : items)
+    {
+        uint64_t key = getKey(item);
+        for (size_t digit = 0; digit < DIGIT_COUNT; digit++)
+        {
+            histograms[digit][(key >> (digit * 8)) & 0xFF]++;
+        }
+    }
+
+    scratch.resize(count);
+    std::vector<T>* source = &items;
+    std::vector<T>* destination = &scratch;
+
+    for (size_t digit = 0; digit < DIGIT_COUNT; digit++)
+    {
+        size_t* histogram = histograms[digit];
+
+        // Every key shares this digit, so the pass wouldn't move anything
+        uint64_t firstDigit = (getKey((*source)[0]) >> (digit * 8)) & 0xFF;
+        if (histogram[firstDigit] == count) continue;
+
+        size_t offset = 0;
+        for (size_t bucket = 0; bucket < BUCKET_COUNT; bucket++)
+        {
+            size_t bucketCount = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += bucketCount;
+        }
+
+        for (T& item : *source)
+        {
+            uint64_t bucket = (getKey(item) >> (digit * 8)) & 0xFF;
+            (*destination)[histogram[bucket]++] = std::move(item);
+        }
+
+        std::swap(source, destination);
+    }
+
+    if (source != &items) items.swap(scratch);
+}
+} // namespace Siege
+
+#endif // SIEGE_ENGINE_RADIXSORT_H
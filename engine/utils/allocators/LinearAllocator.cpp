@@ -0,0 +1,35 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#include "LinearAllocator.h"
+
+#include <algorithm>
+
+namespace Siege
+{
+LinearAllocator::LinearAllocator(uint64_t capacity) : capacity {capacity} {}
+
+uint64_t LinearAllocator::Allocate(uint64_t size, uint64_t alignment)
+{
+    uint64_t alignedOffset = offset;
+    if (alignment > 1) alignedOffset = (offset + alignment - 1) & ~(alignment - 1);
+
+    // Checked against the remaining space rather than summed so large sizes can't overflow
+    if (alignedOffset > capacity || size > capacity - alignedOffset) return INVALID_OFFSET;
+
+    offset = alignedOffset + size;
+    highWaterMark = std::max(highWaterMark, offset);
+    return alignedOffset;
+}
+
+void LinearAllocator::Reset()
+{
+    offset = 0;
+}
+} // namespace Siege
@@ -0,0 +1,97 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#ifndef SIEGE_ENGINE_LINEAR_ALLOCATOR_H
+#define SIEGE_ENGINE_LINEAR_ALLOCATOR_H
+
+#include <cstdint>
+
+namespace Siege
+{
+/**
+ * A bump allocator over a range of memory it doesn't own. Allocations are handed out as offsets
+ * from the start of the range and can't be freed individually, only all at once by resetting the
+ * allocator. Used to sub-allocate memory which lives elsewhere, such as in a GPU buffer
+ */
+class LinearAllocator
+{
+public:
+
+    // Returned by Allocate when an allocation doesn't fit in the remaining space
+    static constexpr uint64_t INVALID_OFFSET = UINT64_MAX;
+
+    /**
+     * Empty constructor, creates an allocator with no capacity
+     */
+    LinearAllocator() = default;
+
+    /**
+     * Creates an allocator over a range of the given size
+     * @param capacity the number of bytes in the range
+     */
+    explicit LinearAllocator(uint64_t capacity);
+
+    /**
+     * Allocates a block of memory from the remaining space
+     * @param size the number of bytes to allocate
+     * @param alignment the alignment of the block's offset. Must be zero or a power of two
+     * @return the offset of the block, or INVALID_OFFSET if the block doesn't fit
+     */
+    uint64_t Allocate(uint64_t size, uint64_t alignment = 1);
+
+    /**
+     * Releases every allocation, making the whole range available again
+     */
+    void Reset();
+
+    /**
+     * Returns the number of bytes in the allocator's range
+     * @return the capacity of the allocator
+     */
+    uint64_t Capacity() const
+    {
+        return capacity;
+    }
+
+    /**
+     * Returns the number of bytes allocated since the last reset, including alignment padding
+     * @return the number of bytes used
+     */
+    uint64_t BytesUsed() const
+    {
+        return offset;
+    }
+
+    /**
+     * Returns the number of bytes which can still be allocated, ignoring alignment padding
+     * @return the number of bytes remaining
+     */
+    uint64_t BytesRemaining() const
+    {
+        return capacity - offset;
+    }
+
+    /**
+     * Returns the most bytes that have been used between any two resets
+     * @return the allocator's high water mark
+     */
+    uint64_t HighWaterMark() const
+    {
+        return highWaterMark;
+    }
+
+private:
+
+    uint64_t capacity {0};
+    uint64_t offset {0};
+    uint64_t highWaterMark {0};
+};
+} // namespace Siege
+
+#endif // SIEGE_ENGINE_LINEAR_ALLOCATOR_H
@@ -0,0 +1,267 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#include "OffsetAllocator.h"
+
+#include <algorithm>
+
+#include "../Logging.h"
+
+namespace Siege
+{
+OffsetAllocator::OffsetAllocator(uint64_t capacity) : capacity {capacity}
+{
+    for (auto& secondLevel : freeLists) std::fill_n(secondLevel, SL_COUNT, INVALID_NODE);
+
+    if (capacity == 0) return;
+
+    uint32_t index = CreateNode();
+    nodes[index].size = capacity;
+    InsertFreeNode(index);
+}
+
+OffsetAllocator::Allocation OffsetAllocator::Allocate(uint64_t size, uint64_t alignment)
+{
+    // Searching for enough space to align any region keeps the search constant time, at the cost
+    // of sometimes skipping a region that was already aligned and just large enough
+    uint64_t padding = alignment > 1 ? alignment - 1 : 0;
+    if (size == 0 || size > capacity || padding > capacity - size) return {};
+
+    uint32_t index = FindFreeNode(size + padding);
+    if (index == INVALID_NODE) return {};
+
+    RemoveFreeNode(index);
+
+    uint64_t offset = nodes[index].offset;
+    uint64_t alignedOffset = alignment > 1 ? (offset + padding) & ~padding : offset;
+
+    // The space skipped to align the allocation stays free, as its own region
+    if (alignedOffset > offset)
+    {
+        uint32_t alignedIndex = SplitNode(index, alignedOffset - offset);
+        InsertFreeNode(index);
+        index = alignedIndex;
+    }
+
+    if (nodes[index].size > size) InsertFreeNode(SplitNode(index, size));
+
+    bytesAllocated += nodes[index].size;
+    allocationCount++;
+
+    return {nodes[index].offset, index};
+}
+
+void OffsetAllocator::Free(const Allocation& allocation)
+{
+    if (allocation.node == INVALID_NODE) return;
+
+    uint32_t index = allocation.node;
+
+    CC_ASSERT((index < nodes.size() && !nodes[index].isFree && nodes[index].size > 0),
+              "Freeing an allocation which is not live!")
+
+    bytesAllocated -= nodes[index].size;
+    allocationCount--;
+
+    // Free regions are always merged with their neighbours, so at most one merge is needed on
+    // either side. Regions merge into the earlier node, which keeps the first node at offset zero
+    uint32_t prev = nodes[index].prevPhysical;
+    if (prev != INVALID_NODE && nodes[prev].isFree)
+    {
+        RemoveFreeNode(prev);
+
+        uint32_t next = nodes[index].nextPhysical;
+        nodes[prev].size += nodes[index].size;
+        nodes[prev].nextPhysical = next;
+        if (next != INVALID_NODE) nodes[next].prevPhysical = prev;
+
+        ReleaseNode(index);
+        index = prev;
+    }
+
+    uint32_t next = nodes[index].nextPhysical;
+    if (next != INVALID_NODE && nodes[next].isFree)
+    {
+        RemoveFreeNode(next);
+
+        uint32_t nextNext = nodes[next].nextPhysical;
+        nodes[index].size += nodes[next].size;
+        nodes[index].nextPhysical = nextNext;
+        if (nextNext != INVALID_NODE) nodes[nextNext].prevPhysical = index;
+
+        ReleaseNode(next);
+    }
+
+    InsertFreeNode(index);
+}
+
+uint64_t OffsetAllocator::GetAllocationSize(const Allocation& allocation) const
+{
+    if (allocation.node == INVALID_NODE) return 0;
+    return nodes[allocation.node].size;
+}
+
+OffsetAllocator::Stats OffsetAllocator::GetStats() const
+{
+    Stats stats;
+    stats.capacity = capacity;
+    stats.bytesAllocated = bytesAllocated;
+    stats.bytesFree = capacity - bytesAllocated;
+    stats.allocationCount = allocationCount;
+
+    if (nodes.empty()) return stats;
+
+    for (uint32_t index = 0; index != INVALID_NODE; index = nodes[index].nextPhysical)
+    {
+        const Node& node = nodes[index];
+        if (!node.isFree) continue;
+
+        stats.freeRegionCount++;
+        stats.largestFreeRegion = std::max(stats.largestFreeRegion, node.size);
+    }
+
+    return stats;
+}
+
+void OffsetAllocator::MapSize(uint64_t size, uint32_t& firstLevel, uint32_t& secondLevel)
+{
+    if (size < SMALL_BLOCK_SIZE)
+    {
+        firstLevel = 0;
+        secondLevel = static_cast<uint32_t>(size);
+        return;
+    }
+
+    uint32_t mostSignificantBit = 63 - __builtin_clzll(size);
+    firstLevel = mostSignificantBit - SL_BITS + 1;
+    secondLevel = static_cast<uint32_t>(size >> (mostSignificantBit - SL_BITS)) ^ SL_COUNT;
+}
+
+uint32_t OffsetAllocator::FindFreeNode(uint64_t size) const
+{
+    // Rounding the size up to the next bin means any region in the bin found is large enough
+    uint64_t searchSize = size;
+    if (size >= SMALL_BLOCK_SIZE)
+    {
+        uint32_t mostSignificantBit = 63 - __builtin_clzll(size);
+        uint64_t round = (1ull << (mostSignificantBit - SL_BITS)) - 1;
+        searchSize = size > UINT64_MAX - round ? UINT64_MAX : size + round;
+    }
+
+    uint32_t firstLevel, secondLevel;
+    MapSize(searchSize, firstLevel, secondLevel);
+
+    uint32_t secondLevelMap = secondLevelBitmaps[firstLevel] & (~0u << secondLevel);
+    uint64_t firstLevelMap =
+        firstLevel + 1 < FL_COUNT ? firstLevelBitmap & (~0ull << (firstLevel + 1)) : 0;
+
+    if (secondLevelMap != 0) return freeLists[firstLevel][__builtin_ctz(secondLevelMap)];
+
+    if (firstLevelMap != 0)
+    {
+        firstLevel = __builtin_ctzll(firstLevelMap);
+        return freeLists[firstLevel][__builtin_ctz(secondLevelBitmaps[firstLevel])];
+    }
+
+    // Only the size's own bin is left, which may hold regions both smaller and larger than it.
+    // Searching it is linear, but only happens when the range is nearly full
+    MapSize(size, firstLevel, secondLevel);
+    for (uint32_t index = freeLists[firstLevel][secondLevel]; index != INVALID_NODE;
+         index = nodes[index].nextFree)
+    {
+        if (nodes[index].size >= size) return index;
+    }
+
+    return INVALID_NODE;
+}
+
+uint32_t OffsetAllocator::SplitNode(uint32_t index, uint64_t size)
+{
+    uint32_t newIndex = CreateNode();
+
+    Node& node = nodes[index];
+    Node& newNode = nodes[newIndex];
+
+    newNode.offset = node.offset + size;
+    newNode.size = node.size - size;
+    newNode.prevPhysical = index;
+    newNode.nextPhysical = node.nextPhysical;
+
+    if (node.nextPhysical != INVALID_NODE) nodes[node.nextPhysical].prevPhysical = newIndex;
+
+    node.nextPhysical = newIndex;
+    node.size = size;
+
+    return newIndex;
+}
+
+void OffsetAllocator::InsertFreeNode(uint32_t index)
+{
+    uint32_t firstLevel, secondLevel;
+    MapSize(nodes[index].size, firstLevel, secondLevel);
+
+    uint32_t head = freeLists[firstLevel][secondLevel];
+
+    Node& node = nodes[index];
+    node.isFree = true;
+    node.prevFree = INVALID_NODE;
+    node.nextFree = head;
+
+    if (head != INVALID_NODE) nodes[head].prevFree = index;
+
+    freeLists[firstLevel][secondLevel] = index;
+    firstLevelBitmap |= 1ull << firstLevel;
+    secondLevelBitmaps[firstLevel] |= 1u << secondLevel;
+}
+
+void OffsetAllocator::RemoveFreeNode(uint32_t index)
+{
+    Node& node = nodes[index];
+
+    if (node.prevFree != INVALID_NODE) nodes[node.prevFree].nextFree = node.nextFree;
+    if (node.nextFree != INVALID_NODE) nodes[node.nextFree].prevFree = node.prevFree;
+
+    uint32_t firstLevel, secondLevel;
+    MapSize(node.size, firstLevel, secondLevel);
+
+    if (freeLists[firstLevel][secondLevel] == index)
+    {
+        freeLists[firstLevel][secondLevel] = node.nextFree;
+
+        if (node.nextFree == INVALID_NODE)
+        {
+            secondLevelBitmaps[firstLevel] &= ~(1u << secondLevel);
+            if (secondLevelBitmaps[firstLevel] == 0) firstLevelBitmap &= ~(1ull << firstLevel);
+        }
+    }
+
+    node.isFree = false;
+    node.prevFree = INVALID_NODE;
+    node.nextFree = INVALID_NODE;
+}
+
+uint32_t OffsetAllocator::CreateNode()
+{
+    if (unusedNodes.empty())
+    {
+        nodes.emplace_back();
+        return static_cast<uint32_t>(nodes.size() - 1);
+    }
+
+    uint32_t index = unusedNodes.back();
+    unusedNodes.pop_back();
+    return index;
+}
+
+void OffsetAllocator::ReleaseNode(uint32_t index)
+{
+    nodes[index] = Node {};
+    unusedNodes.push_back(index);
+}
+} // namespace Siege
@@ -0,0 +1,198 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#ifndef SIEGE_ENGINE_OFFSET_ALLOCATOR_H
+#define SIEGE_ENGINE_OFFSET_ALLOCATOR_H
+
+#include <cstdint>
+#include <vector>
+
+namespace Siege
+{
+/**
+ * A two level segregated fit allocator over a range of memory it doesn't own. Unlike the
+ * TlsfAllocator, block metadata is kept in a separate node list rather than alongside the memory,
+ * so it can manage memory the CPU can't access, such as a block of GPU memory. Allocations are
+ * handed out as offsets from the start of the range, in constant time
+ */
+class OffsetAllocator
+{
+public:
+
+    static constexpr uint64_t INVALID_OFFSET = UINT64_MAX;
+    static constexpr uint32_t INVALID_NODE = UINT32_MAX;
+
+    /**
+     * An allocation made by the allocator
+     * @param offset the offset of the allocation from the start of the range, or INVALID_OFFSET
+     * if the allocation failed
+     * @param node the node tracking the allocation, used to free it
+     */
+    struct Allocation
+    {
+        uint64_t offset {INVALID_OFFSET};
+        uint32_t node {INVALID_NODE};
+    };
+
+    /**
+     * A summary of how the allocator's range is used
+     * @param capacity the number of bytes in the range
+     * @param bytesAllocated the number of bytes in allocations, including alignment padding
+     * @param bytesFree the number of bytes not in any allocation
+     * @param largestFreeRegion the size of the largest contiguous free region
+     * @param allocationCount the number of live allocations
+     * @param freeRegionCount the number of contiguous free regions
+     */
+    struct Stats
+    {
+        uint64_t capacity {0};
+        uint64_t bytesAllocated {0};
+        uint64_t bytesFree {0};
+        uint64_t largestFreeRegion {0};
+        uint32_t allocationCount {0};
+        uint32_t freeRegionCount {0};
+
+        /**
+         * Returns how fragmented the free space is, as the fraction of it outside the largest free
+         * region. Zero means all free space is contiguous, values near one mean large allocations
+         * are likely to fail despite there being space for them
+         * @return the fragmentation, from zero to one
+         */
+        float Fragmentation() const
+        {
+            if (bytesFree == 0) return 0.f;
+            return 1.f - static_cast<float>(largestFreeRegion) / static_cast<float>(bytesFree);
+        }
+    };
+
+    /**
+     * Empty constructor, creates an allocator with no capacity
+     */
+    OffsetAllocator() = default;
+
+    /**
+     * Creates an allocator over a range of the given size
+     * @param capacity the number of bytes in the range
+     */
+    explicit OffsetAllocator(uint64_t capacity);
+
+    /**
+     * Allocates a block from the range
+     * @param size the number of bytes to allocate. Must be greater than zero
+     * @param alignment the alignment of the block's offset. Must be a power of two
+     * @return the allocation, with an offset of INVALID_OFFSET if no free region could fit it
+     */
+    Allocation Allocate(uint64_t size, uint64_t alignment = 1);
+
+    /**
+     * Frees an allocation, merging it with any free regions on either side of it
+     * @param allocation the allocation to free
+     */
+    void Free(const Allocation& allocation);
+
+    /**
+     * Returns the size of a live allocation
+     * @param allocation the allocation to check
+     * @return the size of the allocation in bytes, which may exceed the size requested
+     */
+    uint64_t GetAllocationSize(const Allocation& allocation) const;
+
+    /**
+     * Walks the range to summarise its use. Runs in linear time, so is meant for reporting
+     * @return the allocator's statistics
+     */
+    Stats GetStats() const;
+
+    uint64_t Capacity() const
+    {
+        return capacity;
+    }
+
+    uint64_t BytesAllocated() const
+    {
+        return bytesAllocated;
+    }
+
+    uint32_t AllocationCount() const
+    {
+        return allocationCount;
+    }
+
+    bool IsEmpty() const
+    {
+        return allocationCount == 0;
+    }
+
+private:
+
+    // Each power of two size class is split into 16 linearly spaced bins, and sizes below 16 get
+    // a bin each
+    static constexpr uint32_t SL_BITS = 4;
+    static constexpr uint32_t SL_COUNT = 1 << SL_BITS;
+    static constexpr uint32_t FL_COUNT = 64 - SL_BITS + 1;
+    static constexpr uint64_t SMALL_BLOCK_SIZE = SL_COUNT;
+
+    /**
+     * A contiguous region of the range, either allocated or free. Regions are linked to their
+     * neighbours in the range, and free regions also to the others in their bin
+     */
+    struct Node
+    {
+        uint64_t offset {0};
+        uint64_t size {0};
+        uint32_t prevPhysical {INVALID_NODE};
+        uint32_t nextPhysical {INVALID_NODE};
+        uint32_t prevFree {INVALID_NODE};
+        uint32_t nextFree {INVALID_NODE};
+        bool isFree {false};
+    };
+
+    /**
+     * Maps a size to the bin holding free regions of that size
+     * @param size the size to map
+     * @param firstLevel filled with the size class
+     * @param secondLevel filled with the bin within the size class
+     */
+    static void MapSize(uint64_t size, uint32_t& firstLevel, uint32_t& secondLevel);
+
+    /**
+     * Finds a free region at least as large as a size
+     * @param size the size the region must fit
+     * @return the index of the region's node, or INVALID_NODE if none fit
+     */
+    uint32_t FindFreeNode(uint64_t size) const;
+
+    /**
+     * Splits the end off a region, leaving the region with the given size
+     * @param index the node of the region to split
+     * @param size the size the region should be left with
+     * @return the node of the new region
+     */
+    uint32_t SplitNode(uint32_t index, uint64_t size);
+
+    void InsertFreeNode(uint32_t index);
+    void RemoveFreeNode(uint32_t index);
+
+    uint32_t CreateNode();
+    void ReleaseNode(uint32_t index);
+
+    std::vector<Node> nodes;
+    std::vector<uint32_t> unusedNodes;
+
+    uint64_t firstLevelBitmap {0};
+    uint32_t secondLevelBitmaps[FL_COUNT] {};
+    uint32_t freeLists[FL_COUNT][SL_COUNT] {};
+
+    uint64_t capacity {0};
+    uint64_t bytesAllocated {0};
+    uint32_t allocationCount {0};
+};
+} // namespace Siege
+
+#endif // SIEGE_ENGINE_OFFSET_ALLOCATOR_H
@@ -0,0 +1,79 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#ifndef SIEGE_ENGINE_SPAN_H
+#define SIEGE_ENGINE_SPAN_H
+
+#include <cstddef>
+
+namespace Siege
+{
+/**
+ * @brief A non-owning view over a contiguous range of elements. The Span does not manage the
+ * lifetime of the memory it points to, so the owner of that memory must outlive the Span
+ *
+ * @tparam T The element type being viewed, which should be const for read-only views
+ */
+template<typename T>
+class Span
+{
+public:
+
+    Span() = default;
+
+    /**
+     * @brief Creates a span over an existing range of elements
+     * @param data a pointer to the first element of the range
+     * @param size the number of elements in the range
+     */
+    Span(T* data, size_t size) : data {data}, size {size} {}
+
+    T& operator[](size_t index) const
+    {
+        return data[index];
+    }
+
+    T* Data() const
+    {
+        return data;
+    }
+
+    size_t Size() const
+    {
+        return size;
+    }
+
+    size_t SizeBytes() const
+    {
+        return size * sizeof(T);
+    }
+
+    bool Empty() const
+    {
+        return size == 0;
+    }
+
+    T* begin() const
+    {
+        return data;
+    }
+
+    T* end() const
+    {
+        return data + size;
+    }
+
+private:
+
+    T* data {nullptr};
+    size_t size {0};
+};
+} // namespace Siege
+
+#endif // SIEGE_ENGINE_SPAN_H
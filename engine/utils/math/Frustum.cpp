@@ -0,0 +1,124 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#include "Frustum.h"
+
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SIEGE_FRUSTUM_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace Siege
+{
+static_assert(sizeof(Vec4) == sizeof(float) * 4, "Spheres must be tightly packed to cull with SSE");
+
+static Vec4 GetRow(const Mat4& matrix, unsigned int row)
+{
+    return {matrix[0][row], matrix[1][row], matrix[2][row], matrix[3][row]};
+}
+
+static Vec4 NormalisePlane(const Vec4& plane)
+{
+    float length = Vec3::Length(plane.XYZ());
+    return length > 0.f ? plane / length : plane;
+}
+
+static float DistanceToPlane(const Vec4& plane, const Vec3& point)
+{
+    return Vec3::Dot(plane.XYZ(), point) + plane.w;
+}
+
+Frustum Frustum::FromViewProjection(const Mat4& viewProjection)
+{
+    // Each plane bounds one clip space coordinate by w, so is a sum of the matrix's rows
+    Vec4 x = GetRow(viewProjection, 0);
+    Vec4 y = GetRow(viewProjection, 1);
+    Vec4 z = GetRow(viewProjection, 2);
+    Vec4 w = GetRow(viewProjection, 3);
+
+    Frustum frustum;
+    frustum.planes[PLANE_LEFT] = NormalisePlane(w + x);
+    frustum.planes[PLANE_RIGHT] = NormalisePlane(w - x);
+    frustum.planes[PLANE_BOTTOM] = NormalisePlane(w + y);
+    frustum.planes[PLANE_TOP] = NormalisePlane(w - y);
+    frustum.planes[PLANE_NEAR] = NormalisePlane(z);
+    frustum.planes[PLANE_FAR] = NormalisePlane(w - z);
+    return frustum;
+}
+
+bool Frustum::Intersects(const Vec3& centre, float radius) const
+{
+    for (const Vec4& plane : planes)
+    {
+        if (DistanceToPlane(plane, centre) < -radius) return false;
+    }
+    return true;
+}
+
+bool Frustum::Intersects(const BoundedBox& box) const
+{
+    Vec3 centre = (box.min + box.max) * 0.5f;
+    Vec3 extent = (box.max - box.min) * 0.5f;
+
+    for (const Vec4& plane : planes)
+    {
+        // The box's extent projected onto the plane's normal
+        float radius = extent.x * std::abs(plane.x) + extent.y * std::abs(plane.y) +
+                       extent.z * std::abs(plane.z);
+        if (DistanceToPlane(plane, centre) < -radius) return false;
+    }
+    return true;
+}
+
+size_t CullSpheres(const Frustum& frustum, const Vec4* spheres, size_t count, uint8_t* visible)
+{
+    size_t visibleCount {0};
+    size_t i {0};
+
+#ifdef SIEGE_FRUSTUM_SSE
+    for (; i + 4 <= count; i += 4)
+    {
+        // Transpose four spheres so that each register holds one component of all of them
+        __m128 x = _mm_loadu_ps(&spheres[i].x);
+        __m128 y = _mm_loadu_ps(&spheres[i + 1].x);
+        __m128 z = _mm_loadu_ps(&spheres[i + 2].x);
+        __m128 radius = _mm_loadu_ps(&spheres[i + 3].x);
+        _MM_TRANSPOSE4_PS(x, y, z, radius);
+
+        __m128 negativeRadius = _mm_sub_ps(_mm_setzero_ps(), radius);
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (const Vec4& plane : frustum.planes)
+        {
+            __m128 distance = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(plane.x)),
+                                         _mm_mul_ps(y, _mm_set1_ps(plane.y)));
+            distance = _mm_add_ps(distance, _mm_mul_ps(z, _mm_set1_ps(plane.z)));
+            distance = _mm_add_ps(distance, _mm_set1_ps(plane.w));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, negativeRadius));
+        }
+
+        int mask = _mm_movemask_ps(inside);
+        for (size_t j = 0; j < 4; j++)
+        {
+            visible[i + j] = (mask >> j) & 1;
+            visibleCount += visible[i + j];
+        }
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        visible[i] = frustum.Intersects(spheres[i].XYZ(), spheres[i].w);
+        visibleCount += visible[i];
+    }
+
+    return visibleCount;
+}
+} // namespace Siege
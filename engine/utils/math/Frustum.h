@@ -0,0 +1,83 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#ifndef SIEGE_ENGINE_UTILS_MATH_FRUSTUM_H
+#define SIEGE_ENGINE_UTILS_MATH_FRUSTUM_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../Macros.h"
+#include "Maths.h"
+
+namespace Siege
+{
+/**
+ * The volume visible through a camera, stored as six planes whose normals point into the volume.
+ * Each plane is packed into a Vec4 as its unit normal followed by its distance from the origin,
+ * so a point is on the inside of a plane when the dot product of the plane with (point, 1) is
+ * positive
+ */
+struct Frustum
+{
+    enum Plane
+    {
+        PLANE_LEFT = 0,
+        PLANE_RIGHT = 1,
+        PLANE_BOTTOM = 2,
+        PLANE_TOP = 3,
+        PLANE_NEAR = 4,
+        PLANE_FAR = 5,
+        PLANE_COUNT = 6
+    };
+
+    /**
+     * Extracts the planes of a frustum from a view projection matrix. Expects clip space depth to
+     * run from zero to one, as produced by Perspective and Orthographic
+     * @param viewProjection the combined view and projection matrices of a camera
+     * @return the frustum, in the space the view matrix transforms from
+     */
+    static Frustum FromViewProjection(const Mat4& viewProjection);
+
+    /**
+     * Tests whether a sphere is at least partially inside the frustum. Spheres near the frustum's
+     * corners may be reported as inside when they are not, which only costs a wasted draw
+     * @param centre the centre of the sphere
+     * @param radius the radius of the sphere
+     * @return true if the sphere may be visible, false if it is entirely outside
+     */
+    bool Intersects(const Vec3& centre, float radius) const;
+
+    /**
+     * Tests whether a box is at least partially inside the frustum, with the same conservative
+     * corner behaviour as the sphere test
+     * @param box the axis aligned box to test
+     * @return true if the box may be visible, false if it is entirely outside
+     */
+    bool Intersects(const BoundedBox& box) const;
+
+    Vec4 planes[PLANE_COUNT];
+};
+
+/**
+ * Tests a list of bounding spheres against a frustum, four at a time where SSE is available
+ * @param frustum the frustum to test against
+ * @param spheres the spheres to test, each with its centre in xyz and its radius in w
+ * @param count the number of spheres
+ * @param visible filled with one for each sphere that may be visible and zero for each that is
+ * entirely outside the frustum
+ * @return the number of spheres which may be visible
+ */
+size_t CullSpheres(const Frustum& frustum,
+                   const Vec4* spheres,
+                   size_t count,
+                   OUT uint8_t* visible);
+} // namespace Siege
+
+#endif // SIEGE_ENGINE_UTILS_MATH_FRUSTUM_H
@@ -0,0 +1,207 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#ifndef SIEGE_ENGINE_QUANTISATION_H
+#define SIEGE_ENGINE_QUANTISATION_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include "vec/Vec2.h"
+#include "vec/Vec3.h"
+#include "vec/Vec4.h"
+
+/**
+ * A library for packing floats into smaller fixed point and half precision formats. Encodings
+ * match the Vulkan UNORM, SNORM and SFLOAT conversion rules so that they decode in hardware
+ */
+namespace Siege::Quantisation
+{
+/**
+ * Converts a float to an IEEE 754 half precision float, rounding to the nearest value
+ * @param value the float to convert
+ * @return the bits of the half precision float
+ */
+inline uint16_t FloatToHalf(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    uint16_t sign = (bits >> 16) & 0x8000;
+    int32_t exponent = static_cast<int32_t>((bits >> 23) & 0xff) - 127 + 15;
+    uint32_t mantissa = bits & 0x7fffff;
+
+    // NaN stays NaN, infinities and values too large for a half become infinity
+    if (((bits >> 23) & 0xff) == 0xff) return sign | 0x7c00 | (mantissa ? 0x200 : 0);
+    if (exponent >= 0x1f) return sign | 0x7c00;
+
+    if (exponent <= 0)
+    {
+        // Subnormal halves, values below half the smallest subnormal flush to zero
+        if (exponent < -10) return sign;
+        mantissa |= 0x800000;
+        uint32_t shift = 14 - exponent;
+        uint32_t half = mantissa >> shift;
+        uint32_t remainder = mantissa & ((1u << shift) - 1);
+        uint32_t halfway = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (half & 1))) half++;
+        return sign | half;
+    }
+
+    uint32_t half = (exponent << 10) | (mantissa >> 13);
+    uint32_t remainder = mantissa & 0x1fff;
+    if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1))) half++;
+    return sign | half;
+}
+
+/**
+ * Converts an IEEE 754 half precision float to a float
+ * @param value the bits of the half precision float
+ * @return the converted float
+ */
+inline float HalfToFloat(uint16_t value)
+{
+    uint32_t sign = static_cast<uint32_t>(value & 0x8000) << 16;
+    uint32_t exponent = (value >> 10) & 0x1f;
+    uint32_t mantissa = value & 0x3ff;
+
+    uint32_t bits;
+    if (exponent == 0x1f) bits = sign | 0x7f800000 | (mantissa << 13);
+    else if (exponent != 0) bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+    else if (mantissa == 0) bits = sign;
+    else
+    {
+        // Normalise the subnormal half into a regular float
+        exponent = 127 - 15 + 1;
+        while (!(mantissa & 0x400))
+        {
+            mantissa <<= 1;
+            exponent--;
+        }
+        bits = sign | (exponent << 23) | ((mantissa & 0x3ff) << 13);
+    }
+
+    float result;
+    memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+inline uint16_t EncodeUnorm16(float value)
+{
+    return static_cast<uint16_t>(std::lround(std::clamp(value, 0.f, 1.f) * 65535.f));
+}
+
+inline float DecodeUnorm16(uint16_t value)
+{
+    return static_cast<float>(value) / 65535.f;
+}
+
+inline int16_t EncodeSnorm16(float value)
+{
+    return static_cast<int16_t>(std::lround(std::clamp(value, -1.f, 1.f) * 32767.f));
+}
+
+inline float DecodeSnorm16(int16_t value)
+{
+    return std::max(static_cast<float>(value) / 32767.f, -1.f);
+}
+
+inline uint8_t EncodeUnorm8(float value)
+{
+    return static_cast<uint8_t>(std::lround(std::clamp(value, 0.f, 1.f) * 255.f));
+}
+
+inline float DecodeUnorm8(uint8_t value)
+{
+    return static_cast<float>(value) / 255.f;
+}
+
+/**
+ * Maps a unit vector onto an octahedron unfolded into a square, which represents directions
+ * more evenly than storing each component separately
+ * @param normal the unit vector to encode
+ * @return the position of the vector on the unfolded octahedron, in the range [-1, 1]
+ */
+inline Vec2 OctahedralEncode(const Vec3& normal)
+{
+    float length = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+    if (length <= 0.f) return {0.f, 0.f};
+
+    Vec2 encoded {normal.x / length, normal.y / length};
+    if (normal.z < 0.f)
+    {
+        // Fold the lower hemisphere over the diagonals of the square
+        encoded = {(1.f - std::abs(encoded.y)) * (encoded.x >= 0.f ? 1.f : -1.f),
+                   (1.f - std::abs(encoded.x)) * (encoded.y >= 0.f ? 1.f : -1.f)};
+    }
+    return encoded;
+}
+
+inline Vec3 OctahedralDecode(const Vec2& encoded)
+{
+    Vec3 normal {encoded.x, encoded.y, 1.f - std::abs(encoded.x) - std::abs(encoded.y)};
+    float fold = std::max(-normal.z, 0.f);
+    normal.x += normal.x >= 0.f ? -fold : fold;
+    normal.y += normal.y >= 0.f ? -fold : fold;
+    return Vec3::Normalise(normal);
+}
+
+/**
+ * Packs a unit quaternion into 48 bits by dropping its largest component, which can be recovered
+ * from the other three. The remaining components lie within [-1/sqrt(2), 1/sqrt(2)] and are
+ * stored at 15 bits each, with the index of the dropped component in the two spare bits
+ * @param rotation the unit quaternion to encode, as x, y, z, w
+ * @param encoded the three packed components
+ */
+inline void SmallestThreeEncode(const Vec4& rotation, uint16_t encoded[3])
+{
+    constexpr float SQRT2 {1.41421356f};
+
+    float components[4] = {rotation.x, rotation.y, rotation.z, rotation.w};
+    uint32_t largest = 0;
+    for (uint32_t i = 1; i < 4; i++)
+    {
+        if (std::abs(components[i]) > std::abs(components[largest])) largest = i;
+    }
+
+    // q and -q are the same rotation, so the sign is chosen to make the dropped component positive
+    float sign = components[largest] < 0.f ? -1.f : 1.f;
+    for (uint32_t i = 0, j = 0; i < 4; i++)
+    {
+        if (i == largest) continue;
+        float unit = std::clamp(components[i] * sign * SQRT2 * 0.5f + 0.5f, 0.f, 1.f);
+        encoded[j++] = static_cast<uint16_t>(std::lround(unit * 32767.f));
+    }
+    encoded[0] |= (largest & 1) << 15;
+    encoded[1] |= (largest >> 1) << 15;
+}
+
+inline Vec4 SmallestThreeDecode(const uint16_t encoded[3])
+{
+    constexpr float SQRT2 {1.41421356f};
+
+    uint32_t largest = (encoded[0] >> 15) | ((encoded[1] >> 15) << 1);
+    float components[4];
+    float sumSquares = 0.f;
+    for (uint32_t i = 0, j = 0; i < 4; i++)
+    {
+        if (i == largest) continue;
+        float unit = static_cast<float>(encoded[j++] & 0x7fff) / 32767.f;
+        components[i] = (unit * 2.f - 1.f) / SQRT2;
+        sumSquares += components[i] * components[i];
+    }
+    components[largest] = std::sqrt(std::max(1.f - sumSquares, 0.f));
+    return {components[0], components[1], components[2], components[3]};
+}
+
+} // namespace Siege::Quantisation
+
+#endif // SIEGE_ENGINE_QUANTISATION_H
@@ -22,7 +22,7 @@ RenderResources::RenderResources()
                                                        .AddFloatVec4Attribute()
                                                        .AddFloatVec3Attribute()
                                                        .AddFloatVec2Attribute())
-                                .WithStorage<Siege::ModelTransform>("transforms", 0, 1000)
+                                .WithStorage<Siege::ModelTransform>("transforms")
                                 .WithGlobalData3DUniform()
                                 .Build(),
                             Shader::Builder()
@@ -32,7 +32,7 @@ RenderResources::RenderResources()
 
     cubeMesh = Siege::Vulkan::StaticMesh("assets/models/cube/cube.sm", &cubeMaterial);
 
-    defaultFont = Siege::Vulkan::Font("assets/fonts/PublicPixel.ttf");
+    defaultFont = Siege::Vulkan::Font("assets/fonts/PublicPixel.font");
 }
 
 Siege::Vulkan::Material* RenderResources::GetCubeMaterial()
@@ -35,8 +35,8 @@ int main(int argc, char* argv[])
 
     Siege::Input::SetInputWindowSource(reinterpret_cast<GLFWwindow*>(window.GetRawWindow()));
 
-    // Initialise resources
-    Siege::ResourceSystem::GetInstance().MountPackFile();
+    // Initialise resources, streaming entries so that each scene's bundle is read in one go
+    Siege::ResourceSystem::GetInstance().MountPackFile({}, Siege::PackFile::STREAMED);
 
     Siege::Renderer renderer(window);
     ServiceLocator::Provide(&renderer);
@@ -129,6 +129,9 @@ int main(int argc, char* argv[])
         Siege::Statics::Entity().FreeEntities();
         Siege::Statics::Tool().FreeEntities();
         Siege::Statics::Scene().LoadNextScene();
+
+        // Finalise any asynchronous resource loads on the main thread
+        Siege::ResourceSystem::GetInstance().PumpCompletions();
     }
 
     renderer.ClearQueues();
@@ -56,8 +56,8 @@ int main()
     auto aryehthulu = Siege::Vulkan::Texture2D("Aryehthulu", "assets/textures/aryehthulu.jpg");
     auto cappy = Siege::Vulkan::Texture2D("Cthulhu", "assets/textures/cappy.png");
 
-    auto meslo = Siege::Vulkan::Font("assets/fonts/meslo-lg/MesloLGS-Regular.ttf");
-    auto pixel = Siege::Vulkan::Font("assets/fonts/PublicPixel.ttf");
+    auto meslo = Siege::Vulkan::Font("assets/fonts/meslo-lg/MesloLGS-Regular.font");
+    auto pixel = Siege::Vulkan::Font("assets/fonts/PublicPixel.font");
 
     // Shader Declaration
 
@@ -75,7 +75,24 @@ int main()
                                             .AddFloatVec4Attribute()
                                             .AddFloatVec3Attribute()
                                             .AddFloatVec2Attribute())
-                     .WithStorage<Siege::ModelTransform>("transforms", 0, 1000)
+                     .WithStorage<Siege::ModelTransform>("transforms")
+                     .WithGlobalData3DUniform()
+                     .Build(),
+                 Shader::Builder()
+                     .FromFragmentShader("assets/shaders/diffuseFragShader.frag.spv")
+                     .WithGlobalData3DUniform()
+                     .Build());
+
+    // Quantised meshes store compact vertices which are decoded by their vertex shader
+    auto quantisedMaterial =
+        Material(Shader::Builder()
+                     .FromVertexShader("assets/shaders/simpleShaderQuantised.vert.spv")
+                     .WithVertexBinding(Shader::VertexBinding()
+                                            .AddUnorm16Vec4Attribute()
+                                            .AddSnorm16Vec2Attribute()
+                                            .AddUnorm8Vec4Attribute()
+                                            .AddHalfVec2Attribute())
+                     .WithStorage<Siege::ModelTransform>("transforms")
                      .WithGlobalData3DUniform()
                      .Build(),
                  Shader::Builder()
@@ -85,7 +102,7 @@ int main()
 
     // Generate models
     Siege::Vulkan::StaticMesh cubeObjModel("assets/models/cube.sm", &testMaterial);
-    Siege::Vulkan::StaticMesh vaseObjModel("assets/models/smooth_vase.sm", &testMaterial);
+    Siege::Vulkan::StaticMesh vaseObjModel("assets/models/smooth_vase.sm", &quantisedMaterial);
     Siege::Vulkan::StaticMesh cubeSetObjModel("assets/models/cube_set.sm", &testMaterial);
     Siege::Vulkan::StaticMesh gizmoObjModel("assets/models/gizmo.sm", &testMaterial);
 
@@ -26,7 +26,7 @@ int main()
     Siege::ResourceSystem::GetInstance().MountPackFile();
     Siege::Renderer renderer(window);
 
-    auto pixel = Siege::Vulkan::Font("assets/fonts/PublicPixel.ttf");
+    auto pixel = Siege::Vulkan::Font("assets/fonts/PublicPixel.font");
     auto tilemap = Siege::Vulkan::TextureAtlas("tilemap",
                                                "assets/textures/tilemap.png",
                                                {.5f, .5f},
@@ -0,0 +1,373 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#include "AnimationCompressor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+using Siege::Vec3;
+using Siege::Vec4;
+
+enum TrackType
+{
+    TRACK_POSITION,
+    TRACK_ROTATION,
+    TRACK_SCALE
+};
+
+// Vector tracks keep their values in the first three components so that every track can be
+// handled the same way
+struct Track
+{
+    TrackType type;
+    float reach;
+    std::vector<double> times;
+    std::vector<Vec4> values;
+};
+
+static double Dot(const Vec4& left, const Vec4& right)
+{
+    return static_cast<double>(left.x) * right.x + static_cast<double>(left.y) * right.y +
+           static_cast<double>(left.z) * right.z + static_cast<double>(left.w) * right.w;
+}
+
+static Vec4 Normalise(const Vec4& rotation)
+{
+    double length = std::sqrt(Dot(rotation, rotation));
+    if (length <= 0.0) return {0.f, 0.f, 0.f, 1.f};
+    float scale = static_cast<float>(1.0 / length);
+    return {rotation.x * scale, rotation.y * scale, rotation.z * scale, rotation.w * scale};
+}
+
+static Vec4 Lerp(const Vec4& from, const Vec4& to, float t)
+{
+    return {from.x + (to.x - from.x) * t,
+            from.y + (to.y - from.y) * t,
+            from.z + (to.z - from.z) * t,
+            from.w + (to.w - from.w) * t};
+}
+
+static Vec4 Nlerp(const Vec4& from, Vec4 to, float t)
+{
+    // Interpolate along the shorter of the two arcs between the rotations
+    if (Dot(from, to) < 0.0) to = {-to.x, -to.y, -to.z, -to.w};
+    return Normalise(Lerp(from, to, t));
+}
+
+static Vec4 Slerp(const Vec4& from, Vec4 to, float t)
+{
+    double cosAngle = Dot(from, to);
+    if (cosAngle < 0.0)
+    {
+        to = {-to.x, -to.y, -to.z, -to.w};
+        cosAngle = -cosAngle;
+    }
+
+    // Nearly identical rotations divide by a vanishing sine, where a normalised lerp is exact
+    // enough
+    if (cosAngle > 0.9995) return Normalise(Lerp(from, to, t));
+
+    double angle = std::acos(cosAngle);
+    double sinAngle = std::sin(angle);
+    float fromWeight = static_cast<float>(std::sin((1.0 - t) * angle) / sinAngle);
+    float toWeight = static_cast<float>(std::sin(t * angle) / sinAngle);
+    return {from.x * fromWeight + to.x * toWeight,
+            from.y * fromWeight + to.y * toWeight,
+            from.z * fromWeight + to.z * toWeight,
+            from.w * fromWeight + to.w * toWeight};
+}
+
+static Vec4 Interpolate(TrackType type, const Vec4& from, const Vec4& to, float t)
+{
+    return type == TRACK_ROTATION ? Nlerp(from, to, t) : Lerp(from, to, t);
+}
+
+/**
+ * Measures how far an approximated value moves a bone, or the furthest of its descendants, from
+ * where the exact value would place it
+ */
+static double GetError(const Track& track, const Vec4& approximate, const Vec4& exact)
+{
+    switch (track.type)
+    {
+        case TRACK_POSITION:
+        {
+            double dx = approximate.x - exact.x, dy = approximate.y - exact.y,
+                   dz = approximate.z - exact.z;
+            return std::sqrt(dx * dx + dy * dy + dz * dz);
+        }
+        case TRACK_ROTATION:
+        {
+            double cosHalfAngle = std::min(std::abs(Dot(approximate, exact)), 1.0);
+            return 2.0 * std::acos(cosHalfAngle) * track.reach;
+        }
+        case TRACK_SCALE:
+        {
+            double difference = std::max({std::abs(approximate.x - exact.x),
+                                          std::abs(approximate.y - exact.y),
+                                          std::abs(approximate.z - exact.z)});
+            return difference * track.reach;
+        }
+    }
+    return 0.0;
+}
+
+static Track GetSourceTrack(const Siege::AnimationChannel& channel, TrackType type, float reach)
+{
+    Track track {type, reach};
+    switch (type)
+    {
+        case TRACK_POSITION:
+            for (const Siege::AnimKeyPosition& key : channel.positionKeys)
+            {
+                track.times.push_back(key.timestamp);
+                track.values.push_back({key.position.x, key.position.y, key.position.z, 0.f});
+            }
+            break;
+        case TRACK_ROTATION:
+            for (const Siege::AnimKeyRotation& key : channel.rotationKeys)
+            {
+                track.times.push_back(key.timestamp);
+                track.values.push_back(Normalise(key.rotation));
+            }
+            break;
+        case TRACK_SCALE:
+            for (const Siege::AnimKeyScale& key : channel.scaleKeys)
+            {
+                track.times.push_back(key.timestamp);
+                track.values.push_back({key.scale.x, key.scale.y, key.scale.z, 0.f});
+            }
+            break;
+    }
+    return track;
+}
+
+static Vec4 Sample(const Track& source, double time)
+{
+    auto next = std::upper_bound(source.times.begin(), source.times.end(), time);
+    if (next == source.times.begin()) return source.values.front();
+    if (next == source.times.end()) return source.values.back();
+
+    size_t index = next - source.times.begin();
+    double span = source.times[index] - source.times[index - 1];
+    float t = span > 0.0 ? static_cast<float>((time - source.times[index - 1]) / span) : 0.f;
+    if (source.type == TRACK_ROTATION)
+    {
+        return Slerp(source.values[index - 1], source.values[index], t);
+    }
+    return Lerp(source.values[index - 1], source.values[index], t);
+}
+
+static Siege::AnimCompressedTrack QuantiseTrack(const Track& samples,
+                                               OUT std::vector<Vec4>& decoded)
+{
+    Siege::AnimCompressedTrack track;
+    std::vector<Siege::AnimCompressedKey>& keys = track.keys;
+    keys.resize(samples.values.size());
+    decoded.resize(samples.values.size());
+
+    if (samples.type == TRACK_ROTATION)
+    {
+        for (size_t i = 0; i < keys.size(); i++)
+        {
+            keys[i].frame = static_cast<uint16_t>(i);
+            Siege::Quantisation::SmallestThreeEncode(samples.values[i], keys[i].value);
+            decoded[i] = Siege::DecodeAnimKeyRotation(keys[i]);
+        }
+        return track;
+    }
+
+    Vec3 rangeMax {samples.values[0].x, samples.values[0].y, samples.values[0].z};
+    track.rangeMin = rangeMax;
+    for (const Vec4& value : samples.values)
+    {
+        track.rangeMin = {std::min(track.rangeMin.x, value.x),
+                          std::min(track.rangeMin.y, value.y),
+                          std::min(track.rangeMin.z, value.z)};
+        rangeMax = {std::max(rangeMax.x, value.x),
+                    std::max(rangeMax.y, value.y),
+                    std::max(rangeMax.z, value.z)};
+    }
+
+    // Constant components have no range, which would otherwise divide by zero
+    track.rangeExtent = rangeMax - track.rangeMin;
+    if (track.rangeExtent.x <= 0.f) track.rangeExtent.x = 1.f;
+    if (track.rangeExtent.y <= 0.f) track.rangeExtent.y = 1.f;
+    if (track.rangeExtent.z <= 0.f) track.rangeExtent.z = 1.f;
+
+    using namespace Siege::Quantisation;
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        const Vec4& value = samples.values[i];
+        keys[i].frame = static_cast<uint16_t>(i);
+        keys[i].value[0] = EncodeUnorm16((value.x - track.rangeMin.x) / track.rangeExtent.x);
+        keys[i].value[1] = EncodeUnorm16((value.y - track.rangeMin.y) / track.rangeExtent.y);
+        keys[i].value[2] = EncodeUnorm16((value.z - track.rangeMin.z) / track.rangeExtent.z);
+        Vec3 vector = Siege::DecodeAnimKeyVector(track, keys[i]);
+        decoded[i] = {vector.x, vector.y, vector.z, 0.f};
+    }
+    return track;
+}
+
+/**
+ * Removes the keys of a quantised track that interpolating between the kept keys reproduces
+ * within the tolerance. Like Douglas-Peucker line simplification, the worst fitting frame of each
+ * span is kept and the span split around it until every frame fits
+ */
+static void ReduceTrack(const Track& samples,
+                        const std::vector<Vec4>& decoded,
+                        float tolerance,
+                        OUT Siege::AnimCompressedTrack& track)
+{
+    size_t frameCount = decoded.size();
+    std::vector<bool> keep(frameCount, false);
+    keep[0] = true;
+
+    // Tracks that barely move need only their first key
+    bool isConstant = true;
+    for (size_t i = 1; i < frameCount && isConstant; i++)
+    {
+        isConstant = GetError(samples, decoded[0], samples.values[i]) <= tolerance;
+    }
+
+    if (!isConstant)
+    {
+        keep[frameCount - 1] = true;
+        std::vector<std::pair<size_t, size_t>> spans {{0, frameCount - 1}};
+        while (!spans.empty())
+        {
+            auto [first, last] = spans.back();
+            spans.pop_back();
+
+            size_t worstFrame = first;
+            double worstError = tolerance;
+            for (size_t i = first + 1; i < last; i++)
+            {
+                float t = static_cast<float>(i - first) / static_cast<float>(last - first);
+                Vec4 approximate = Interpolate(samples.type, decoded[first], decoded[last], t);
+                double error = GetError(samples, approximate, samples.values[i]);
+                if (error > worstError)
+                {
+                    worstFrame = i;
+                    worstError = error;
+                }
+            }
+
+            if (worstFrame == first) continue;
+            keep[worstFrame] = true;
+            spans.emplace_back(first, worstFrame);
+            spans.emplace_back(worstFrame, last);
+        }
+    }
+
+    std::vector<Siege::AnimCompressedKey> keptKeys;
+    for (size_t i = 0; i < frameCount; i++)
+    {
+        if (keep[i]) keptKeys.push_back(track.keys[i]);
+    }
+    track.keys = std::move(keptKeys);
+}
+
+static Vec4 SampleCompressed(const Siege::AnimCompressedTrack& track, TrackType type, double frame)
+{
+    auto decode = [&track, type](const Siege::AnimCompressedKey& key) -> Vec4 {
+        if (type == TRACK_ROTATION) return Siege::DecodeAnimKeyRotation(key);
+        Vec3 vector = Siege::DecodeAnimKeyVector(track, key);
+        return {vector.x, vector.y, vector.z, 0.f};
+    };
+
+    auto next = std::upper_bound(track.keys.begin(),
+                                 track.keys.end(),
+                                 frame,
+                                 [](double f, const Siege::AnimCompressedKey& key) {
+                                     return f < key.frame;
+                                 });
+    if (next == track.keys.begin()) return decode(track.keys.front());
+    if (next == track.keys.end()) return decode(track.keys.back());
+
+    auto previous = next - 1;
+    float t = static_cast<float>((frame - previous->frame) / (next->frame - previous->frame));
+    return Interpolate(type, decode(*previous), decode(*next), t);
+}
+
+template<typename T>
+static size_t GetSerialisedSize(T value)
+{
+    Siege::BinarySerialisation::Buffer buffer;
+    Siege::BinarySerialisation::serialise(buffer, value, Siege::BinarySerialisation::SERIALISE);
+    return buffer.data.size();
+}
+
+bool CompressAnimation(OUT Siege::AnimationData& animation,
+                       const std::map<Siege::String, float>& boneReaches,
+                       float tolerance,
+                       double sampleRate,
+                       OUT AnimationCompressionReport& report)
+{
+    // Clips without a tick rate are conventionally played at 25 ticks per second
+    double ticksPerSecond = animation.speed > 0.0 ? animation.speed : 25.0;
+    double seconds = std::max(animation.length, 0.0) / ticksPerSecond;
+    double frameCount = std::ceil(seconds * sampleRate - 1e-6) + 1.0;
+    if (frameCount > UINT16_MAX + 1.0) return false;
+
+    // Frames are spaced to land exactly on both ends of the clip
+    size_t frames = static_cast<size_t>(frameCount);
+    animation.frameDuration = frames > 1 ? animation.length / static_cast<double>(frames - 1) : 1.0;
+
+    report = {};
+    for (const auto& [name, channel] : animation.channels)
+    {
+        auto reachIt = boneReaches.find(name);
+        float reach = reachIt != boneReaches.end() ? reachIt->second : 1.f;
+
+        Siege::AnimCompressedChannel& compressed = animation.compressedChannels[name];
+        Siege::AnimCompressedTrack* tracks[] = {&compressed.positions,
+                                                &compressed.rotations,
+                                                &compressed.scales};
+        for (TrackType type : {TRACK_POSITION, TRACK_ROTATION, TRACK_SCALE})
+        {
+            Track source = GetSourceTrack(channel, type, reach);
+            if (source.values.empty()) continue;
+
+            Track samples {type, reach};
+            for (size_t i = 0; i < frames; i++)
+            {
+                samples.values.push_back(Sample(source, i * animation.frameDuration));
+            }
+
+            std::vector<Vec4> decoded;
+            Siege::AnimCompressedTrack& track = *tracks[type];
+            track = QuantiseTrack(samples, decoded);
+            ReduceTrack(samples, decoded, tolerance, track);
+
+            // Error is measured against the source keys as well as the frames, so any detail lost
+            // to resampling shows up in the report
+            std::vector<double> times = source.times;
+            for (size_t i = 0; i < frames; i++) times.push_back(i * animation.frameDuration);
+            for (double time : times)
+            {
+                Vec4 approximate = SampleCompressed(track, type, time / animation.frameDuration);
+                double error = GetError(source, approximate, Sample(source, time));
+                if (error <= report.maxError) continue;
+                report.maxError = error;
+                report.maxErrorChannel = name;
+            }
+        }
+    }
+
+    size_t sourceSize = GetSerialisedSize(animation.channels);
+    size_t compressedSize = GetSerialisedSize(animation.compressedChannels);
+    report.compressionRatio =
+        compressedSize > 0 ? static_cast<double>(sourceSize) / compressedSize : 0.0;
+
+    animation.channels.clear();
+    return true;
+}
@@ -0,0 +1,53 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#ifndef SIEGE_ENGINE_PACKER_ANIMATIONCOMPRESSOR_H
+#define SIEGE_ENGINE_PACKER_ANIMATIONCOMPRESSOR_H
+
+#include <resources/AnimationData.h>
+#include <utils/Macros.h>
+
+#include <map>
+
+// The number of frames per second tracks are resampled at when a clip does not specify a rate
+#define ANIMATION_COMPRESSOR_DEFAULT_SAMPLE_RATE 30.0
+
+// The displacement in model units compression may introduce at any bone by default
+#define ANIMATION_COMPRESSOR_DEFAULT_TOLERANCE 0.001f
+
+struct AnimationCompressionReport
+{
+    // The serialised size of the source channels over that of the compressed channels
+    double compressionRatio {0.0};
+    // The largest displacement compression introduced at any bone, in model units
+    double maxError {0.0};
+    // The channel the largest displacement was measured at
+    Siege::String maxErrorChannel;
+};
+
+/**
+ * Compresses the channels of an animation. Each track is resampled at a uniform frame rate,
+ * quantised, and reduced to the keys that linear interpolation cannot reproduce within the
+ * tolerance. Rotation and scale errors move a bone's descendants further than the bone itself, so
+ * they are measured as displacements at the bone's reach, making the tolerance per bone
+ * @param animation - the animation to compress, its channels are replaced by compressed channels
+ * @param boneReaches - the distance from each channel's bone to its furthest descendant, channels
+ * without a reach are treated as having a reach of one unit
+ * @param tolerance - the displacement in model units allowed at any bone
+ * @param sampleRate - the number of frames per second to resample tracks at
+ * @param report - filled with the size reduction and accuracy of the compression
+ * @return true if the animation was compressed, false if it has too many frames to index
+ */
+bool CompressAnimation(OUT Siege::AnimationData& animation,
+                       const std::map<Siege::String, float>& boneReaches,
+                       float tolerance,
+                       double sampleRate,
+                       OUT AnimationCompressionReport& report);
+
+#endif // SIEGE_ENGINE_PACKER_ANIMATIONCOMPRESSOR_H
@@ -0,0 +1,188 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#include "BuildCache.h"
+
+#include <resources/PackFile.h>
+#include <utils/FileSystem.h>
+#include <utils/Hash.h>
+#include <utils/Logging.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#pragma pack(push, 1)
+struct CacheHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    uint64_t dataSize;
+    uint64_t compressedDataSize;
+};
+#pragma pack(pop)
+
+static uint64_t HashFileContents(const std::filesystem::path& path, uint64_t hash)
+{
+    std::ifstream inputFileStream(path, std::ios::in | std::ios::binary);
+    std::vector<char> contents((std::istreambuf_iterator<char>(inputFileStream)),
+                               std::istreambuf_iterator<char>());
+    uint64_t size = contents.size();
+    hash = Siege::Hash::Fnv1a64(reinterpret_cast<const uint8_t*>(&size), sizeof(size), hash);
+    return Siege::Hash::Fnv1a64(reinterpret_cast<const uint8_t*>(contents.data()),
+                                contents.size(),
+                                hash);
+}
+
+static uint64_t HashString(const Siege::String& string, uint64_t hash)
+{
+    return Siege::Hash::Fnv1a64(reinterpret_cast<const uint8_t*>(string.Str()),
+                                string.Size() + 1,
+                                hash);
+}
+
+static std::filesystem::path GetCachePath(const Siege::String& cacheDir, uint64_t key)
+{
+    char fileName[32];
+    snprintf(fileName, sizeof(fileName), "%016llx.pkc", static_cast<unsigned long long>(key));
+    return std::filesystem::path(cacheDir.Str()) / fileName;
+}
+
+uint64_t HashInputFile(const std::filesystem::path& file,
+                       const Siege::String& assetsDir,
+                       uint64_t optionsHash)
+{
+    uint32_t versions[] = {PACKER_FILE_VERSION, PACKER_CACHE_VERSION};
+    uint64_t hash = Siege::Hash::Fnv1a64(reinterpret_cast<const uint8_t*>(versions),
+                                         sizeof(versions));
+    hash = Siege::Hash::Fnv1a64(reinterpret_cast<const uint8_t*>(&optionsHash),
+                                sizeof(optionsHash),
+                                hash);
+    hash = HashString(file.c_str(), hash);
+
+    std::filesystem::path fullPath = std::filesystem::path(assetsDir.Str()) / file;
+    if (std::filesystem::is_directory(fullPath))
+    {
+        // Scenes are directories of entity files, which are read in directory order
+        std::vector<std::filesystem::path> paths;
+        for (const auto& entry : std::filesystem::directory_iterator(fullPath))
+        {
+            paths.push_back(entry.path());
+        }
+        std::sort(paths.begin(), paths.end());
+        for (const std::filesystem::path& path : paths)
+        {
+            hash = HashString(path.filename().c_str(), hash);
+            hash = HashFileContents(path, hash);
+        }
+        return hash;
+    }
+
+    hash = HashFileContents(fullPath, hash);
+
+    // Attribute files reference their source data by path, so changes to those must be seen too
+    Siege::String extension = file.extension().c_str();
+    if (extension == ".sm" || extension == ".sk" || extension == ".ska" || extension == ".font")
+    {
+        Siege::String contents = Siege::FileSystem::Read(fullPath.c_str());
+        for (const Siege::String& line : contents.Split(ATTR_FILE_LINE_SEP))
+        {
+            std::vector<Siege::String> attribute = line.Split(ATTR_FILE_VALUE_SEP);
+            if (attribute.size() != 2) continue;
+
+            std::filesystem::path referencePath =
+                std::filesystem::path(assetsDir.Str()) / attribute[1].Str();
+            if (!std::filesystem::is_regular_file(referencePath)) continue;
+            hash = HashString(attribute[1], hash);
+            hash = HashFileContents(referencePath, hash);
+        }
+    }
+    return hash;
+}
+
+bool ReadCachedEntry(const Siege::String& cacheDir,
+                     uint64_t key,
+                     Siege::PackFileData*& data,
+                     std::vector<Bytef>& compressedData)
+{
+    std::filesystem::path cachePath = GetCachePath(cacheDir, key);
+    std::ifstream inputFileStream(cachePath, std::ios::in | std::ios::binary);
+    if (!inputFileStream) return false;
+
+    CacheHeader header {};
+    inputFileStream.read(reinterpret_cast<char*>(&header), sizeof(CacheHeader));
+    if (!inputFileStream || memcmp(&header.magic, PACKER_MAGIC_NUMBER_CACHE, 4) != 0 ||
+        header.version != PACKER_CACHE_VERSION || header.key != key ||
+        header.dataSize < sizeof(Siege::PackFileData))
+    {
+        return false;
+    }
+
+    // The sizes come straight from the file, so check them against what's actually there before
+    // allocating for them
+    std::error_code error;
+    uint64_t fileSize = std::filesystem::file_size(cachePath, error);
+    if (error || fileSize < sizeof(CacheHeader) ||
+        header.dataSize > fileSize - sizeof(CacheHeader) ||
+        header.compressedDataSize != fileSize - sizeof(CacheHeader) - header.dataSize)
+    {
+        return false;
+    }
+
+    void* mem = malloc(header.dataSize);
+    compressedData.resize(header.compressedDataSize);
+    inputFileStream.read(static_cast<char*>(mem), static_cast<std::streamsize>(header.dataSize));
+    inputFileStream.read(reinterpret_cast<char*>(compressedData.data()),
+                         static_cast<std::streamsize>(header.compressedDataSize));
+
+    // The entry's embedded size is what its ToC entry and body are written from, so it must agree
+    // with the header as well
+    auto cachedData = static_cast<Siege::PackFileData*>(mem);
+    if (!inputFileStream || cachedData->GetDataSize() != header.dataSize)
+    {
+        free(mem);
+        compressedData.clear();
+        return false;
+    }
+
+    data = cachedData;
+    return true;
+}
+
+bool WriteCachedEntry(const Siege::String& cacheDir,
+                      uint64_t key,
+                      const Siege::PackFileData* data,
+                      const std::vector<Bytef>& compressedData)
+{
+    CacheHeader header {0, PACKER_CACHE_VERSION, key, data->GetDataSize(), compressedData.size()};
+    memcpy(&header.magic, PACKER_MAGIC_NUMBER_CACHE, 4);
+
+    // Write to a temporary file first so that concurrent or interrupted runs never see a partial
+    // entry under its final name
+    std::filesystem::path cachePath = GetCachePath(cacheDir, key);
+    std::filesystem::path tempPath = cachePath;
+    tempPath += ".tmp";
+    {
+        std::ofstream outputFileStream(tempPath, std::ios::out | std::ios::binary);
+        outputFileStream.write(reinterpret_cast<const char*>(&header), sizeof(CacheHeader));
+        outputFileStream.write(reinterpret_cast<const char*>(data), data->GetDataSize());
+        outputFileStream.write(reinterpret_cast<const char*>(compressedData.data()),
+                               static_cast<std::streamsize>(compressedData.size()));
+        if (!outputFileStream)
+        {
+            CC_LOG_WARNING("Failed to write build cache entry \"{}\"", tempPath.string().c_str())
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, cachePath, error);
+    return !error;
+}
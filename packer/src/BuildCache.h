@@ -0,0 +1,54 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#ifndef SIEGE_ENGINE_PACKER_BUILDCACHE_H
+#define SIEGE_ENGINE_PACKER_BUILDCACHE_H
+
+#include <resources/PackFileData.h>
+#include <utils/String.h>
+#include <zlib.h>
+
+#include <filesystem>
+#include <vector>
+
+#define PACKER_MAGIC_NUMBER_CACHE "pkc!"
+// Bump whenever a change to the packers alters their output, invalidating all cached entries
+#define PACKER_CACHE_VERSION 5
+
+/**
+ * Computes the cache key of an input file. The key covers the entry name, the packer and cache
+ * versions, the packing options and the contents of the input along with any files it references
+ * @param file - the input file path, relative to the assets directory
+ * @param assetsDir - the assets directory the input is read from
+ * @param optionsHash - a hash of the packing options that affect entry contents
+ * @return the cache key for the input
+ */
+uint64_t HashInputFile(const std::filesystem::path& file,
+                       const Siege::String& assetsDir,
+                       uint64_t optionsHash);
+
+/**
+ * Reads a cached entry from the build cache
+ * @param cacheDir - the build cache directory
+ * @param key - the cache key of the input the entry was packed from
+ * @param data - the packed entry data, allocated with malloc on success
+ * @param compressedData - the compressed entry data
+ * @return true if a valid entry was found for the key, false otherwise
+ */
+bool ReadCachedEntry(const Siege::String& cacheDir,
+                     uint64_t key,
+                     Siege::PackFileData*& data,
+                     std::vector<Bytef>& compressedData);
+
+bool WriteCachedEntry(const Siege::String& cacheDir,
+                      uint64_t key,
+                      const Siege::PackFileData* data,
+                      const std::vector<Bytef>& compressedData);
+
+#endif // SIEGE_ENGINE_PACKER_BUILDCACHE_H
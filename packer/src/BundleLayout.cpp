@@ -0,0 +1,135 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#include "BundleLayout.h"
+
+#include <resources/SceneData.h>
+#include <utils/FileSystem.h>
+#include <utils/Logging.h>
+
+#include <cstring>
+#include <map>
+
+using Siege::PackFile;
+
+static bool IsSceneEntry(const Siege::String& name)
+{
+    static constexpr const char* sceneExtension = ".scene";
+    size_t extensionLength = strlen(sceneExtension);
+    return name.Size() >= extensionLength &&
+           strcmp(name.Str() + name.Size() - extensionLength, sceneExtension) == 0;
+}
+
+static bool IsReferenceTo(const Siege::String& value, const Siege::String& name)
+{
+    // Entities reference assets either by their full entry name or relative to the assets folder
+    if (value.IsEmpty() || value.Size() > name.Size()) return false;
+    if (value == name) return true;
+    size_t prefixLength = name.Size() - value.Size();
+    return name.Str()[prefixLength - 1] == '/' &&
+           strcmp(name.Str() + prefixLength, value.Str()) == 0;
+}
+
+static std::vector<Siege::String> FindSceneReferences(const Siege::PackFileData& sceneData)
+{
+    Siege::SceneData scene;
+    Siege::BinarySerialisation::Buffer dataBuffer;
+    dataBuffer.Fill(reinterpret_cast<const uint8_t*>(sceneData.data), sceneData.dataSize);
+    Siege::BinarySerialisation::serialise(dataBuffer,
+                                          scene,
+                                          Siege::BinarySerialisation::DESERIALISE);
+
+    std::vector<Siege::String> references;
+    for (const Siege::String& entity : scene.entities)
+    {
+        for (const Siege::String& line : entity.Split(ATTR_FILE_LINE_SEP))
+        {
+            std::vector<Siege::String> attribute = line.Split(ATTR_FILE_VALUE_SEP);
+            if (attribute.size() == 2) references.push_back(attribute[1]);
+        }
+    }
+    return references;
+}
+
+bool ReadAccessTrace(const Siege::String& tracePath, std::vector<Siege::String>& trace)
+{
+    if (!Siege::FileSystem::Exists(tracePath))
+    {
+        CC_LOG_ERROR("Failed to find access trace file \"{}\"", tracePath)
+        return false;
+    }
+
+    Siege::String content = Siege::FileSystem::Read(tracePath);
+    for (const Siege::String& line : content.Split("\r\n"))
+    {
+        if (!line.IsEmpty()) trace.push_back(line);
+    }
+    return true;
+}
+
+Siege::PackBundleData OrderEntriesByScene(
+    std::vector<std::pair<PackFile::TocEntry*, void*>>& entries,
+    const std::vector<Siege::String>& trace)
+{
+    std::map<Siege::String, std::vector<Siege::String>> tracedGroups;
+    Siege::String tracedScene;
+    for (const Siege::String& name : trace)
+    {
+        if (IsSceneEntry(name)) tracedScene = name;
+        else if (!tracedScene.IsEmpty()) tracedGroups[tracedScene].push_back(name);
+    }
+
+    std::vector<size_t> order;
+    std::vector<bool> placed(entries.size(), false);
+    Siege::PackBundleData bundleData;
+
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        PackFile::TocEntry* sceneEntry = entries[i].first;
+        if (sceneEntry->IsRemoved() || !IsSceneEntry(sceneEntry->name)) continue;
+
+        Siege::PackBundle& bundle = bundleData.bundles[sceneEntry->name];
+        auto placeMatching = [&](const Siege::String& reference) {
+            for (size_t j = 0; j < entries.size(); j++)
+            {
+                if (placed[j] || entries[j].first->IsRemoved()) continue;
+                if (!IsReferenceTo(reference, entries[j].first->name)) continue;
+
+                placed[j] = true;
+                order.push_back(j);
+                bundle.entries.emplace_back(entries[j].first->name);
+            }
+        };
+
+        placeMatching(sceneEntry->name);
+        for (const Siege::String& name : tracedGroups[sceneEntry->name]) placeMatching(name);
+
+        auto sceneData = static_cast<const Siege::PackFileData*>(entries[i].second);
+        for (const Siege::String& reference : FindSceneReferences(*sceneData))
+        {
+            placeMatching(reference);
+        }
+
+        CC_LOG_INFO("Grouped {} entries into bundle for scene \"{}\"",
+                    bundle.entries.size(),
+                    sceneEntry->name)
+    }
+
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        if (!placed[i]) order.push_back(i);
+    }
+
+    std::vector<std::pair<PackFile::TocEntry*, void*>> orderedEntries;
+    orderedEntries.reserve(entries.size());
+    for (size_t index : order) orderedEntries.push_back(entries[index]);
+    entries = std::move(orderedEntries);
+
+    return bundleData;
+}
@@ -0,0 +1,38 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#ifndef SIEGE_ENGINE_PACKER_BUNDLELAYOUT_H
+#define SIEGE_ENGINE_PACKER_BUNDLELAYOUT_H
+
+#include <resources/PackBundleData.h>
+#include <resources/PackFile.h>
+
+/**
+ * Reads an access trace recorded by the ResourceSystem. Each line names an entry in the order it
+ * was first loaded, with scene entries starting the group of the entries that follow them
+ * @param tracePath - the path of the trace file
+ * @param trace - the traced entry names, in order
+ * @return true if the trace could be read, false otherwise
+ */
+bool ReadAccessTrace(const Siege::String& tracePath, std::vector<Siege::String>& trace);
+
+/**
+ * Reorders packed entries so that the entries used by each scene are laid out contiguously, in
+ * the order they are expected to be loaded. A scene's group is the scene itself, then the entries
+ * traced after it, then the entries its entities reference. Entries shared between scenes belong
+ * to the first scene using them, and entries no scene uses keep their input order at the end
+ * @param entries - the packed entries, reordered in place
+ * @param trace - an optional access trace used to order the entries within each group
+ * @return the bundle table naming the entries of each scene, with data ranges left to be filled
+ */
+Siege::PackBundleData OrderEntriesByScene(
+    std::vector<std::pair<Siege::PackFile::TocEntry*, void*>>& entries,
+    const std::vector<Siege::String>& trace);
+
+#endif // SIEGE_ENGINE_PACKER_BUNDLELAYOUT_H
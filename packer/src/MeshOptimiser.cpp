@@ -0,0 +1,536 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#include "MeshOptimiser.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <map>
+#include <numeric>
+
+static int64_t GetNextVertex(const std::vector<uint32_t>& candidates,
+                             const std::vector<uint32_t>& liveTriangles,
+                             const std::vector<uint32_t>& cacheTimes,
+                             uint32_t time,
+                             OUT std::vector<uint32_t>& deadEnds,
+                             OUT uint32_t& cursor,
+                             OUT bool& isCandidate)
+{
+    // Prefer the candidate that will still be in the cache once its remaining triangles are
+    // emitted, and of those the one that entered the cache earliest
+    int64_t bestVertex = -1;
+    int64_t bestPriority = -1;
+    for (uint32_t vertex : candidates)
+    {
+        if (liveTriangles[vertex] == 0) continue;
+
+        int64_t priority = 0;
+        if (time - cacheTimes[vertex] + 2 * liveTriangles[vertex] <= MESH_OPTIMISER_CACHE_SIZE)
+        {
+            priority = time - cacheTimes[vertex];
+        }
+        if (priority > bestPriority)
+        {
+            bestPriority = priority;
+            bestVertex = vertex;
+        }
+    }
+    isCandidate = bestVertex != -1;
+    if (isCandidate) return bestVertex;
+
+    // Otherwise fall back to recently used vertices, then to the next unfinished vertex in order
+    while (!deadEnds.empty())
+    {
+        uint32_t vertex = deadEnds.back();
+        deadEnds.pop_back();
+        if (liveTriangles[vertex] > 0) return vertex;
+    }
+    for (; cursor < liveTriangles.size(); cursor++)
+    {
+        if (liveTriangles[cursor] > 0) return cursor;
+    }
+    return -1;
+}
+
+void OptimiseVertexCache(OUT std::vector<uint32_t>& indices,
+                         uint32_t vertexCount,
+                         OUT std::vector<uint32_t>& clusters)
+{
+    clusters.clear();
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) return;
+
+    // Build vertex to triangle adjacency as offsets into a flat list
+    std::vector<uint32_t> liveTriangles(vertexCount, 0);
+    for (uint32_t index : indices) liveTriangles[index]++;
+
+    std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+    for (uint32_t i = 0; i < vertexCount; i++)
+    {
+        adjacencyOffsets[i + 1] = adjacencyOffsets[i] + liveTriangles[i];
+    }
+    std::vector<uint32_t> adjacency(indices.size());
+    std::vector<uint32_t> adjacencyFill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+    for (size_t i = 0; i < indices.size(); i++)
+    {
+        adjacency[adjacencyFill[indices[i]]++] = i / 3;
+    }
+
+    std::vector<uint32_t> cacheTimes(vertexCount, 0);
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<uint32_t> deadEnds;
+    std::vector<uint32_t> candidates;
+    std::vector<uint32_t> output;
+    output.reserve(indices.size());
+
+    uint32_t time = MESH_OPTIMISER_CACHE_SIZE + 1;
+    uint32_t cursor = 0;
+    bool isCandidate = false;
+    int64_t fanningVertex =
+        GetNextVertex(candidates, liveTriangles, cacheTimes, time, deadEnds, cursor, isCandidate);
+    while (fanningVertex >= 0)
+    {
+        // Leaving the candidates means starting somewhere cold, so a new cluster begins here
+        if (!isCandidate) clusters.push_back(output.size());
+
+        candidates.clear();
+        uint32_t vertex = fanningVertex;
+        for (uint32_t i = adjacencyOffsets[vertex]; i < adjacencyOffsets[vertex + 1]; i++)
+        {
+            uint32_t triangle = adjacency[i];
+            if (emitted[triangle]) continue;
+            emitted[triangle] = true;
+
+            for (uint32_t j = 0; j < 3; j++)
+            {
+                uint32_t triangleVertex = indices[triangle * 3 + j];
+                output.push_back(triangleVertex);
+                deadEnds.push_back(triangleVertex);
+                candidates.push_back(triangleVertex);
+                liveTriangles[triangleVertex]--;
+                if (time - cacheTimes[triangleVertex] > MESH_OPTIMISER_CACHE_SIZE)
+                {
+                    cacheTimes[triangleVertex] = time++;
+                }
+            }
+        }
+
+        fanningVertex = GetNextVertex(candidates,
+                                      liveTriangles,
+                                      cacheTimes,
+                                      time,
+                                      deadEnds,
+                                      cursor,
+                                      isCandidate);
+    }
+
+    indices = std::move(output);
+}
+
+void OptimiseOverdraw(OUT std::vector<uint32_t>& indices,
+                      const std::vector<float>& positions,
+                      const std::vector<uint32_t>& clusters)
+{
+    if (clusters.size() < 2) return;
+
+    auto getPosition = [&positions](uint32_t index, float* out) {
+        for (uint32_t i = 0; i < 3; i++) out[i] = positions[index * 3 + i];
+    };
+
+    // Area weighted centroids and normals of the whole mesh and of each cluster
+    float meshCentroid[3] = {};
+    float meshArea = 0.f;
+    std::vector<float> clusterCentroids(clusters.size() * 3, 0.f);
+    std::vector<float> clusterNormals(clusters.size() * 3, 0.f);
+    std::vector<float> clusterAreas(clusters.size(), 0.f);
+    for (size_t c = 0; c < clusters.size(); c++)
+    {
+        size_t end = c + 1 < clusters.size() ? clusters[c + 1] : indices.size();
+        for (size_t i = clusters[c]; i < end; i += 3)
+        {
+            float a[3], b[3], d[3];
+            getPosition(indices[i], a);
+            getPosition(indices[i + 1], b);
+            getPosition(indices[i + 2], d);
+
+            float ab[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+            float ad[3] = {d[0] - a[0], d[1] - a[1], d[2] - a[2]};
+            float normal[3] = {ab[1] * ad[2] - ab[2] * ad[1],
+                               ab[2] * ad[0] - ab[0] * ad[2],
+                               ab[0] * ad[1] - ab[1] * ad[0]};
+            float area =
+                std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+
+            for (uint32_t k = 0; k < 3; k++)
+            {
+                float centre = (a[k] + b[k] + d[k]) / 3.f;
+                clusterCentroids[c * 3 + k] += centre * area;
+                clusterNormals[c * 3 + k] += normal[k];
+                meshCentroid[k] += centre * area;
+            }
+            clusterAreas[c] += area;
+            meshArea += area;
+        }
+    }
+    if (meshArea <= 0.f) return;
+    for (float& value : meshCentroid) value /= meshArea;
+
+    std::vector<float> sortKeys(clusters.size(), 0.f);
+    for (size_t c = 0; c < clusters.size(); c++)
+    {
+        float* normal = &clusterNormals[c * 3];
+        float length =
+            std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        if (clusterAreas[c] <= 0.f || length <= 0.f) continue;
+
+        for (uint32_t k = 0; k < 3; k++)
+        {
+            float offset = clusterCentroids[c * 3 + k] / clusterAreas[c] - meshCentroid[k];
+            sortKeys[c] += offset * normal[k] / length;
+        }
+    }
+
+    // Clusters facing outward from the centre are the most likely to occlude the others
+    std::vector<size_t> order(clusters.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&sortKeys](size_t lhs, size_t rhs) {
+        return sortKeys[lhs] > sortKeys[rhs];
+    });
+
+    std::vector<uint32_t> output;
+    output.reserve(indices.size());
+    for (size_t c : order)
+    {
+        size_t end = c + 1 < clusters.size() ? clusters[c + 1] : indices.size();
+        output.insert(output.end(), indices.begin() + clusters[c], indices.begin() + end);
+    }
+    indices = std::move(output);
+}
+
+/**
+ * A symmetric 4x4 matrix summing the squared distances to a set of planes, along with the total
+ * weight of those planes
+ */
+struct Quadric
+{
+    double a2, ab, ac, ad, b2, bc, bd, c2, cd, d2, weight;
+};
+
+static void AddPlane(OUT Quadric& quadric, const double* normal, double distance, double weight)
+{
+    double a = normal[0], b = normal[1], c = normal[2], d = distance;
+    quadric.a2 += a * a * weight;
+    quadric.ab += a * b * weight;
+    quadric.ac += a * c * weight;
+    quadric.ad += a * d * weight;
+    quadric.b2 += b * b * weight;
+    quadric.bc += b * c * weight;
+    quadric.bd += b * d * weight;
+    quadric.c2 += c * c * weight;
+    quadric.cd += c * d * weight;
+    quadric.d2 += d * d * weight;
+    quadric.weight += weight;
+}
+
+static void AddQuadric(OUT Quadric& quadric, const Quadric& other)
+{
+    quadric.a2 += other.a2;
+    quadric.ab += other.ab;
+    quadric.ac += other.ac;
+    quadric.ad += other.ad;
+    quadric.b2 += other.b2;
+    quadric.bc += other.bc;
+    quadric.bd += other.bd;
+    quadric.c2 += other.c2;
+    quadric.cd += other.cd;
+    quadric.d2 += other.d2;
+    quadric.weight += other.weight;
+}
+
+static double EvaluateQuadric(const Quadric& quadric, const double* point)
+{
+    double x = point[0], y = point[1], z = point[2];
+    double result = quadric.a2 * x * x + quadric.b2 * y * y + quadric.c2 * z * z + quadric.d2 +
+                    2.0 * (quadric.ab * x * y + quadric.ac * x * z + quadric.bc * y * z +
+                           quadric.ad * x + quadric.bd * y + quadric.cd * z);
+    return quadric.weight > 0.0 ? std::max(result, 0.0) / quadric.weight : 0.0;
+}
+
+static double CalculateTriangleNormal(const double* a,
+                                      const double* b,
+                                      const double* c,
+                                      OUT double* normal)
+{
+    double ab[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+    double ac[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+    normal[0] = ab[1] * ac[2] - ab[2] * ac[1];
+    normal[1] = ab[2] * ac[0] - ab[0] * ac[2];
+    normal[2] = ab[0] * ac[1] - ab[1] * ac[0];
+    double length =
+        std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+    if (length <= 0.0) return 0.0;
+
+    for (uint32_t k = 0; k < 3; k++) normal[k] /= length;
+    return length;
+}
+
+std::vector<uint32_t> SimplifyMesh(const std::vector<uint32_t>& indices,
+                                   const std::vector<float>& positions,
+                                   const std::vector<float>& normals,
+                                   size_t targetIndexCount,
+                                   OUT float& error)
+{
+    error = 0.f;
+
+    // Vertices split along seams share a position, and must collapse together to avoid cracks
+    size_t vertexCount = positions.size() / 3;
+    std::map<std::array<float, 3>, uint32_t> uniquePositions;
+    std::vector<uint32_t> positionIds(vertexCount);
+    std::vector<std::vector<uint32_t>> wedges;
+    std::vector<double> points;
+    for (size_t i = 0; i < vertexCount; i++)
+    {
+        std::array<float, 3> position = {positions[i * 3],
+                                         positions[i * 3 + 1],
+                                         positions[i * 3 + 2]};
+        auto it = uniquePositions.try_emplace(position, wedges.size());
+        if (it.second)
+        {
+            wedges.emplace_back();
+            points.insert(points.end(), position.begin(), position.end());
+        }
+        positionIds[i] = it.first->second;
+        wedges[it.first->second].push_back(i);
+    }
+    size_t positionCount = wedges.size();
+
+    // Each position starts with the area weighted planes of its triangles, while open borders
+    // add planes perpendicular to their triangle so that they keep their shape
+    std::vector<Quadric> quadrics(positionCount, Quadric {});
+    std::map<std::pair<uint32_t, uint32_t>, std::pair<uint32_t, size_t>> edgeTriangles;
+    for (size_t i = 0; i + 2 < indices.size(); i += 3)
+    {
+        uint32_t corners[3] = {positionIds[indices[i]],
+                               positionIds[indices[i + 1]],
+                               positionIds[indices[i + 2]]};
+        double normal[3];
+        double area = CalculateTriangleNormal(&points[corners[0] * 3],
+                                              &points[corners[1] * 3],
+                                              &points[corners[2] * 3],
+                                              normal);
+        if (area <= 0.0) continue;
+
+        double distance = -(normal[0] * points[corners[0] * 3] +
+                            normal[1] * points[corners[0] * 3 + 1] +
+                            normal[2] * points[corners[0] * 3 + 2]);
+        for (uint32_t corner : corners) AddPlane(quadrics[corner], normal, distance, area * 0.5);
+
+        for (uint32_t k = 0; k < 3; k++)
+        {
+            uint32_t from = corners[k], to = corners[(k + 1) % 3];
+            auto it = edgeTriangles.try_emplace({std::min(from, to), std::max(from, to)}, 0, i);
+            it.first->second.first++;
+        }
+    }
+    for (const auto& edge : edgeTriangles)
+    {
+        if (edge.second.first != 1) continue;
+
+        const double* from = &points[edge.first.first * 3];
+        const double* to = &points[edge.first.second * 3];
+        size_t triangle = edge.second.second;
+        double triangleNormal[3];
+        CalculateTriangleNormal(&points[positionIds[indices[triangle]] * 3],
+                                &points[positionIds[indices[triangle + 1]] * 3],
+                                &points[positionIds[indices[triangle + 2]] * 3],
+                                triangleNormal);
+
+        double direction[3] = {to[0] - from[0], to[1] - from[1], to[2] - from[2]};
+        double normal[3] = {direction[1] * triangleNormal[2] - direction[2] * triangleNormal[1],
+                            direction[2] * triangleNormal[0] - direction[0] * triangleNormal[2],
+                            direction[0] * triangleNormal[1] - direction[1] * triangleNormal[0]};
+        double length =
+            std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        if (length <= 0.0) continue;
+        for (double& value : normal) value /= length;
+
+        double distance = -(normal[0] * from[0] + normal[1] * from[1] + normal[2] * from[2]);
+        double weight = (direction[0] * direction[0] + direction[1] * direction[1] +
+                         direction[2] * direction[2]) *
+                        MESH_OPTIMISER_BORDER_WEIGHT;
+        AddPlane(quadrics[edge.first.first], normal, distance, weight);
+        AddPlane(quadrics[edge.first.second], normal, distance, weight);
+    }
+
+    // Vertices collapsing onto a position take on whichever of its vertices best matches them
+    auto getClosestWedge = [&](uint32_t vertex, uint32_t position) {
+        uint32_t closest = wedges[position][0];
+        if (normals.size() != positions.size()) return closest;
+
+        float closestDot = -2.f;
+        for (uint32_t wedge : wedges[position])
+        {
+            float dot = normals[vertex * 3] * normals[wedge * 3] +
+                        normals[vertex * 3 + 1] * normals[wedge * 3 + 1] +
+                        normals[vertex * 3 + 2] * normals[wedge * 3 + 2];
+            if (dot > closestDot)
+            {
+                closestDot = dot;
+                closest = wedge;
+            }
+        }
+        return closest;
+    };
+
+    struct Collapse
+    {
+        uint32_t from;
+        uint32_t to;
+        double error;
+    };
+
+    // Each pass collapses the cheapest edges whose endpoints are untouched by any other collapse
+    // in the same pass, until the target is reached or nothing more can collapse
+    std::vector<uint32_t> result = indices;
+    double maxError = 0.0;
+    while (result.size() > targetIndexCount)
+    {
+        std::vector<std::vector<size_t>> positionTriangles(positionCount);
+        std::vector<std::pair<uint32_t, uint32_t>> edges;
+        for (size_t i = 0; i < result.size(); i += 3)
+        {
+            for (uint32_t k = 0; k < 3; k++)
+            {
+                uint32_t from = positionIds[result[i + k]];
+                uint32_t to = positionIds[result[i + (k + 1) % 3]];
+                positionTriangles[from].push_back(i);
+                edges.emplace_back(std::min(from, to), std::max(from, to));
+            }
+        }
+        std::sort(edges.begin(), edges.end());
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+        std::vector<Collapse> collapses;
+        collapses.reserve(edges.size());
+        for (const auto& edge : edges)
+        {
+            Quadric quadric = quadrics[edge.first];
+            AddQuadric(quadric, quadrics[edge.second]);
+            double toSecond = EvaluateQuadric(quadric, &points[edge.second * 3]);
+            double toFirst = EvaluateQuadric(quadric, &points[edge.first * 3]);
+            if (toSecond <= toFirst) collapses.push_back({edge.first, edge.second, toSecond});
+            else collapses.push_back({edge.second, edge.first, toFirst});
+        }
+        if (collapses.empty()) break;
+        std::sort(collapses.begin(), collapses.end(), [](const Collapse& lhs, const Collapse& rhs) {
+            return lhs.error < rhs.error;
+        });
+
+        // Most collapses remove two triangles, and limiting each pass to errors near those needed
+        // to reach the target stops a pass from taking expensive collapses over cheap ones
+        size_t trianglesToRemove = (result.size() - targetIndexCount + 2) / 3;
+        size_t limitIndex = std::min(collapses.size() - 1, trianglesToRemove / 2);
+        double errorLimit = collapses[limitIndex].error * 1.5;
+
+        std::vector<uint32_t> collapseTargets(positionCount);
+        std::iota(collapseTargets.begin(), collapseTargets.end(), 0);
+        std::vector<bool> locked(positionCount, false);
+        size_t trianglesRemoved = 0;
+        for (const Collapse& collapse : collapses)
+        {
+            if (trianglesRemoved >= trianglesToRemove || collapse.error > errorLimit) break;
+            if (locked[collapse.from] || locked[collapse.to]) continue;
+
+            // Reject collapses that would flip any of the surrounding triangles over
+            bool flips = false;
+            size_t sharedTriangles = 0;
+            for (size_t triangle : positionTriangles[collapse.from])
+            {
+                uint32_t corners[3] = {positionIds[result[triangle]],
+                                       positionIds[result[triangle + 1]],
+                                       positionIds[result[triangle + 2]]};
+                if (corners[0] == collapse.to || corners[1] == collapse.to ||
+                    corners[2] == collapse.to)
+                {
+                    sharedTriangles++;
+                    continue;
+                }
+
+                double before[3], after[3];
+                const double* moved[3];
+                for (uint32_t k = 0; k < 3; k++)
+                {
+                    uint32_t corner = corners[k] == collapse.from ? collapse.to : corners[k];
+                    moved[k] = &points[corner * 3];
+                }
+                CalculateTriangleNormal(&points[corners[0] * 3],
+                                        &points[corners[1] * 3],
+                                        &points[corners[2] * 3],
+                                        before);
+                double area = CalculateTriangleNormal(moved[0], moved[1], moved[2], after);
+                if (area <= 0.0 ||
+                    before[0] * after[0] + before[1] * after[1] + before[2] * after[2] <= 0.0)
+                {
+                    flips = true;
+                    break;
+                }
+            }
+            if (flips) continue;
+
+            collapseTargets[collapse.from] = collapse.to;
+            locked[collapse.from] = true;
+            locked[collapse.to] = true;
+            AddQuadric(quadrics[collapse.to], quadrics[collapse.from]);
+            maxError = std::max(maxError, collapse.error);
+            trianglesRemoved += sharedTriangles;
+        }
+        if (trianglesRemoved == 0) break;
+
+        std::vector<uint32_t> collapsed;
+        collapsed.reserve(result.size());
+        for (size_t i = 0; i < result.size(); i += 3)
+        {
+            uint32_t triangle[3];
+            for (uint32_t k = 0; k < 3; k++)
+            {
+                uint32_t vertex = result[i + k];
+                uint32_t target = collapseTargets[positionIds[vertex]];
+                bool isCollapsed = target != positionIds[vertex];
+                triangle[k] = isCollapsed ? getClosestWedge(vertex, target) : vertex;
+            }
+
+            uint32_t a = positionIds[triangle[0]], b = positionIds[triangle[1]],
+                     c = positionIds[triangle[2]];
+            if (a == b || b == c || c == a) continue;
+            collapsed.insert(collapsed.end(), triangle, triangle + 3);
+        }
+        result = std::move(collapsed);
+    }
+
+    error = static_cast<float>(std::sqrt(maxError));
+    return result;
+}
+
+float CalculateAcmr(const std::vector<uint32_t>& indices, uint32_t vertexCount)
+{
+    if (indices.size() < 3) return 0.f;
+
+    // A vertex is in the FIFO cache if fewer than cache size misses happened since its own miss
+    std::vector<uint32_t> missTimes(vertexCount, 0);
+    uint32_t misses = 0;
+    for (uint32_t index : indices)
+    {
+        if (missTimes[index] == 0 || misses - missTimes[index] >= MESH_OPTIMISER_CACHE_SIZE)
+        {
+            missTimes[index] = ++misses;
+        }
+    }
+    return static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+}
@@ -0,0 +1,123 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#ifndef SIEGE_ENGINE_PACKER_MESHOPTIMISER_H
+#define SIEGE_ENGINE_PACKER_MESHOPTIMISER_H
+
+#include <utils/Macros.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// The post-transform cache size to optimise for, small enough to suit most hardware
+#define MESH_OPTIMISER_CACHE_SIZE 16
+
+// How much more heavily open borders are preserved than the surface during simplification
+#define MESH_OPTIMISER_BORDER_WEIGHT 10.0
+
+/**
+ * Merges identical vertices, remapping the indices to the first occurrence of each
+ * @param vertices - the vertices to weld, compacted in place
+ * @param indices - the indices referencing the vertices, remapped in place
+ */
+template<typename TVertex>
+void WeldVertices(OUT std::vector<TVertex>& vertices, OUT std::vector<uint32_t>& indices)
+{
+    std::unordered_map<TVertex, uint32_t> uniqueVertices;
+    std::vector<uint32_t> remap(vertices.size());
+    std::vector<TVertex> weldedVertices;
+    for (size_t i = 0; i < vertices.size(); i++)
+    {
+        auto it = uniqueVertices.try_emplace(vertices[i], weldedVertices.size());
+        if (it.second) weldedVertices.push_back(vertices[i]);
+        remap[i] = it.first->second;
+    }
+
+    for (uint32_t& index : indices) index = remap[index];
+    vertices = std::move(weldedVertices);
+}
+
+/**
+ * Reorders triangles for the post-transform vertex cache using Tipsify (Sander et al. 2007),
+ * which runs in linear time
+ * @param indices - the triangle list indices, reordered in place
+ * @param vertexCount - the number of vertices the indices reference
+ * @param clusters - the index offsets at which the ordering lost cache locality, which can be
+ * reordered freely without significantly affecting the cache hit rate
+ */
+void OptimiseVertexCache(OUT std::vector<uint32_t>& indices,
+                         uint32_t vertexCount,
+                         OUT std::vector<uint32_t>& clusters);
+
+/**
+ * Reorders clusters of triangles so that those facing away from the mesh centre draw first,
+ * which approximates front-to-back order from any viewpoint and reduces overdraw
+ * @param indices - the triangle list indices, reordered in place
+ * @param positions - the vertex positions, as x, y, z triples
+ * @param clusters - the cluster offsets produced by OptimiseVertexCache
+ */
+void OptimiseOverdraw(OUT std::vector<uint32_t>& indices,
+                      const std::vector<float>& positions,
+                      const std::vector<uint32_t>& clusters);
+
+/**
+ * Reorders vertices into the order the indices first reference them, so that vertex fetches
+ * walk memory linearly. Vertices no index references are dropped
+ * @param vertices - the vertices to reorder in place
+ * @param indices - the indices referencing the vertices, remapped in place
+ */
+template<typename TVertex>
+void OptimiseVertexFetch(OUT std::vector<TVertex>& vertices, OUT std::vector<uint32_t>& indices)
+{
+    std::vector<uint32_t> remap(vertices.size(), UINT32_MAX);
+    std::vector<TVertex> orderedVertices;
+    orderedVertices.reserve(vertices.size());
+    for (uint32_t& index : indices)
+    {
+        if (remap[index] == UINT32_MAX)
+        {
+            remap[index] = orderedVertices.size();
+            orderedVertices.push_back(vertices[index]);
+        }
+        index = remap[index];
+    }
+    vertices = std::move(orderedVertices);
+}
+
+/**
+ * Simplifies a mesh towards a target index count by collapsing edges in order of their quadric
+ * error (Garland & Heckbert 1997). Vertices sharing a position collapse together and only ever
+ * collapse onto existing vertices, so the simplified indices reference the original vertices
+ * @param indices - the triangle list indices to simplify
+ * @param positions - the vertex positions, as x, y, z triples
+ * @param normals - the vertex normals, as x, y, z triples, used to choose between the vertices
+ * sharing the position a vertex collapses onto
+ * @param targetIndexCount - the index count to simplify towards
+ * @param error - the largest root mean square distance the surface was moved by a collapse
+ * @return the simplified indices, which may not reach the target if no more edges can collapse
+ * without folding the surface over
+ */
+std::vector<uint32_t> SimplifyMesh(const std::vector<uint32_t>& indices,
+                                   const std::vector<float>& positions,
+                                   const std::vector<float>& normals,
+                                   size_t targetIndexCount,
+                                   OUT float& error);
+
+/**
+ * Simulates a FIFO post-transform cache to compute the average cache miss ratio (ACMR), the
+ * number of vertices transformed per triangle
+ * @param indices - the triangle list indices
+ * @param vertexCount - the number of vertices the indices reference
+ * @return the average number of cache misses per triangle
+ */
+float CalculateAcmr(const std::vector<uint32_t>& indices, uint32_t vertexCount);
+
+#endif // SIEGE_ENGINE_PACKER_MESHOPTIMISER_H
@@ -0,0 +1,192 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#include "MipGenerator.h"
+
+#include <resources/Texture2DData.h>
+
+#include <algorithm>
+#include <cmath>
+
+static float SrgbToLinear(float value)
+{
+    if (value <= 0.04045f) return value / 12.92f;
+    return std::pow((value + 0.055f) / 1.055f, 2.4f);
+}
+
+static float LinearToSrgb(float value)
+{
+    if (value <= 0.0031308f) return value * 12.92f;
+    return 1.055f * std::pow(value, 1.f / 2.4f) - 0.055f;
+}
+
+static double BesselI0(double x)
+{
+    // Power series for the zeroth order modified Bessel function of the first kind
+    double sum = 1.0;
+    double term = 1.0;
+    for (int k = 1; k < 32; k++)
+    {
+        double factor = x / (2.0 * k);
+        term *= factor * factor;
+        sum += term;
+        if (term < sum * 1e-12) break;
+    }
+    return sum;
+}
+
+static double KaiserSinc(double x)
+{
+    if (std::abs(x) >= MIP_GENERATOR_KAISER_RADIUS) return 0.0;
+
+    double t = x / MIP_GENERATOR_KAISER_RADIUS;
+    double window = BesselI0(MIP_GENERATOR_KAISER_ALPHA * std::sqrt(1.0 - t * t)) /
+                    BesselI0(MIP_GENERATOR_KAISER_ALPHA);
+    double sinc = x == 0.0 ? 1.0 : std::sin(M_PI * x) / (M_PI * x);
+    return sinc * window;
+}
+
+struct FilterTap
+{
+    uint32_t source;
+    float weight;
+};
+
+/**
+ * Builds the normalised taps that resample one axis of a level down to the next, where each
+ * destination texel covers srcSize / dstSize source texels
+ */
+static std::vector<std::vector<FilterTap>> BuildAxisTaps(uint32_t srcSize,
+                                                         uint32_t dstSize,
+                                                         MipFilter filter)
+{
+    double scale = static_cast<double>(srcSize) / dstSize;
+    double support = filter == MIP_FILTER_KAISER ? MIP_GENERATOR_KAISER_RADIUS * scale : scale;
+
+    std::vector<std::vector<FilterTap>> taps(dstSize);
+    for (uint32_t dst = 0; dst < dstSize; dst++)
+    {
+        double centre = (dst + 0.5) * scale;
+        int64_t first = static_cast<int64_t>(std::floor(centre - support));
+        int64_t last = static_cast<int64_t>(std::ceil(centre + support));
+
+        double totalWeight = 0.0;
+        for (int64_t src = first; src <= last; src++)
+        {
+            double weight;
+            if (filter == MIP_FILTER_KAISER) weight = KaiserSinc((src + 0.5 - centre) / scale);
+            else
+            {
+                // The overlap of the source texel with the destination texel's footprint
+                double overlapStart = std::max<double>(src, dst * scale);
+                double overlapEnd = std::min<double>(src + 1, (dst + 1) * scale);
+                weight = std::max(overlapEnd - overlapStart, 0.0);
+            }
+            if (weight == 0.0) continue;
+
+            // Clamp to the edge of the texture, merging taps that land on the same texel
+            uint32_t source = static_cast<uint32_t>(std::clamp<int64_t>(src, 0, srcSize - 1));
+            auto it = std::find_if(taps[dst].begin(), taps[dst].end(), [source](auto& tap) {
+                return tap.source == source;
+            });
+            if (it != taps[dst].end()) it->weight += static_cast<float>(weight);
+            else taps[dst].push_back({source, static_cast<float>(weight)});
+            totalWeight += weight;
+        }
+
+        for (FilterTap& tap : taps[dst]) tap.weight = static_cast<float>(tap.weight / totalWeight);
+    }
+    return taps;
+}
+
+static std::vector<float> DownsampleLevel(const std::vector<float>& src,
+                                          uint32_t srcWidth,
+                                          uint32_t srcHeight,
+                                          uint32_t dstWidth,
+                                          uint32_t dstHeight,
+                                          uint32_t channels,
+                                          MipFilter filter)
+{
+    std::vector<std::vector<FilterTap>> columnTaps = BuildAxisTaps(srcWidth, dstWidth, filter);
+    std::vector<std::vector<FilterTap>> rowTaps = BuildAxisTaps(srcHeight, dstHeight, filter);
+
+    // Filter horizontally into an intermediate of the destination width, then vertically
+    std::vector<float> horizontal(dstWidth * srcHeight * channels, 0.f);
+    for (uint32_t y = 0; y < srcHeight; y++)
+    {
+        for (uint32_t x = 0; x < dstWidth; x++)
+        {
+            float* out = &horizontal[(y * dstWidth + x) * channels];
+            for (const FilterTap& tap : columnTaps[x])
+            {
+                const float* in = &src[(y * srcWidth + tap.source) * channels];
+                for (uint32_t c = 0; c < channels; c++) out[c] += in[c] * tap.weight;
+            }
+        }
+    }
+
+    std::vector<float> dst(dstWidth * dstHeight * channels, 0.f);
+    for (uint32_t y = 0; y < dstHeight; y++)
+    {
+        for (const FilterTap& tap : rowTaps[y])
+        {
+            const float* in = &horizontal[tap.source * dstWidth * channels];
+            float* out = &dst[y * dstWidth * channels];
+            for (uint32_t i = 0; i < dstWidth * channels; i++) out[i] += in[i] * tap.weight;
+        }
+    }
+
+    // Negative filter lobes can ring past the representable range
+    for (float& value : dst) value = std::clamp(value, 0.f, 1.f);
+    return dst;
+}
+
+void GenerateMipChain(OUT std::vector<uint8_t>& pixels,
+                      int32_t width,
+                      int32_t height,
+                      int32_t channels,
+                      MipFilter filter,
+                      bool srgb)
+{
+    if (filter == MIP_FILTER_NONE) return;
+
+    float toLinear[256];
+    for (int i = 0; i < 256; i++) toLinear[i] = SrgbToLinear(i / 255.f);
+
+    auto isLinear = [srgb](uint32_t index, int32_t channels) {
+        return !srgb || (channels == 4 && index % channels == 3);
+    };
+
+    // Each level is filtered from the one above it at full precision, so rounding errors do not
+    // accumulate down the chain
+    uint64_t baseSize =
+        Siege::GetTexture2DLevelSize(width, height, channels, Siege::TEXTURE2D_FORMAT_RGBA8, 0);
+    std::vector<float> level(baseSize);
+    for (uint64_t i = 0; i < baseSize; i++)
+    {
+        level[i] = isLinear(i, channels) ? pixels[i] / 255.f : toLinear[pixels[i]];
+    }
+    pixels.resize(baseSize);
+
+    uint32_t levelCount = Siege::GetTexture2DFullLevelCount(width, height);
+    for (uint32_t i = 1; i < levelCount; i++)
+    {
+        uint32_t srcWidth = std::max(width >> (i - 1), 1);
+        uint32_t srcHeight = std::max(height >> (i - 1), 1);
+        uint32_t dstWidth = std::max(width >> i, 1);
+        uint32_t dstHeight = std::max(height >> i, 1);
+        level = DownsampleLevel(level, srcWidth, srcHeight, dstWidth, dstHeight, channels, filter);
+
+        for (uint64_t j = 0; j < level.size(); j++)
+        {
+            float value = isLinear(j, channels) ? level[j] : LinearToSrgb(level[j]);
+            pixels.push_back(static_cast<uint8_t>(std::lround(value * 255.f)));
+        }
+    }
+}
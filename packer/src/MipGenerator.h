@@ -0,0 +1,47 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#ifndef SIEGE_ENGINE_PACKER_MIPGENERATOR_H
+#define SIEGE_ENGINE_PACKER_MIPGENERATOR_H
+
+#include <utils/Macros.h>
+
+#include <cstdint>
+#include <vector>
+
+// The radius of the Kaiser filter in destination texels, and the sharpness of its window
+#define MIP_GENERATOR_KAISER_RADIUS 3.0
+#define MIP_GENERATOR_KAISER_ALPHA 4.0
+
+enum MipFilter
+{
+    MIP_FILTER_NONE = 0,
+    MIP_FILTER_BOX = 1,
+    MIP_FILTER_KAISER = 2
+};
+
+/**
+ * Generates a full mip chain for a texture, appending every level below the base to its pixels.
+ * Colour channels of sRGB textures are filtered in linear space while alpha is left as is
+ * @param pixels - the base level pixels of the texture, extended in place with the mip chain
+ * @param width - the width of the base level
+ * @param height - the height of the base level
+ * @param channels - the number of channels per texel, the fourth of which is treated as alpha
+ * @param filter - the filter to downsample each level with, a box for speed or a Kaiser windowed
+ *                 sinc for sharper results
+ * @param srgb - whether the colour channels are sRGB encoded, or hold linear data such as normals
+ */
+void GenerateMipChain(OUT std::vector<uint8_t>& pixels,
+                      int32_t width,
+                      int32_t height,
+                      int32_t channels,
+                      MipFilter filter,
+                      bool srgb = true);
+
+#endif // SIEGE_ENGINE_PACKER_MIPGENERATOR_H
@@ -0,0 +1,735 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#include "TextureCompressor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+// The interpolation weights of BC7's 4-bit indices, out of 64
+static const uint32_t BC7_WEIGHTS[16] =
+    {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+// BC1 palette entries in index order expressed as weights towards the second endpoint
+static const float BC1_WEIGHTS[4] = {0.f, 1.f, 1.f / 3.f, 2.f / 3.f};
+
+struct BitWriter
+{
+    uint8_t* data;
+    uint32_t position {0};
+
+    void Write(uint32_t value, uint32_t bitCount)
+    {
+        for (uint32_t i = 0; i < bitCount; i++, position++)
+        {
+            if ((value >> i) & 1) data[position >> 3] |= 1 << (position & 7);
+        }
+    }
+};
+
+struct BitReader
+{
+    const uint8_t* data;
+    uint32_t position {0};
+
+    uint32_t Read(uint32_t bitCount)
+    {
+        uint32_t value = 0;
+        for (uint32_t i = 0; i < bitCount; i++, position++)
+        {
+            value |= ((data[position >> 3] >> (position & 7)) & 1) << i;
+        }
+        return value;
+    }
+};
+
+static void ReadBlock(const uint8_t* level,
+                      uint32_t width,
+                      uint32_t height,
+                      uint32_t blockX,
+                      uint32_t blockY,
+                      OUT uint8_t texels[16][4])
+{
+    // Blocks that overhang the edge of a level repeat its last row and column
+    for (uint32_t y = 0; y < 4; y++)
+    {
+        for (uint32_t x = 0; x < 4; x++)
+        {
+            uint32_t sourceX = std::min(blockX * 4 + x, width - 1);
+            uint32_t sourceY = std::min(blockY * 4 + y, height - 1);
+            memcpy(texels[y * 4 + x], level + (sourceY * width + sourceX) * 4, 4);
+        }
+    }
+}
+
+static void WriteBlock(const uint8_t texels[16][4],
+                       uint32_t width,
+                       uint32_t height,
+                       uint32_t blockX,
+                       uint32_t blockY,
+                       OUT uint8_t* level)
+{
+    for (uint32_t y = 0; y < 4 && blockY * 4 + y < height; y++)
+    {
+        for (uint32_t x = 0; x < 4 && blockX * 4 + x < width; x++)
+        {
+            memcpy(level + ((blockY * 4 + y) * width + blockX * 4 + x) * 4, texels[y * 4 + x], 4);
+        }
+    }
+}
+
+static void FindPrincipalAxis(const float points[16][4],
+                              uint32_t channels,
+                              OUT float mean[4],
+                              OUT float axis[4])
+{
+    for (uint32_t c = 0; c < 4; c++) mean[c] = axis[c] = 0.f;
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        for (uint32_t c = 0; c < channels; c++) mean[c] += points[i][c] / 16.f;
+    }
+
+    float covariance[4][4] = {};
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        for (uint32_t r = 0; r < channels; r++)
+        {
+            for (uint32_t c = 0; c < channels; c++)
+            {
+                covariance[r][c] += (points[i][r] - mean[r]) * (points[i][c] - mean[c]);
+            }
+        }
+    }
+
+    // Power iteration from the row of greatest variance, which converges in a handful of steps
+    // for the nearly linear distributions found within most blocks
+    uint32_t start = 0;
+    for (uint32_t c = 1; c < channels; c++)
+    {
+        if (covariance[c][c] > covariance[start][start]) start = c;
+    }
+    for (uint32_t c = 0; c < channels; c++) axis[c] = covariance[start][c];
+
+    for (uint32_t iteration = 0; iteration < 8; iteration++)
+    {
+        float next[4] = {};
+        for (uint32_t r = 0; r < channels; r++)
+        {
+            for (uint32_t c = 0; c < channels; c++) next[r] += covariance[r][c] * axis[c];
+        }
+
+        float length = 0.f;
+        for (uint32_t c = 0; c < channels; c++) length += next[c] * next[c];
+        length = std::sqrt(length);
+        if (length < 1e-6f) return;
+        for (uint32_t c = 0; c < channels; c++) axis[c] = next[c] / length;
+    }
+}
+
+static void FitLineEndpoints(const float points[16][4],
+                             uint32_t channels,
+                             OUT float start[4],
+                             OUT float end[4])
+{
+    float mean[4], axis[4];
+    FindPrincipalAxis(points, channels, mean, axis);
+
+    float minProjection = std::numeric_limits<float>::max();
+    float maxProjection = std::numeric_limits<float>::lowest();
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        float projection = 0.f;
+        for (uint32_t c = 0; c < channels; c++) projection += (points[i][c] - mean[c]) * axis[c];
+        minProjection = std::min(minProjection, projection);
+        maxProjection = std::max(maxProjection, projection);
+    }
+
+    for (uint32_t c = 0; c < 4; c++)
+    {
+        start[c] = std::clamp(mean[c] + axis[c] * minProjection, 0.f, 255.f);
+        end[c] = std::clamp(mean[c] + axis[c] * maxProjection, 0.f, 255.f);
+    }
+}
+
+/**
+ * Solves for the endpoints that best reproduce the points in the least squares sense, given
+ * each point's interpolation weight towards the end endpoint
+ */
+static bool RefineEndpoints(const float points[16][4],
+                            const float weights[16],
+                            uint32_t channels,
+                            OUT float start[4],
+                            OUT float end[4])
+{
+    float aa = 0.f, ab = 0.f, bb = 0.f;
+    float ax[4] = {}, bx[4] = {};
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        float a = 1.f - weights[i];
+        float b = weights[i];
+        aa += a * a;
+        ab += a * b;
+        bb += b * b;
+        for (uint32_t c = 0; c < channels; c++)
+        {
+            ax[c] += a * points[i][c];
+            bx[c] += b * points[i][c];
+        }
+    }
+
+    float determinant = aa * bb - ab * ab;
+    if (std::abs(determinant) < 1e-6f) return false;
+
+    for (uint32_t c = 0; c < channels; c++)
+    {
+        start[c] = std::clamp((ax[c] * bb - bx[c] * ab) / determinant, 0.f, 255.f);
+        end[c] = std::clamp((bx[c] * aa - ax[c] * ab) / determinant, 0.f, 255.f);
+    }
+    return true;
+}
+
+static uint16_t PackRgb565(const float colour[4])
+{
+    uint32_t r = std::clamp<long>(std::lround(colour[0] * 31.f / 255.f), 0, 31);
+    uint32_t g = std::clamp<long>(std::lround(colour[1] * 63.f / 255.f), 0, 63);
+    uint32_t b = std::clamp<long>(std::lround(colour[2] * 31.f / 255.f), 0, 31);
+    return (r << 11) | (g << 5) | b;
+}
+
+static void GetBc1Palette(uint16_t colour0,
+                          uint16_t colour1,
+                          bool allowTransparent,
+                          OUT uint8_t palette[4][4])
+{
+    uint16_t colours[2] = {colour0, colour1};
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        uint32_t r = (colours[i] >> 11) & 31, g = (colours[i] >> 5) & 63, b = colours[i] & 31;
+        palette[i][0] = (r << 3) | (r >> 2);
+        palette[i][1] = (g << 2) | (g >> 4);
+        palette[i][2] = (b << 3) | (b >> 2);
+        palette[i][3] = 255;
+    }
+
+    // The three colour mode is only used by BC1 when the endpoints are not in descending order
+    bool fourColour = !allowTransparent || colour0 > colour1;
+    for (uint32_t c = 0; c < 3; c++)
+    {
+        if (fourColour)
+        {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+        else
+        {
+            palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+            palette[3][c] = 0;
+        }
+    }
+    palette[2][3] = palette[3][3] = 255;
+}
+
+static void EncodeBc1Block(const uint8_t texels[16][4], OUT uint8_t* block)
+{
+    float points[16][4];
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        for (uint32_t c = 0; c < 4; c++) points[i][c] = texels[i][c];
+    }
+
+    float start[4], end[4];
+    FitLineEndpoints(points, 3, start, end);
+
+    uint16_t bestColours[2] = {0, 0};
+    uint8_t bestIndices[16] = {};
+    uint32_t bestError = std::numeric_limits<uint32_t>::max();
+    for (uint32_t pass = 0; pass <= TEXTURE_COMPRESSOR_REFINE_PASSES; pass++)
+    {
+        uint16_t colour0 = PackRgb565(start), colour1 = PackRgb565(end);
+        uint8_t palette[4][4];
+        GetBc1Palette(colour0, colour1, false, palette);
+
+        uint8_t indices[16];
+        float weights[16];
+        uint32_t error = 0;
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            uint32_t bestEntryError = std::numeric_limits<uint32_t>::max();
+            for (uint32_t entry = 0; entry < 4; entry++)
+            {
+                uint32_t entryError = 0;
+                for (uint32_t c = 0; c < 3; c++)
+                {
+                    int32_t difference = texels[i][c] - palette[entry][c];
+                    entryError += difference * difference;
+                }
+                if (entryError >= bestEntryError) continue;
+                bestEntryError = entryError;
+                indices[i] = entry;
+            }
+            weights[i] = BC1_WEIGHTS[indices[i]];
+            error += bestEntryError;
+        }
+
+        if (error < bestError)
+        {
+            bestError = error;
+            bestColours[0] = colour0;
+            bestColours[1] = colour1;
+            memcpy(bestIndices, indices, sizeof(indices));
+        }
+        if (bestError == 0 || !RefineEndpoints(points, weights, 3, start, end)) break;
+    }
+
+    // Keep the endpoints descending so the block decodes in four colour mode, where swapping them
+    // swaps the first and second pairs of palette entries
+    if (bestColours[0] < bestColours[1])
+    {
+        std::swap(bestColours[0], bestColours[1]);
+        for (uint8_t& index : bestIndices) index ^= 1;
+    }
+    else if (bestColours[0] == bestColours[1])
+    {
+        for (uint8_t& index : bestIndices) index = 0;
+    }
+
+    uint32_t packedIndices = 0;
+    for (uint32_t i = 0; i < 16; i++) packedIndices |= bestIndices[i] << (i * 2);
+    memcpy(block, bestColours, sizeof(bestColours));
+    memcpy(block + 4, &packedIndices, sizeof(packedIndices));
+}
+
+static void DecodeBc1Block(const uint8_t* block, bool allowTransparent, OUT uint8_t texels[16][4])
+{
+    uint16_t colours[2];
+    uint32_t packedIndices;
+    memcpy(colours, block, sizeof(colours));
+    memcpy(&packedIndices, block + 4, sizeof(packedIndices));
+
+    uint8_t palette[4][4];
+    GetBc1Palette(colours[0], colours[1], allowTransparent, palette);
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        memcpy(texels[i], palette[(packedIndices >> (i * 2)) & 3], 4);
+    }
+}
+
+static void GetBc4Palette(uint8_t value0, uint8_t value1, OUT uint8_t palette[8])
+{
+    palette[0] = value0;
+    palette[1] = value1;
+    if (value0 > value1)
+    {
+        for (uint32_t i = 1; i < 7; i++)
+        {
+            palette[i + 1] = ((7 - i) * value0 + i * value1 + 3) / 7;
+        }
+    }
+    else
+    {
+        for (uint32_t i = 1; i < 5; i++)
+        {
+            palette[i + 1] = ((5 - i) * value0 + i * value1 + 2) / 5;
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+}
+
+static uint32_t AssignBc4Indices(const uint8_t values[16],
+                                 const uint8_t palette[8],
+                                 OUT uint8_t indices[16])
+{
+    uint32_t error = 0;
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        uint32_t bestEntryError = std::numeric_limits<uint32_t>::max();
+        for (uint32_t entry = 0; entry < 8; entry++)
+        {
+            int32_t difference = values[i] - palette[entry];
+            uint32_t entryError = difference * difference;
+            if (entryError >= bestEntryError) continue;
+            bestEntryError = entryError;
+            indices[i] = entry;
+        }
+        error += bestEntryError;
+    }
+    return error;
+}
+
+static void EncodeBc4Block(const uint8_t texels[16][4], uint32_t channel, OUT uint8_t* block)
+{
+    uint8_t values[16];
+    for (uint32_t i = 0; i < 16; i++) values[i] = texels[i][channel];
+
+    // Try the eight value mode spanning the whole block, and the six value mode spanning all but
+    // the exact extremes it can already represent
+    uint8_t minValue = 255, maxValue = 0, innerMin = 255, innerMax = 0;
+    for (uint8_t value : values)
+    {
+        minValue = std::min(minValue, value);
+        maxValue = std::max(maxValue, value);
+        if (value == 0 || value == 255) continue;
+        innerMin = std::min(innerMin, value);
+        innerMax = std::max(innerMax, value);
+    }
+    if (innerMin > innerMax) innerMin = innerMax = 0;
+
+    uint8_t palette[8], indices[16], innerIndices[16];
+    GetBc4Palette(maxValue, minValue, palette);
+    uint32_t error = AssignBc4Indices(values, palette, indices);
+    GetBc4Palette(innerMin, innerMax, palette);
+    uint32_t innerError = AssignBc4Indices(values, palette, innerIndices);
+
+    block[0] = innerError < error ? innerMin : maxValue;
+    block[1] = innerError < error ? innerMax : minValue;
+    const uint8_t* bestIndices = innerError < error ? innerIndices : indices;
+
+    uint64_t packedIndices = 0;
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        packedIndices |= static_cast<uint64_t>(bestIndices[i]) << (i * 3);
+    }
+    memcpy(block + 2, &packedIndices, 6);
+}
+
+static void DecodeBc4Block(const uint8_t* block, uint32_t channel, OUT uint8_t texels[16][4])
+{
+    uint8_t palette[8];
+    GetBc4Palette(block[0], block[1], palette);
+
+    uint64_t packedIndices = 0;
+    memcpy(&packedIndices, block + 2, 6);
+    for (uint32_t i = 0; i < 16; i++) texels[i][channel] = palette[(packedIndices >> (i * 3)) & 7];
+}
+
+static void QuantiseBc7Endpoint(const float endpoint[4],
+                                uint32_t pBit,
+                                OUT uint32_t quantised[4],
+                                OUT uint32_t reconstructed[4])
+{
+    for (uint32_t c = 0; c < 4; c++)
+    {
+        quantised[c] = std::clamp<long>(std::lround((endpoint[c] - pBit) / 2.f), 0, 127);
+        reconstructed[c] = (quantised[c] << 1) | pBit;
+    }
+}
+
+static void GetBc7Palette(const uint32_t endpoints[2][4], OUT uint8_t palette[16][4])
+{
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        for (uint32_t c = 0; c < 4; c++)
+        {
+            palette[i][c] =
+                ((64 - BC7_WEIGHTS[i]) * endpoints[0][c] + BC7_WEIGHTS[i] * endpoints[1][c] + 32) >>
+                6;
+        }
+    }
+}
+
+static void EncodeBc7Block(const uint8_t texels[16][4], OUT uint8_t* block)
+{
+    // Only mode 6 is used, a single subset with 7.7.7.7 endpoints, per-endpoint low bits and
+    // 4-bit indices, which suits smooth colour and alpha well without a partition search
+    float points[16][4];
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        for (uint32_t c = 0; c < 4; c++) points[i][c] = texels[i][c];
+    }
+
+    float start[4], end[4];
+    FitLineEndpoints(points, 4, start, end);
+
+    uint32_t bestEndpoints[2][4] = {};
+    uint32_t bestPBits[2] = {0, 0};
+    uint8_t bestIndices[16] = {};
+    uint32_t bestError = std::numeric_limits<uint32_t>::max();
+    for (uint32_t pass = 0; pass <= TEXTURE_COMPRESSOR_REFINE_PASSES; pass++)
+    {
+        // The low bit is shared across an endpoint's channels, and pairs of odd and even bits
+        // interpolate to different values, so every pairing is scored against the whole block
+        float weights[16];
+        uint32_t passError = std::numeric_limits<uint32_t>::max();
+        for (uint32_t pBitPair = 0; pBitPair < 4; pBitPair++)
+        {
+            uint32_t pBits[2] = {pBitPair & 1, pBitPair >> 1};
+            uint32_t quantised[2][4], endpoints[2][4];
+            QuantiseBc7Endpoint(start, pBits[0], quantised[0], endpoints[0]);
+            QuantiseBc7Endpoint(end, pBits[1], quantised[1], endpoints[1]);
+
+            uint8_t palette[16][4];
+            GetBc7Palette(endpoints, palette);
+
+            uint8_t indices[16];
+            uint32_t error = 0;
+            for (uint32_t i = 0; i < 16; i++)
+            {
+                uint32_t bestEntryError = std::numeric_limits<uint32_t>::max();
+                for (uint32_t entry = 0; entry < 16; entry++)
+                {
+                    uint32_t entryError = 0;
+                    for (uint32_t c = 0; c < 4; c++)
+                    {
+                        int32_t difference = texels[i][c] - palette[entry][c];
+                        entryError += difference * difference;
+                    }
+                    if (entryError >= bestEntryError) continue;
+                    bestEntryError = entryError;
+                    indices[i] = entry;
+                }
+                error += bestEntryError;
+            }
+
+            if (error < passError)
+            {
+                passError = error;
+                for (uint32_t i = 0; i < 16; i++) weights[i] = BC7_WEIGHTS[indices[i]] / 64.f;
+            }
+            if (error < bestError)
+            {
+                bestError = error;
+                memcpy(bestEndpoints, quantised, sizeof(quantised));
+                memcpy(bestPBits, pBits, sizeof(pBits));
+                memcpy(bestIndices, indices, sizeof(indices));
+            }
+        }
+        if (bestError == 0 || !RefineEndpoints(points, weights, 4, start, end)) break;
+    }
+
+    // The first index drops its high bit, so swap the endpoints if it would be set. The weights
+    // are symmetric, making the swapped block decode identically
+    if (bestIndices[0] & 8)
+    {
+        std::swap(bestEndpoints[0], bestEndpoints[1]);
+        std::swap(bestPBits[0], bestPBits[1]);
+        for (uint8_t& index : bestIndices) index = 15 - index;
+    }
+
+    memset(block, 0, 16);
+    BitWriter writer {block};
+    writer.Write(1 << 6, 7);
+    for (uint32_t c = 0; c < 4; c++)
+    {
+        writer.Write(bestEndpoints[0][c], 7);
+        writer.Write(bestEndpoints[1][c], 7);
+    }
+    writer.Write(bestPBits[0], 1);
+    writer.Write(bestPBits[1], 1);
+    writer.Write(bestIndices[0], 3);
+    for (uint32_t i = 1; i < 16; i++) writer.Write(bestIndices[i], 4);
+}
+
+static void DecodeBc7Block(const uint8_t* block, OUT uint8_t texels[16][4])
+{
+    // Only the mode written by the encoder is supported, other modes decode as opaque magenta
+    BitReader reader {block};
+    if (reader.Read(7) != 1 << 6)
+    {
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            texels[i][0] = texels[i][2] = texels[i][3] = 255;
+            texels[i][1] = 0;
+        }
+        return;
+    }
+
+    uint32_t endpoints[2][4];
+    for (uint32_t c = 0; c < 4; c++)
+    {
+        endpoints[0][c] = reader.Read(7) << 1;
+        endpoints[1][c] = reader.Read(7) << 1;
+    }
+    for (uint32_t e = 0; e < 2; e++)
+    {
+        uint32_t pBit = reader.Read(1);
+        for (uint32_t c = 0; c < 4; c++) endpoints[e][c] |= pBit;
+    }
+
+    uint8_t palette[16][4];
+    GetBc7Palette(endpoints, palette);
+    for (uint32_t i = 0; i < 16; i++) memcpy(texels[i], palette[reader.Read(i == 0 ? 3 : 4)], 4);
+}
+
+static void EncodeBlock(const uint8_t texels[16][4],
+                        Siege::Texture2DFormat format,
+                        OUT uint8_t* block)
+{
+    switch (format)
+    {
+        case Siege::TEXTURE2D_FORMAT_BC1:
+            EncodeBc1Block(texels, block);
+            break;
+        case Siege::TEXTURE2D_FORMAT_BC3:
+            EncodeBc4Block(texels, 3, block);
+            EncodeBc1Block(texels, block + 8);
+            break;
+        case Siege::TEXTURE2D_FORMAT_BC4:
+            EncodeBc4Block(texels, 0, block);
+            break;
+        case Siege::TEXTURE2D_FORMAT_BC5:
+            EncodeBc4Block(texels, 0, block);
+            EncodeBc4Block(texels, 1, block + 8);
+            break;
+        case Siege::TEXTURE2D_FORMAT_BC7:
+            EncodeBc7Block(texels, block);
+            break;
+        default:
+            break;
+    }
+}
+
+static void DecodeBlock(const uint8_t* block,
+                        Siege::Texture2DFormat format,
+                        OUT uint8_t texels[16][4])
+{
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        texels[i][0] = texels[i][1] = texels[i][2] = 0;
+        texels[i][3] = 255;
+    }
+
+    switch (format)
+    {
+        case Siege::TEXTURE2D_FORMAT_BC1:
+            DecodeBc1Block(block, true, texels);
+            break;
+        case Siege::TEXTURE2D_FORMAT_BC3:
+            DecodeBc1Block(block + 8, false, texels);
+            DecodeBc4Block(block, 3, texels);
+            break;
+        case Siege::TEXTURE2D_FORMAT_BC4:
+            DecodeBc4Block(block, 0, texels);
+            break;
+        case Siege::TEXTURE2D_FORMAT_BC5:
+            DecodeBc4Block(block, 0, texels);
+            DecodeBc4Block(block + 8, 1, texels);
+            break;
+        case Siege::TEXTURE2D_FORMAT_BC7:
+            DecodeBc7Block(block, texels);
+            break;
+        default:
+            break;
+    }
+}
+
+static uint32_t GetStoredChannelCount(Siege::Texture2DFormat format)
+{
+    switch (format)
+    {
+        case Siege::TEXTURE2D_FORMAT_BC1:
+            return 3;
+        case Siege::TEXTURE2D_FORMAT_BC4:
+            return 1;
+        case Siege::TEXTURE2D_FORMAT_BC5:
+            return 2;
+        default:
+            return 4;
+    }
+}
+
+std::vector<uint8_t> CompressTexture(const std::vector<uint8_t>& pixels,
+                                     int32_t width,
+                                     int32_t height,
+                                     uint32_t levelCount,
+                                     Siege::Texture2DFormat format,
+                                     OUT TextureCompressionReport& report)
+{
+    using Siege::GetTexture2DLevelSize;
+    using Siege::TEXTURE2D_FORMAT_RGBA8;
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    uint32_t blockSize = Siege::GetTexture2DBlockSize(format);
+    std::vector<uint8_t> blocks;
+    uint64_t texelCount = 0;
+    uint64_t levelOffset = 0;
+    for (uint32_t level = 0; level < levelCount; level++)
+    {
+        uint32_t levelWidth = std::max(width >> level, 1);
+        uint32_t levelHeight = std::max(height >> level, 1);
+        uint32_t blocksWide = (levelWidth + 3) / 4, blocksHigh = (levelHeight + 3) / 4;
+
+        uint64_t blockOffset = blocks.size();
+        blocks.resize(blockOffset + GetTexture2DLevelSize(width, height, 4, format, level));
+        for (uint32_t blockY = 0; blockY < blocksHigh; blockY++)
+        {
+            for (uint32_t blockX = 0; blockX < blocksWide; blockX++)
+            {
+                uint8_t texels[16][4];
+                ReadBlock(&pixels[levelOffset], levelWidth, levelHeight, blockX, blockY, texels);
+                uint8_t* block = &blocks[blockOffset + (blockY * blocksWide + blockX) * blockSize];
+                EncodeBlock(texels, format, block);
+            }
+        }
+
+        texelCount += levelWidth * levelHeight;
+        levelOffset += GetTexture2DLevelSize(width, height, 4, TEXTURE2D_FORMAT_RGBA8, level);
+    }
+
+    std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - startTime;
+    report.megatexelsPerSecond = texelCount / std::max(seconds.count(), 1e-9) / 1e6;
+
+    // Measure quality against the source over only the channels the format stores
+    std::vector<uint8_t> decoded = DecompressTexture(blocks, width, height, levelCount, format);
+    uint32_t channels = GetStoredChannelCount(format);
+    double squaredError = 0.0;
+    for (uint64_t i = 0; i < decoded.size(); i++)
+    {
+        if (i % 4 >= channels) continue;
+        double difference = static_cast<double>(decoded[i]) - pixels[i];
+        squaredError += difference * difference;
+    }
+    double meanSquaredError = squaredError / (texelCount * channels);
+    report.psnr = meanSquaredError > 0.0 ? 10.0 * std::log10(255.0 * 255.0 / meanSquaredError) :
+                                           std::numeric_limits<double>::infinity();
+
+    return blocks;
+}
+
+std::vector<uint8_t> DecompressTexture(const std::vector<uint8_t>& blocks,
+                                       int32_t width,
+                                       int32_t height,
+                                       uint32_t levelCount,
+                                       Siege::Texture2DFormat format)
+{
+    using Siege::GetTexture2DLevelSize;
+    using Siege::TEXTURE2D_FORMAT_RGBA8;
+
+    uint32_t blockSize = Siege::GetTexture2DBlockSize(format);
+    std::vector<uint8_t> pixels;
+    uint64_t blockOffset = 0;
+    for (uint32_t level = 0; level < levelCount; level++)
+    {
+        uint32_t levelWidth = std::max(width >> level, 1);
+        uint32_t levelHeight = std::max(height >> level, 1);
+        uint32_t blocksWide = (levelWidth + 3) / 4, blocksHigh = (levelHeight + 3) / 4;
+
+        uint64_t levelOffset = pixels.size();
+        pixels.resize(levelOffset +
+                      GetTexture2DLevelSize(width, height, 4, TEXTURE2D_FORMAT_RGBA8, level));
+        for (uint32_t blockY = 0; blockY < blocksHigh; blockY++)
+        {
+            for (uint32_t blockX = 0; blockX < blocksWide; blockX++)
+            {
+                uint8_t texels[16][4];
+                const uint8_t* block =
+                    &blocks[blockOffset + (blockY * blocksWide + blockX) * blockSize];
+                DecodeBlock(block, format, texels);
+                WriteBlock(texels, levelWidth, levelHeight, blockX, blockY, &pixels[levelOffset]);
+            }
+        }
+
+        blockOffset += GetTexture2DLevelSize(width, height, 4, format, level);
+    }
+    return pixels;
+}
@@ -0,0 +1,64 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#ifndef SIEGE_ENGINE_PACKER_TEXTURECOMPRESSOR_H
+#define SIEGE_ENGINE_PACKER_TEXTURECOMPRESSOR_H
+
+#include <resources/Texture2DData.h>
+#include <utils/Macros.h>
+
+#include <cstdint>
+#include <vector>
+
+// The number of least squares passes used to refine block endpoints after the initial fit
+#define TEXTURE_COMPRESSOR_REFINE_PASSES 2
+
+struct TextureCompressionReport
+{
+    // Peak signal to noise ratio over the channels the format stores, in decibels
+    double psnr {0.0};
+    // Encoding throughput in millions of texels per second
+    double megatexelsPerSecond {0.0};
+};
+
+/**
+ * Block compresses every level of an RGBA8 mip chain. BC1 stores opaque colour, BC3 and BC7 store
+ * colour and alpha, BC4 stores the red channel and BC5 the red and green channels
+ * @param pixels - the uncompressed mip chain, with each level following the one above it
+ * @param width - the width of the base level
+ * @param height - the height of the base level
+ * @param levelCount - the number of levels in the chain
+ * @param format - the block compressed format to encode to
+ * @param report - filled with the quality and speed of the encode
+ * @return the compressed mip chain, laid out as Texture2DData expects for the format
+ */
+std::vector<uint8_t> CompressTexture(const std::vector<uint8_t>& pixels,
+                                     int32_t width,
+                                     int32_t height,
+                                     uint32_t levelCount,
+                                     Siege::Texture2DFormat format,
+                                     OUT TextureCompressionReport& report);
+
+/**
+ * Decodes every level of a block compressed mip chain back to RGBA8, filling any channels the
+ * format does not store with zero for colour and opaque for alpha
+ * @param blocks - the compressed mip chain
+ * @param width - the width of the base level
+ * @param height - the height of the base level
+ * @param levelCount - the number of levels in the chain
+ * @param format - the block compressed format the chain is encoded in
+ * @return the uncompressed mip chain
+ */
+std::vector<uint8_t> DecompressTexture(const std::vector<uint8_t>& blocks,
+                                       int32_t width,
+                                       int32_t height,
+                                       uint32_t levelCount,
+                                       Siege::Texture2DFormat format);
+
+#endif // SIEGE_ENGINE_PACKER_TEXTURECOMPRESSOR_H
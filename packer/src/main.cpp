@@ -9,13 +9,23 @@
 
 #include <resources/PackFile.h>
 #include <resources/PackFileData.h>
-#include <resources/ResourceSystem.h>
 #include <utils/Logging.h>
 #include <zlib.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
+#include <functional>
+#include <set>
+#include <thread>
+#include <unordered_map>
 
+#include "BuildCache.h"
+#include "BundleLayout.h"
 #include "types/AnimationDataPacker.h"
+#include "types/FontDataPacker.h"
 #include "types/GenericFileDataPacker.h"
 #include "types/SceneDataPacker.h"
 #include "types/SkeletalMeshDataPacker.h"
@@ -24,12 +34,154 @@
 
 using Siege::PackFile;
 
+/**
+ * Reduces a set of entries to those that differ from a base pack. Unchanged entries are freed and
+ * removed, and entries the base pack has but the inputs do not are added as removal markers
+ * @param basePackPath - the path of the pack the delta will be mounted on top of
+ * @param entries - the complete set of packed entries, filtered in place
+ * @return true if the base pack could be read, false otherwise
+ */
+static bool FilterDeltaEntries(const Siege::String& basePackPath,
+                               std::vector<std::pair<PackFile::TocEntry*, void*>>& entries)
+{
+    PackFile basePackFile(basePackPath);
+    if (!basePackFile.IsValid())
+    {
+        CC_LOG_ERROR("Failed to read delta base pack file \"{}\"", basePackPath)
+        return false;
+    }
+
+    std::set<Siege::String> entryNames;
+    std::vector<std::pair<PackFile::TocEntry*, void*>> deltaEntries;
+    for (const std::pair<PackFile::TocEntry*, void*>& entry : entries)
+    {
+        entryNames.insert(entry.first->name);
+
+        auto data = static_cast<Siege::PackFileData*>(entry.second);
+        std::shared_ptr<Siege::PackFileData> baseData = basePackFile.FindData(entry.first->name);
+        if (baseData && baseData->dataSize == data->dataSize &&
+            memcmp(baseData.get(), data, data->GetDataSize()) == 0)
+        {
+            CC_LOG_INFO("Skipping unchanged entry \"{}\"", entry.first->name)
+            free(entry.first);
+            free(entry.second);
+            continue;
+        }
+        deltaEntries.push_back(entry);
+    }
+
+    // Sort removals by name so that the output does not depend on the base pack's hash order
+    std::set<Siege::String> removedNames;
+    for (const auto& baseEntry : basePackFile.GetEntries())
+    {
+        if (baseEntry.second->IsRemoved() || entryNames.count(baseEntry.first)) continue;
+
+        // Generated entries are never inputs, and are written again for the delta if it needs
+        // them, so a removal marker would hide the delta's own copy
+        if (baseEntry.first.Str()[0] == PACKER_GENERATED_ENTRY_PREFIX) continue;
+
+        removedNames.insert(baseEntry.first);
+    }
+    for (const Siege::String& removedName : removedNames)
+    {
+        deltaEntries.emplace_back(PackFile::TocEntry::Create(removedName, 0, 0), nullptr);
+    }
+
+    entries = std::move(deltaEntries);
+    return true;
+}
+
+/**
+ * Runs a job for every index in a range across a pool of threads. Each index is claimed by exactly
+ * one thread, so jobs writing only to their own slot of a result array need no locking
+ * @param count - the number of indices to run the job for
+ * @param jobCount - the maximum number of threads to run jobs on
+ * @param job - the job to run for each index
+ */
+static void ParallelFor(size_t count, uint32_t jobCount, const std::function<void(size_t)>& job)
+{
+    std::atomic<size_t> nextIndex {0};
+    auto runJobs = [&nextIndex, count, &job]() {
+        for (size_t i = nextIndex++; i < count; i = nextIndex++) job(i);
+    };
+
+    std::vector<std::thread> workers;
+    size_t workerCount = std::min<size_t>(jobCount, count);
+    for (size_t i = 1; i < workerCount; i++) workers.emplace_back(runJobs);
+    runJobs();
+    for (std::thread& worker : workers) worker.join();
+}
+
+static Siege::PackFileData* PackInputFile(const std::filesystem::path& file,
+                                          const Siege::String& assetsDir,
+                                          bool inPlace,
+                                          MipFilter mipFilter)
+{
+    Siege::String fullPath = assetsDir + "/" + Siege::String(file.c_str());
+    std::filesystem::path extension = file.extension();
+    if (extension == ".sm") return PackStaticMeshFile(fullPath, assetsDir, inPlace);
+    if (extension == ".sk") return PackSkeletalMeshFile(fullPath, assetsDir, inPlace);
+    if (extension == ".ska") return PackAnimationFile(fullPath, assetsDir);
+    if (extension == ".font") return PackFontFile(fullPath, assetsDir, inPlace);
+    if (extension == ".jpg" || extension == ".jpeg" || extension == ".png")
+    {
+        return PackTexture2DFile(fullPath, inPlace, mipFilter);
+    }
+    if (extension == ".scene") return PackSceneFile(fullPath);
+    if (extension == ".spv" || extension == ".ttf") return PackGenericFile(fullPath);
+    return nullptr;
+}
+
+// zlib's lengths are 32-bit on some platforms, so entries are streamed through it in chunks
+static constexpr uint64_t ZLIB_CHUNK_SIZE = 1u << 30;
+
+static std::vector<Bytef> CompressEntry(const std::pair<PackFile::TocEntry*, void*>& entry)
+{
+    z_stream stream {};
+    int result = deflateInit(&stream, Z_BEST_COMPRESSION);
+    CC_ASSERT(result == Z_OK, "Compression failed for entry: " + Siege::String(entry.first->name));
+
+    uint64_t bodyDataSizeRemaining = entry.first->dataSize;
+    stream.next_in = static_cast<Bytef*>(entry.second);
+
+    std::vector<Bytef> bodyDataCompressed;
+    while (result != Z_STREAM_END)
+    {
+        if (stream.avail_in == 0)
+        {
+            stream.avail_in = static_cast<uInt>(std::min(bodyDataSizeRemaining, ZLIB_CHUNK_SIZE));
+            bodyDataSizeRemaining -= stream.avail_in;
+        }
+
+        // Compressed data rarely outgrows its input, so the output grows towards the input's size
+        uInt outputSize = static_cast<uInt>(
+            std::clamp<uint64_t>(stream.avail_in + bodyDataSizeRemaining, 1024, ZLIB_CHUNK_SIZE));
+        size_t outputOffset = bodyDataCompressed.size();
+        bodyDataCompressed.resize(outputOffset + outputSize);
+        stream.next_out = bodyDataCompressed.data() + outputOffset;
+        stream.avail_out = outputSize;
+
+        int flush = bodyDataSizeRemaining == 0 ? Z_FINISH : Z_NO_FLUSH;
+        result = deflate(&stream, flush);
+        CC_ASSERT(result == Z_OK || result == Z_STREAM_END || result == Z_BUF_ERROR,
+                  "Compression failed for entry: " + Siege::String(entry.first->name));
+
+        bodyDataCompressed.resize(outputOffset + outputSize - stream.avail_out);
+    }
+    deflateEnd(&stream);
+
+    return bodyDataCompressed;
+}
+
 int main(int argc, char* argv[])
 {
     if (argc <= 1)
     {
         CC_LOG_ERROR("Requires at least three arguments, expected form <outputFile> <assetsDir> "
-                     "[<inputFiles>]")
+                     "[--in-place] [--mips=<box|kaiser>] [--alignment=<bytes>] "
+                     "[--delta-base=<basePackFile>] [--bundle-scenes] [--access-trace=<traceFile>] "
+                     "[--jobs=<count>] "
+                     "[--cache-dir=<cacheDir>] [<inputFiles>]")
         return 1;
     }
 
@@ -37,49 +189,139 @@ int main(int argc, char* argv[])
     Siege::String outputFile = argv[1];
     Siege::String assetsDir = argv[2];
 
+    bool inPlace = false;
+    MipFilter mipFilter = MIP_FILTER_NONE;
+    uint32_t entryAlignment = PACKER_DEFAULT_ENTRY_ALIGNMENT;
+    Siege::String deltaBasePath;
+    bool bundleScenes = false;
+    std::vector<Siege::String> accessTrace;
+    uint32_t jobCount = std::max(std::thread::hardware_concurrency(), 1u);
+    Siege::String cacheDir;
     std::vector<std::filesystem::path> inputFiles;
     for (int currentArg = 3; currentArg < argc; ++currentArg)
     {
-        inputFiles.emplace_back(argv[currentArg]);
-    }
-
-    uint32_t entriesDataSize = 0;
-    uint32_t entriesTocSize = 0;
-
-    std::vector<std::pair<PackFile::TocEntry*, void*>> entries;
-    for (auto& file : inputFiles)
-    {
-        if (file.empty()) continue;
-        CC_LOG_INFO("Reading asset at path {}", file.c_str())
-
-        Siege::PackFileData* data = nullptr;
-        Siege::String fullPath = assetsDir + "/" + Siege::String(file.c_str());
-        std::filesystem::path extension = file.extension();
-        if (extension == ".sm")
+        Siege::String arg = argv[currentArg];
+        if (arg == "--in-place")
+        {
+            // Write mesh and texture data as aligned records that can be viewed without copying
+            inPlace = true;
+            continue;
+        }
+        if (strncmp(arg.Str(), "--mips=", 7) == 0)
+        {
+            // Generate a full mip chain for each texture, filtered in linear space
+            Siege::String filter = arg.Str() + 7;
+            if (filter == "box") mipFilter = MIP_FILTER_BOX;
+            else if (filter == "kaiser") mipFilter = MIP_FILTER_KAISER;
+            else
+            {
+                CC_LOG_ERROR("Mip filter must be one of \"box\" or \"kaiser\", got \"{}\"", filter)
+                return 1;
+            }
+            continue;
+        }
+        if (strncmp(arg.Str(), "--alignment=", 12) == 0)
+        {
+            // Entry data alignment, use the page size to allow direct mapped or unbuffered reads
+            entryAlignment = std::strtoul(arg.Str() + 12, nullptr, 10);
+            if (entryAlignment == 0 || (entryAlignment & (entryAlignment - 1)) != 0)
+            {
+                CC_LOG_ERROR("Entry alignment must be a power of two, got \"{}\"", arg)
+                return 1;
+            }
+            continue;
+        }
+        if (strncmp(arg.Str(), "--delta-base=", 13) == 0)
+        {
+            // Only write entries that differ from the given base pack, for mounting as a patch
+            deltaBasePath = arg.Str() + 13;
+            continue;
+        }
+        if (arg == "--bundle-scenes")
         {
-            data = PackStaticMeshFile(fullPath, assetsDir);
+            // Lay out the entries used by each scene contiguously so they can be read in one go
+            bundleScenes = true;
+            continue;
         }
-        else if (extension == ".sk")
+        if (strncmp(arg.Str(), "--access-trace=", 15) == 0)
         {
-            data = PackSkeletalMeshFile(fullPath, assetsDir);
+            // Order the entries within each scene bundle by a trace recorded at runtime
+            if (!ReadAccessTrace(arg.Str() + 15, accessTrace)) return 1;
+            bundleScenes = true;
+            continue;
         }
-        else if (extension == ".ska")
+        if (strncmp(arg.Str(), "--jobs=", 7) == 0)
         {
-            data = PackAnimationFile(fullPath, assetsDir);
+            // The number of threads to import and compress on, output does not depend on this
+            jobCount = std::max<uint32_t>(std::strtoul(arg.Str() + 7, nullptr, 10), 1);
+            continue;
         }
-        else if (extension == ".jpg" || extension == ".jpeg" || extension == ".png")
+        if (strncmp(arg.Str(), "--cache-dir=", 12) == 0)
         {
-            data = PackTexture2DFile(fullPath);
+            // Reuse packed and compressed entries whose inputs have not changed since the last run
+            cacheDir = arg.Str() + 12;
+            continue;
         }
-        else if (extension == ".scene")
+        inputFiles.emplace_back(argv[currentArg]);
+    }
+
+    auto alignOffset = [entryAlignment](uint64_t offset) {
+        return (offset + entryAlignment - 1) & ~static_cast<uint64_t>(entryAlignment - 1);
+    };
+
+    uint64_t entriesDataSize = 0;
+    uint64_t entriesTocSize = 0;
+
+    if (!cacheDir.IsEmpty())
+    {
+        std::error_code error;
+        std::filesystem::create_directories(cacheDir.Str(), error);
+        if (error)
         {
-            data = PackSceneFile(fullPath);
+            CC_LOG_ERROR("Failed to create build cache directory \"{}\"", cacheDir)
+            return 1;
         }
-        else if (extension == ".spv" || extension == ".ttf")
+    }
+
+    // Only options that change the contents of entries belong in their cache keys
+    uint64_t optionsHash = (inPlace ? 1 : 0) | (static_cast<uint64_t>(mipFilter) << 1);
+
+    // Import and convert every input in parallel, keeping the results in input order so that the
+    // output does not depend on which thread finished first
+    CC_LOG_INFO("Packing {} input files across {} jobs...", inputFiles.size(), jobCount)
+    std::vector<Siege::PackFileData*> packedData(inputFiles.size(), nullptr);
+    std::vector<uint64_t> cacheKeys(inputFiles.size(), 0);
+    std::vector<std::vector<Bytef>> cachedCompressedData(inputFiles.size());
+    std::atomic<uint32_t> cacheHits {0};
+    ParallelFor(inputFiles.size(), jobCount, [&](size_t i) {
+        if (inputFiles[i].empty()) return;
+
+        if (!cacheDir.IsEmpty())
         {
-            data = PackGenericFile(fullPath);
+            cacheKeys[i] = HashInputFile(inputFiles[i], assetsDir, optionsHash);
+            if (ReadCachedEntry(cacheDir, cacheKeys[i], packedData[i], cachedCompressedData[i]))
+            {
+                cacheHits++;
+                return;
+            }
         }
 
+        CC_LOG_INFO("Reading asset at path {}", inputFiles[i].c_str())
+        packedData[i] = PackInputFile(inputFiles[i], assetsDir, inPlace, mipFilter);
+    });
+    if (!cacheDir.IsEmpty())
+    {
+        CC_LOG_INFO("Reused {} of {} entries from build cache", cacheHits.load(), inputFiles.size())
+    }
+
+    std::vector<std::pair<PackFile::TocEntry*, void*>> entries;
+    std::unordered_map<Siege::String, size_t> inputIndices;
+    for (size_t i = 0; i < inputFiles.size(); i++)
+    {
+        const std::filesystem::path& file = inputFiles[i];
+        if (file.empty()) continue;
+
+        Siege::PackFileData* data = packedData[i];
         if (!data)
         {
             CC_LOG_ERROR("Failed to create pack data for file \"{}\"", file.c_str())
@@ -87,58 +329,99 @@ int main(int argc, char* argv[])
             continue;
         }
 
-        uint32_t dataSize = data->GetDataSize();
+        uint64_t dataSize = data->GetDataSize();
         PackFile::TocEntry* tocEntry =
             PackFile::TocEntry::Create(file.c_str(), entriesDataSize, dataSize);
 
         entries.emplace_back(tocEntry, data);
+        inputIndices[file.c_str()] = i;
 
         entriesDataSize += dataSize;
-        entriesTocSize += tocEntry->GetDataSize();
+    }
+
+    uint32_t headerFlags = 0;
+    if (!deltaBasePath.IsEmpty())
+    {
+        CC_LOG_INFO("Comparing entries against base pack file \"{}\"...", deltaBasePath)
+        if (!FilterDeltaEntries(deltaBasePath, entries)) return 1;
+        headerFlags |= PACKER_FLAG_DELTA;
+    }
+
+    Siege::PackBundleData bundleData;
+    if (bundleScenes)
+    {
+        CC_LOG_INFO("Grouping entries into scene bundles...")
+        bundleData = OrderEntriesByScene(entries, accessTrace);
+    }
+
+    for (const std::pair<PackFile::TocEntry*, void*>& entry : entries)
+    {
+        entriesTocSize += entry.first->GetDataSize();
     }
 
     PackFile::Header header {{PACKER_MAGIC_NUMBER_FILE},
                              PACKER_FILE_VERSION,
                              entriesDataSize + PACKER_MAGIC_NUMBER_SIZE + entriesTocSize,
-                             entriesDataSize};
-
-    CC_LOG_INFO(
-        "Beginning pack file version {} write process for body size {} and ToC offset of {}...",
-        header.version,
-        header.bodySize,
-        header.tocOffset)
+                             entriesDataSize,
+                             alignOffset(sizeof(PackFile::Header)),
+                             entryAlignment,
+                             headerFlags};
+
+    CC_LOG_INFO("Beginning pack file version {} write process for body size {} and ToC offset of "
+                "{} with entry alignment {}...",
+                header.version,
+                header.bodySize,
+                header.tocOffset,
+                header.entryAlignment)
     uint64_t writeTotal = 0;
 
     std::ofstream outputFileStream;
     outputFileStream.open(outputFile, std::ios::out | std::ios::binary);
 
+    auto writePadding = [&outputFileStream, &writeTotal](uint64_t size) {
+        for (uint64_t i = 0; i < size; i++) outputFileStream.put(0);
+        writeTotal += size;
+    };
+
     outputFileStream.write(reinterpret_cast<char*>(&header), sizeof(PackFile::Header));
     writeTotal += sizeof(PackFile::Header);
     CC_LOG_INFO("Adding HEADER to pack file with size: {} (write total: {})",
                 sizeof(PackFile::Header),
                 writeTotal)
+    writePadding(header.bodyOffset - sizeof(PackFile::Header));
 
-    entriesDataSize = 0;
-    Bytef* bodyDataBufferCompressed = nullptr;
-    for (const std::pair<PackFile::TocEntry*, void*>& entry : entries)
-    {
-        uLongf bodyDataSizeUncompressed = entry.first->dataSize;
-        uLongf bodyDataSizeCompressed = compressBound(bodyDataSizeUncompressed);
+    CC_LOG_INFO("Compressing {} entries across {} jobs...", entries.size(), jobCount)
+    std::vector<std::vector<Bytef>> compressedEntries(entries.size());
+    ParallelFor(entries.size(), jobCount, [&](size_t i) {
+        if (entries[i].first->IsRemoved()) return;
 
-        Bytef* tempBuffer =
-            static_cast<Bytef*>(realloc(bodyDataBufferCompressed, bodyDataSizeCompressed));
-        bodyDataBufferCompressed = tempBuffer;
+        size_t inputIndex = inputIndices.at(entries[i].first->name);
+        if (!cachedCompressedData[inputIndex].empty())
+        {
+            compressedEntries[i] = std::move(cachedCompressedData[inputIndex]);
+            return;
+        }
 
-        int result = compress2(bodyDataBufferCompressed,
-                               &bodyDataSizeCompressed,
-                               static_cast<Bytef*>(entry.second),
-                               bodyDataSizeUncompressed,
-                               Z_BEST_COMPRESSION);
-        CC_ASSERT(result == Z_OK,
-                  "Compression failed for entry: " + Siege::String(entry.first->name));
+        compressedEntries[i] = CompressEntry(entries[i]);
+        if (!cacheDir.IsEmpty())
+        {
+            auto data = static_cast<const Siege::PackFileData*>(entries[i].second);
+            WriteCachedEntry(cacheDir, cacheKeys[inputIndex], data, compressedEntries[i]);
+        }
+    });
+
+    entriesDataSize = 0;
+    auto writeEntry = [&](const std::pair<PackFile::TocEntry*, void*>& entry,
+                          const std::vector<Bytef>& bodyDataCompressed) {
+        uint64_t bodyDataSizeUncompressed = entry.first->dataSize;
+        uint64_t bodyDataSizeCompressed = bodyDataCompressed.size();
 
-        outputFileStream.write(reinterpret_cast<char*>(bodyDataBufferCompressed),
-                               static_cast<long>(bodyDataSizeCompressed));
+        uint64_t alignedDataSize = alignOffset(entriesDataSize);
+        writePadding(alignedDataSize - entriesDataSize);
+        entriesDataSize = alignedDataSize;
+
+        outputFileStream.write(reinterpret_cast<const char*>(bodyDataCompressed.data()),
+                               static_cast<std::streamsize>(bodyDataSizeCompressed));
         entry.first->dataOffset = entriesDataSize;
         entry.first->dataSizeCompressed = bodyDataSizeCompressed;
         writeTotal += bodyDataSizeCompressed;
@@ -152,8 +435,54 @@ int main(int argc, char* argv[])
             static_cast<uint8_t>(ceilf(static_cast<float>(bodyDataSizeCompressed) /
                                        static_cast<float>(bodyDataSizeUncompressed) * 100.f)),
             writeTotal)
+    };
+
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        const std::pair<PackFile::TocEntry*, void*>& entry = entries[i];
+        if (entry.first->IsRemoved())
+        {
+            entry.first->dataOffset = entriesDataSize;
+            CC_LOG_INFO("Adding REMOVAL of \"{}\" to pack file", entry.first->name)
+            continue;
+        }
+        writeEntry(entry, compressedEntries[i]);
+        compressedEntries[i].clear();
+        compressedEntries[i].shrink_to_fit();
+    }
+
+    if (!bundleData.bundles.empty())
+    {
+        // Bundles span from their first entry to the end of their last, which are contiguous
+        std::unordered_map<Siege::String, const PackFile::TocEntry*> writtenEntries;
+        for (const std::pair<PackFile::TocEntry*, void*>& entry : entries)
+        {
+            writtenEntries[entry.first->name] = entry.first;
+        }
+        for (auto& bundle : bundleData.bundles)
+        {
+            if (bundle.second.entries.empty()) continue;
+            Siege::PackBundle& packBundle = bundle.second;
+            const PackFile::TocEntry* first = writtenEntries[packBundle.entries.front()];
+            const PackFile::TocEntry* last = writtenEntries[packBundle.entries.back()];
+            packBundle.dataOffset = first->dataOffset;
+            packBundle.dataSize = last->dataOffset + last->dataSizeCompressed - first->dataOffset;
+        }
+
+        Siege::BinarySerialisation::Buffer dataBuffer;
+        Siege::BinarySerialisation::serialise(dataBuffer,
+                                              bundleData,
+                                              Siege::BinarySerialisation::SERIALISE);
+        Siege::PackFileData* data =
+            Siege::PackFileData::Create(reinterpret_cast<char*>(dataBuffer.data.data()),
+                                        dataBuffer.data.size());
+        PackFile::TocEntry* tocEntry = PackFile::TocEntry::Create(PACKER_BUNDLE_TABLE_NAME,
+                                                                  entriesDataSize,
+                                                                  data->GetDataSize());
+        entries.emplace_back(tocEntry, data);
+        entriesTocSize += tocEntry->GetDataSize();
+        writeEntry(entries.back(), CompressEntry(entries.back()));
     }
-    if (bodyDataBufferCompressed) free(bodyDataBufferCompressed);
 
     outputFileStream.write(PACKER_MAGIC_NUMBER_TOC, PACKER_MAGIC_NUMBER_SIZE);
     writeTotal += PACKER_MAGIC_NUMBER_SIZE;
@@ -180,27 +509,23 @@ int main(int argc, char* argv[])
     outputFileStream.close();
     CC_LOG_INFO("Ended pack file write process (write total: {})", writeTotal)
 
-    uint32_t expectedSize = sizeof(PackFile::Header) + header.bodySize;
+    uint64_t expectedSize = header.bodyOffset + header.bodySize;
     CC_ASSERT(expectedSize == writeTotal, "Write total does not match expected file size!")
 
-    CC_LOG_INFO("Mounting and verifying ToC contents of written pack file...")
-    Siege::ResourceSystem& resourceSystem = Siege::ResourceSystem::GetInstance();
-    std::filesystem::path buildDir(outputFile.Str());
-    resourceSystem.MountPackFile(buildDir.remove_filename().c_str());
-    PackFile* packFile = resourceSystem.GetPackFile();
-
-    for (const std::filesystem::path& file : inputFiles)
+    CC_LOG_INFO("Loading and verifying ToC contents of written pack file...")
     {
-        auto it = packFile->GetEntries().find(file.c_str());
-        if (it == packFile->GetEntries().end())
+        PackFile packFile(outputFile);
+        for (const std::pair<PackFile::TocEntry*, void*>& entry : entries)
         {
-            CC_LOG_WARNING("Missing ToC entry for input file \"{}\"", file.c_str())
-            errors = true;
+            auto it = packFile.GetEntries().find(entry.first->name);
+            if (it == packFile.GetEntries().end())
+            {
+                CC_LOG_WARNING("Missing ToC entry for input file \"{}\"", entry.first->name)
+                errors = true;
+            }
         }
     }
-
-    CC_LOG_INFO("ToC contents finished verification process, unmounting written pack file...")
-    resourceSystem.UnmountPackFile();
+    CC_LOG_INFO("ToC contents finished verification process")
 
     CC_LOG_INFO("Freeing dynamically allocated memory from packer...")
     for (const std::pair<PackFile::TocEntry*, void*>& entry : entries)
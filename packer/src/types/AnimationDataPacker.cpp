@@ -18,9 +18,13 @@
 #include <assimp/Importer.hpp>
 #include <fstream>
 
+#include "../AnimationCompressor.h"
 #include "StaticMeshDataPacker.h"
 
 REGISTER_TOKEN(ANIM_NAME);
+REGISTER_TOKEN(COMPRESS);
+REGISTER_TOKEN(ERROR_TOLERANCE);
+REGISTER_TOKEN(SAMPLE_RATE);
 
 static void GetAnimationData(aiAnimation* animation, OUT Siege::AnimationData& anim)
 {
@@ -67,6 +71,44 @@ static void GetAnimationData(aiAnimation* animation, OUT Siege::AnimationData& a
     }
 }
 
+/**
+ * Finds the distance from each node to its furthest descendant in the scene's rest pose. Leaf
+ * nodes use their distance from their parent, as their bone extends about that far beyond them
+ * @param node - the node to measure the reach of
+ * @param parentTransform - the world transform of the node's parent
+ * @param reaches - filled with the reach of the node and its descendants, by node name
+ * @param descendants - appended with the world positions of the node and its descendants
+ */
+static void GetBoneReaches(const aiNode* node,
+                           const aiMatrix4x4& parentTransform,
+                           OUT std::map<Siege::String, float>& reaches,
+                           OUT std::vector<aiVector3D>& descendants)
+{
+    aiMatrix4x4 transform = parentTransform * node->mTransformation;
+    aiVector3D position {transform.a4, transform.b4, transform.c4};
+
+    std::vector<aiVector3D> childPositions;
+    for (uint32_t i = 0; i < node->mNumChildren; i++)
+    {
+        GetBoneReaches(node->mChildren[i], transform, reaches, childPositions);
+    }
+
+    float reach = 0.f;
+    for (const aiVector3D& childPosition : childPositions)
+    {
+        reach = std::max(reach, (childPosition - position).Length());
+    }
+    if (childPositions.empty())
+    {
+        const aiMatrix4x4& local = node->mTransformation;
+        reach = aiVector3D {local.a4, local.b4, local.c4}.Length();
+    }
+    if (reach > 0.f) reaches[node->mName.C_Str()] = reach;
+
+    descendants.push_back(position);
+    descendants.insert(descendants.end(), childPositions.begin(), childPositions.end());
+}
+
 Siege::PackFileData* PackAnimationFile(const Siege::String& filePath,
                                        const Siege::String& assetsPath)
 {
@@ -130,6 +172,51 @@ Siege::PackFileData* PackAnimationFile(const Siege::String& filePath,
     Siege::AnimationData animData;
     GetAnimationData(animation, animData);
 
+    auto compressIt = attributes.find(TOKEN_COMPRESS);
+    if (compressIt != attributes.end() && compressIt->second == "true")
+    {
+        float tolerance = ANIMATION_COMPRESSOR_DEFAULT_TOLERANCE;
+        auto toleranceIt = attributes.find(TOKEN_ERROR_TOLERANCE);
+        if (toleranceIt != attributes.end() &&
+            (!toleranceIt->second.GetFloat(tolerance) || tolerance < 0.f))
+        {
+            CC_LOG_WARNING("ERROR_TOLERANCE in .ska file at path \"{}\" must not be negative",
+                           filePath)
+            return nullptr;
+        }
+
+        float sampleRate = ANIMATION_COMPRESSOR_DEFAULT_SAMPLE_RATE;
+        auto sampleRateIt = attributes.find(TOKEN_SAMPLE_RATE);
+        if (sampleRateIt != attributes.end() &&
+            (!sampleRateIt->second.GetFloat(sampleRate) || sampleRate <= 0.f))
+        {
+            CC_LOG_WARNING("SAMPLE_RATE in .ska file at path \"{}\" must be positive", filePath)
+            return nullptr;
+        }
+
+        std::map<Siege::String, float> boneReaches;
+        std::vector<aiVector3D> bonePositions;
+        GetBoneReaches(scene->mRootNode, aiMatrix4x4 {}, boneReaches, bonePositions);
+
+        AnimationCompressionReport report;
+        if (CompressAnimation(animData, boneReaches, tolerance, sampleRate, report))
+        {
+            CC_LOG_INFO("Compressed animation \"{}\" by a ratio of {} with a maximum error of {} "
+                        "at channel \"{}\"",
+                        nameIt->second,
+                        report.compressionRatio,
+                        report.maxError,
+                        report.maxErrorChannel)
+        }
+        else
+        {
+            CC_LOG_WARNING("Animation \"{}\" has too many frames to compress at {} frames per "
+                           "second, packing it uncompressed",
+                           nameIt->second,
+                           sampleRate)
+        }
+    }
+
     Siege::BinarySerialisation::Buffer dataBuffer;
     Siege::BinarySerialisation::serialise(dataBuffer,
                                           animData,
@@ -0,0 +1,278 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#include "FontDataPacker.h"
+
+#include <freetype/freetype.h>
+#include <freetype/ftmodapi.h>
+#include <resources/FontData.h>
+#include <utils/BinarySerialisation.h>
+#include <utils/Defer.h>
+#include <utils/FileSystem.h>
+#include <utils/Logging.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "StaticMeshDataPacker.h"
+
+REGISTER_TOKEN(GLYPH_SIZE);
+REGISTER_TOKEN(DISTANCE_RANGE);
+
+// The printable ASCII range, which is all the runtime font currently draws
+static constexpr uint32_t FIRST_CODEPOINT = 32;
+static constexpr uint32_t LAST_CODEPOINT = 126;
+
+struct GlyphBitmap
+{
+    Siege::FontGlyph glyph;
+    uint32_t width {0};
+    uint32_t height {0};
+    std::vector<uint8_t> pixels;
+};
+
+static bool GetIntAttribute(const std::map<Siege::Token, Siege::String>& attributes,
+                            Siege::Token token,
+                            int32_t minValue,
+                            OUT int32_t& value)
+{
+    auto it = attributes.find(token);
+    if (it == attributes.end()) return true;
+    return it->second.GetInt(value) && value >= minValue;
+}
+
+static bool RenderGlyph(FT_Face face, uint32_t codepoint, float glyphSize, OUT GlyphBitmap& bitmap)
+{
+    if (FT_Load_Char(face, codepoint, FT_LOAD_DEFAULT)) return false;
+
+    FT_GlyphSlot slot = face->glyph;
+    bitmap.glyph.codepoint = codepoint;
+    bitmap.glyph.advance = static_cast<float>(slot->advance.x) / 64.f / glyphSize;
+
+    // Whitespace has no outline to render, so only needs its advance
+    if (slot->outline.n_points == 0) return true;
+    if (FT_Render_Glyph(slot, FT_RENDER_MODE_SDF)) return false;
+
+    // The rendered bitmap is already padded by the field's spread, which the bearings account for
+    const FT_Bitmap& source = slot->bitmap;
+    bitmap.width = source.width;
+    bitmap.height = source.rows;
+    bitmap.pixels.resize(bitmap.width * bitmap.height);
+    for (uint32_t row = 0; row < bitmap.height; row++)
+    {
+        std::copy_n(source.buffer + row * source.pitch,
+                    bitmap.width,
+                    bitmap.pixels.data() + row * bitmap.width);
+    }
+
+    bitmap.glyph.width = static_cast<float>(bitmap.width) / glyphSize;
+    bitmap.glyph.height = static_cast<float>(bitmap.height) / glyphSize;
+    bitmap.glyph.bearingX = static_cast<float>(slot->bitmap_left) / glyphSize;
+    bitmap.glyph.bearingY = static_cast<float>(slot->bitmap_top) / glyphSize;
+    return true;
+}
+
+static uint32_t PackShelves(std::vector<GlyphBitmap>& bitmaps,
+                            const std::vector<size_t>& order,
+                            uint32_t width)
+{
+    uint32_t x {0}, y {0}, shelfHeight {0};
+    for (size_t index : order)
+    {
+        GlyphBitmap& bitmap = bitmaps[index];
+        if (bitmap.width == 0) continue;
+
+        uint32_t paddedWidth = bitmap.width + FONT_PACKER_GLYPH_GUTTER;
+        if (x + paddedWidth > width)
+        {
+            x = 0;
+            y += shelfHeight;
+            shelfHeight = 0;
+        }
+
+        bitmap.glyph.atlasX = static_cast<float>(x + FONT_PACKER_GLYPH_GUTTER);
+        bitmap.glyph.atlasY = static_cast<float>(y + FONT_PACKER_GLYPH_GUTTER);
+        bitmap.glyph.atlasWidth = static_cast<float>(bitmap.width);
+        bitmap.glyph.atlasHeight = static_cast<float>(bitmap.height);
+
+        x += paddedWidth;
+        shelfHeight = std::max(shelfHeight, bitmap.height + FONT_PACKER_GLYPH_GUTTER);
+    }
+    return y + shelfHeight + FONT_PACKER_GLYPH_GUTTER;
+}
+
+static void PackAtlas(std::vector<GlyphBitmap>& bitmaps, OUT Siege::FontData& fontData)
+{
+    // Packing the tallest glyphs first keeps the wasted space at the top of each shelf small
+    std::vector<size_t> order(bitmaps.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&bitmaps](size_t left, size_t right) {
+        return bitmaps[left].height > bitmaps[right].height;
+    });
+
+    uint64_t area {0};
+    for (const GlyphBitmap& bitmap : bitmaps)
+    {
+        area += static_cast<uint64_t>(bitmap.width + FONT_PACKER_GLYPH_GUTTER) *
+                (bitmap.height + FONT_PACKER_GLYPH_GUTTER);
+    }
+
+    // Widen a power of two atlas until the glyphs fit within a square
+    uint32_t width {64};
+    while (static_cast<uint64_t>(width) * width < area) width *= 2;
+    uint32_t height = PackShelves(bitmaps, order, width);
+    while (height > width)
+    {
+        width *= 2;
+        height = PackShelves(bitmaps, order, width);
+    }
+
+    fontData.atlas.width = static_cast<int32_t>(width);
+    fontData.atlas.height = static_cast<int32_t>(height);
+    fontData.pixels.assign(static_cast<size_t>(width) * height, 0);
+    for (const GlyphBitmap& bitmap : bitmaps)
+    {
+        uint32_t atlasX = static_cast<uint32_t>(bitmap.glyph.atlasX);
+        uint32_t atlasY = static_cast<uint32_t>(bitmap.glyph.atlasY);
+        for (uint32_t row = 0; row < bitmap.height; row++)
+        {
+            std::copy_n(bitmap.pixels.data() + row * bitmap.width,
+                        bitmap.width,
+                        fontData.pixels.data() + (atlasY + row) * width + atlasX);
+        }
+        fontData.glyphs.push_back(bitmap.glyph);
+    }
+}
+
+static void GetKerningPairs(FT_Face face, OUT Siege::FontData& fontData)
+{
+    if (!FT_HAS_KERNING(face)) return;
+
+    float unitsPerEm = static_cast<float>(face->units_per_EM);
+    for (uint32_t left = FIRST_CODEPOINT; left <= LAST_CODEPOINT; left++)
+    {
+        FT_UInt leftIndex = FT_Get_Char_Index(face, left);
+        if (leftIndex == 0) continue;
+
+        for (uint32_t right = FIRST_CODEPOINT; right <= LAST_CODEPOINT; right++)
+        {
+            FT_UInt rightIndex = FT_Get_Char_Index(face, right);
+            FT_Vector kerning;
+            if (rightIndex == 0 ||
+                FT_Get_Kerning(face, leftIndex, rightIndex, FT_KERNING_UNSCALED, &kerning) ||
+                kerning.x == 0)
+            {
+                continue;
+            }
+            fontData.kerning.push_back({left, right, static_cast<float>(kerning.x) / unitsPerEm});
+        }
+    }
+}
+
+Siege::PackFileData* PackFontFile(const Siege::String& filePath,
+                                  const Siege::String& assetsPath,
+                                  bool inPlace)
+{
+    Siege::String contents = Siege::FileSystem::Read(filePath);
+    std::map<Siege::Token, Siege::String> attributes =
+        Siege::FileSystem::ParseAttributeFileData(contents);
+
+    if (attributes.empty())
+    {
+        CC_LOG_WARNING("Received empty font file at path \"{}\"", filePath)
+        return nullptr;
+    }
+
+    auto it = attributes.find(TOKEN_SOURCE_PATH);
+    if (it == attributes.end())
+    {
+        CC_LOG_WARNING("Failed to find SOURCE_PATH attribute in .font file at path \"{}\"",
+                       filePath)
+        return nullptr;
+    }
+
+    int32_t glyphSize = FONT_PACKER_DEFAULT_GLYPH_SIZE;
+    if (!GetIntAttribute(attributes, TOKEN_GLYPH_SIZE, 1, glyphSize))
+    {
+        CC_LOG_WARNING("GLYPH_SIZE in .font file at path \"{}\" must be a positive integer",
+                       filePath)
+        return nullptr;
+    }
+
+    // FreeType only renders distance fields with spreads between 2 and 32 texels
+    int32_t distanceRange = FONT_PACKER_DEFAULT_DISTANCE_RANGE;
+    if (!GetIntAttribute(attributes, TOKEN_DISTANCE_RANGE, 2, distanceRange) ||
+        distanceRange > 32)
+    {
+        CC_LOG_WARNING("DISTANCE_RANGE in .font file at path \"{}\" must be between 2 and 32",
+                       filePath)
+        return nullptr;
+    }
+
+    FT_Library library;
+    if (FT_Init_FreeType(&library))
+    {
+        CC_LOG_WARNING("Failed to initialise FreeType for font at path \"{}\"", filePath)
+        return nullptr;
+    }
+    defer([library] { FT_Done_FreeType(library); });
+
+    Siege::String fontPath = assetsPath + '/' + it->second;
+    FT_Face face;
+    if (FT_New_Face(library, fontPath, 0, &face))
+    {
+        CC_LOG_WARNING("Failed to read font file at path \"{}\"", fontPath)
+        return nullptr;
+    }
+    defer([face] { FT_Done_Face(face); });
+
+    FT_Property_Set(library, "sdf", "spread", &distanceRange);
+    FT_Set_Pixel_Sizes(face, 0, glyphSize);
+
+    CC_LOG_INFO("Baking font \"{}\" at {} texels per em with a distance range of {}",
+                fontPath,
+                glyphSize,
+                distanceRange)
+
+    std::vector<GlyphBitmap> bitmaps;
+    for (uint32_t codepoint = FIRST_CODEPOINT; codepoint <= LAST_CODEPOINT; codepoint++)
+    {
+        if (FT_Get_Char_Index(face, codepoint) == 0) continue;
+
+        GlyphBitmap& bitmap = bitmaps.emplace_back();
+        if (!RenderGlyph(face, codepoint, static_cast<float>(glyphSize), bitmap))
+        {
+            CC_LOG_WARNING("Failed to render glyph {} of font at path \"{}\"", codepoint, fontPath)
+            bitmaps.pop_back();
+        }
+    }
+
+    Siege::FontData fontData;
+    fontData.atlas.glyphSize = static_cast<float>(glyphSize);
+    fontData.atlas.distanceRange = static_cast<float>(distanceRange);
+    PackAtlas(bitmaps, fontData);
+    GetKerningPairs(face, fontData);
+
+    CC_LOG_INFO("Packed {} glyphs and {} kerning pairs into a {} by {} atlas",
+                fontData.glyphs.size(),
+                fontData.kerning.size(),
+                fontData.atlas.width,
+                fontData.atlas.height)
+
+    if (inPlace) return Siege::InPlace::Write(fontData);
+
+    Siege::BinarySerialisation::Buffer dataBuffer;
+    Siege::BinarySerialisation::serialise(dataBuffer,
+                                          fontData,
+                                          Siege::BinarySerialisation::SERIALISE);
+
+    char* data = reinterpret_cast<char*>(dataBuffer.data.data());
+    return Siege::PackFileData::Create(data, dataBuffer.data.size());
+}
@@ -0,0 +1,34 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#ifndef SIEGE_ENGINE_FONTDATAPACKER_H
+#define SIEGE_ENGINE_FONTDATAPACKER_H
+
+#include <resources/PackFile.h>
+
+// The size of the em square glyphs are rasterised at when a font file does not specify one
+#define FONT_PACKER_DEFAULT_GLYPH_SIZE 48
+// The distance in texels the field spans either side of an edge when a font file does not specify
+#define FONT_PACKER_DEFAULT_DISTANCE_RANGE 6
+// The empty texels left between glyphs so that filtering never samples a neighbouring glyph
+#define FONT_PACKER_GLYPH_GUTTER 1
+
+/**
+ * Bakes the printable ASCII range of a TrueType font into a signed distance field atlas, along
+ * with the metrics and kerning of each glyph
+ * @param filePath - the path of the .font file describing the font to bake
+ * @param assetsPath - the directory the font's source path is relative to
+ * @param inPlace - whether to write the font as an in-place record
+ * @return the packed font data, or nullptr if the font could not be baked
+ */
+Siege::PackFileData* PackFontFile(const Siege::String& filePath,
+                                  const Siege::String& assetsPath,
+                                  bool inPlace = false);
+
+#endif // SIEGE_ENGINE_FONTDATAPACKER_H
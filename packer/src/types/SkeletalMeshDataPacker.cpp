@@ -128,7 +128,8 @@ static aiMesh* FindMeshAtPath(const aiScene* scene,
 }
 
 Siege::PackFileData* PackSkeletalMeshFile(const Siege::String& filePath,
-                                          const Siege::String& assetsPath)
+                                          const Siege::String& assetsPath,
+                                          bool inPlace)
 {
     Siege::String contents = Siege::FileSystem::Read(filePath);
     std::map<Siege::Token, Siege::String> attributes =
@@ -219,6 +220,21 @@ Siege::PackFileData* PackSkeletalMeshFile(const Siege::String& filePath,
     Siege::SkeletalMeshData skeletalMeshData;
     GetMeshData(scene, mesh, baseXform, skeletalMeshData);
 
+    // Quantised vertices only have an in-place layout, so they are always packed as a record
+    auto quantiseIt = attributes.find(TOKEN_QUANTISE);
+    if (quantiseIt != attributes.end() && quantiseIt->second == "true")
+    {
+        if (skeletalMeshData.bones.size() <= UINT8_MAX + 1)
+        {
+            return Siege::InPlace::WriteQuantised(skeletalMeshData);
+        }
+        CC_LOG_WARNING("Skeletal mesh \"{}\" has too many bones to quantise, packing at full "
+                       "precision",
+                       filePath)
+    }
+
+    if (inPlace) return Siege::InPlace::Write(skeletalMeshData);
+
     Siege::BinarySerialisation::Buffer dataBuffer;
     Siege::BinarySerialisation::serialise(dataBuffer,
                                           skeletalMeshData,
@@ -12,6 +12,7 @@
 #include <resources/PackFile.h>
 
 Siege::PackFileData* PackSkeletalMeshFile(const Siege::String& filePath,
-                                          const Siege::String& assetsPath);
+                                          const Siege::String& assetsPath,
+                                          bool inPlace = false);
 
 #endif // SIEGE_ENGINE_SKELETALMESHDATAPACKER_H
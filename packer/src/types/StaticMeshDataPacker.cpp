@@ -21,8 +21,15 @@
 #include <assimp/Importer.hpp>
 #include <fstream>
 
+#include "../MeshOptimiser.h"
 #include "../PackerUtils.h"
 
+// The fraction of the previous LOD's triangles each LOD aims to keep by default
+#define LOD_DEFAULT_RATIO 0.5f
+
+// LODs keeping more than this fraction of the previous LOD's triangles aren't worth drawing
+#define LOD_MIN_REDUCTION 0.9f
+
 enum RequestPathStage
 {
     PARENT,
@@ -58,6 +65,8 @@ static void GetMeshData(const aiScene* scene,
                         OUT std::vector<Siege::BaseVertex>& vertices,
                         OUT std::vector<uint32_t>& indices)
 {
+    // Each mesh's indices are relative to its own vertices, which follow the previous meshes'
+    const uint32_t indexOffset = vertices.size();
     for (uint32_t i = 0; i < mesh->mNumVertices; i++)
     {
         Siege::BaseVertex vertex {};
@@ -80,8 +89,6 @@ static void GetMeshData(const aiScene* scene,
         vertices.push_back(vertex);
     }
 
-    const auto it = std::max_element(indices.begin(), indices.end());
-    const uint32_t indexOffset = it != indices.end() ? *it + 1 : 0;
     for (uint32_t i = 0; i < mesh->mNumFaces; i++)
     {
         const aiFace face = mesh->mFaces[i];
@@ -142,8 +149,104 @@ static void GetMeshesForNode(const aiScene* scene,
     }
 };
 
+static void OptimiseMesh(const Siege::String& filePath, OUT Siege::StaticMeshData& meshData)
+{
+    uint32_t vertexCount = meshData.vertices.size();
+    float acmr = CalculateAcmr(meshData.indices, vertexCount);
+
+    WeldVertices(meshData.vertices, meshData.indices);
+
+    std::vector<uint32_t> clusters;
+    OptimiseVertexCache(meshData.indices, meshData.vertices.size(), clusters);
+
+    std::vector<float> positions;
+    positions.reserve(meshData.vertices.size() * 3);
+    for (const Siege::BaseVertex& vertex : meshData.vertices)
+    {
+        const Siege::Vec3& position = vertex.position;
+        positions.insert(positions.end(), {position.x, position.y, position.z});
+    }
+    OptimiseOverdraw(meshData.indices, positions, clusters);
+
+    OptimiseVertexFetch(meshData.vertices, meshData.indices);
+
+    CC_LOG_INFO("Optimised static mesh {}: vertices {} -> {}, ACMR {} -> {}",
+                filePath,
+                vertexCount,
+                meshData.vertices.size(),
+                acmr,
+                CalculateAcmr(meshData.indices, meshData.vertices.size()))
+}
+
+static void GenerateLods(const Siege::String& filePath,
+                         uint32_t lodCount,
+                         float ratio,
+                         bool optimise,
+                         OUT Siege::StaticMeshData& meshData)
+{
+    Siege::StaticMeshDataView view;
+    Siege::InPlace::View(meshData, view);
+
+    Siege::Vec3 centre;
+    float radius;
+    Siege::CalculateBoundingSphere(view, centre, radius);
+    if (radius <= 0.f) return;
+
+    std::vector<float> positions;
+    std::vector<float> normals;
+    positions.reserve(meshData.vertices.size() * 3);
+    normals.reserve(meshData.vertices.size() * 3);
+    for (const Siege::BaseVertex& vertex : meshData.vertices)
+    {
+        const Siege::Vec3& position = vertex.position;
+        const Siege::Vec3& normal = vertex.normal;
+        positions.insert(positions.end(), {position.x, position.y, position.z});
+        normals.insert(normals.end(), {normal.x, normal.y, normal.z});
+    }
+
+    // Every LOD is simplified from the full detail mesh so that its error is measured against it
+    std::vector<uint32_t> baseIndices = meshData.indices;
+    size_t previousIndexCount = baseIndices.size();
+    float lodError = 0.f;
+    float targetRatio = 1.f;
+    for (uint32_t i = 0; i < lodCount; i++)
+    {
+        targetRatio *= ratio;
+        size_t targetIndexCount = static_cast<size_t>(baseIndices.size() / 3 * targetRatio) * 3;
+
+        float error;
+        std::vector<uint32_t> lodIndices =
+            SimplifyMesh(baseIndices, positions, normals, targetIndexCount, error);
+        if (lodIndices.empty() || lodIndices.size() > previousIndexCount * LOD_MIN_REDUCTION)
+        {
+            CC_LOG_INFO("Static mesh {} cannot be simplified past LOD {}", filePath, i)
+            break;
+        }
+
+        if (optimise)
+        {
+            std::vector<uint32_t> clusters;
+            OptimiseVertexCache(lodIndices, meshData.vertices.size(), clusters);
+        }
+
+        lodError = std::max(lodError, error / radius);
+        meshData.lods.push_back({static_cast<uint32_t>(meshData.indices.size()),
+                                 static_cast<uint32_t>(lodIndices.size()),
+                                 lodError});
+        meshData.indices.insert(meshData.indices.end(), lodIndices.begin(), lodIndices.end());
+        previousIndexCount = lodIndices.size();
+
+        CC_LOG_INFO("Generated LOD {} for static mesh {}: {} triangles, error {}",
+                    i + 1,
+                    filePath,
+                    lodIndices.size() / 3,
+                    lodError)
+    }
+}
+
 Siege::PackFileData* PackStaticMeshFile(const Siege::String& filePath,
-                                        const Siege::String& assetsPath)
+                                        const Siege::String& assetsPath,
+                                        bool inPlace)
 {
     Siege::String contents = Siege::FileSystem::Read(filePath);
     std::map<Siege::Token, Siege::String> attributes =
@@ -220,6 +323,44 @@ Siege::PackFileData* PackStaticMeshFile(const Siege::String& filePath,
                      staticMeshData.vertices,
                      staticMeshData.indices);
 
+    auto optimiseIt = attributes.find(TOKEN_OPTIMISE);
+    bool optimise = optimiseIt != attributes.end() && optimiseIt->second == "true";
+    if (optimise) OptimiseMesh(filePath, staticMeshData);
+
+    int lodCount = 0;
+    auto lodCountIt = attributes.find(TOKEN_LOD_COUNT);
+    if (lodCountIt != attributes.end() && (!lodCountIt->second.GetInt(lodCount) || lodCount < 0))
+    {
+        CC_LOG_WARNING("Found invalid LOD_COUNT attribute in .sm file at path \"{}\"", filePath)
+        lodCount = 0;
+    }
+
+    float lodRatio = LOD_DEFAULT_RATIO;
+    auto lodRatioIt = attributes.find(TOKEN_LOD_RATIO);
+    if (lodRatioIt != attributes.end() &&
+        (!lodRatioIt->second.GetFloat(lodRatio) || lodRatio <= 0.f || lodRatio >= 1.f))
+    {
+        CC_LOG_WARNING("Found invalid LOD_RATIO attribute in .sm file at path \"{}\"", filePath)
+        lodRatio = LOD_DEFAULT_RATIO;
+    }
+
+    if (lodCount > 0) GenerateLods(filePath, lodCount, lodRatio, optimise, staticMeshData);
+
+    // Compact vertex and index formats and LODs only have an in-place layout, so quantised meshes
+    // and meshes with LODs are always packed as a record, and records use 16-bit indices wherever
+    // the mesh allows
+    Siege::IndexFormat indexFormat = Siege::SelectIndexFormat(staticMeshData.vertices.size());
+    auto quantiseIt = attributes.find(TOKEN_QUANTISE);
+    if (quantiseIt != attributes.end() && quantiseIt->second == "true")
+    {
+        return Siege::InPlace::Write(staticMeshData, Siege::VERTEX_FORMAT_QUANTISED, indexFormat);
+    }
+
+    if (inPlace || !staticMeshData.lods.empty())
+    {
+        return Siege::InPlace::Write(staticMeshData, Siege::VERTEX_FORMAT_FULL, indexFormat);
+    }
+
     Siege::BinarySerialisation::Buffer dataBuffer;
     Siege::BinarySerialisation::serialise(dataBuffer,
                                           staticMeshData,
@@ -16,8 +16,13 @@
 REGISTER_TOKEN(SOURCE_PATH);
 REGISTER_TOKEN(NODE_PATH);
 REGISTER_TOKEN(FLIP_AXES);
+REGISTER_TOKEN(OPTIMISE);
+REGISTER_TOKEN(QUANTISE);
+REGISTER_TOKEN(LOD_COUNT);
+REGISTER_TOKEN(LOD_RATIO);
 
 Siege::PackFileData* PackStaticMeshFile(const Siege::String& filePath,
-                                        const Siege::String& assetsPath);
+                                        const Siege::String& assetsPath,
+                                        bool inPlace = false);
 
 #endif // SIEGE_ENGINE_STATICMESHDATAPACKER_H
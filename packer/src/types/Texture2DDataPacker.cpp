@@ -18,8 +18,26 @@
 #include <utils/Logging.h>
 
 #include <algorithm>
+#include <filesystem>
 
-Siege::PackFileData* PackTexture2DFile(const Siege::String& filePath)
+#include "../TextureCompressor.h"
+
+static Siege::Texture2DFormat GetTextureFormat(const Siege::String& filePath)
+{
+    // Block compression is requested by a suffix on the texture's name, as in "rock.bc7.png"
+    Siege::String suffix =
+        std::filesystem::path(filePath.Str()).stem().extension().string().c_str();
+    if (suffix == ".bc1") return Siege::TEXTURE2D_FORMAT_BC1;
+    if (suffix == ".bc3") return Siege::TEXTURE2D_FORMAT_BC3;
+    if (suffix == ".bc4") return Siege::TEXTURE2D_FORMAT_BC4;
+    if (suffix == ".bc5") return Siege::TEXTURE2D_FORMAT_BC5;
+    if (suffix == ".bc7") return Siege::TEXTURE2D_FORMAT_BC7;
+    return Siege::TEXTURE2D_FORMAT_RGBA8;
+}
+
+Siege::PackFileData* PackTexture2DFile(const Siege::String& filePath,
+                                       bool inPlace,
+                                       MipFilter mipFilter)
 {
     int32_t texWidth, texHeight, texChannels;
     stbi_uc* pixels = stbi_load(filePath, &texWidth, &texHeight, &texChannels, STBI_rgb_alpha);
@@ -37,6 +55,33 @@ Siege::PackFileData* PackTexture2DFile(const Siege::String& filePath)
     texture2dData.texChannels = TEXTURE2D_TEXTURE_CHANNELS;
     std::copy_n(pixels, texture2dData.GetImageSize(), std::back_inserter(texture2dData.pixels));
 
+    Siege::Texture2DFormat format = GetTextureFormat(filePath);
+    GenerateMipChain(texture2dData.pixels,
+                     texture2dData.texWidth,
+                     texture2dData.texHeight,
+                     texture2dData.texChannels,
+                     mipFilter,
+                     Siege::IsTexture2DFormatSrgb(format));
+
+    if (format != Siege::TEXTURE2D_FORMAT_RGBA8)
+    {
+        TextureCompressionReport report;
+        texture2dData.pixels = CompressTexture(texture2dData.pixels,
+                                               texture2dData.texWidth,
+                                               texture2dData.texHeight,
+                                               texture2dData.GetMipLevelCount(),
+                                               format,
+                                               report);
+        texture2dData.format = format;
+
+        CC_LOG_INFO("Block compressed texture to {} bytes at {} dB PSNR, {} megatexels/s",
+                    texture2dData.pixels.size(),
+                    report.psnr,
+                    report.megatexelsPerSecond)
+    }
+
+    if (inPlace) return Siege::InPlace::Write(texture2dData);
+
     Siege::BinarySerialisation::Buffer dataBuffer;
     Siege::BinarySerialisation::serialise(dataBuffer,
                                           texture2dData,
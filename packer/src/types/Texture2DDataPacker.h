@@ -12,6 +12,10 @@
 
 #include <resources/PackFile.h>
 
-Siege::PackFileData* PackTexture2DFile(const Siege::String& filePath);
+#include "../MipGenerator.h"
+
+Siege::PackFileData* PackTexture2DFile(const Siege::String& filePath,
+                                       bool inPlace = false,
+                                       MipFilter mipFilter = MIP_FILTER_NONE);
 
 #endif // SIEGE_ENGINE_TEXTURE2DDATAPACKER_H
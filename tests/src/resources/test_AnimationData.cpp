@@ -0,0 +1,55 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#include <resources/AnimationData.h>
+#include <utest.h>
+
+using namespace Siege;
+
+UTEST(test_AnimationData, SerialiseAndDecompressChannel)
+{
+    AnimCompressedChannel channel;
+    channel.positions.rangeMin = {-1.f, 0.f, 2.f};
+    channel.positions.rangeExtent = {2.f, 1.f, 1.f};
+    channel.positions.keys = {{0, {0, 65535, 0}}, {12, {65535, 0, 0}}};
+
+    AnimCompressedKey rotationKey {3};
+    Quantisation::SmallestThreeEncode({0.f, 0.70710678f, 0.f, 0.70710678f}, rotationKey.value);
+    channel.rotations.keys = {rotationKey};
+
+    AnimationData data {};
+    data.length = 24.0;
+    data.speed = 24.0;
+    data.frameDuration = 2.0;
+    data.compressedChannels["root"] = channel;
+
+    BinarySerialisation::Buffer buffer;
+    AnimationData deserialised {};
+    BinarySerialisation::serialise(buffer, data, BinarySerialisation::SERIALISE);
+    BinarySerialisation::serialise(buffer, deserialised, BinarySerialisation::DESERIALISE);
+    ASSERT_EQ(2.0, deserialised.frameDuration);
+    ASSERT_EQ(1u, deserialised.compressedChannels.size());
+
+    AnimationChannel decompressed;
+    DecompressAnimationChannel(deserialised.compressedChannels["root"],
+                               deserialised.frameDuration,
+                               decompressed);
+    ASSERT_EQ(2u, decompressed.positionKeys.size());
+    ASSERT_EQ(24.0, decompressed.positionKeys[1].timestamp);
+    ASSERT_EQ(-1.f, decompressed.positionKeys[0].position.x);
+    ASSERT_EQ(1.f, decompressed.positionKeys[0].position.y);
+    ASSERT_EQ(1.f, decompressed.positionKeys[1].position.x);
+    ASSERT_EQ(2.f, decompressed.positionKeys[1].position.z);
+
+    ASSERT_EQ(1u, decompressed.rotationKeys.size());
+    ASSERT_EQ(6.0, decompressed.rotationKeys[0].timestamp);
+    ASSERT_NEAR(0.70710678f, decompressed.rotationKeys[0].rotation.y, 1e-4f);
+    ASSERT_NEAR(0.70710678f, decompressed.rotationKeys[0].rotation.w, 1e-4f);
+    ASSERT_TRUE(decompressed.scaleKeys.empty());
+}
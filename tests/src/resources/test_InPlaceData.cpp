@@ -0,0 +1,382 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#include <resources/FontData.h>
+#include <resources/InPlaceData.h>
+#include <resources/SkeletalMeshData.h>
+#include <resources/StaticMeshData.h>
+#include <resources/Texture2DData.h>
+#include <utest.h>
+
+#include <memory>
+
+using namespace Siege;
+
+static StaticMeshData CreateStaticMeshData()
+{
+    StaticMeshData data;
+    data.indices = {0, 1, 2, 2, 3, 0};
+    data.vertices = {{{-1.f, -1.f, 0.f}, {1.f, 0.f, 0.f, 1.f}, {0.f, 0.f, 1.f}, {0.f, 0.f}},
+                     {{1.f, -1.f, 0.f}, {0.f, 1.f, 0.f, 1.f}, {0.f, 0.f, 1.f}, {1.f, 0.f}},
+                     {{1.f, 1.f, 0.f}, {0.f, 0.f, 1.f, 1.f}, {0.f, 0.f, 1.f}, {1.f, 1.f}},
+                     {{-1.f, 1.f, 0.f}, {1.f, 1.f, 1.f, 1.f}, {0.f, 0.f, 1.f}, {0.f, 1.f}}};
+    return data;
+}
+
+UTEST(test_InPlaceData, WriteAndViewStaticMeshData)
+{
+    StaticMeshData data = CreateStaticMeshData();
+    std::shared_ptr<PackFileData> packFileData(InPlace::Write(data), free);
+    ASSERT_TRUE(InPlace::Record::IsRecord(*packFileData));
+
+    InPlace::Record record(*packFileData);
+    ASSERT_TRUE(record.IsValid());
+    ASSERT_EQ(2u, record.GetSectionCount());
+
+    StaticMeshDataView view;
+    ASSERT_TRUE(InPlace::Read(record, view));
+    ASSERT_EQ(data.indices.size(), view.indices.Size());
+    ASSERT_EQ(data.vertices.size(), view.vertices.Size());
+
+    // The view should point straight into the record memory at aligned offsets
+    const char* recordStart = reinterpret_cast<const char*>(packFileData.get());
+    const char* recordEnd = recordStart + packFileData->GetDataSize();
+    const char* verticesStart = reinterpret_cast<const char*>(view.vertices.Data());
+    ASSERT_TRUE(verticesStart > recordStart && verticesStart < recordEnd);
+    ASSERT_EQ(0u, (verticesStart - recordStart) % IN_PLACE_SECTION_ALIGNMENT);
+    ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(view.indices.Data()) % alignof(uint32_t));
+
+    for (size_t i = 0; i < data.indices.size(); i++) ASSERT_EQ(data.indices[i], view.indices[i]);
+    for (size_t i = 0; i < data.vertices.size(); i++)
+    {
+        ASSERT_TRUE(data.vertices[i] == view.vertices[i]);
+    }
+}
+
+UTEST(test_InPlaceData, WriteAndReadStaticMeshData)
+{
+    StaticMeshData data = CreateStaticMeshData();
+    std::shared_ptr<PackFileData> packFileData(InPlace::Write(data), free);
+
+    StaticMeshData readData;
+    ASSERT_TRUE(InPlace::Read(InPlace::Record(*packFileData), readData));
+    ASSERT_TRUE(data.indices == readData.indices);
+    ASSERT_TRUE(data.vertices == readData.vertices);
+}
+
+UTEST(test_InPlaceData, WriteAndReadQuantisedStaticMeshData)
+{
+    StaticMeshData data = CreateStaticMeshData();
+    std::shared_ptr<PackFileData> packFileData(
+        InPlace::Write(data, VERTEX_FORMAT_QUANTISED, INDEX_FORMAT_UINT32),
+        free);
+    InPlace::Record record(*packFileData);
+    ASSERT_EQ(3u, record.GetSectionCount());
+
+    StaticMeshDataView view;
+    ASSERT_TRUE(InPlace::Read(record, view));
+    ASSERT_EQ(VERTEX_FORMAT_QUANTISED, view.format.vertexFormat);
+    ASSERT_TRUE(view.vertices.Empty());
+    ASSERT_EQ(data.vertices.size(), view.quantisedVertices.Size());
+    ASSERT_EQ(20u, sizeof(QuantisedVertex));
+    ASSERT_EQ(-1.f, view.format.boundsMin.x);
+    ASSERT_EQ(2.f, view.format.boundsExtent.x);
+    ASSERT_EQ(65535, view.quantisedVertices[2].position[0]);
+
+    // Reading into owned data should decode back to within quantisation error
+    StaticMeshData readData;
+    ASSERT_TRUE(InPlace::Read(record, readData));
+    ASSERT_TRUE(data.indices == readData.indices);
+    ASSERT_EQ(data.vertices.size(), readData.vertices.size());
+    for (size_t i = 0; i < data.vertices.size(); i++)
+    {
+        const BaseVertex& expected = data.vertices[i];
+        const BaseVertex& actual = readData.vertices[i];
+        ASSERT_NEAR(expected.position.x, actual.position.x, 1e-4f);
+        ASSERT_NEAR(expected.position.y, actual.position.y, 1e-4f);
+        ASSERT_NEAR(expected.position.z, actual.position.z, 1e-4f);
+        ASSERT_NEAR(expected.normal.z, actual.normal.z, 1e-4f);
+        ASSERT_NEAR(expected.color.r, actual.color.r, 1e-2f);
+        ASSERT_EQ(expected.uv.x, actual.uv.x);
+        ASSERT_EQ(expected.uv.y, actual.uv.y);
+    }
+}
+
+UTEST(test_InPlaceData, WriteAndReadShortIndexStaticMeshData)
+{
+    ASSERT_EQ(INDEX_FORMAT_UINT16, SelectIndexFormat(4));
+    ASSERT_EQ(INDEX_FORMAT_UINT16, SelectIndexFormat(65536));
+    ASSERT_EQ(INDEX_FORMAT_UINT32, SelectIndexFormat(65537));
+
+    StaticMeshData data = CreateStaticMeshData();
+    std::shared_ptr<PackFileData> packFileData(
+        InPlace::Write(data, VERTEX_FORMAT_FULL, INDEX_FORMAT_UINT16),
+        free);
+    InPlace::Record record(*packFileData);
+    ASSERT_EQ(3u, record.GetSectionCount());
+
+    StaticMeshDataView view;
+    ASSERT_TRUE(InPlace::Read(record, view));
+    ASSERT_EQ(INDEX_FORMAT_UINT16, view.format.indexFormat);
+    ASSERT_TRUE(view.indices.Empty());
+    ASSERT_EQ(data.indices.size(), view.shortIndices.Size());
+    ASSERT_EQ(data.vertices.size(), view.vertices.Size());
+    for (size_t i = 0; i < data.indices.size(); i++)
+    {
+        ASSERT_EQ(data.indices[i], view.shortIndices[i]);
+    }
+
+    // Reading into owned data should widen the indices back to 32 bits
+    StaticMeshData readData;
+    ASSERT_TRUE(InPlace::Read(record, readData));
+    ASSERT_TRUE(data.indices == readData.indices);
+    ASSERT_TRUE(data.vertices == readData.vertices);
+}
+
+UTEST(test_InPlaceData, WriteAndReadStaticMeshLods)
+{
+    StaticMeshData data = CreateStaticMeshData();
+    data.indices.insert(data.indices.end(), {0, 1, 2});
+    data.lods = {{6, 3, 0.5f}};
+    std::shared_ptr<PackFileData> packFileData(
+        InPlace::Write(data, VERTEX_FORMAT_FULL, INDEX_FORMAT_UINT16),
+        free);
+    InPlace::Record record(*packFileData);
+    ASSERT_EQ(4u, record.GetSectionCount());
+
+    StaticMeshDataView view;
+    ASSERT_TRUE(InPlace::Read(record, view));
+    ASSERT_EQ(9u, view.shortIndices.Size());
+    ASSERT_EQ(1u, view.lods.Size());
+    ASSERT_EQ(6u, view.lods[0].indexOffset);
+    ASSERT_EQ(3u, view.lods[0].indexCount);
+    ASSERT_EQ(0.5f, view.lods[0].error);
+
+    StaticMeshData readData;
+    ASSERT_TRUE(InPlace::Read(record, readData));
+    ASSERT_TRUE(data.indices == readData.indices);
+    ASSERT_EQ(1u, readData.lods.size());
+    ASSERT_EQ(6u, readData.lods[0].indexOffset);
+
+    Vec3 centre;
+    float radius;
+    CalculateBoundingSphere(view, centre, radius);
+    ASSERT_EQ(0.f, centre.x);
+    ASSERT_EQ(0.f, centre.y);
+    ASSERT_NEAR(1.41421f, radius, 1e-5f);
+}
+
+UTEST(test_InPlaceData, SelectStaticMeshLods)
+{
+    MeshLod lods[] = {{0, 0, 0.01f}, {0, 0, 0.1f}};
+    Span<const MeshLod> lodSpan(lods, 2);
+
+    // Coarser LODs are picked as the projected error allows
+    ASSERT_EQ(0u, SelectMeshLod(lodSpan, 1.f, 0, 0.002f, 0.25f));
+    ASSERT_EQ(1u, SelectMeshLod(lodSpan, 0.1f, 0, 0.002f, 0.25f));
+    ASSERT_EQ(2u, SelectMeshLod(lodSpan, 0.01f, 0, 0.002f, 0.25f));
+    ASSERT_EQ(0u, SelectMeshLod({}, 0.01f, 0, 0.002f, 0.25f));
+
+    // Coarsening is held back within the hysteresis band, while refining is not
+    ASSERT_EQ(0u, SelectMeshLod(lodSpan, 0.19f, 0, 0.002f, 0.25f));
+    ASSERT_EQ(1u, SelectMeshLod(lodSpan, 0.19f, 1, 0.002f, 0.25f));
+    ASSERT_EQ(1u, SelectMeshLod(lodSpan, 0.14f, 0, 0.002f, 0.25f));
+    ASSERT_EQ(0u, SelectMeshLod(lodSpan, 0.21f, 1, 0.002f, 0.25f));
+    ASSERT_EQ(2u, SelectMeshLod(lodSpan, 0.019f, 2, 0.002f, 0.25f));
+    ASSERT_EQ(1u, SelectMeshLod(lodSpan, 0.019f, 1, 0.002f, 0.25f));
+}
+
+UTEST(test_InPlaceData, WriteAndViewTexture2DData)
+{
+    Texture2DData data;
+    data.texWidth = 3;
+    data.texHeight = 2;
+    for (uint32_t i = 0; i < data.GetImageSize(); i++) data.pixels.push_back(i);
+    std::shared_ptr<PackFileData> packFileData(InPlace::Write(data), free);
+
+    Texture2DDataView view;
+    ASSERT_TRUE(InPlace::Read(InPlace::Record(*packFileData), view));
+    ASSERT_EQ(3, view.texWidth);
+    ASSERT_EQ(2, view.texHeight);
+    ASSERT_EQ(TEXTURE2D_TEXTURE_CHANNELS, view.texChannels);
+    ASSERT_EQ(data.GetImageSize(), view.GetImageSize());
+    ASSERT_EQ(1u, view.GetMipLevelCount());
+    ASSERT_EQ(data.pixels.size(), view.pixels.Size());
+    ASSERT_EQ(0, memcmp(data.pixels.data(), view.pixels.Data(), view.pixels.SizeBytes()));
+}
+
+UTEST(test_InPlaceData, WriteAndViewTexture2DMipChain)
+{
+    Texture2DData data;
+    data.texWidth = 5;
+    data.texHeight = 3;
+    ASSERT_EQ(3u, GetTexture2DFullLevelCount(data.texWidth, data.texHeight));
+
+    // A base level of 5x3 followed by levels of 2x1 and 1x1
+    data.pixels.resize((15 + 2 + 1) * TEXTURE2D_TEXTURE_CHANNELS);
+    for (uint32_t i = 0; i < data.pixels.size(); i++) data.pixels[i] = i;
+    std::shared_ptr<PackFileData> packFileData(InPlace::Write(data), free);
+
+    Texture2DDataView view;
+    ASSERT_TRUE(InPlace::Read(InPlace::Record(*packFileData), view));
+    ASSERT_EQ(3u, view.GetMipLevelCount());
+    ASSERT_EQ(0u, view.GetMipLevelOffset(0));
+    ASSERT_EQ(60u, view.GetMipLevelOffset(1));
+    ASSERT_EQ(68u, view.GetMipLevelOffset(2));
+    ASSERT_EQ(60u, view.GetMipLevelSize(0));
+    ASSERT_EQ(8u, view.GetMipLevelSize(1));
+    ASSERT_EQ(4u, view.GetMipLevelSize(2));
+    ASSERT_EQ(view.GetImageSize(), view.GetMipLevelSize(0));
+
+    // Partial chains are kept, and pixels that do not fit a chain are treated as a single level
+    data.pixels.resize((15 + 2) * TEXTURE2D_TEXTURE_CHANNELS);
+    ASSERT_EQ(2u, data.GetMipLevelCount());
+    data.pixels.resize(data.pixels.size() + 1);
+    ASSERT_EQ(1u, data.GetMipLevelCount());
+}
+
+UTEST(test_InPlaceData, WriteAndViewBlockCompressedTexture2DData)
+{
+    Texture2DData data;
+    data.texWidth = 10;
+    data.texHeight = 6;
+    data.format = TEXTURE2D_FORMAT_BC1;
+    ASSERT_EQ(8u, GetTexture2DBlockSize(TEXTURE2D_FORMAT_BC4));
+    ASSERT_EQ(16u, GetTexture2DBlockSize(TEXTURE2D_FORMAT_BC7));
+    ASSERT_EQ(0u, GetTexture2DBlockSize(TEXTURE2D_FORMAT_RGBA8));
+
+    // Levels of 10x6, 5x3, 2x1 and 1x1 texels are padded out to 3x2, 2x1, 1x1 and 1x1 blocks
+    data.pixels.resize((6 + 2 + 1 + 1) * 8);
+    for (uint32_t i = 0; i < data.pixels.size(); i++) data.pixels[i] = i;
+    std::shared_ptr<PackFileData> packFileData(InPlace::Write(data), free);
+
+    Texture2DDataView view;
+    ASSERT_TRUE(InPlace::Read(InPlace::Record(*packFileData), view));
+    ASSERT_EQ(TEXTURE2D_FORMAT_BC1, view.format);
+    ASSERT_EQ(4u, view.GetMipLevelCount());
+    ASSERT_EQ(48u, view.GetImageSize());
+    ASSERT_EQ(48u, view.GetMipLevelOffset(1));
+    ASSERT_EQ(64u, view.GetMipLevelOffset(2));
+    ASSERT_EQ(72u, view.GetMipLevelOffset(3));
+    ASSERT_EQ(8u, view.GetMipLevelSize(3));
+
+    Texture2DData deserialised;
+    BinarySerialisation::Buffer buffer;
+    BinarySerialisation::serialise(buffer, data, BinarySerialisation::SERIALISE);
+    BinarySerialisation::serialise(buffer, deserialised, BinarySerialisation::DESERIALISE);
+    ASSERT_EQ(TEXTURE2D_FORMAT_BC1, deserialised.format);
+    ASSERT_EQ(data.pixels.size(), deserialised.pixels.size());
+}
+
+UTEST(test_InPlaceData, WriteAndViewFontData)
+{
+    FontData data;
+    data.atlas = {4, 2, 48.f, 6.f};
+    data.glyphs = {{'A', 0.f, 0.f, 2.f, 2.f, 1.125f, 1.125f, -0.125f, 1.f, 1.f},
+                   {'V', 2.f, 0.f, 2.f, 2.f, 1.125f, 1.125f, -0.125f, 1.f, 1.f}};
+    data.kerning = {{'A', 'V', -0.0625f}};
+    for (uint32_t i = 0; i < 8; i++) data.pixels.push_back(i * 32);
+    std::shared_ptr<PackFileData> packFileData(InPlace::Write(data), free);
+
+    FontDataView view;
+    ASSERT_TRUE(InPlace::Read(InPlace::Record(*packFileData), view));
+    ASSERT_EQ(4, view.atlas.width);
+    ASSERT_EQ(2, view.atlas.height);
+    ASSERT_EQ(6.f, view.atlas.distanceRange);
+    ASSERT_EQ(2u, view.glyphs.Size());
+    ASSERT_EQ(static_cast<uint32_t>('V'), view.glyphs[1].codepoint);
+    ASSERT_EQ(2.f, view.glyphs[1].atlasX);
+    ASSERT_EQ(1u, view.kerning.Size());
+    ASSERT_EQ(-0.0625f, view.kerning[0].offset);
+    ASSERT_EQ(0, memcmp(data.pixels.data(), view.pixels.Data(), view.pixels.SizeBytes()));
+
+    // Fonts packed without --in-place are serialised, and must read back the same
+    BinarySerialisation::Buffer buffer;
+    FontData deserialised;
+    BinarySerialisation::serialise(buffer, data, BinarySerialisation::SERIALISE);
+    BinarySerialisation::serialise(buffer, deserialised, BinarySerialisation::DESERIALISE);
+    ASSERT_EQ(48.f, deserialised.atlas.glyphSize);
+    ASSERT_EQ(2u, deserialised.glyphs.size());
+    ASSERT_EQ(-0.125f, deserialised.glyphs[0].bearingX);
+    ASSERT_EQ(static_cast<uint32_t>('V'), deserialised.kerning[0].right);
+    ASSERT_EQ(data.pixels, deserialised.pixels);
+}
+
+UTEST(test_InPlaceData, WriteAndViewSkeletalMeshData)
+{
+    SkeletalMeshData data;
+    data.indices = {0, 1, 2};
+    data.vertices.resize(3);
+    data.vertices[1].bones = {1.f, 0.f, 0.f, 0.f};
+    data.vertices[1].weights = {1.f, 0.f, 0.f, 0.f};
+    data.bones["root"] = {0, Mat4::Identity()};
+    data.bones["arm"] = {1, Mat4::Identity()};
+    std::shared_ptr<PackFileData> packFileData(InPlace::Write(data), free);
+
+    SkeletalMeshDataView view;
+    ASSERT_TRUE(InPlace::Read(InPlace::Record(*packFileData), view));
+    ASSERT_EQ(3u, view.indices.Size());
+    ASSERT_EQ(3u, view.vertices.Size());
+    ASSERT_TRUE(data.vertices[1] == view.vertices[1]);
+    ASSERT_EQ(2u, view.bones.size());
+    ASSERT_EQ(1u, view.bones.at("arm").id);
+}
+
+UTEST(test_InPlaceData, WriteAndReadQuantisedSkeletalMeshData)
+{
+    SkeletalMeshData data;
+    data.indices = {0, 1, 2};
+    data.vertices.resize(3);
+    data.vertices[1].position = {2.f, 4.f, 8.f};
+    data.vertices[1].bones = {3.f, 1.f, 0.f, 0.f};
+    data.vertices[1].weights = {0.7f, 0.3f, 0.f, 0.f};
+    data.bones["root"] = {0, Mat4::Identity()};
+    std::shared_ptr<PackFileData> packFileData(InPlace::WriteQuantised(data), free);
+
+    SkeletalMeshDataView view;
+    ASSERT_TRUE(InPlace::Read(InPlace::Record(*packFileData), view));
+    ASSERT_EQ(VERTEX_FORMAT_QUANTISED, view.format.vertexFormat);
+    ASSERT_EQ(28u, sizeof(QuantisedSkinnedVertex));
+    ASSERT_EQ(3u, view.quantisedVertices.Size());
+    ASSERT_EQ(3, view.quantisedVertices[1].bones[0]);
+    ASSERT_EQ(255, view.quantisedVertices[1].weights[0] + view.quantisedVertices[1].weights[1]);
+    ASSERT_EQ(1u, view.bones.size());
+
+    SkeletalMeshData readData;
+    ASSERT_TRUE(InPlace::Read(InPlace::Record(*packFileData), readData));
+    ASSERT_EQ(3u, readData.vertices.size());
+    ASSERT_NEAR(8.f, readData.vertices[1].position.z, 1e-3f);
+    ASSERT_EQ(1.f, readData.vertices[1].bones.y);
+    ASSERT_NEAR(0.7f, readData.vertices[1].weights.x, 1e-2f);
+}
+
+UTEST(test_InPlaceData, RejectMismatchedRecords)
+{
+    // Records for one type should not be readable as another
+    StaticMeshData data = CreateStaticMeshData();
+    std::shared_ptr<PackFileData> packFileData(InPlace::Write(data), free);
+
+    SkeletalMeshDataView skeletalView;
+    ASSERT_FALSE(InPlace::Read(InPlace::Record(*packFileData), skeletalView));
+
+    // Sections that run past the end of the data should invalidate the record
+    packFileData->dataSize = sizeof(InPlace::RecordHeader) + sizeof(InPlace::Section);
+    InPlace::Record truncatedRecord(*packFileData);
+    ASSERT_FALSE(truncatedRecord.IsValid());
+    StaticMeshDataView staticView;
+    ASSERT_FALSE(InPlace::Read(truncatedRecord, staticView));
+
+    // Serialised data should not be mistaken for an in-place record
+    BinarySerialisation::Buffer buffer;
+    BinarySerialisation::serialise(buffer, data, BinarySerialisation::SERIALISE);
+    std::shared_ptr<PackFileData> serialisedData(
+        PackFileData::Create(reinterpret_cast<char*>(buffer.data.data()), buffer.data.size()),
+        free);
+    ASSERT_FALSE(InPlace::Record::IsRecord(*serialisedData));
+}
@@ -17,12 +17,96 @@
 #include <resources/Texture2DData.h>
 #include <utest.h>
 
+#include <utils/FileSystem.h>
+
+#include <algorithm>
+#include <fstream>
+
 using namespace Siege;
 
 // Define test fixture
 struct test_ResourceSystem
 {};
 
+// Writes a version 2 pack file containing the given entries, where entries with no data are
+// written as removal markers. Bundles name the entries they span, which must be contiguous
+static void WritePackFile(const std::filesystem::path& packPath,
+                          const std::vector<std::pair<String, String>>& entries,
+                          uint32_t flags,
+                          const std::map<String, std::vector<String>>& bundles = {})
+{
+    std::vector<Bytef> body;
+    std::vector<PackFile::TocEntry*> tocEntries;
+    auto appendEntry = [&body, &tocEntries](const String& name, char* entryData, uint32_t size) {
+        PackFileData* data = PackFileData::Create(entryData, size);
+        uLongf compressedSize = compressBound(data->GetDataSize());
+        std::vector<Bytef> compressedData(compressedSize);
+        compress(compressedData.data(),
+                 &compressedSize,
+                 reinterpret_cast<Bytef*>(data),
+                 data->GetDataSize());
+
+        PackFile::TocEntry* toc =
+            PackFile::TocEntry::Create(name, body.size(), data->GetDataSize());
+        toc->dataSizeCompressed = compressedSize;
+        tocEntries.push_back(toc);
+        body.insert(body.end(), compressedData.begin(), compressedData.begin() + compressedSize);
+        free(data);
+    };
+
+    std::map<String, PackFile::TocEntry*> tocEntriesByName;
+    for (const auto& entry : entries)
+    {
+        if (entry.second.IsEmpty())
+        {
+            tocEntries.push_back(PackFile::TocEntry::Create(entry.first, body.size(), 0));
+            continue;
+        }
+        appendEntry(entry.first, const_cast<char*>(entry.second.Str()), entry.second.Size() + 1);
+        tocEntriesByName[entry.first] = tocEntries.back();
+    }
+
+    if (!bundles.empty())
+    {
+        PackBundleData bundleData;
+        for (const auto& bundle : bundles)
+        {
+            PackFile::TocEntry* first = tocEntriesByName[bundle.second.front()];
+            PackFile::TocEntry* last = tocEntriesByName[bundle.second.back()];
+            bundleData.bundles[bundle.first] = {
+                first->dataOffset,
+                last->dataOffset + last->dataSizeCompressed - first->dataOffset,
+                bundle.second};
+        }
+
+        BinarySerialisation::Buffer dataBuffer;
+        BinarySerialisation::serialise(dataBuffer, bundleData, BinarySerialisation::SERIALISE);
+        appendEntry(PACKER_BUNDLE_TABLE_NAME,
+                    reinterpret_cast<char*>(dataBuffer.data.data()),
+                    dataBuffer.data.size());
+    }
+
+    uint64_t tocOffset = body.size();
+    body.insert(body.end(), PACKER_MAGIC_NUMBER_TOC, PACKER_MAGIC_NUMBER_TOC + 4);
+    for (PackFile::TocEntry* toc : tocEntries)
+    {
+        Bytef* tocData = reinterpret_cast<Bytef*>(toc);
+        body.insert(body.end(), tocData, tocData + toc->GetDataSize());
+        free(toc);
+    }
+
+    PackFile::Header header {{PACKER_MAGIC_NUMBER_FILE},
+                             PACKER_FILE_VERSION,
+                             body.size(),
+                             tocOffset,
+                             sizeof(PackFile::Header),
+                             1,
+                             flags};
+    std::ofstream outputFileStream(packPath, std::ios::out | std::ios::binary);
+    outputFileStream.write(reinterpret_cast<char*>(&header), sizeof(header));
+    outputFileStream.write(reinterpret_cast<char*>(body.data()), body.size());
+}
+
 UTEST_F_SETUP(test_ResourceSystem)
 {
     ResourceSystem& resourceSystem = ResourceSystem::GetInstance();
@@ -57,8 +141,26 @@ UTEST_F(test_ResourceSystem, ReadAllPackedEntries)
 
     const PackFile::Header& header = packFile->GetHeader();
     ASSERT_STREQ("pck", header.magic.string);
-    ASSERT_EQ(49643, header.bodySize);
-    ASSERT_EQ(49386, header.tocOffset);
+    ASSERT_EQ(PACKER_FILE_VERSION, header.version);
+    ASSERT_EQ(PACKER_DEFAULT_ENTRY_ALIGNMENT, header.entryAlignment);
+    ASSERT_EQ(0, header.bodyOffset % header.entryAlignment);
+
+    // Entry data should be aligned and tightly followed by the ToC
+    uint64_t dataEnd = 0;
+    uint64_t dataSizeCompressed = 0;
+    uint64_t tocSize = 0;
+    for (auto& entry : packFile->GetEntries())
+    {
+        const PackFile::TocEntry* toc = entry.second;
+        ASSERT_EQ(0, toc->dataOffset % header.entryAlignment);
+        dataEnd = std::max(dataEnd, toc->dataOffset + toc->dataSizeCompressed);
+        dataSizeCompressed += toc->dataSizeCompressed;
+        tocSize += toc->GetDataSize();
+    }
+    ASSERT_EQ(49386, dataSizeCompressed);
+    ASSERT_EQ(349, tocSize);
+    ASSERT_EQ(dataEnd, header.tocOffset);
+    ASSERT_EQ(header.tocOffset + PACKER_MAGIC_NUMBER_SIZE + tocSize, header.bodySize);
 
     std::vector<String> packedFilepaths {"assets/scene2.scene",
                                          "assets/scene1.scene",
@@ -561,3 +663,275 @@ UTEST_F(test_ResourceSystem, LoadAnimationData)
         }
     }
 }
+
+UTEST_F(test_ResourceSystem, LoadDataAsync)
+{
+    ResourceSystem& resourceSystem = ResourceSystem::GetInstance();
+
+    uint32_t callbackCount = 0;
+    std::shared_ptr<Texture2DData> callbackData;
+    LoadHandle<Texture2DData> textureHandle = resourceSystem.LoadAsync<Texture2DData>(
+        "assets/cappy.png",
+        LoadPriority::HIGH,
+        [&callbackCount, &callbackData](const std::shared_ptr<Texture2DData>& data) {
+            callbackCount++;
+            callbackData = data;
+        });
+    LoadHandle<PackFileData> fontHandle =
+        resourceSystem.LoadAsync<PackFileData>("assets/PublicPixel.ttf");
+    LoadHandle<PackFileData> missingHandle =
+        resourceSystem.LoadAsync<PackFileData>("assets/nonexistent.filetype");
+
+    ASSERT_TRUE(resourceSystem.HasPendingLoads());
+    while (resourceSystem.HasPendingLoads()) resourceSystem.PumpCompletions();
+
+    ASSERT_EQ(1, callbackCount);
+    ASSERT_TRUE(textureHandle.IsReady());
+    ASSERT_TRUE(callbackData == textureHandle.Get());
+    ASSERT_EQ(160000, textureHandle.Get()->GetImageSize());
+    ASSERT_TRUE(fontHandle.IsReady());
+    ASSERT_EQ(97456, fontHandle.Get()->dataSize);
+    ASSERT_EQ(LoadStatus::FAILED, missingHandle.GetStatus());
+    ASSERT_FALSE(missingHandle.Get());
+}
+
+UTEST_F(test_ResourceSystem, CancelDataAsync)
+{
+    ResourceSystem& resourceSystem = ResourceSystem::GetInstance();
+
+    bool callbackCalled = false;
+    LoadHandle<Texture2DData> handle = resourceSystem.LoadAsync<Texture2DData>(
+        "assets/cappy.png",
+        LoadPriority::LOW,
+        [&callbackCalled](const std::shared_ptr<Texture2DData>&) { callbackCalled = true; });
+    handle.Cancel();
+
+    while (resourceSystem.HasPendingLoads()) resourceSystem.PumpCompletions();
+
+    ASSERT_FALSE(callbackCalled);
+    ASSERT_EQ(LoadStatus::CANCELLED, handle.GetStatus());
+    ASSERT_FALSE(handle.Get());
+}
+
+UTEST(test_ResourceSystem, LoadDataAsyncWithoutPackFile)
+{
+    ResourceSystem& resourceSystem = ResourceSystem::GetInstance();
+
+    LoadHandle<PackFileData> handle =
+        resourceSystem.LoadAsync<PackFileData>("assets/PublicPixel.ttf");
+    ASSERT_TRUE(handle.IsDone());
+    ASSERT_EQ(LoadStatus::FAILED, handle.GetStatus());
+    ASSERT_FALSE(resourceSystem.HasPendingLoads());
+}
+
+UTEST_F(test_ResourceSystem, ViewPackedData)
+{
+    ResourceSystem& resourceSystem = ResourceSystem::GetInstance();
+    PackFile* packFile = resourceSystem.GetPackFile();
+
+    std::shared_ptr<StaticMeshData> meshData =
+        packFile->FindDataDeserialised<StaticMeshData>("assets/cube.sm");
+    std::shared_ptr<const StaticMeshDataView> meshView =
+        packFile->FindDataView<StaticMeshDataView>("assets/cube.sm");
+    ASSERT_TRUE(meshData);
+    ASSERT_TRUE(meshView);
+    ASSERT_EQ(meshData->indices.size(), meshView->indices.Size());
+    ASSERT_EQ(meshData->vertices.size(), meshView->vertices.Size());
+    for (size_t i = 0; i < meshData->vertices.size(); i++)
+    {
+        ASSERT_TRUE(meshData->vertices[i] == meshView->vertices[i]);
+    }
+
+    std::shared_ptr<const Texture2DDataView> textureView =
+        packFile->FindDataView<Texture2DDataView>("assets/cappy.png");
+    ASSERT_TRUE(textureView);
+    ASSERT_EQ(160000, textureView->GetImageSize());
+    ASSERT_EQ(160000, textureView->pixels.Size());
+
+    std::shared_ptr<const StaticMeshDataView> missingView =
+        packFile->FindDataView<StaticMeshDataView>("assets/nonexistent.sm");
+    ASSERT_FALSE(missingView);
+}
+
+UTEST(test_ResourceSystem, LoadVersion1PackFile)
+{
+    // Version 1 packs have 32-bit offsets and entry sizes, and no entry alignment
+    const char entryName[] = "assets/data.bin";
+    const char entryData[] = "version one data";
+
+    uint32_t rawSize = sizeof(PackFileDataV1) + sizeof(entryData);
+    std::vector<char> rawData(rawSize);
+    reinterpret_cast<PackFileDataV1*>(rawData.data())->dataSize = sizeof(entryData);
+    memcpy(rawData.data() + sizeof(PackFileDataV1), entryData, sizeof(entryData));
+
+    uLongf compressedSize = compressBound(rawSize);
+    std::vector<Bytef> compressedData(compressedSize);
+    compress(compressedData.data(),
+             &compressedSize,
+             reinterpret_cast<Bytef*>(rawData.data()),
+             rawSize);
+
+    PackFile::TocEntryV1 tocEntry {0, rawSize, static_cast<uint32_t>(compressedSize)};
+    uint64_t tocSize = sizeof(PackFile::TocEntryV1) + sizeof(entryName);
+    PackFile::HeaderV1 header {{PACKER_MAGIC_NUMBER_FILE},
+                               PACKER_FILE_VERSION_V1,
+                               compressedSize + PACKER_MAGIC_NUMBER_SIZE + tocSize,
+                               compressedSize};
+
+    std::filesystem::path packPath = std::filesystem::temp_directory_path() / "siege_v1.pck";
+    std::ofstream outputFileStream(packPath, std::ios::out | std::ios::binary);
+    outputFileStream.write(reinterpret_cast<char*>(&header), sizeof(header));
+    outputFileStream.write(reinterpret_cast<char*>(compressedData.data()), compressedSize);
+    outputFileStream.write(PACKER_MAGIC_NUMBER_TOC, PACKER_MAGIC_NUMBER_SIZE);
+    outputFileStream.write(reinterpret_cast<char*>(&tocEntry), sizeof(tocEntry));
+    outputFileStream.write(entryName, sizeof(entryName));
+    outputFileStream.close();
+
+    PackFile packFile(packPath.c_str());
+    std::filesystem::remove(packPath);
+
+    ASSERT_EQ(PACKER_FILE_VERSION_V1, packFile.GetHeader().version);
+    ASSERT_EQ(1, packFile.GetEntries().size());
+
+    std::shared_ptr<PackFileData> data = packFile.FindData(entryName);
+    ASSERT_TRUE(data);
+    ASSERT_EQ(sizeof(entryData), data->dataSize);
+    ASSERT_STREQ(entryData, data->GetData());
+}
+
+UTEST(test_ResourceSystem, MountPatchPackFileWithoutBase)
+{
+    ResourceSystem& resourceSystem = ResourceSystem::GetInstance();
+
+    std::filesystem::path patchPath = std::filesystem::temp_directory_path() / "siege_patch.pck";
+    WritePackFile(patchPath, {{"assets/patched.txt", "patched"}}, PACKER_FLAG_DELTA);
+
+    bool result = resourceSystem.MountPatchPackFile(patchPath.c_str());
+    std::filesystem::remove(patchPath);
+    ASSERT_FALSE(result);
+    ASSERT_FALSE(resourceSystem.GetPackFile());
+}
+
+UTEST_F(test_ResourceSystem, MountPatchPackFiles)
+{
+    ResourceSystem& resourceSystem = ResourceSystem::GetInstance();
+    PackFile* basePackFile = resourceSystem.GetPackFile();
+
+    std::filesystem::path tempDir = std::filesystem::temp_directory_path();
+    std::filesystem::path firstPatchPath = tempDir / "siege_patch_1.pck";
+    std::filesystem::path secondPatchPath = tempDir / "siege_patch_2.pck";
+    WritePackFile(firstPatchPath,
+                  {{"assets/PublicPixel.ttf", "first font"}, {"assets/added.txt", "added"}},
+                  PACKER_FLAG_DELTA);
+    WritePackFile(secondPatchPath,
+                  {{"assets/PublicPixel.ttf", "second font"}, {"assets/cappy.png", ""}},
+                  PACKER_FLAG_DELTA);
+
+    ASSERT_TRUE(resourceSystem.MountPatchPackFile(firstPatchPath.c_str()));
+    ASSERT_TRUE(resourceSystem.MountPatchPackFile(secondPatchPath.c_str()));
+    std::filesystem::remove(firstPatchPath);
+    std::filesystem::remove(secondPatchPath);
+
+    ASSERT_EQ(3, resourceSystem.GetPackFiles().size());
+    ASSERT_TRUE(basePackFile == resourceSystem.GetPackFile());
+    ASSERT_TRUE(resourceSystem.GetPackFiles()[1]->IsDelta());
+
+    // Later patches should shadow entries from earlier packs
+    std::shared_ptr<PackFileData> fontData = resourceSystem.FindData("assets/PublicPixel.ttf");
+    ASSERT_TRUE(fontData);
+    ASSERT_STREQ("second font", fontData->GetData());
+    ASSERT_TRUE(resourceSystem.GetPackFiles()[2] ==
+                resourceSystem.FindPackFile("assets/PublicPixel.ttf"));
+
+    std::shared_ptr<PackFileData> addedData = resourceSystem.FindData("assets/added.txt");
+    ASSERT_TRUE(addedData);
+    ASSERT_STREQ("added", addedData->GetData());
+
+    // Entries removed by a patch should no longer be found, others should come from the base
+    ASSERT_FALSE(resourceSystem.FindPackFile("assets/cappy.png"));
+    ASSERT_FALSE(resourceSystem.FindData("assets/cappy.png"));
+    ASSERT_TRUE(basePackFile == resourceSystem.FindPackFile("assets/cube.sm"));
+    ASSERT_TRUE(resourceSystem.FindDataDeserialised<StaticMeshData>("assets/cube.sm"));
+}
+
+UTEST(test_ResourceSystem, PreloadPackBundles)
+{
+    std::filesystem::path packPath = std::filesystem::temp_directory_path() / "siege_bundles.pck";
+    WritePackFile(packPath,
+                  {{"assets/level.scene", "level"},
+                   {"assets/level.txt", "level data"},
+                   {"assets/other.txt", "other data"}},
+                  0,
+                  {{"assets/level.scene", {"assets/level.scene", "assets/level.txt"}}});
+
+    PackFile packFile(packPath.c_str(), PackFile::STREAMED);
+    PackFile residentPackFile(packPath.c_str());
+    std::filesystem::remove(packPath);
+    ASSERT_TRUE(packFile.IsValid());
+
+    const PackBundle* bundle = packFile.FindBundle("assets/level.scene");
+    ASSERT_TRUE(bundle);
+    ASSERT_EQ(2, bundle->entries.size());
+    ASSERT_TRUE(bundle->entries[1] == "assets/level.txt");
+    ASSERT_FALSE(packFile.FindBundle("assets/level.txt"));
+
+    ASSERT_FALSE(packFile.PreloadBundle("assets/missing.scene"));
+    ASSERT_TRUE(packFile.PreloadBundle("assets/level.scene"));
+    ASSERT_TRUE(residentPackFile.PreloadBundle("assets/level.scene"));
+
+    // Entries should read the same whether they come from a preloaded bundle or the file
+    std::shared_ptr<PackFileData> levelData = packFile.FindData("assets/level.txt");
+    std::shared_ptr<PackFileData> otherData = packFile.FindData("assets/other.txt");
+    packFile.ReleaseBundles();
+    std::shared_ptr<PackFileData> releasedData = packFile.FindData("assets/level.txt");
+    ASSERT_TRUE(levelData);
+    ASSERT_TRUE(otherData);
+    ASSERT_TRUE(releasedData);
+    ASSERT_STREQ("level data", levelData->GetData());
+    ASSERT_STREQ("other data", otherData->GetData());
+    ASSERT_STREQ("level data", releasedData->GetData());
+    ASSERT_STREQ("level", packFile.FindData("assets/level.scene")->GetData());
+}
+
+UTEST(test_ResourceSystem, MountPackedDeltaWithBundles)
+{
+    ResourceSystem& resourceSystem = ResourceSystem::GetInstance();
+    ASSERT_TRUE(resourceSystem.MountPackFile("patch"));
+    ASSERT_TRUE(resourceSystem.MountPatchPackFile("patch/delta.pck", PackFile::STREAMED));
+
+    // Both packs were bundled, so the delta should carry its own bundle table rather than a
+    // removal of the base pack's
+    PackFile* deltaPackFile = resourceSystem.GetPackFiles().back();
+    auto it = deltaPackFile->GetEntries().find(PACKER_BUNDLE_TABLE_NAME);
+    bool hasBundleTable = it != deltaPackFile->GetEntries().end() && !it->second->IsRemoved();
+    bool hasSceneBundle = deltaPackFile->FindBundle("assets/scene2.scene");
+    bool preloaded = resourceSystem.PreloadBundle("assets/scene2.scene");
+    std::shared_ptr<PackFileData> sceneData = resourceSystem.FindData("assets/scene2.scene");
+    resourceSystem.UnmountPackFile();
+
+    ASSERT_TRUE(hasBundleTable);
+    ASSERT_TRUE(hasSceneBundle);
+    ASSERT_TRUE(preloaded);
+    ASSERT_TRUE(sceneData);
+}
+
+UTEST_F(test_ResourceSystem, TraceResourceAccesses)
+{
+    ResourceSystem& resourceSystem = ResourceSystem::GetInstance();
+    std::filesystem::path tracePath = std::filesystem::temp_directory_path() / "siege_trace.txt";
+
+    // The bundled test pack has no bundles to preload
+    ASSERT_FALSE(resourceSystem.PreloadBundle("assets/scene1.scene"));
+
+    resourceSystem.StartAccessTrace();
+    resourceSystem.FindData("assets/scene1.scene");
+    resourceSystem.FindData("assets/cappy.png");
+    resourceSystem.FindData("assets/missing.png");
+    resourceSystem.FindData("assets/scene1.scene");
+    ASSERT_TRUE(resourceSystem.StopAccessTrace(tracePath.c_str()));
+    resourceSystem.FindData("assets/cube.sm");
+
+    String trace = FileSystem::Read(tracePath.c_str());
+    std::filesystem::remove(tracePath);
+    ASSERT_STREQ("assets/scene1.scene\nassets/cappy.png\n", trace.Str());
+}
@@ -63,6 +63,15 @@ UTEST(test_BinarySerialisation, Native)
     ASSERT_EQ(36, i);
     buffer.Reset();
 
+    {
+        uint64_t u = 0x100000002;
+        Siege::BinarySerialisation::serialise(buffer, u, Siege::BinarySerialisation::SERIALISE);
+    }
+    uint64_t u;
+    Siege::BinarySerialisation::serialise(buffer, u, Siege::BinarySerialisation::DESERIALISE);
+    ASSERT_EQ(0x100000002, u);
+    buffer.Reset();
+
     {
         float f = 3.14f;
         Siege::BinarySerialisation::serialise(buffer, f, Siege::BinarySerialisation::SERIALISE);
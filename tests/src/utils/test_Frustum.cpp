@@ -0,0 +1,89 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#include <utest.h>
+#include <utils/math/Frustum.h>
+#include <utils/math/Projection.h>
+
+using namespace Siege;
+
+// A camera at the origin looking down negative z, seeing from 0.1 to 100 units away
+static Frustum MakeFrustum()
+{
+    return Frustum::FromViewProjection(Perspective(Float::Radians(90.f), 1.f, 0.1f, 100.f));
+}
+
+UTEST(test_Frustum, ExtractNormalisedPlanes)
+{
+    Frustum frustum = MakeFrustum();
+    for (const Vec4& plane : frustum.planes)
+    {
+        ASSERT_NEAR(1.f, Vec3::Length(plane.XYZ()), 1e-5f);
+    }
+
+    // The near and far planes face each other along the view direction
+    ASSERT_NEAR(-1.f, frustum.planes[Frustum::PLANE_NEAR].z, 1e-5f);
+    ASSERT_NEAR(-0.1f, frustum.planes[Frustum::PLANE_NEAR].w, 1e-4f);
+    ASSERT_NEAR(1.f, frustum.planes[Frustum::PLANE_FAR].z, 1e-5f);
+    ASSERT_NEAR(100.f, frustum.planes[Frustum::PLANE_FAR].w, 1e-2f);
+}
+
+UTEST(test_Frustum, IntersectSpheres)
+{
+    Frustum frustum = MakeFrustum();
+
+    ASSERT_TRUE(frustum.Intersects(Vec3 {0.f, 0.f, -5.f}, 1.f));
+    ASSERT_FALSE(frustum.Intersects(Vec3 {0.f, 0.f, 5.f}, 1.f));
+    ASSERT_FALSE(frustum.Intersects(Vec3 {0.f, 0.f, -102.f}, 1.f));
+    ASSERT_FALSE(frustum.Intersects(Vec3 {-20.f, 0.f, -5.f}, 1.f));
+    ASSERT_FALSE(frustum.Intersects(Vec3 {0.f, 20.f, -5.f}, 1.f));
+
+    // Spheres straddling a plane are kept
+    ASSERT_TRUE(frustum.Intersects(Vec3 {0.f, 0.f, 0.5f}, 1.f));
+    ASSERT_TRUE(frustum.Intersects(Vec3 {-5.5f, 0.f, -5.f}, 1.f));
+}
+
+UTEST(test_Frustum, IntersectBoxes)
+{
+    Frustum frustum = MakeFrustum();
+
+    ASSERT_TRUE(frustum.Intersects(BoundedBox({-1.f, -1.f, -6.f}, {1.f, 1.f, -4.f})));
+    ASSERT_FALSE(frustum.Intersects(BoundedBox({-1.f, -1.f, 4.f}, {1.f, 1.f, 6.f})));
+    ASSERT_FALSE(frustum.Intersects(BoundedBox({-22.f, -1.f, -6.f}, {-20.f, 1.f, -4.f})));
+
+    // A long box crossing the view is kept even though none of its corners are inside
+    ASSERT_TRUE(frustum.Intersects(BoundedBox({-50.f, -0.1f, -5.1f}, {50.f, 0.1f, -4.9f})));
+}
+
+UTEST(test_Frustum, CullSpheresMatchesIntersects)
+{
+    Frustum frustum = MakeFrustum();
+
+    // Enough spheres to cover both whole groups of four and a remainder
+    Vec4 spheres[11];
+    for (size_t i = 0; i < 11; i++)
+    {
+        float offset = static_cast<float>(i) * 4.f - 20.f;
+        spheres[i] = {offset, offset * 0.5f, -10.f + offset, 1.5f};
+    }
+
+    uint8_t visible[11] {};
+    size_t visibleCount = CullSpheres(frustum, spheres, 11, visible);
+
+    size_t expectedCount {0};
+    for (size_t i = 0; i < 11; i++)
+    {
+        bool expected = frustum.Intersects(spheres[i].XYZ(), spheres[i].w);
+        ASSERT_EQ(expected, visible[i] == 1);
+        expectedCount += expected;
+    }
+    ASSERT_EQ(expectedCount, visibleCount);
+    ASSERT_GT(visibleCount, 0u);
+    ASSERT_LT(visibleCount, 11u);
+}
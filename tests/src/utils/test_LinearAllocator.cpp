@@ -0,0 +1,69 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#include <utest.h>
+#include <utils/allocators/LinearAllocator.h>
+
+using namespace Siege;
+
+UTEST(test_LinearAllocator, EmptyConstructor)
+{
+    LinearAllocator a;
+    ASSERT_EQ(0, a.Capacity());
+    ASSERT_EQ(0, a.BytesRemaining());
+    ASSERT_EQ(LinearAllocator::INVALID_OFFSET, a.Allocate(1));
+}
+
+UTEST(test_LinearAllocator, AllocateSequentially)
+{
+    LinearAllocator a(64);
+    ASSERT_EQ(0, a.Allocate(16));
+    ASSERT_EQ(16, a.Allocate(8));
+    ASSERT_EQ(24, a.Allocate(40));
+    ASSERT_EQ(64, a.BytesUsed());
+    ASSERT_EQ(0, a.BytesRemaining());
+}
+
+UTEST(test_LinearAllocator, AllocateAligned)
+{
+    LinearAllocator a(256);
+    ASSERT_EQ(0, a.Allocate(4, 64));
+    ASSERT_EQ(64, a.Allocate(4, 64));
+    ASSERT_EQ(68, a.Allocate(4));
+    ASSERT_EQ(80, a.Allocate(4, 16));
+    ASSERT_EQ(84, a.BytesUsed());
+}
+
+UTEST(test_LinearAllocator, AllocateWhenFull)
+{
+    LinearAllocator a(128);
+    ASSERT_EQ(0, a.Allocate(100));
+
+    // Fits in the remaining space, but not once the offset is aligned
+    ASSERT_EQ(LinearAllocator::INVALID_OFFSET, a.Allocate(20, 64));
+    ASSERT_EQ(LinearAllocator::INVALID_OFFSET, a.Allocate(UINT64_MAX));
+    ASSERT_EQ(100, a.BytesUsed());
+
+    ASSERT_EQ(100, a.Allocate(28));
+}
+
+UTEST(test_LinearAllocator, ResetKeepsHighWaterMark)
+{
+    LinearAllocator a(128);
+    a.Allocate(96);
+    a.Reset();
+
+    ASSERT_EQ(0, a.BytesUsed());
+    ASSERT_EQ(96, a.HighWaterMark());
+    ASSERT_EQ(0, a.Allocate(32));
+
+    a.Reset();
+    a.Allocate(120);
+    ASSERT_EQ(120, a.HighWaterMark());
+}
@@ -0,0 +1,177 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#include <utest.h>
+#include <utils/allocators/OffsetAllocator.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace Siege;
+
+UTEST(test_OffsetAllocator, EmptyConstructor)
+{
+    OffsetAllocator a;
+    ASSERT_EQ(0, a.Capacity());
+    ASSERT_TRUE(a.IsEmpty());
+    ASSERT_EQ(OffsetAllocator::INVALID_OFFSET, a.Allocate(16).offset);
+}
+
+UTEST(test_OffsetAllocator, AllocateSequentially)
+{
+    OffsetAllocator a(1024);
+
+    auto first = a.Allocate(100);
+    auto second = a.Allocate(200);
+    ASSERT_EQ(0, first.offset);
+    ASSERT_EQ(100, second.offset);
+    ASSERT_EQ(100, a.GetAllocationSize(first));
+    ASSERT_EQ(300, a.BytesAllocated());
+    ASSERT_EQ(2, a.AllocationCount());
+}
+
+UTEST(test_OffsetAllocator, AllocateAligned)
+{
+    OffsetAllocator a(4096);
+
+    auto first = a.Allocate(10);
+    auto aligned = a.Allocate(64, 256);
+    ASSERT_EQ(0, first.offset);
+    ASSERT_EQ(256, aligned.offset);
+
+    // The space skipped for alignment can still be allocated
+    auto small = a.Allocate(100);
+    ASSERT_NE(OffsetAllocator::INVALID_OFFSET, small.offset);
+    ASSERT_LT(small.offset, 256);
+    ASSERT_GE(small.offset, 10);
+}
+
+UTEST(test_OffsetAllocator, AllocateWhenFull)
+{
+    OffsetAllocator a(256);
+
+    ASSERT_EQ(0, a.Allocate(256).offset);
+    ASSERT_EQ(OffsetAllocator::INVALID_OFFSET, a.Allocate(1).offset);
+    ASSERT_EQ(OffsetAllocator::INVALID_OFFSET, a.Allocate(0).offset);
+    ASSERT_EQ(OffsetAllocator::INVALID_OFFSET, a.Allocate(UINT64_MAX).offset);
+}
+
+UTEST(test_OffsetAllocator, FreeMergesNeighbours)
+{
+    OffsetAllocator a(300);
+
+    auto first = a.Allocate(100);
+    auto second = a.Allocate(100);
+    auto third = a.Allocate(100);
+
+    a.Free(first);
+    a.Free(third);
+
+    auto stats = a.GetStats();
+    ASSERT_EQ(2, stats.freeRegionCount);
+    ASSERT_EQ(100, stats.largestFreeRegion);
+    ASSERT_EQ(OffsetAllocator::INVALID_OFFSET, a.Allocate(150).offset);
+
+    // Freeing the middle allocation joins all three regions back together
+    a.Free(second);
+
+    stats = a.GetStats();
+    ASSERT_TRUE(a.IsEmpty());
+    ASSERT_EQ(1, stats.freeRegionCount);
+    ASSERT_EQ(300, stats.largestFreeRegion);
+    ASSERT_EQ(0, a.Allocate(300).offset);
+}
+
+UTEST(test_OffsetAllocator, ReuseFreedSpace)
+{
+    OffsetAllocator a(1024);
+
+    auto first = a.Allocate(512);
+    a.Allocate(512);
+    a.Free(first);
+
+    auto reused = a.Allocate(256);
+    ASSERT_EQ(0, reused.offset);
+    ASSERT_EQ(256, a.Allocate(256).offset);
+}
+
+UTEST(test_OffsetAllocator, StatsReportFragmentation)
+{
+    OffsetAllocator a(1000);
+
+    std::vector<OffsetAllocator::Allocation> allocations;
+    for (size_t i = 0; i < 10; i++) allocations.push_back(a.Allocate(100));
+
+    // Freeing every other allocation leaves five separate 100 byte regions
+    for (size_t i = 0; i < allocations.size(); i += 2) a.Free(allocations[i]);
+
+    auto stats = a.GetStats();
+    ASSERT_EQ(1000, stats.capacity);
+    ASSERT_EQ(500, stats.bytesAllocated);
+    ASSERT_EQ(500, stats.bytesFree);
+    ASSERT_EQ(5, stats.allocationCount);
+    ASSERT_EQ(5, stats.freeRegionCount);
+    ASSERT_EQ(100, stats.largestFreeRegion);
+    ASSERT_NEAR(0.8f, stats.Fragmentation(), 0.0001f);
+
+    for (size_t i = 1; i < allocations.size(); i += 2) a.Free(allocations[i]);
+    ASSERT_NEAR(0.f, a.GetStats().Fragmentation(), 0.0001f);
+}
+
+UTEST(test_OffsetAllocator, RandomAllocationsDontOverlap)
+{
+    std::mt19937 random(11);
+    std::uniform_int_distribution<uint64_t> sizes(1, 4096);
+    std::uniform_int_distribution<uint32_t> alignmentShifts(0, 8);
+
+    OffsetAllocator a(1 << 20);
+
+    struct Range
+    {
+        OffsetAllocator::Allocation allocation;
+        uint64_t size;
+    };
+    std::vector<Range> live;
+
+    for (size_t i = 0; i < 2000; i++)
+    {
+        if (!live.empty() && random() % 3 == 0)
+        {
+            size_t index = random() % live.size();
+            a.Free(live[index].allocation);
+            live.erase(live.begin() + index);
+            continue;
+        }
+
+        uint64_t size = sizes(random);
+        uint64_t alignment = 1ull << alignmentShifts(random);
+        auto allocation = a.Allocate(size, alignment);
+        if (allocation.offset == OffsetAllocator::INVALID_OFFSET) continue;
+
+        ASSERT_EQ(0, allocation.offset % alignment);
+        ASSERT_LE(allocation.offset + size, a.Capacity());
+        live.push_back({allocation, size});
+    }
+
+    std::sort(live.begin(), live.end(), [](const Range& left, const Range& right) {
+        return left.allocation.offset < right.allocation.offset;
+    });
+    for (size_t i = 1; i < live.size(); i++)
+    {
+        ASSERT_LE(live[i - 1].allocation.offset + live[i - 1].size, live[i].allocation.offset);
+    }
+
+    for (auto& range : live) a.Free(range.allocation);
+
+    auto stats = a.GetStats();
+    ASSERT_TRUE(a.IsEmpty());
+    ASSERT_EQ(1, stats.freeRegionCount);
+    ASSERT_EQ(a.Capacity(), stats.largestFreeRegion);
+}
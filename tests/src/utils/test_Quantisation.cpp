@@ -0,0 +1,98 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#include <utest.h>
+#include <utils/math/Quantisation.h>
+
+using namespace Siege;
+
+UTEST(test_Quantisation, HalfConversion)
+{
+    ASSERT_EQ(0x0000, Quantisation::FloatToHalf(0.f));
+    ASSERT_EQ(0x3c00, Quantisation::FloatToHalf(1.f));
+    ASSERT_EQ(0xc000, Quantisation::FloatToHalf(-2.f));
+    ASSERT_EQ(0x3555, Quantisation::FloatToHalf(1.f / 3.f));
+    ASSERT_EQ(0x7bff, Quantisation::FloatToHalf(65504.f));
+    ASSERT_EQ(0x7c00, Quantisation::FloatToHalf(100000.f));
+    ASSERT_EQ(0x0001, Quantisation::FloatToHalf(5.9604645e-8f));
+
+    ASSERT_EQ(1.f, Quantisation::HalfToFloat(0x3c00));
+    ASSERT_EQ(-2.f, Quantisation::HalfToFloat(0xc000));
+    ASSERT_EQ(65504.f, Quantisation::HalfToFloat(0x7bff));
+    ASSERT_EQ(5.9604645e-8f, Quantisation::HalfToFloat(0x0001));
+
+    // Values exactly representable as halves should round trip
+    for (float value : {0.5f, 0.25f, 0.75f, 1024.f, -0.125f})
+    {
+        ASSERT_EQ(value, Quantisation::HalfToFloat(Quantisation::FloatToHalf(value)));
+    }
+}
+
+UTEST(test_Quantisation, NormalisedConversion)
+{
+    ASSERT_EQ(0, Quantisation::EncodeUnorm16(-1.f));
+    ASSERT_EQ(65535, Quantisation::EncodeUnorm16(1.f));
+    ASSERT_EQ(32768, Quantisation::EncodeUnorm16(0.5f));
+    ASSERT_EQ(1.f, Quantisation::DecodeUnorm16(65535));
+
+    ASSERT_EQ(-32767, Quantisation::EncodeSnorm16(-2.f));
+    ASSERT_EQ(32767, Quantisation::EncodeSnorm16(1.f));
+    ASSERT_EQ(-1.f, Quantisation::DecodeSnorm16(-32768));
+
+    ASSERT_EQ(128, Quantisation::EncodeUnorm8(0.5f));
+    ASSERT_EQ(255, Quantisation::EncodeUnorm8(2.f));
+    ASSERT_EQ(1.f, Quantisation::DecodeUnorm8(255));
+}
+
+UTEST(test_Quantisation, OctahedralEncoding)
+{
+    Vec3 normals[] = {{0.f, 0.f, 1.f},
+                      {0.f, 0.f, -1.f},
+                      {1.f, 0.f, 0.f},
+                      {0.f, -1.f, 0.f},
+                      Vec3::Normalise({1.f, 2.f, -3.f}),
+                      Vec3::Normalise({-0.3f, 0.4f, -0.2f})};
+    for (const Vec3& normal : normals)
+    {
+        Vec2 encoded = Quantisation::OctahedralEncode(normal);
+        ASSERT_LE(std::abs(encoded.x), 1.f);
+        ASSERT_LE(std::abs(encoded.y), 1.f);
+
+        Vec3 decoded = Quantisation::OctahedralDecode(encoded);
+        ASSERT_NEAR(normal.x, decoded.x, 1e-5f);
+        ASSERT_NEAR(normal.y, decoded.y, 1e-5f);
+        ASSERT_NEAR(normal.z, decoded.z, 1e-5f);
+
+        // Storing the encoding as 16-bit normalised values should keep the error small
+        Vec2 stored {Quantisation::DecodeSnorm16(Quantisation::EncodeSnorm16(encoded.x)),
+                     Quantisation::DecodeSnorm16(Quantisation::EncodeSnorm16(encoded.y))};
+        ASSERT_GT(Vec3::Dot(normal, Quantisation::OctahedralDecode(stored)), 0.9999f);
+    }
+}
+
+UTEST(test_Quantisation, SmallestThreeEncoding)
+{
+    Vec4 rotations[] = {{0.f, 0.f, 0.f, 1.f},
+                        {0.f, 0.f, 0.f, -1.f},
+                        {1.f, 0.f, 0.f, 0.f},
+                        {0.f, -0.70710678f, 0.f, 0.70710678f},
+                        {0.5f, -0.5f, 0.5f, 0.5f},
+                        {0.18257419f, -0.36514837f, 0.54772256f, -0.73029674f}};
+    for (const Vec4& rotation : rotations)
+    {
+        uint16_t encoded[3];
+        Quantisation::SmallestThreeEncode(rotation, encoded);
+        Vec4 decoded = Quantisation::SmallestThreeDecode(encoded);
+
+        // The decoded rotation may be negated, which represents the same orientation
+        float dot = rotation.x * decoded.x + rotation.y * decoded.y + rotation.z * decoded.z +
+                    rotation.w * decoded.w;
+        ASSERT_GT(std::abs(dot), 0.99999f);
+    }
+}
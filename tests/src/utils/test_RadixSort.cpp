@@ -0,0 +1,88 @@
+//
+// Copyright (c) 2020-present Caps Collective & contributors
+// Originally authored by Jonathan Moallem (@jonjondev) & Aryeh Zinn (@Raelr)
+//
+// This code is released under an unmodified zlib license.
+// For conditions of distribution and use, please see:
+//     https://opensource.org/licenses/Zlib
+//
+
+#include <utest.h>
+#include <utils/RadixSort.h>
+
+#include <algorithm>
+#include <random>
+
+struct SortItem
+{
+    uint64_t key;
+    uint32_t index;
+};
+
+static uint64_t GetItemKey(const SortItem& item)
+{
+    return item.key;
+}
+
+UTEST(test_RadixSort, SortEmptyAndSingleItem)
+{
+    std::vector<SortItem> items, scratch;
+    Siege::RadixSort(items, scratch, GetItemKey);
+    ASSERT_TRUE(items.empty());
+
+    items.push_back({42, 0});
+    Siege::RadixSort(items, scratch, GetItemKey);
+    ASSERT_EQ(1, items.size());
+    ASSERT_EQ(42, items[0].key);
+}
+
+UTEST(test_RadixSort, SortRandomKeys)
+{
+    std::mt19937_64 random(7);
+    std::vector<SortItem> items, scratch;
+    for (uint32_t i = 0; i < 1000; i++) items.push_back({random(), i});
+
+    std::vector<SortItem> expected = items;
+    std::stable_sort(expected.begin(), expected.end(), [](const SortItem& a, const SortItem& b) {
+        return a.key < b.key;
+    });
+
+    Siege::RadixSort(items, scratch, GetItemKey);
+
+    ASSERT_EQ(expected.size(), items.size());
+    for (size_t i = 0; i < items.size(); i++)
+    {
+        ASSERT_EQ(expected[i].key, items[i].key);
+        ASSERT_EQ(expected[i].index, items[i].index);
+    }
+}
+
+UTEST(test_RadixSort, SortIsStable)
+{
+    std::vector<SortItem> items, scratch;
+    for (uint32_t i = 0; i < 64; i++) items.push_back({(i % 4) << 8, i});
+
+    Siege::RadixSort(items, scratch, GetItemKey);
+
+    for (size_t i = 1; i < items.size(); i++)
+    {
+        ASSERT_LE(items[i - 1].key, items[i].key);
+        if (items[i - 1].key == items[i].key) ASSERT_LT(items[i - 1].index, items[i].index);
+    }
+}
+
+UTEST(test_RadixSort, SortKeysDifferingInOneDigit)
+{
+    // Only the top byte varies, so a single pass sorts the keys and leaves them in the scratch
+    // buffer, which has to be swapped back
+    std::vector<SortItem> items, scratch;
+    for (uint32_t i = 0; i < 16; i++) items.push_back({(uint64_t(15 - i) << 56) | 0xABCD, i});
+
+    Siege::RadixSort(items, scratch, GetItemKey);
+
+    for (size_t i = 0; i < items.size(); i++)
+    {
+        ASSERT_EQ((uint64_t(i) << 56) | 0xABCD, items[i].key);
+        ASSERT_EQ(15 - i, items[i].index);
+    }
+}